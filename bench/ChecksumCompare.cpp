@@ -0,0 +1,276 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    ChecksumCompare.cpp
+///	\author  Paul Ullrich
+///	\version October 18, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "CommandLine.h"
+#include "Announce.h"
+#include "Exception.h"
+
+#include <mpi.h>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Names of the statistics stored for each component.
+///	</summary>
+static const char * ChecksumStatisticNames[3] = {
+	"sum",
+	"L2",
+	"Linf"
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A checksum regression log written by OutputManagerChecksum.
+///	</summary>
+class ChecksumLog {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	ChecksumLog() :
+		fp(NULL)
+	{ }
+
+	///	<summary>
+	///		Destructor.
+	///	</summary>
+	~ChecksumLog() {
+		if (fp != NULL) {
+			fclose(fp);
+		}
+	}
+
+	///	<summary>
+	///		Open the log and read its header.
+	///	</summary>
+	void Open(
+		const std::string & strFile
+	) {
+		fp = fopen(strFile.c_str(), "rb");
+		if (fp == NULL) {
+			_EXCEPTION1("Unable to open checksum log \"%s\"", strFile.c_str());
+		}
+
+		char szMagic[8];
+		int nComponents;
+
+		if ((fread(szMagic, sizeof(char), 8, fp) != 8) ||
+			(strncmp(szMagic, "TEMPCHK1", 8) != 0)
+		) {
+			_EXCEPTION1("\"%s\" is not a checksum log", strFile.c_str());
+		}
+		if ((fread(&nComponents, sizeof(int), 1, fp) != 1) ||
+			(nComponents < 0)
+		) {
+			_EXCEPTION1("Invalid header in \"%s\"", strFile.c_str());
+		}
+
+		vecNames.resize(nComponents);
+		for (int c = 0; c < nComponents; c++) {
+			char szName[17];
+			if (fread(szName, sizeof(char), 16, fp) != 16) {
+				_EXCEPTION1("Invalid header in \"%s\"", strFile.c_str());
+			}
+			szName[16] = '\0';
+			vecNames[c] = szName;
+		}
+
+		vecValues.resize(3 * nComponents);
+	}
+
+	///	<summary>
+	///		Read the next record.  Returns false at the end of the log.
+	///	</summary>
+	bool ReadRecord() {
+		int iRecord[2];
+		if (fread(iRecord, sizeof(int), 2, fp) != 2) {
+			return false;
+		}
+		if (fread(&dTime, sizeof(double), 1, fp) != 1) {
+			return false;
+		}
+		if (fread(&(vecValues[0]), sizeof(double), vecValues.size(), fp)
+			!= vecValues.size()
+		) {
+			return false;
+		}
+
+		iOutput = iRecord[0];
+		return true;
+	}
+
+public:
+	///	<summary>
+	///		File handle.
+	///	</summary>
+	FILE * fp;
+
+	///	<summary>
+	///		Short name of each component.
+	///	</summary>
+	std::vector<std::string> vecNames;
+
+	///	<summary>
+	///		Output index of the current record.
+	///	</summary>
+	int iOutput;
+
+	///	<summary>
+	///		Time of the current record.
+	///	</summary>
+	double dTime;
+
+	///	<summary>
+	///		Sums, L2 norms and maximum norms of the current record.
+	///	</summary>
+	std::vector<double> vecValues;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char ** argv) {
+
+	// Initialize MPI
+	MPI_Init(&argc, &argv);
+
+	// Logs differ
+	bool fDiverged = false;
+
+	// Comparison could not be performed
+	bool fFailure = false;
+
+try {
+	// First log
+	std::string strLogA;
+
+	// Second log
+	std::string strLogB;
+
+	// Relative difference that is reported as a divergence
+	double dTolerance;
+
+	// Parse the command line
+	BeginCommandLine()
+		CommandLineString(strLogA, "a", "");
+		CommandLineString(strLogB, "b", "");
+		CommandLineDouble(dTolerance, "tolerance", 0.0);
+
+		ParseCommandLine(argc, argv);
+	EndCommandLine(argv)
+
+	if ((strLogA == "") || (strLogB == "")) {
+		_EXCEPTIONT("Two checksum logs must be specified (--a and --b)");
+	}
+
+	ChecksumLog logA;
+	ChecksumLog logB;
+
+	logA.Open(strLogA);
+	logB.Open(strLogB);
+
+	if (logA.vecNames != logB.vecNames) {
+		_EXCEPTIONT("Checksum logs contain different components");
+	}
+
+	int nComponents = static_cast<int>(logA.vecNames.size());
+
+	// Compare records until the first divergence
+	int nRecords = 0;
+	for (;;) {
+		bool fReadA = logA.ReadRecord();
+		bool fReadB = logB.ReadRecord();
+
+		if (!fReadA && !fReadB) {
+			break;
+		}
+		if (fReadA != fReadB) {
+			Announce("Logs have different lengths: %s ends after %i records",
+				(fReadA)?(strLogB.c_str()):(strLogA.c_str()), nRecords);
+			fDiverged = true;
+			break;
+		}
+		if (logA.iOutput != logB.iOutput) {
+			_EXCEPTION2("Output index mismatch (%i vs %i)",
+				logA.iOutput, logB.iOutput);
+		}
+
+		for (int s = 0; (s < 3) && (!fDiverged); s++) {
+		for (int c = 0; (c < nComponents) && (!fDiverged); c++) {
+			double dA = logA.vecValues[s * nComponents + c];
+			double dB = logB.vecValues[s * nComponents + c];
+
+			double dScale = fabs(dA);
+			if (fabs(dB) > dScale) {
+				dScale = fabs(dB);
+			}
+
+			double dDiff = fabs(dA - dB);
+			if (dScale > 0.0) {
+				dDiff /= dScale;
+			}
+
+			// A NaN in only one of the logs is always a divergence
+			if ((dDiff > dTolerance) || (std::isnan(dA) != std::isnan(dB))) {
+				Announce("First divergence at output %i (t = %1.6e s)",
+					logA.iOutput, logA.dTime);
+				Announce("  component %s (%s): %1.17e vs %1.17e"
+					" (relative difference %1.5e)",
+					logA.vecNames[c].c_str(),
+					ChecksumStatisticNames[s],
+					dA, dB, dDiff);
+				fDiverged = true;
+			}
+		}
+		}
+		if (fDiverged) {
+			break;
+		}
+
+		nRecords++;
+	}
+
+	if (!fDiverged) {
+		Announce("Logs agree over %i records (tolerance %1.5e)",
+			nRecords, dTolerance);
+	}
+
+} catch(Exception & e) {
+	std::cout << e.ToString() << std::endl;
+	fFailure = true;
+}
+
+	// Deinitialize MPI
+	MPI_Finalize();
+
+	if (fFailure) {
+		return (2);
+	}
+	if (fDiverged) {
+		return (1);
+	}
+	return (0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
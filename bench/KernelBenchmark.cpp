@@ -0,0 +1,869 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    KernelBenchmark.cpp
+///	\author  Paul Ullrich
+///	\version October 18, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "Tempest.h"
+#include "Profiler.h"
+#include "GridGLL.h"
+#include "GridPatchGLL.h"
+#include "Connectivity.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Synthetic state used to initialize the kernel benchmarks: a
+///		stratified atmosphere with constant Brunt-Vaisala frequency in
+///		solid body rotation, perturbed by a smooth potential temperature
+///		anomaly so that no field is trivially constant.
+///	</summary>
+class KernelBenchmarkTest : public TestCase {
+
+protected:
+	///	<summary>
+	///		Model cap.
+	///	</summary>
+	double m_dZtop;
+
+	///	<summary>
+	///		Background wind speed.
+	///	</summary>
+	double m_dU0;
+
+	///	<summary>
+	///		Background Brunt-Vaisala frequency.
+	///	</summary>
+	double m_dN;
+
+	///	<summary>
+	///		Surface temperature at the equator.
+	///	</summary>
+	double m_dTeq;
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	KernelBenchmarkTest(
+		double dZtop
+	) :
+		m_dZtop(dZtop),
+		m_dU0(20.0),
+		m_dN(0.01),
+		m_dTeq(300.0)
+	{ }
+
+public:
+	///	<summary>
+	///		Number of tracers used in this test.
+	///	</summary>
+	virtual int GetTracerCount() const {
+		return 0;
+	}
+
+	///	<summary>
+	///		Get the altitude of the model cap.
+	///	</summary>
+	virtual double GetZtop() const {
+		return m_dZtop;
+	}
+
+	///	<summary>
+	///		Flag indicating that a reference state is available.
+	///	</summary>
+	virtual bool HasReferenceState() const {
+		return true;
+	}
+
+	///	<summary>
+	///		Evaluate the reference state at the given point.
+	///	</summary>
+	virtual void EvaluateReferenceState(
+		const PhysicalConstants & phys,
+		double dZ,
+		double dLon,
+		double dLat,
+		double * dState
+	) const {
+
+		// Reference temperature
+		double dG = phys.GetG() * phys.GetG() / (m_dN * m_dN * phys.GetCp());
+
+		// Surface temperature
+		double dTsExpTerm =
+			- m_dU0 * m_dN * m_dN / 4.0 / (phys.GetG() * phys.GetG())
+				* (m_dU0 + 2.0 * phys.GetOmega() * phys.GetEarthRadius())
+				* (cos(2.0 * dLat) - 1.0);
+
+		double dTs = dG + (m_dTeq - dG) * exp(dTsExpTerm);
+
+		// 3D temperature
+		double dT = dG + (dTs - dG) * exp(m_dN * m_dN * dZ / phys.GetG());
+
+		// Surface pressure
+		double dPsTempScaling = pow(dTs / m_dTeq, 1.0 / phys.GetKappa());
+
+		double dPsExpTerm =
+			m_dU0 / (4.0 * dG * phys.GetR())
+				* (m_dU0 + 2.0 * phys.GetOmega() * phys.GetEarthRadius())
+				* (cos(2.0 * dLat) - 1.0);
+
+		double dPs = phys.GetP0() * exp(dPsExpTerm) * dPsTempScaling;
+
+		// 3D Pressure
+		double dPVertTerm =
+			dG / dTs * exp(- m_dN * m_dN * dZ / phys.GetG()) + 1.0 - dG / dTs;
+
+		double dPressure = dPs * pow(dPVertTerm, 1.0 / phys.GetKappa());
+
+		// Calculate exact density
+		double dRho = dPressure / (phys.GetR() * dT);
+
+		// Store the state
+		dState[0] = m_dU0 * cos(dLat);
+		dState[1] = 0.0;
+		dState[2] = phys.RhoThetaFromPressure(dPressure) / dRho;
+		dState[3] = 0.0;
+		dState[4] = dRho;
+	}
+
+	///	<summary>
+	///		Evaluate the state vector at the given point.
+	///	</summary>
+	virtual void EvaluatePointwiseState(
+		const PhysicalConstants & phys,
+		const Time & time,
+		double dZ,
+		double dLon,
+		double dLat,
+		double * dState,
+		double * dTracer
+	) const {
+
+		// Calculate the reference state
+		EvaluateReferenceState(phys, dZ, dLon, dLat, dState);
+
+		// Add in a potential temperature perturbation
+		dState[2] += cos(dLat) * cos(dLon) * sin(M_PI * dZ / m_dZtop);
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A kernel which is timed in isolation.  Each call to Run() performs
+///		one application of the kernel over all active patches on this
+///		processor.
+///	</summary>
+class KernelBenchmark {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	KernelBenchmark(
+		Model & model,
+		const std::string & strName
+	) :
+		m_model(model),
+		m_strName(strName)
+	{ }
+
+	///	<summary>
+	///		Destructor.
+	///	</summary>
+	virtual ~KernelBenchmark()
+	{ }
+
+public:
+	///	<summary>
+	///		Check if this kernel is available for the current model
+	///		configuration.
+	///	</summary>
+	virtual bool IsAvailable() const {
+		return true;
+	}
+
+	///	<summary>
+	///		Apply the kernel once.
+	///	</summary>
+	virtual void Run() = 0;
+
+	///	<summary>
+	///		Bytes of memory traffic per application on this processor, or
+	///		a negative value if no traffic model is available.
+	///	</summary>
+	virtual double GetBytes() const {
+		return (-1.0);
+	}
+
+	///	<summary>
+	///		Floating point operations per application on this processor,
+	///		or a negative value if no exact operation count is available.
+	///	</summary>
+	virtual double GetFLOPs() const {
+		return (-1.0);
+	}
+
+public:
+	///	<summary>
+	///		Reference to the model.
+	///	</summary>
+	Model & m_model;
+
+	///	<summary>
+	///		Name of this kernel.
+	///	</summary>
+	std::string m_strName;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Total number of state values (including halos) stored at the given
+///		location for one data instance on this processor.
+///	</summary>
+double GetLocalStateValues(
+	const Grid & grid,
+	DataLocation loc
+) {
+	double dValues = 0.0;
+	for (int n = 0; n < grid.GetActivePatchCount(); n++) {
+		dValues += static_cast<double>(
+			grid.GetActivePatch(n)->GetDataState(0, loc).GetTotalElements());
+	}
+	return dValues;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Explicit horizontal dynamics of the non-hydrostatic equations.
+///	</summary>
+class KernelBenchmarkHorizontalDynamics : public KernelBenchmark {
+
+public:
+	KernelBenchmarkHorizontalDynamics(Model & model) :
+		KernelBenchmark(model, "HorizontalDynamics"),
+		m_pHorizontalDynamics(
+			dynamic_cast<HorizontalDynamicsFEM *>(
+				model.GetHorizontalDynamics()))
+	{ }
+
+	virtual bool IsAvailable() const {
+		return (m_pHorizontalDynamics != NULL);
+	}
+
+	virtual void Run() {
+		m_pHorizontalDynamics->StepNonhydrostaticPrimitive(
+			0, 1, m_model.GetStartTime(),
+			m_model.GetDeltaT().GetSeconds());
+	}
+
+protected:
+	HorizontalDynamicsFEM * m_pHorizontalDynamics;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Scalar or vector hyperdiffusion.  A zero timestep is used so that
+///		repeated application leaves the data unchanged while performing
+///		the same amount of work.
+///	</summary>
+class KernelBenchmarkHyperdiffusion : public KernelBenchmark {
+
+public:
+	KernelBenchmarkHyperdiffusion(Model & model, bool fVector) :
+		KernelBenchmark(model,
+			fVector ? "VectorHyperdiffusion" : "ScalarHyperdiffusion"),
+		m_pHorizontalDynamics(
+			dynamic_cast<HorizontalDynamicsFEM *>(
+				model.GetHorizontalDynamics())),
+		m_fVector(fVector)
+	{ }
+
+	virtual bool IsAvailable() const {
+		return (m_pHorizontalDynamics != NULL);
+	}
+
+	virtual void Run() {
+		if (m_fVector) {
+			m_pHorizontalDynamics->ApplyVectorHyperdiffusion(
+				0, 2, 0.0, 1.0, 1.0, false);
+		} else {
+			m_pHorizontalDynamics->ApplyScalarHyperdiffusion(
+				0, 2, 0.0, 1.0, false);
+		}
+	}
+
+protected:
+	HorizontalDynamicsFEM * m_pHorizontalDynamics;
+
+	bool m_fVector;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Direct stiffness summation, including the halo exchange.
+///	</summary>
+class KernelBenchmarkDSS : public KernelBenchmark {
+
+public:
+	KernelBenchmarkDSS(Model & model) :
+		KernelBenchmark(model, "DSS"),
+		m_pGrid(dynamic_cast<GridGLL *>(model.GetGrid()))
+	{ }
+
+	virtual bool IsAvailable() const {
+		return (m_pGrid != NULL);
+	}
+
+	virtual void Run() {
+		m_pGrid->ApplyDSS(1);
+	}
+
+protected:
+	GridGLL * m_pGrid;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Implicit solve of the vertical column equations.
+///	</summary>
+class KernelBenchmarkVerticalImplicit : public KernelBenchmark {
+
+public:
+	KernelBenchmarkVerticalImplicit(Model & model) :
+		KernelBenchmark(model, "VerticalImplicit"),
+		m_pVerticalDynamics(
+			dynamic_cast<VerticalDynamicsFEM *>(
+				model.GetVerticalDynamics()))
+	{ }
+
+	virtual bool IsAvailable() const {
+		if (m_pVerticalDynamics == NULL) {
+			return false;
+		}
+		return (!m_pVerticalDynamics->IsFullyExplicit());
+	}
+
+	virtual void Run() {
+		m_pVerticalDynamics->StepImplicit(
+			0, 1, m_model.GetStartTime(),
+			m_model.GetDeltaT().GetSeconds());
+	}
+
+protected:
+	VerticalDynamicsFEM * m_pVerticalDynamics;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Interpolation of every interior column from model levels to
+///		interfaces with a LinearColumnOperator.
+///	</summary>
+class KernelBenchmarkColumnOperator : public KernelBenchmark {
+
+public:
+	KernelBenchmarkColumnOperator(Model & model) :
+		KernelBenchmark(model, "ColumnOperator"),
+		m_pGrid(dynamic_cast<GridGLL *>(model.GetGrid())),
+		m_dColumns(0.0)
+	{
+		if (m_pGrid == NULL) {
+			return;
+		}
+
+		for (int n = 0; n < m_pGrid->GetActivePatchCount(); n++) {
+			const PatchBox & box = m_pGrid->GetActivePatch(n)->GetPatchBox();
+
+			m_dColumns += static_cast<double>(
+				  box.GetAInteriorWidth()
+				* box.GetBInteriorWidth()
+				* m_model.GetEquationSet().GetComponents());
+		}
+	}
+
+	virtual bool IsAvailable() const {
+		return (m_pGrid != NULL);
+	}
+
+	virtual void Run() {
+		const LinearColumnInterpFEM & opInterp =
+			m_pGrid->GetOpInterpNodeToREdge();
+
+		for (int n = 0; n < m_pGrid->GetActivePatchCount(); n++) {
+			GridPatch * pPatch = m_pGrid->GetActivePatch(n);
+
+			const PatchBox & box = pPatch->GetPatchBox();
+
+			const GridData4D & dataNode =
+				pPatch->GetDataState(0, DataLocation_Node);
+			GridData4D & dataREdge =
+				pPatch->GetDataState(1, DataLocation_REdge);
+
+			const int nStride =
+				dataNode.GetAElements() * dataNode.GetBElements();
+
+			for (int c = 0; c < dataNode.GetComponents(); c++) {
+			for (int i = box.GetAInteriorBegin(); i < box.GetAInteriorEnd(); i++) {
+			for (int j = box.GetBInteriorBegin(); j < box.GetBInteriorEnd(); j++) {
+				opInterp.Apply(
+					&(dataNode[c][0][i][j]),
+					&(dataREdge[c][0][i][j]),
+					nStride,
+					nStride);
+			}
+			}
+			}
+		}
+	}
+
+	virtual double GetBytes() const {
+		const int nRElements = m_pGrid->GetRElements();
+
+		return (m_dColumns
+			* static_cast<double>(2 * nRElements + 1)
+			* sizeof(double));
+	}
+
+	virtual double GetFLOPs() const {
+		const LinearColumnInterpFEM & opInterp =
+			m_pGrid->GetOpInterpNodeToREdge();
+
+		const DataVector<int> & iBegin = opInterp.GetIxBegin();
+		const DataVector<int> & iEnd = opInterp.GetIxEnd();
+
+		int nTerms = 0;
+		for (int k = 0; k < iBegin.GetRows(); k++) {
+			nTerms += iEnd[k] - iBegin[k];
+		}
+
+		return (m_dColumns * static_cast<double>(2 * nTerms));
+	}
+
+protected:
+	GridGLL * m_pGrid;
+
+	double m_dColumns;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Linear combination of state data instances, as used between
+///		stages of the timestep schemes.
+///	</summary>
+class KernelBenchmarkLinearCombine : public KernelBenchmark {
+
+public:
+	KernelBenchmarkLinearCombine(Model & model) :
+		KernelBenchmark(model, "LinearCombineData")
+	{
+		m_dCoeff.Initialize(3);
+		m_dCoeff[0] = 0.5;
+		m_dCoeff[1] = 0.5;
+		m_dCoeff[2] = 0.0;
+
+		m_dValues =
+			  GetLocalStateValues(*(model.GetGrid()), DataLocation_Node)
+			+ GetLocalStateValues(*(model.GetGrid()), DataLocation_REdge);
+	}
+
+	virtual void Run() {
+		m_model.GetGrid()->LinearCombineData(m_dCoeff, 2, DataType_State);
+	}
+
+	virtual double GetBytes() const {
+		// One pass to zero the destination and two read-modify-write
+		// passes which each also read a source instance
+		return (7.0 * m_dValues * sizeof(double));
+	}
+
+	virtual double GetFLOPs() const {
+		return (4.0 * m_dValues);
+	}
+
+protected:
+	DataVector<double> m_dCoeff;
+
+	double m_dValues;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Packing or unpacking of state data into the exchange buffers of
+///		all exterior neighbors, without any communication.
+///	</summary>
+class KernelBenchmarkExchangeBuffers : public KernelBenchmark {
+
+public:
+	KernelBenchmarkExchangeBuffers(Model & model, bool fUnpack) :
+		KernelBenchmark(model, fUnpack ? "Unpack" : "Pack"),
+		m_fUnpack(fUnpack),
+		m_dValues(0.0)
+	{ }
+
+	virtual void Run() {
+		Grid * pGrid = m_model.GetGrid();
+
+		double dValues = 0.0;
+
+		for (int n = 0; n < pGrid->GetActivePatchCount(); n++) {
+			GridPatch * pPatch = pGrid->GetActivePatch(n);
+
+			GridData4D & dataNode =
+				pPatch->GetDataState(1, DataLocation_Node);
+			GridData4D & dataREdge =
+				pPatch->GetDataState(1, DataLocation_REdge);
+
+			const Connectivity::ExteriorNeighborVector & vecNeighbors =
+				pPatch->GetConnectivity().GetExteriorNeighbors();
+
+			for (int m = 0; m < vecNeighbors.size(); m++) {
+				ExteriorNeighbor * pNeighbor = vecNeighbors[m];
+
+				// Reset buffer indices without posting a receive
+				pNeighbor->Neighbor::PrepareExchange(
+					ExchangePrecision_Double);
+
+				if (m_fUnpack) {
+					pNeighbor->Unpack(dataNode);
+					pNeighbor->Unpack(dataREdge);
+					dValues += pNeighbor->m_ixRecvBuffer;
+				} else {
+					pNeighbor->Pack(dataNode);
+					pNeighbor->Pack(dataREdge);
+					dValues += pNeighbor->m_ixSendBuffer;
+				}
+			}
+		}
+
+		m_dValues = dValues;
+	}
+
+	virtual double GetBytes() const {
+		return (2.0 * m_dValues * sizeof(double));
+	}
+
+protected:
+	bool m_fUnpack;
+
+	double m_dValues;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Global diagnostics and state checksum, including the reductions
+///		over all processors, with or without reproducible sums.
+///	</summary>
+class KernelBenchmarkReductions : public KernelBenchmark {
+
+public:
+	KernelBenchmarkReductions(Model & model, bool fReproducible) :
+		KernelBenchmark(model,
+			fReproducible ? "ReductionsExact" : "Reductions"),
+		m_fReproducible(fReproducible)
+	{ }
+
+	virtual void Run() {
+		Grid * pGrid = m_model.GetGrid();
+
+		bool fReproducibleReductions = pGrid->HasReproducibleReductions();
+		pGrid->SetReproducibleReductions(m_fReproducible);
+
+		DataVector<double> dDiagnostics;
+		pGrid->BeginComputeDiagnostics(0);
+		pGrid->EndComputeDiagnostics(dDiagnostics);
+
+		DataVector<double> dChecksums;
+		pGrid->Checksum(DataType_State, dChecksums, 0, ChecksumType_Sum);
+
+		pGrid->SetReproducibleReductions(fReproducibleReductions);
+	}
+
+protected:
+	bool m_fReproducible;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Timing of one kernel aggregated over all processors.
+///	</summary>
+struct KernelBenchmarkResult {
+	std::string strName;
+	double dTime;
+	double dBytes;
+	double dFLOPs;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Time a kernel.  Scratch data instances are reset from the state
+///		before a warm-up application, after which the kernel is applied
+///		nIterations times.  The time per application is the maximum over
+///		all processors.
+///	</summary>
+KernelBenchmarkResult RunKernelBenchmark(
+	KernelBenchmark & bench,
+	int nIterations
+) {
+	Grid * pGrid = bench.m_model.GetGrid();
+
+	pGrid->CopyData(0, 1, DataType_State);
+	pGrid->CopyData(0, 2, DataType_State);
+
+	bench.Run();
+
+	MPI_Barrier(MPI_COMM_WORLD);
+
+	double dStartTime = Profiler::GetTime();
+	for (int i = 0; i < nIterations; i++) {
+		bench.Run();
+	}
+	double dLocal[3];
+	dLocal[0] = (Profiler::GetTime() - dStartTime)
+		/ static_cast<double>(nIterations);
+	dLocal[1] = bench.GetBytes();
+	dLocal[2] = bench.GetFLOPs();
+
+	KernelBenchmarkResult result;
+	result.strName = bench.m_strName;
+
+	MPI_Allreduce(
+		&(dLocal[0]), &(result.dTime), 1,
+		MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+	MPI_Allreduce(
+		&(dLocal[1]), &(result.dBytes), 1,
+		MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+
+	MPI_Allreduce(
+		&(dLocal[2]), &(result.dFLOPs), 1,
+		MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+
+	// Traffic and operation counts are either known on all processors
+	// or on none
+	if (dLocal[1] < 0.0) {
+		result.dBytes = -1.0;
+	}
+	if (dLocal[2] < 0.0) {
+		result.dFLOPs = -1.0;
+	}
+
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+
+	// Initialize Tempest
+	TempestInitialize(&argc, &argv);
+
+try {
+	// Model cap.
+	double dZtop;
+
+	// Number of timed applications of each kernel.
+	int nIterations;
+
+	// Output file for benchmark results.
+	std::string strBenchFile;
+
+	// Parse the command line
+	BeginTempestCommandLine("KernelBenchmark");
+		SetDefaultResolution(20);
+		SetDefaultLevels(10);
+		SetDefaultOutputDeltaT("200s");
+		SetDefaultDeltaT("200s");
+		SetDefaultEndTime("0s");
+		SetDefaultHorizontalOrder(4);
+		SetDefaultVerticalOrder(1);
+
+		CommandLineDouble(dZtop, "ztop", 10000.0);
+		CommandLineInt(nIterations, "iterations", 20);
+		CommandLineString(strBenchFile, "bench_out", "");
+
+		ParseCommandLine(argc, argv);
+	EndTempestCommandLine(argv)
+
+	if (nIterations < 1) {
+		_EXCEPTIONT("--iterations must be positive");
+	}
+
+	// Benchmarks never write model output
+	_tempestvars.fNoOutput = true;
+
+	// Setup the Model
+	AnnounceBanner("MODEL SETUP");
+
+	Model model(EquationSet::PrimitiveNonhydrostaticEquations);
+
+	TempestSetupCubedSphereModel(model);
+
+	// Set the test case for the model
+	AnnounceStartBlock("Initializing test case");
+	model.SetTestCase(new KernelBenchmarkTest(dZtop));
+	AnnounceEndBlock("Done");
+
+	// Initialize all operators and auxiliary data; the model is only
+	// integrated forward if an end time is specified
+	AnnounceBanner("INITIALIZATION");
+	model.Go();
+
+	Profiler::Reset();
+
+	// Degrees of freedom in the interior of all patches
+	Grid * pGrid = model.GetGrid();
+
+	double dLocalDOFs = 0.0;
+	for (int n = 0; n < pGrid->GetActivePatchCount(); n++) {
+		const PatchBox & box = pGrid->GetActivePatch(n)->GetPatchBox();
+
+		dLocalDOFs += static_cast<double>(
+			  box.GetAInteriorWidth()
+			* box.GetBInteriorWidth()
+			* pGrid->GetDegreesOfFreedomPerColumn());
+	}
+
+	double dDOFs;
+	MPI_Allreduce(
+		&dLocalDOFs, &dDOFs, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+
+	int nCommSize;
+	MPI_Comm_size(MPI_COMM_WORLD, &nCommSize);
+
+	// Kernels
+	std::vector<KernelBenchmark *> vecBenchmarks;
+	vecBenchmarks.push_back(new KernelBenchmarkHorizontalDynamics(model));
+	vecBenchmarks.push_back(new KernelBenchmarkHyperdiffusion(model, false));
+	vecBenchmarks.push_back(new KernelBenchmarkHyperdiffusion(model, true));
+	vecBenchmarks.push_back(new KernelBenchmarkDSS(model));
+	vecBenchmarks.push_back(new KernelBenchmarkVerticalImplicit(model));
+	vecBenchmarks.push_back(new KernelBenchmarkColumnOperator(model));
+	vecBenchmarks.push_back(new KernelBenchmarkLinearCombine(model));
+	vecBenchmarks.push_back(new KernelBenchmarkExchangeBuffers(model, false));
+	vecBenchmarks.push_back(new KernelBenchmarkExchangeBuffers(model, true));
+	vecBenchmarks.push_back(new KernelBenchmarkReductions(model, false));
+	vecBenchmarks.push_back(new KernelBenchmarkReductions(model, true));
+
+	// Run benchmarks
+	AnnounceBanner("BENCHMARKS");
+	Announce("Processors: %i  Patches: %i  Degrees of freedom: %.0f",
+		nCommSize, pGrid->GetPatchCount(), dDOFs);
+	Announce("Iterations per kernel: %i", nIterations);
+
+	std::vector<KernelBenchmarkResult> vecResults;
+	for (int b = 0; b < vecBenchmarks.size(); b++) {
+		if (!vecBenchmarks[b]->IsAvailable()) {
+			Announce("%s not available for this configuration",
+				vecBenchmarks[b]->m_strName.c_str());
+			continue;
+		}
+		try {
+			vecResults.push_back(
+				RunKernelBenchmark(*(vecBenchmarks[b]), nIterations));
+
+		} catch(Exception & e) {
+			Announce("%s failed: %s",
+				vecBenchmarks[b]->m_strName.c_str(), e.ToString().c_str());
+		}
+	}
+
+	for (int b = 0; b < vecBenchmarks.size(); b++) {
+		delete vecBenchmarks[b];
+	}
+
+	// Output results
+	int nRank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &nRank);
+
+	AnnounceBanner("RESULTS");
+	Announce("%-22s %12s %10s %10s %10s",
+		"Kernel", "Time (s)", "ns/DOF", "GB/s", "GFLOP/s");
+
+	FILE * fp = NULL;
+	if ((nRank == 0) && (strBenchFile != "")) {
+		fp = fopen(strBenchFile.c_str(), "w");
+		if (fp == NULL) {
+			_EXCEPTION1("Unable to open file \"%s\"", strBenchFile.c_str());
+		}
+		fprintf(fp, "kernel,processors,dofs,iterations,"
+			"time_s,ns_per_dof,gb_per_s,gflop_per_s\n");
+	}
+
+	for (int b = 0; b < vecResults.size(); b++) {
+		const KernelBenchmarkResult & result = vecResults[b];
+
+		double dNsPerDOF = result.dTime / dDOFs * 1.0e9;
+
+		double dGBs = -1.0;
+		if ((result.dBytes >= 0.0) && (result.dTime > 0.0)) {
+			dGBs = result.dBytes / result.dTime * 1.0e-9;
+		}
+
+		double dGFLOPs = -1.0;
+		if ((result.dFLOPs >= 0.0) && (result.dTime > 0.0)) {
+			dGFLOPs = result.dFLOPs / result.dTime * 1.0e-9;
+		}
+
+		char szGBs[32] = "-";
+		char szGFLOPs[32] = "-";
+		if (dGBs >= 0.0) {
+			snprintf(szGBs, 32, "%10.3f", dGBs);
+		}
+		if (dGFLOPs >= 0.0) {
+			snprintf(szGFLOPs, 32, "%10.3f", dGFLOPs);
+		}
+
+		Announce("%-22s %12.4e %10.4f %10s %10s",
+			result.strName.c_str(), result.dTime, dNsPerDOF,
+			szGBs, szGFLOPs);
+
+		if (fp != NULL) {
+			fprintf(fp, "%s,%i,%.0f,%i,%.6e,%.6e,%.6e,%.6e\n",
+				result.strName.c_str(), nCommSize, dDOFs, nIterations,
+				result.dTime, dNsPerDOF, dGBs, dGFLOPs);
+		}
+	}
+
+	if (fp != NULL) {
+		fclose(fp);
+	}
+
+	AnnounceBanner();
+
+} catch(Exception & e) {
+	std::cout << e.ToString() << std::endl;
+}
+
+	// Deinitialize Tempest
+	TempestDeinitialize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,144 @@
+#!/bin/sh
+###############################################################################
+##
+##  \file    ScalingBenchmark.sh
+##  \author  Paul Ullrich
+##  \version October 18, 2026
+##
+##  Run test cases at several resolutions and processor counts and build a
+##  scaling report from their profiles with ScalingReport.
+##
+##  In strong scaling mode every resolution is run on every processor
+##  count.  In weak scaling mode the i-th resolution is paired with the
+##  i-th processor count.
+##
+##  Example:
+##    ./ScalingBenchmark.sh --tests BaroclinicWaveJWTest,HeldSuarezTest \
+##      --resolutions 6,12 --procs 1,2,4,8 --baseline old/scaling_report.csv
+##
+###############################################################################
+
+TESTS="BaroclinicWaveJWTest"
+TEST_DIR="../test/nonhydro_sphere"
+RESOLUTIONS="6"
+PROCS="1,2,4"
+MODE="strong"
+LAUNCHER="mpirun -np"
+ARGS="--levels 10 --dt 5s --endtime 100s --explicitvertical"
+OUTPUT_DIR="scaling"
+BASELINE=""
+TOLERANCE="0.10"
+
+REPORT="`dirname $0`/ScalingReport"
+
+usage() {
+	echo "Usage: $0 [options]"
+	echo "  --tests <list>        test case executables [$TESTS]"
+	echo "  --test_dir <dir>      directory of the executables [$TEST_DIR]"
+	echo "  --resolutions <list>  horizontal resolutions [$RESOLUTIONS]"
+	echo "  --procs <list>        processor counts [$PROCS]"
+	echo "  --mode <mode>         (strong | weak) [$MODE]"
+	echo "  --launcher <cmd>      parallel launcher, followed by the count [$LAUNCHER]"
+	echo "  --args <args>         arguments passed to each test [$ARGS]"
+	echo "  --output_dir <dir>    directory for logs, profiles and report [$OUTPUT_DIR]"
+	echo "  --baseline <file>     previous report to check for regressions"
+	echo "  --tolerance <frac>    slowdown reported as a regression [$TOLERANCE]"
+	exit 1
+}
+
+while [ $# -gt 0 ]; do
+	if [ $# -lt 2 ]; then
+		usage
+	fi
+	case "$1" in
+		--tests) TESTS="$2" ;;
+		--test_dir) TEST_DIR="$2" ;;
+		--resolutions) RESOLUTIONS="$2" ;;
+		--procs) PROCS="$2" ;;
+		--mode) MODE="$2" ;;
+		--launcher) LAUNCHER="$2" ;;
+		--args) ARGS="$2" ;;
+		--output_dir) OUTPUT_DIR="$2" ;;
+		--baseline) BASELINE="$2" ;;
+		--tolerance) TOLERANCE="$2" ;;
+		*) usage ;;
+	esac
+	shift 2
+done
+
+if [ ! -x "$REPORT" ]; then
+	echo "ScalingReport not found; run make in `dirname $0`"
+	exit 1
+fi
+
+RESOLUTIONS=`echo $RESOLUTIONS | tr ',' ' '`
+PROCS=`echo $PROCS | tr ',' ' '`
+
+# Build the list of (resolution, processors) configurations
+CONFIGS=""
+if [ "$MODE" = "strong" ]; then
+	for R in $RESOLUTIONS; do
+		for P in $PROCS; do
+			CONFIGS="$CONFIGS $R:$P"
+		done
+	done
+
+elif [ "$MODE" = "weak" ]; then
+	set -- $PROCS
+	for R in $RESOLUTIONS; do
+		if [ $# -eq 0 ]; then
+			echo "--resolutions and --procs must have the same length"
+			exit 1
+		fi
+		CONFIGS="$CONFIGS $R:$1"
+		shift
+	done
+	if [ $# -ne 0 ]; then
+		echo "--resolutions and --procs must have the same length"
+		exit 1
+	fi
+
+else
+	echo "Invalid value for --mode"
+	exit 1
+fi
+
+mkdir -p "$OUTPUT_DIR"
+
+RUNS="$OUTPUT_DIR/runs.txt"
+: > "$RUNS"
+
+# Execute all runs; each line of the run list records the configuration,
+# the base name of its profile and the exit status
+for TEST in `echo $TESTS | tr ',' ' '`; do
+	for CONFIG in $CONFIGS; do
+		R=${CONFIG%:*}
+		P=${CONFIG#*:}
+		BASE="$OUTPUT_DIR/${TEST}_r${R}_p${P}"
+
+		echo "Running $TEST (resolution $R, $P processors)"
+
+		rm -f "$BASE.csv" "$BASE.json"
+
+		$LAUNCHER $P "$TEST_DIR/$TEST" \
+			--resolution $R --output_none --profile_out "$BASE" $ARGS \
+			> "$BASE.log" 2>&1
+		STATUS=$?
+
+		if [ $STATUS -ne 0 ]; then
+			echo "  FAILED: see $BASE.log"
+		fi
+
+		echo "$TEST $R $P $BASE $STATUS" >> "$RUNS"
+	done
+done
+
+# Build the report
+if [ "$BASELINE" = "" ]; then
+	"$REPORT" --runs "$RUNS" --mode $MODE \
+		--out "$OUTPUT_DIR/scaling_report.csv"
+else
+	"$REPORT" --runs "$RUNS" --mode $MODE \
+		--out "$OUTPUT_DIR/scaling_report.csv" \
+		--baseline "$BASELINE" --tolerance $TOLERANCE
+fi
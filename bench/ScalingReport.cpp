@@ -0,0 +1,566 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    ScalingReport.cpp
+///	\author  Paul Ullrich
+///	\version October 18, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "CommandLine.h"
+#include "Announce.h"
+#include "Exception.h"
+
+#include <mpi.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Split a comma separated list.
+///	</summary>
+void ParseList(
+	const std::string & strList,
+	std::vector<std::string> & vecItems
+) {
+	vecItems.clear();
+
+	int iBegin = 0;
+	for (int i = 0; i <= strList.length(); i++) {
+		if ((i == strList.length()) || (strList[i] == ',')) {
+			if (i > iBegin) {
+				vecItems.push_back(strList.substr(iBegin, i - iBegin));
+			}
+			iBegin = i + 1;
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A single run of a test case and the statistics extracted from its
+///		profile.
+///	</summary>
+struct ScalingRun {
+
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	ScalingRun() :
+		nResolution(0),
+		nProcessors(0),
+		fSuccess(false),
+		dStepTimeMean(0.0),
+		dStepTimeMax(0.0),
+		dExchangeTime(0.0),
+		dPatchesMax(0.0),
+		dColumnsMax(0.0),
+		dDegreesOfFreedom(0.0),
+		dMemoryMean(0.0),
+		dMemoryMax(0.0),
+		dSpeedup(0.0),
+		dEfficiency(0.0)
+	{ }
+
+	///	<summary>
+	///		Name of the test case executable.
+	///	</summary>
+	std::string strTest;
+
+	///	<summary>
+	///		Horizontal resolution.
+	///	</summary>
+	int nResolution;
+
+	///	<summary>
+	///		Number of processors.
+	///	</summary>
+	int nProcessors;
+
+	///	<summary>
+	///		Base name of the profile and log files of this run.
+	///	</summary>
+	std::string strBaseName;
+
+	///	<summary>
+	///		Flag indicating the run completed and its profile was read.
+	///	</summary>
+	bool fSuccess;
+
+	///	<summary>
+	///		Mean and maximum over processors of the time spent stepping.
+	///	</summary>
+	double dStepTimeMean;
+	double dStepTimeMax;
+
+	///	<summary>
+	///		Mean over processors of the time spent in halo exchanges while
+	///		stepping.
+	///	</summary>
+	double dExchangeTime;
+
+	///	<summary>
+	///		Maximum number of patches on any processor.
+	///	</summary>
+	double dPatchesMax;
+
+	///	<summary>
+	///		Maximum number of columns on any processor.
+	///	</summary>
+	double dColumnsMax;
+
+	///	<summary>
+	///		Total number of degrees of freedom.
+	///	</summary>
+	double dDegreesOfFreedom;
+
+	///	<summary>
+	///		Mean and maximum peak memory per processor (in MB).
+	///	</summary>
+	double dMemoryMean;
+	double dMemoryMax;
+
+	///	<summary>
+	///		Speedup and parallel efficiency relative to the reference run.
+	///	</summary>
+	double dSpeedup;
+	double dEfficiency;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Read the region timings written by Profiler::Report.
+///	</summary>
+bool ReadProfileCSV(
+	const std::string & strFile,
+	ScalingRun & run
+) {
+	FILE * fp = fopen(strFile.c_str(), "r");
+	if (fp == NULL) {
+		return false;
+	}
+
+	bool fFoundStep = false;
+
+	char szLine[1024];
+	while (fgets(szLine, sizeof(szLine), fp) != NULL) {
+		char * szComma = strchr(szLine, ',');
+		if (szComma == NULL) {
+			continue;
+		}
+
+		std::string strRegion(szLine, szComma - szLine);
+
+		int nDepth;
+		double dCalls;
+		double dMean;
+		double dMin;
+		double dMax;
+
+		if (sscanf(szComma + 1, "%i,%lf,%lf,%lf,%lf",
+			&nDepth, &dCalls, &dMean, &dMin, &dMax) != 5
+		) {
+			continue;
+		}
+
+		// Total time spent stepping
+		if (strRegion == "Step") {
+			run.dStepTimeMean = dMean;
+			run.dStepTimeMax = dMax;
+			fFoundStep = true;
+			continue;
+		}
+
+		// Outermost exchange regions within a step
+		if (strRegion.compare(0, 5, "Step/") != 0) {
+			continue;
+		}
+
+		size_t iExchange = strRegion.find("/Exchange");
+		if ((iExchange != std::string::npos) &&
+			(iExchange + 9 == strRegion.length())
+		) {
+			run.dExchangeTime += dMean;
+		}
+	}
+
+	fclose(fp);
+
+	return fFoundStep;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Read the value of a metric written by Profiler::Report.
+///	</summary>
+bool ReadProfileMetric(
+	const std::string & strJSON,
+	const std::string & strName,
+	const char * szField,
+	double & dValue
+) {
+	std::string strKey = "{\"name\": \"" + strName + "\"";
+
+	size_t iMetric = strJSON.find(strKey);
+	if (iMetric == std::string::npos) {
+		return false;
+	}
+
+	size_t iEnd = strJSON.find('}', iMetric);
+
+	std::string strField = "\"" + std::string(szField) + "\": ";
+
+	size_t iField = strJSON.find(strField, iMetric);
+	if ((iField == std::string::npos) || (iField > iEnd)) {
+		return false;
+	}
+
+	dValue = atof(strJSON.c_str() + iField + strField.length());
+
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Read the metrics written by Profiler::Report.
+///	</summary>
+bool ReadProfileJSON(
+	const std::string & strFile,
+	ScalingRun & run
+) {
+	FILE * fp = fopen(strFile.c_str(), "r");
+	if (fp == NULL) {
+		return false;
+	}
+
+	std::string strJSON;
+
+	char szBuffer[4096];
+	size_t nRead;
+	while ((nRead = fread(szBuffer, 1, sizeof(szBuffer), fp)) > 0) {
+		strJSON.append(szBuffer, nRead);
+	}
+
+	fclose(fp);
+
+	double dDegreesOfFreedomMean;
+
+	bool fSuccess =
+		   ReadProfileMetric(strJSON, "patches", "max", run.dPatchesMax)
+		&& ReadProfileMetric(strJSON, "columns", "max", run.dColumnsMax)
+		&& ReadProfileMetric(
+			strJSON, "degrees_of_freedom", "mean", dDegreesOfFreedomMean)
+		&& ReadProfileMetric(
+			strJSON, "peak_memory_mb", "mean", run.dMemoryMean)
+		&& ReadProfileMetric(
+			strJSON, "peak_memory_mb", "max", run.dMemoryMax);
+
+	run.dDegreesOfFreedom =
+		dDegreesOfFreedomMean * static_cast<double>(run.nProcessors);
+
+	return fSuccess;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Read the step time of each run in a previous report.
+///	</summary>
+void ReadBaselineReport(
+	const std::string & strFile,
+	std::vector<ScalingRun> & vecBaseline
+) {
+	FILE * fp = fopen(strFile.c_str(), "r");
+	if (fp == NULL) {
+		_EXCEPTION1("Unable to open baseline report \"%s\"", strFile.c_str());
+	}
+
+	char szLine[1024];
+	while (fgets(szLine, sizeof(szLine), fp) != NULL) {
+		char * szComma = strchr(szLine, ',');
+		if (szComma == NULL) {
+			continue;
+		}
+
+		ScalingRun run;
+		run.strTest = std::string(szLine, szComma - szLine);
+
+		if (sscanf(szComma + 1, "%i,%i,%lf",
+			&(run.nResolution), &(run.nProcessors), &(run.dStepTimeMax)) != 3
+		) {
+			continue;
+		}
+
+		run.fSuccess = true;
+		vecBaseline.push_back(run);
+	}
+
+	fclose(fp);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char ** argv) {
+
+	// Initialize MPI
+	MPI_Init(&argc, &argv);
+
+	// Number of failed runs and regressions
+	int nFailures = 0;
+	int nRegressions = 0;
+
+try {
+	// List of runs
+	std::string strRunList;
+
+	// Scaling mode
+	std::string strMode;
+
+	// Output report
+	std::string strReportFile;
+
+	// Report from a previous run
+	std::string strBaselineFile;
+
+	// Relative slowdown that is reported as a regression
+	double dTolerance;
+
+	// Parse the command line
+	BeginCommandLine()
+		CommandLineString(strRunList, "runs", "");
+		CommandLineStringD(strMode, "mode", "strong", "(strong | weak)");
+		CommandLineString(strReportFile, "out", "scaling_report.csv");
+		CommandLineString(strBaselineFile, "baseline", "");
+		CommandLineDouble(dTolerance, "tolerance", 0.10);
+
+		ParseCommandLine(argc, argv);
+	EndCommandLine(argv)
+
+	if (strRunList == "") {
+		_EXCEPTIONT("No run list specified");
+	}
+	if ((strMode != "strong") && (strMode != "weak")) {
+		_EXCEPTIONT("Invalid value for --mode");
+	}
+
+	// Load all runs
+	std::vector<ScalingRun> vecRuns;
+
+	FILE * fpRuns = fopen(strRunList.c_str(), "r");
+	if (fpRuns == NULL) {
+		_EXCEPTION1("Unable to open run list \"%s\"", strRunList.c_str());
+	}
+
+	char szLine[1024];
+	while (fgets(szLine, sizeof(szLine), fpRuns) != NULL) {
+		char szTest[256];
+		char szBaseName[512];
+		int iStatus;
+
+		ScalingRun run;
+
+		if (sscanf(szLine, "%255s %i %i %511s %i",
+			szTest, &(run.nResolution), &(run.nProcessors),
+			szBaseName, &iStatus) != 5
+		) {
+			continue;
+		}
+
+		run.strTest = szTest;
+		run.strBaseName = szBaseName;
+
+		run.fSuccess =
+			   (iStatus == 0)
+			&& ReadProfileCSV(run.strBaseName + ".csv", run)
+			&& ReadProfileJSON(run.strBaseName + ".json", run);
+
+		vecRuns.push_back(run);
+	}
+
+	fclose(fpRuns);
+
+	// Speedup and efficiency relative to the run with the fewest
+	// processors of the same test (and resolution, for strong scaling)
+	for (int i = 0; i < vecRuns.size(); i++) {
+		if (!vecRuns[i].fSuccess) {
+			continue;
+		}
+
+		int iReference = i;
+		for (int j = 0; j < vecRuns.size(); j++) {
+			if ((!vecRuns[j].fSuccess) ||
+				(vecRuns[j].strTest != vecRuns[i].strTest)
+			) {
+				continue;
+			}
+			if ((strMode == "strong") &&
+				(vecRuns[j].nResolution != vecRuns[i].nResolution)
+			) {
+				continue;
+			}
+			if (vecRuns[j].nProcessors < vecRuns[iReference].nProcessors) {
+				iReference = j;
+			}
+		}
+
+		const ScalingRun & ref = vecRuns[iReference];
+		ScalingRun & run = vecRuns[i];
+
+		if (run.dStepTimeMax <= 0.0) {
+			continue;
+		}
+
+		if (strMode == "strong") {
+			run.dSpeedup = ref.dStepTimeMax / run.dStepTimeMax;
+			run.dEfficiency =
+				run.dSpeedup
+				* static_cast<double>(ref.nProcessors)
+				/ static_cast<double>(run.nProcessors);
+
+		// Weak scaling compares the time per column on the most heavily
+		// loaded processor, since the cubed-sphere decomposition does not
+		// keep the work per processor exactly constant
+		} else {
+			run.dEfficiency =
+				(ref.dStepTimeMax / ref.dColumnsMax)
+				/ (run.dStepTimeMax / run.dColumnsMax);
+			run.dSpeedup =
+				run.dEfficiency
+				* static_cast<double>(run.nProcessors)
+				/ static_cast<double>(ref.nProcessors);
+		}
+	}
+
+	// Compare against a previous report
+	std::vector<ScalingRun> vecBaseline;
+	if (strBaselineFile != "") {
+		ReadBaselineReport(strBaselineFile, vecBaseline);
+	}
+
+	// Output the report
+	FILE * fpReport = fopen(strReportFile.c_str(), "w");
+	if (fpReport == NULL) {
+		_EXCEPTION1("Unable to open report \"%s\"", strReportFile.c_str());
+	}
+
+	fprintf(fpReport,
+		"test,resolution,processors,step_time_s,step_imbalance,"
+		"speedup,efficiency,comm_fraction,patches_per_proc,"
+		"columns_per_proc,dofs,memory_per_proc_mb,memory_per_proc_max_mb\n");
+
+	AnnounceStartBlock("Scaling report");
+	Announce("%-28s %5s %6s %12s %8s %8s %8s %8s %10s %10s",
+		"Test", "Res", "Procs", "Step (s)", "Imbal", "Speedup",
+		"Eff", "Comm", "Cols/proc", "MB/proc");
+
+	for (int i = 0; i < vecRuns.size(); i++) {
+		const ScalingRun & run = vecRuns[i];
+
+		if (!run.fSuccess) {
+			Announce("%-28s %5i %6i %12s",
+				run.strTest.c_str(), run.nResolution, run.nProcessors,
+				"FAILED");
+			nFailures++;
+			continue;
+		}
+
+		double dImbalance = 0.0;
+		double dCommFraction = 0.0;
+		if (run.dStepTimeMean > 0.0) {
+			dImbalance = run.dStepTimeMax / run.dStepTimeMean - 1.0;
+			dCommFraction = run.dExchangeTime / run.dStepTimeMean;
+		}
+
+		Announce("%-28s %5i %6i %12.4e %7.1f%% %8.3f %7.1f%% %7.1f%% %10.0f %10.1f",
+			run.strTest.c_str(),
+			run.nResolution,
+			run.nProcessors,
+			run.dStepTimeMax,
+			100.0 * dImbalance,
+			run.dSpeedup,
+			100.0 * run.dEfficiency,
+			100.0 * dCommFraction,
+			run.dColumnsMax,
+			run.dMemoryMax);
+
+		fprintf(fpReport, "%s,%i,%i,%.6e,%.6e,%.6e,%.6e,%.6e,%.0f,%.0f,%.0f,"
+			"%.6e,%.6e\n",
+			run.strTest.c_str(),
+			run.nResolution,
+			run.nProcessors,
+			run.dStepTimeMax,
+			dImbalance,
+			run.dSpeedup,
+			run.dEfficiency,
+			dCommFraction,
+			run.dPatchesMax,
+			run.dColumnsMax,
+			run.dDegreesOfFreedom,
+			run.dMemoryMean,
+			run.dMemoryMax);
+
+		// Check for regressions
+		for (int j = 0; j < vecBaseline.size(); j++) {
+			const ScalingRun & base = vecBaseline[j];
+			if ((base.strTest != run.strTest) ||
+				(base.nResolution != run.nResolution) ||
+				(base.nProcessors != run.nProcessors) ||
+				(base.dStepTimeMax <= 0.0)
+			) {
+				continue;
+			}
+
+			double dSlowdown = run.dStepTimeMax / base.dStepTimeMax - 1.0;
+			if (dSlowdown > dTolerance) {
+				Announce("  REGRESSION: %.1f%% slower than baseline (%.4e s)",
+					100.0 * dSlowdown, base.dStepTimeMax);
+				nRegressions++;
+			}
+		}
+	}
+
+	fclose(fpReport);
+
+	AnnounceEndBlock("Done");
+
+	Announce("Report written to %s", strReportFile.c_str());
+
+	if (nFailures != 0) {
+		Announce("%i run(s) failed", nFailures);
+	}
+	if (nRegressions != 0) {
+		Announce("%i performance regression(s) detected", nRegressions);
+	}
+
+} catch(Exception & e) {
+	std::cout << e.ToString() << std::endl;
+	nFailures++;
+}
+
+	// Deinitialize MPI
+	MPI_Finalize();
+
+	if ((nFailures != 0) || (nRegressions != 0)) {
+		return (1);
+	}
+	return (0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
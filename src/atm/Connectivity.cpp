@@ -20,6 +20,14 @@
 #include "GridPatch.h"
 #include "Model.h"
 #include "EquationSet.h"
+#include "ExchangeStatistics.h"
+
+#include "MemoryTracker.h"
+#include "Profiler.h"
+
+#include <cstring>
+#include <cfloat>
+#include <cmath>
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -34,6 +42,7 @@ void Neighbor::InitializeBuffers(
 	int nHaloElements,
 	int nComponents
 ) {
+	MemoryTrackerRegion memory(MemoryTag_Exchange);
 
 	// Store buffer size
 	m_nMaxRElements = nRElements + 1;
@@ -49,6 +58,163 @@ void Neighbor::InitializeBuffers(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void Neighbor::InitializeReducedPrecisionBuffers() {
+	MemoryTrackerRegion memory(MemoryTag_Exchange);
+
+	// Reduced precision data never requires more space than double
+	// precision data plus an offset and scale for each block
+	int nBytes =
+		  m_nBoundarySize
+		* m_nMaxRElements
+		* m_nHaloElements
+		* m_nComponents
+		* sizeof(double)
+		+ 2 * m_nMaxRElements * m_nComponents * sizeof(double);
+
+	m_vecSendBytes.Initialize(nBytes);
+	m_vecRecvBytes.Initialize(nBytes);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Neighbor::EncodeSendBuffer(
+	int ixBegin,
+	int nLevels
+) {
+	int nValues = m_ixSendBuffer - ixBegin;
+
+	if ((nLevels <= 0) || (nValues % nLevels != 0)) {
+		_EXCEPTIONT("Invalid number of levels in reduced precision block");
+	}
+
+	const double * dValues = &(m_vecSendBuffer[ixBegin]);
+
+	unsigned char * pBytes = &(m_vecSendBytes[0]);
+
+	// Single precision
+	if (m_ePrecision == ExchangePrecision_Single) {
+		if (m_ixSendBytes + nValues * sizeof(float)
+			> m_vecSendBytes.GetRows()
+		) {
+			_EXCEPTIONT("Insufficient space in SendBytes for operation.");
+		}
+
+		for (int i = 0; i < nValues; i++) {
+			float flValue = static_cast<float>(dValues[i]);
+			memcpy(pBytes + m_ixSendBytes, &flValue, sizeof(float));
+			m_ixSendBytes += sizeof(float);
+		}
+
+	// Scaled 16-bit representation with one offset and scale per level
+	} else if (m_ePrecision == ExchangePrecision_Scaled16) {
+		int nBlockSize = nValues / nLevels;
+
+		if (m_ixSendBytes
+			+ nValues * sizeof(unsigned short)
+			+ nLevels * 2 * sizeof(double)
+			> m_vecSendBytes.GetRows()
+		) {
+			_EXCEPTIONT("Insufficient space in SendBytes for operation.");
+		}
+
+		for (int k = 0; k < nLevels; k++) {
+			const double * dBlock = dValues + k * nBlockSize;
+
+			double dMin = dBlock[0];
+			double dMax = dBlock[0];
+			for (int i = 1; i < nBlockSize; i++) {
+				if (dBlock[i] < dMin) {
+					dMin = dBlock[i];
+				}
+				if (dBlock[i] > dMax) {
+					dMax = dBlock[i];
+				}
+			}
+
+			double dScale = (dMax - dMin) / 65535.0;
+
+			memcpy(pBytes + m_ixSendBytes, &dMin, sizeof(double));
+			m_ixSendBytes += sizeof(double);
+			memcpy(pBytes + m_ixSendBytes, &dScale, sizeof(double));
+			m_ixSendBytes += sizeof(double);
+
+			double dInvScale = 0.0;
+			if (dScale > 0.0) {
+				dInvScale = 1.0 / dScale;
+			}
+
+			for (int i = 0; i < nBlockSize; i++) {
+				unsigned short sValue = static_cast<unsigned short>(
+					floor((dBlock[i] - dMin) * dInvScale + 0.5));
+				memcpy(pBytes + m_ixSendBytes, &sValue, sizeof(unsigned short));
+				m_ixSendBytes += sizeof(unsigned short);
+			}
+		}
+
+	} else {
+		_EXCEPTIONT("Invalid ExchangePrecision");
+	}
+
+	// Staging area in the send buffer can be reused
+	m_ixSendBuffer = ixBegin;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Neighbor::DecodeRecvBuffer(
+	int nValues,
+	int nLevels
+) {
+	if ((nLevels <= 0) || (nValues % nLevels != 0)) {
+		_EXCEPTIONT("Invalid number of levels in reduced precision block");
+	}
+
+	if (m_ixRecvBuffer + nValues > m_vecRecvBuffer.GetRows()) {
+		_EXCEPTIONT("Insufficient space in RecvBuffer for operation.");
+	}
+
+	double * dValues = &(m_vecRecvBuffer[m_ixRecvBuffer]);
+
+	const unsigned char * pBytes = &(m_vecRecvBytes[0]);
+
+	// Single precision
+	if (m_ePrecision == ExchangePrecision_Single) {
+		for (int i = 0; i < nValues; i++) {
+			float flValue;
+			memcpy(&flValue, pBytes + m_ixRecvBytes, sizeof(float));
+			m_ixRecvBytes += sizeof(float);
+			dValues[i] = static_cast<double>(flValue);
+		}
+
+	// Scaled 16-bit representation with one offset and scale per level
+	} else if (m_ePrecision == ExchangePrecision_Scaled16) {
+		int nBlockSize = nValues / nLevels;
+
+		for (int k = 0; k < nLevels; k++) {
+			double * dBlock = dValues + k * nBlockSize;
+
+			double dMin;
+			double dScale;
+			memcpy(&dMin, pBytes + m_ixRecvBytes, sizeof(double));
+			m_ixRecvBytes += sizeof(double);
+			memcpy(&dScale, pBytes + m_ixRecvBytes, sizeof(double));
+			m_ixRecvBytes += sizeof(double);
+
+			for (int i = 0; i < nBlockSize; i++) {
+				unsigned short sValue;
+				memcpy(&sValue, pBytes + m_ixRecvBytes, sizeof(unsigned short));
+				m_ixRecvBytes += sizeof(unsigned short);
+				dBlock[i] = dMin + dScale * static_cast<double>(sValue);
+			}
+		}
+
+	} else {
+		_EXCEPTIONT("Invalid ExchangePrecision");
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 bool Neighbor::CheckReceive() {
 
 	// Check if message already received and processed
@@ -115,10 +281,12 @@ bool ExteriorNeighbor::CheckReceive() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void ExteriorNeighbor::PrepareExchange() {
-
+void ExteriorNeighbor::PrepareExchange(
+	ExchangePrecision ePrecision,
+	DataType eDataType
+) {
 	// Call up the stack
-	Neighbor::PrepareExchange();
+	Neighbor::PrepareExchange(ePrecision, eDataType);
 
 #ifndef SYNCHRONOUS_COMM 
 	// Information for receive
@@ -134,14 +302,26 @@ void ExteriorNeighbor::PrepareExchange() {
 	int nTag = (m_ixNeighbor << 16) + (ixPatch << 4) + (int)(m_dir);
 
 	// Prepare an asynchronous receive
-	MPI_Irecv(
-		&(m_vecRecvBuffer[0]),
-		m_vecRecvBuffer.GetRows(),
-		MPI_DOUBLE,
-		iProcessor,
-		nTag,
-		MPI_COMM_WORLD,
-		&m_reqRecv);
+	if (m_ePrecision == ExchangePrecision_Double) {
+		MPI_Irecv(
+			&(m_vecRecvBuffer[0]),
+			m_vecRecvBuffer.GetRows(),
+			MPI_DOUBLE,
+			iProcessor,
+			nTag,
+			MPI_COMM_WORLD,
+			&m_reqRecv);
+
+	} else {
+		MPI_Irecv(
+			&(m_vecRecvBytes[0]),
+			m_vecRecvBytes.GetRows(),
+			MPI_BYTE,
+			iProcessor,
+			nTag,
+			MPI_COMM_WORLD,
+			&m_reqRecv);
+	}
 #endif
 }
 
@@ -150,6 +330,9 @@ void ExteriorNeighbor::PrepareExchange() {
 void ExteriorNeighbor::Pack(
 	const GridData3D & data
 ) {
+	// Beginning of the data packed by this call
+	int ixSendBegin = m_ixSendBuffer;
+
 	// Check matrix bounds
 	if (((m_dir == Direction_Right) || (m_dir == Direction_Left)) &&
 		(m_ixSecond > data.GetBElements())
@@ -465,6 +648,11 @@ void ExteriorNeighbor::Pack(
 	} else {
 		_EXCEPTIONT("Invalid direction");
 	}
+
+	// Convert packed data to reduced precision
+	if (m_ePrecision != ExchangePrecision_Double) {
+		EncodeSendBuffer(ixSendBegin, data.GetRElements());
+	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -521,14 +709,37 @@ void ExteriorNeighbor::Send() {
 
 #pragma message "Move MPI_TAG processing to Connectivity"
 
-	MPI_Isend(
-		&(m_vecSendBuffer[0]),
-		m_ixSendBuffer,
-		MPI_DOUBLE,
-		iProcessor,
-		nTag,
-		MPI_COMM_WORLD,
-		&m_reqSend);
+	// Record the message
+	if (m_ePrecision == ExchangePrecision_Double) {
+		ExchangeStatistics::AddMessage(
+			m_eDataType, iProcessor,
+			static_cast<double>(m_ixSendBuffer * sizeof(double)));
+	} else {
+		ExchangeStatistics::AddMessage(
+			m_eDataType, iProcessor,
+			static_cast<double>(m_ixSendBytes));
+	}
+
+	if (m_ePrecision == ExchangePrecision_Double) {
+		MPI_Isend(
+			&(m_vecSendBuffer[0]),
+			m_ixSendBuffer,
+			MPI_DOUBLE,
+			iProcessor,
+			nTag,
+			MPI_COMM_WORLD,
+			&m_reqSend);
+
+	} else {
+		MPI_Isend(
+			&(m_vecSendBytes[0]),
+			m_ixSendBytes,
+			MPI_BYTE,
+			iProcessor,
+			nTag,
+			MPI_COMM_WORLD,
+			&m_reqSend);
+	}
 /*
 	MPI_Send(
 		&(m_vecSendBuffer[0]),
@@ -559,6 +770,29 @@ void ExteriorNeighbor::Unpack(
 	// Model grid
 	const Grid & grid = m_pConnect->GetGridPatch().GetGrid();
 
+	// Beginning of the data unpacked by this call
+	int ixRecvBegin = m_ixRecvBuffer;
+
+	// Convert data from reduced precision
+	if (m_ePrecision != ExchangePrecision_Double) {
+		int nValues;
+		if ((m_dir == Direction_Right) || (m_dir == Direction_Top) ||
+			(m_dir == Direction_Left) || (m_dir == Direction_Bottom)
+		) {
+			nValues =
+				  data.GetRElements()
+				* data.GetHaloElements()
+				* (m_ixSecond - m_ixFirst);
+		} else {
+			nValues =
+				  data.GetRElements()
+				* data.GetHaloElements()
+				* data.GetHaloElements();
+		}
+
+		DecodeRecvBuffer(nValues, data.GetRElements());
+	}
+
 	// Index for halo elements along boundary
 	int ixBoundaryBegin;
 	int ixBoundaryEnd;
@@ -757,6 +991,11 @@ void ExteriorNeighbor::Unpack(
 	} else {
 		_EXCEPTIONT("Invalid direction");
 	}
+
+	// Staging area in the receive buffer can be reused
+	if (m_ePrecision != ExchangePrecision_Double) {
+		m_ixRecvBuffer = ixRecvBegin;
+	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -793,10 +1032,11 @@ void ExteriorNeighbor::Unpack(
 ///////////////////////////////////////////////////////////////////////////////
 
 void ExteriorNeighbor::WaitSend() {
-/*
+
+	// Send buffers are reused by the next exchange, so the send must
+	// complete before this neighbor can be packed again
 	MPI_Status status;
 	MPI_Wait(&m_reqSend, &status);
-*/
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -889,11 +1129,13 @@ void Connectivity::BuildFluxConnectivity() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void Connectivity::PrepareExchange() {
-
+void Connectivity::PrepareExchange(
+	ExchangePrecision ePrecision,
+	DataType eDataType
+) {
 	// Prepare for asynchronous receives from each neighbor
 	for (int m = 0; m < m_vecExteriorNeighbors.size(); m++) {
-		m_vecExteriorNeighbors[m]->PrepareExchange();
+		m_vecExteriorNeighbors[m]->PrepareExchange(ePrecision, eDataType);
 	}
 }
 
@@ -931,6 +1173,68 @@ void Connectivity::Send() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void Connectivity::PackAndSend(
+	const GridData3D & data
+) {
+	// Pack and send data to each exterior neighbor in turn
+	for (int m = 0; m < m_vecExteriorNeighbors.size(); m++) {
+		double dStartTime = Profiler::GetTime();
+
+		m_vecExteriorNeighbors[m]->Pack(data);
+
+		ExchangeStatistics::AddTime(
+			m_vecExteriorNeighbors[m]->m_eDataType,
+			ExchangeStatistics::CounterType_PackTime,
+			Profiler::GetTime() - dStartTime);
+
+		m_vecExteriorNeighbors[m]->Send();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Connectivity::PackAndSend(
+	const GridData4D & data
+) {
+	// Pack and send data to each exterior neighbor in turn
+	for (int m = 0; m < m_vecExteriorNeighbors.size(); m++) {
+		double dStartTime = Profiler::GetTime();
+
+		m_vecExteriorNeighbors[m]->Pack(data);
+
+		ExchangeStatistics::AddTime(
+			m_vecExteriorNeighbors[m]->m_eDataType,
+			ExchangeStatistics::CounterType_PackTime,
+			Profiler::GetTime() - dStartTime);
+
+		m_vecExteriorNeighbors[m]->Send();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Connectivity::PackAndSend(
+	const GridData4D & data1,
+	const GridData4D & data2
+) {
+	// Pack and send data to each exterior neighbor in turn
+	for (int m = 0; m < m_vecExteriorNeighbors.size(); m++) {
+		double dStartTime = Profiler::GetTime();
+
+		m_vecExteriorNeighbors[m]->Pack(data1);
+		m_vecExteriorNeighbors[m]->Pack(data2);
+
+		ExchangeStatistics::AddTime(
+			m_vecExteriorNeighbors[m]->m_eDataType,
+			ExchangeStatistics::CounterType_PackTime,
+			Profiler::GetTime() - dStartTime);
+
+		m_vecExteriorNeighbors[m]->Send();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void Connectivity::SendBuffers() {
 
 	// Send data to exterior neighbors
@@ -944,6 +1248,8 @@ void Connectivity::SendBuffers() {
 
 Neighbor * Connectivity::WaitReceive() {
 
+	double dStartTime = Profiler::GetTime();
+
 	// Receive data from exterior neighbors
 	int nRecvMessageCount = 0;
 
@@ -957,6 +1263,12 @@ Neighbor * Connectivity::WaitReceive() {
 			}
 			if (m_vecExteriorNeighbors[m]->CheckReceive()) {
 				m_vecExteriorNeighbors[m]->SetComplete();
+
+				ExchangeStatistics::AddTime(
+					m_vecExteriorNeighbors[m]->m_eDataType,
+					ExchangeStatistics::CounterType_WaitTime,
+					Profiler::GetTime() - dStartTime);
+
 				return m_vecExteriorNeighbors[m];
 			}
 		}
@@ -971,7 +1283,14 @@ void Connectivity::WaitSend() {
 
 	// Wait for all asynchronous send requests to complete
 	for (int m = 0; m < m_vecExteriorNeighbors.size(); m++) {
+		double dStartTime = Profiler::GetTime();
+
 		m_vecExteriorNeighbors[m]->WaitSend();
+
+		ExchangeStatistics::AddTime(
+			m_vecExteriorNeighbors[m]->m_eDataType,
+			ExchangeStatistics::CounterType_WaitTime,
+			Profiler::GetTime() - dStartTime);
 	}
 }
 
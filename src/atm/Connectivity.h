@@ -18,6 +18,8 @@
 #define _CONNECTIVITY_H_
 
 #include "Direction.h"
+#include "ExchangePrecision.h"
+#include "DataType.h"
 
 #include "DataVector.h"
 #include "GridData4D.h"
@@ -57,8 +59,14 @@ public:
 		m_nHaloElements(0),
 		m_nComponents(0),
 		m_fComplete(false),
+		m_ePrecision(ExchangePrecision_Double),
+		m_eDataType(DataType_None),
 		m_ixSendBuffer(0),
-		m_ixRecvBuffer(0)
+		m_ixRecvBuffer(0),
+		m_ixSendBytes(0),
+		m_ixRecvBytes(0),
+		m_reqSend(MPI_REQUEST_NULL),
+		m_reqRecv(MPI_REQUEST_NULL)
 	{
 		if (m_nBoundarySize < 0) {
 			_EXCEPTIONT("Invalid boundary size");
@@ -101,18 +109,64 @@ public:
 	///	<summary>
 	///		Prepare an asynchronous receive.
 	///	</summary>
-	virtual void PrepareExchange() {
+	virtual void PrepareExchange(
+		ExchangePrecision ePrecision = ExchangePrecision_Double,
+		DataType eDataType = DataType_None
+	) {
+		// Set the precision of this exchange
+		m_ePrecision = ePrecision;
+
+		// Set the type of data in this exchange
+		m_eDataType = eDataType;
 
 		// Reset the send buffer index
 		m_ixSendBuffer = 0;
+		m_ixSendBytes = 0;
 
 		// Reset the receive buffer index
 		m_ixRecvBuffer = 0;
+		m_ixRecvBytes = 0;
+
+		// Allocate buffers for reduced precision exchange
+		if ((m_ePrecision != ExchangePrecision_Double) &&
+			(m_vecSendBytes.GetRows() == 0)
+		) {
+			InitializeReducedPrecisionBuffers();
+		}
 
 		// Reset the complete flag
 		m_fComplete = false;
+
+		// Reset the MPI requests
+		m_reqSend = MPI_REQUEST_NULL;
+		m_reqRecv = MPI_REQUEST_NULL;
 	}
 
+	///	<summary>
+	///		Allocate buffers used for reduced precision exchange.
+	///	</summary>
+	void InitializeReducedPrecisionBuffers();
+
+	///	<summary>
+	///		Convert values in the send buffer, starting at ixBegin, to the
+	///		reduced precision representation and append them to the send
+	///		byte buffer.  The values are grouped into nLevels blocks of
+	///		equal size, each of which is scaled independently.
+	///	</summary>
+	void EncodeSendBuffer(
+		int ixBegin,
+		int nLevels
+	);
+
+	///	<summary>
+	///		Convert nValues values from the receive byte buffer into the
+	///		receive buffer, starting at the current receive index.
+	///	</summary>
+	void DecodeRecvBuffer(
+		int nValues,
+		int nLevels
+	);
+
 	///	<summary>
 	///		Pack data into the send buffer.
 	///	</summary>
@@ -217,6 +271,16 @@ public:
 	///	</summary>
 	bool m_fComplete;
 
+	///	<summary>
+	///		Precision used for the current exchange.
+	///	</summary>
+	ExchangePrecision m_ePrecision;
+
+	///	<summary>
+	///		Type of data in the current exchange.
+	///	</summary>
+	DataType m_eDataType;
+
 	///	<summary>
 	///		Index into the send buffer.
 	///	</summary>
@@ -227,6 +291,16 @@ public:
 	///	</summary>
 	int m_ixRecvBuffer;
 
+	///	<summary>
+	///		Index into the send byte buffer (reduced precision only).
+	///	</summary>
+	int m_ixSendBytes;
+
+	///	<summary>
+	///		Index into the receive byte buffer (reduced precision only).
+	///	</summary>
+	int m_ixRecvBytes;
+
 	///	<summary>
 	///		MPI_Request objects used for asynchronous exchange of data.
 	///	</summary>
@@ -238,6 +312,12 @@ public:
 	///	</summary>
 	DataVector<double> m_vecSendBuffer;
 	DataVector<double> m_vecRecvBuffer;
+
+	///	<summary>
+	///		DataVector used for exchange of reduced precision data.
+	///	</summary>
+	DataVector<unsigned char> m_vecSendBytes;
+	DataVector<unsigned char> m_vecRecvBytes;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -319,7 +399,10 @@ public:
 	///	<summary>
 	///		Prepare an asynchronous receive.
 	///	</summary>
-	virtual void PrepareExchange();
+	virtual void PrepareExchange(
+		ExchangePrecision ePrecision = ExchangePrecision_Double,
+		DataType eDataType = DataType_None
+	);
 
 	///	<summary>
 	///		Pack data into the send buffer.
@@ -404,7 +487,10 @@ public:
 	///	<summary>
 	///		Prepare an asynchronous receive.
 	///	</summary>
-	virtual void PrepareExchange() {
+	virtual void PrepareExchange(
+		ExchangePrecision ePrecision = ExchangePrecision_Double,
+		DataType eDataType = DataType_None
+	) {
 	}
 
 	///	<summary>
@@ -503,7 +589,10 @@ public:
 	///	<summary>
 	///		Prepare for the exchange of data between processors.
 	///	</summary>
-	void PrepareExchange();
+	void PrepareExchange(
+		ExchangePrecision ePrecision = ExchangePrecision_Double,
+		DataType eDataType = DataType_None
+	);
 
 	///	<summary>
 	///		Pack data into the send buffer in preparation for a send.
@@ -524,6 +613,32 @@ public:
 	///	</summary>
 	void Send();
 
+	///	<summary>
+	///		Pack data into the send buffer of each neighbor and post the
+	///		send to that neighbor as soon as its buffer is complete.
+	///	</summary>
+	void PackAndSend(
+		const GridData3D & data
+	);
+
+	///	<summary>
+	///		Pack data into the send buffer of each neighbor and post the
+	///		send to that neighbor as soon as its buffer is complete.
+	///	</summary>
+	void PackAndSend(
+		const GridData4D & data
+	);
+
+	///	<summary>
+	///		Pack two data objects into the send buffer of each neighbor
+	///		and post the send to that neighbor as soon as its buffer is
+	///		complete.
+	///	</summary>
+	void PackAndSend(
+		const GridData4D & data1,
+		const GridData4D & data2
+	);
+
 	///	<summary>
 	///		Send buffers to other processors.
 	///	</summary>
@@ -555,14 +670,14 @@ public:
 	const GridPatch & GetGridPatch() const {
 		return m_patch;
 	}
-/*
+
 	///	<summary>
 	///		Get the vector of exterior boundary neighbors.
 	///	</summary>
 	const ExteriorNeighborVector & GetExteriorNeighbors() const {
 		return m_vecExteriorNeighbors;
 	}
-
+/*
 	///	<summary>
 	///		Get the vector of interior boundary neighbors.
 	///	</summary>
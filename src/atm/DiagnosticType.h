@@ -0,0 +1,36 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    DiagnosticType.h
+///	\author  Paul Ullrich
+///	\version October 18, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _DIAGNOSTICTYPE_H_
+#define _DIAGNOSTICTYPE_H_
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Global diagnostics computed in a single sweep over the state.  The
+///		integrals of each state variable follow the named diagnostics.
+///	</summary>
+enum DiagnosticType {
+	DiagnosticType_Energy,
+	DiagnosticType_PotentialEnstrophy,
+	DiagnosticType_Mass,
+	DiagnosticType_Count
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
@@ -0,0 +1,34 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    ExchangePrecision.h
+///	\author  Paul Ullrich
+///	\version October 18, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _EXCHANGEPRECISION_H_
+#define _EXCHANGEPRECISION_H_
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Precision used to represent halo data sent between processors.
+///	</summary>
+enum ExchangePrecision {
+	ExchangePrecision_Double,
+	ExchangePrecision_Single,
+	ExchangePrecision_Scaled16
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
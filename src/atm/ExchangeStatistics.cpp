@@ -0,0 +1,290 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    ExchangeStatistics.cpp
+///	\author  Paul Ullrich
+///	\version October 18, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "ExchangeStatistics.h"
+
+#include "Announce.h"
+#include "Exception.h"
+
+#include <mpi.h>
+#include <cstdio>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Number of DataTypes with counters (DataType_Default..DataType_None).
+///	</summary>
+static const int ExchangeStatisticsDataTypeCount =
+	static_cast<int>(DataType_None) + 1;
+
+///	<summary>
+///		Names of the DataTypes used in the report.
+///	</summary>
+static const char * ExchangeStatisticsDataTypeNames[] = {
+	"State",
+	"RefState",
+	"Tracers",
+	"Auxiliary",
+	"Jacobian",
+	"ElementArea",
+	"Topography",
+	"TopographyDeriv",
+	"Longitude",
+	"Latitude",
+	"Z",
+	"Pressure",
+	"KineticEnergy",
+	"Vorticity",
+	"Divergence",
+	"Temperature",
+	"RayleighStrength",
+	"Other"
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+std::vector<double> ExchangeStatistics::m_vecCounters;
+
+std::vector<double> ExchangeStatistics::m_vecProcessorMessages;
+
+std::vector<double> ExchangeStatistics::m_vecProcessorBytes;
+
+///////////////////////////////////////////////////////////////////////////////
+
+int ExchangeStatistics::GetDataTypeIndex(
+	DataType eDataType
+) {
+	if ((eDataType < DataType_Default) || (eDataType > DataType_None)) {
+		return static_cast<int>(DataType_None);
+	}
+	return static_cast<int>(eDataType);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ExchangeStatistics::Initialize() {
+	if (m_vecCounters.size() != 0) {
+		return;
+	}
+
+	int nSize;
+	MPI_Comm_size(MPI_COMM_WORLD, &nSize);
+
+	m_vecCounters.resize(
+		ExchangeStatisticsDataTypeCount * CounterType_Count, 0.0);
+	m_vecProcessorMessages.resize(nSize, 0.0);
+	m_vecProcessorBytes.resize(nSize, 0.0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ExchangeStatistics::AddMessage(
+	DataType eDataType,
+	int iProcessor,
+	double dBytes
+) {
+	Initialize();
+
+	int ix = GetDataTypeIndex(eDataType) * CounterType_Count;
+
+	m_vecCounters[ix + CounterType_Messages] += 1.0;
+	m_vecCounters[ix + CounterType_Bytes] += dBytes;
+
+	if ((iProcessor >= 0) &&
+		(iProcessor < static_cast<int>(m_vecProcessorMessages.size()))
+	) {
+		m_vecProcessorMessages[iProcessor] += 1.0;
+		m_vecProcessorBytes[iProcessor] += dBytes;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ExchangeStatistics::AddTime(
+	DataType eDataType,
+	CounterType eCounterType,
+	double dTime
+) {
+	Initialize();
+
+	m_vecCounters[
+		GetDataTypeIndex(eDataType) * CounterType_Count
+			+ eCounterType] += dTime;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ExchangeStatistics::Reset() {
+	m_vecCounters.clear();
+	m_vecProcessorMessages.clear();
+	m_vecProcessorBytes.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ExchangeStatistics::Report(
+	const std::string & strFile
+) {
+	Initialize();
+
+	int nRank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &nRank);
+
+	int nSize;
+	MPI_Comm_size(MPI_COMM_WORLD, &nSize);
+
+	int nCounters = static_cast<int>(m_vecCounters.size());
+
+	// Totals and maxima over all processors
+	std::vector<double> vecCountersSum(nCounters);
+	std::vector<double> vecCountersMax(nCounters);
+
+	MPI_Reduce(
+		&(m_vecCounters[0]), &(vecCountersSum[0]), nCounters,
+		MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+	MPI_Reduce(
+		&(m_vecCounters[0]), &(vecCountersMax[0]), nCounters,
+		MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+	// Processor-to-processor matrix; row i contains the messages sent by
+	// processor i, so column i contains the messages it received
+	std::vector<double> vecMatrixMessages;
+	std::vector<double> vecMatrixBytes;
+
+	if (nRank == 0) {
+		vecMatrixMessages.resize(nSize * nSize);
+		vecMatrixBytes.resize(nSize * nSize);
+	}
+
+	MPI_Gather(
+		&(m_vecProcessorMessages[0]), nSize, MPI_DOUBLE,
+		(nRank == 0)?(&(vecMatrixMessages[0])):(NULL), nSize, MPI_DOUBLE,
+		0, MPI_COMM_WORLD);
+	MPI_Gather(
+		&(m_vecProcessorBytes[0]), nSize, MPI_DOUBLE,
+		(nRank == 0)?(&(vecMatrixBytes[0])):(NULL), nSize, MPI_DOUBLE,
+		0, MPI_COMM_WORLD);
+
+	if (nRank != 0) {
+		return;
+	}
+
+	// Summary table
+	AnnounceStartBlock("Exchange statistics");
+	Announce("Aggregated over %i processors", nSize);
+	Announce("%-18s %12s %12s %12s %12s %12s %12s",
+		"DataType", "Messages", "MBytes", "Max MBytes",
+		"Pack (s)", "Wait (s)", "Unpack (s)");
+
+	for (int d = 0; d < ExchangeStatisticsDataTypeCount; d++) {
+		int ix = d * CounterType_Count;
+
+		if ((vecCountersSum[ix + CounterType_Messages] == 0.0) &&
+			(vecCountersSum[ix + CounterType_WaitTime] == 0.0)
+		) {
+			continue;
+		}
+
+		Announce("%-18s %12.0f %12.4e %12.4e %12.4e %12.4e %12.4e",
+			ExchangeStatisticsDataTypeNames[d],
+			vecCountersSum[ix + CounterType_Messages],
+			vecCountersSum[ix + CounterType_Bytes] / 1048576.0,
+			vecCountersMax[ix + CounterType_Bytes] / 1048576.0,
+			vecCountersMax[ix + CounterType_PackTime],
+			vecCountersMax[ix + CounterType_WaitTime],
+			vecCountersMax[ix + CounterType_UnpackTime]);
+	}
+
+	// Largest volume sent and received by a single processor
+	double dMaxSent = 0.0;
+	double dMaxReceived = 0.0;
+	for (int i = 0; i < nSize; i++) {
+		double dSent = 0.0;
+		double dReceived = 0.0;
+		for (int j = 0; j < nSize; j++) {
+			dSent += vecMatrixBytes[i * nSize + j];
+			dReceived += vecMatrixBytes[j * nSize + i];
+		}
+		if (dSent > dMaxSent) {
+			dMaxSent = dSent;
+		}
+		if (dReceived > dMaxReceived) {
+			dMaxReceived = dReceived;
+		}
+	}
+	Announce("Max sent by one processor:     %12.4e MBytes",
+		dMaxSent / 1048576.0);
+	Announce("Max received by one processor: %12.4e MBytes",
+		dMaxReceived / 1048576.0);
+	AnnounceEndBlock("Done");
+
+	if (strFile == "") {
+		return;
+	}
+
+	// Totals for each DataType
+	std::string strCSVFile = strFile + ".comm.csv";
+	FILE * fpCSV = fopen(strCSVFile.c_str(), "w");
+	if (fpCSV == NULL) {
+		_EXCEPTION1("Unable to open exchange statistics file \"%s\"",
+			strCSVFile.c_str());
+	}
+
+	fprintf(fpCSV, "datatype,messages,bytes,max_bytes,"
+		"pack_sum,pack_max,wait_sum,wait_max,unpack_sum,unpack_max\n");
+	for (int d = 0; d < ExchangeStatisticsDataTypeCount; d++) {
+		int ix = d * CounterType_Count;
+
+		fprintf(fpCSV,
+			"%s,%.17g,%.17g,%.17g,%.17g,%.17g,%.17g,%.17g,%.17g,%.17g\n",
+			ExchangeStatisticsDataTypeNames[d],
+			vecCountersSum[ix + CounterType_Messages],
+			vecCountersSum[ix + CounterType_Bytes],
+			vecCountersMax[ix + CounterType_Bytes],
+			vecCountersSum[ix + CounterType_PackTime],
+			vecCountersMax[ix + CounterType_PackTime],
+			vecCountersSum[ix + CounterType_WaitTime],
+			vecCountersMax[ix + CounterType_WaitTime],
+			vecCountersSum[ix + CounterType_UnpackTime],
+			vecCountersMax[ix + CounterType_UnpackTime]);
+	}
+	fclose(fpCSV);
+
+	// Nonzero entries of the processor-to-processor matrix
+	std::string strMatrixFile = strFile + ".comm_matrix.csv";
+	FILE * fpMatrix = fopen(strMatrixFile.c_str(), "w");
+	if (fpMatrix == NULL) {
+		_EXCEPTION1("Unable to open exchange statistics file \"%s\"",
+			strMatrixFile.c_str());
+	}
+
+	fprintf(fpMatrix, "source,destination,messages,bytes\n");
+	for (int i = 0; i < nSize; i++) {
+	for (int j = 0; j < nSize; j++) {
+		if (vecMatrixMessages[i * nSize + j] == 0.0) {
+			continue;
+		}
+		fprintf(fpMatrix, "%i,%i,%.17g,%.17g\n",
+			i, j,
+			vecMatrixMessages[i * nSize + j],
+			vecMatrixBytes[i * nSize + j]);
+	}
+	}
+	fclose(fpMatrix);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,116 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    ExchangeStatistics.h
+///	\author  Paul Ullrich
+///	\version October 18, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _EXCHANGESTATISTICS_H_
+#define _EXCHANGESTATISTICS_H_
+
+#include "DataType.h"
+
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Counters for halo exchanges on this processor.  Messages and bytes
+///		are recorded for each DataType and destination processor, and the
+///		time spent packing, waiting for and unpacking messages is recorded
+///		for each DataType.
+///	</summary>
+class ExchangeStatistics {
+
+public:
+	///	<summary>
+	///		Types of counters recorded for each DataType.
+	///	</summary>
+	enum CounterType {
+		CounterType_Messages,
+		CounterType_Bytes,
+		CounterType_PackTime,
+		CounterType_WaitTime,
+		CounterType_UnpackTime,
+		CounterType_Count
+	};
+
+public:
+	///	<summary>
+	///		Record a message sent to the given processor.
+	///	</summary>
+	static void AddMessage(
+		DataType eDataType,
+		int iProcessor,
+		double dBytes
+	);
+
+	///	<summary>
+	///		Record time spent on one type of activity.
+	///	</summary>
+	static void AddTime(
+		DataType eDataType,
+		CounterType eCounterType,
+		double dTime
+	);
+
+	///	<summary>
+	///		Remove all counters.
+	///	</summary>
+	static void Reset();
+
+	///	<summary>
+	///		Aggregate counters over all processors and output a summary
+	///		table.  If strFile is not empty the totals for each DataType are
+	///		written to strFile.comm.csv and the processor-to-processor
+	///		communication matrix is written to strFile.comm_matrix.csv.
+	///		This function must be called on all processors.
+	///	</summary>
+	static void Report(
+		const std::string & strFile = ""
+	);
+
+private:
+	///	<summary>
+	///		Get the counter index of a DataType.
+	///	</summary>
+	static int GetDataTypeIndex(
+		DataType eDataType
+	);
+
+	///	<summary>
+	///		Allocate counters if necessary.
+	///	</summary>
+	static void Initialize();
+
+private:
+	///	<summary>
+	///		Counters for each DataType.
+	///	</summary>
+	static std::vector<double> m_vecCounters;
+
+	///	<summary>
+	///		Number of messages sent to each processor.
+	///	</summary>
+	static std::vector<double> m_vecProcessorMessages;
+
+	///	<summary>
+	///		Number of bytes sent to each processor.
+	///	</summary>
+	static std::vector<double> m_vecProcessorBytes;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
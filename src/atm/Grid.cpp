@@ -19,8 +19,11 @@
 #include "TestCase.h"
 #include "ConsolidationStatus.h"
 #include "VerticalStretch.h"
+#include "ExchangeStatistics.h"
 
 #include "Exception.h"
+#include "Profiler.h"
+#include "ReproducibleSum.h"
 
 #include <cfloat>
 #include <cmath>
@@ -42,6 +45,9 @@ Grid::Grid(
 	m_iGridStamp(0),
 	m_model(model),
 	m_fBlockParallelExchange(false),
+	m_fReproducibleReductions(false),
+	m_nDefaultPatchProcessors(0),
+	m_vecExchangePrecision(DataType_None, ExchangePrecision_Double),
 	m_nABaseResolution(nABaseResolution),
 	m_nBBaseResolution(nBBaseResolution),
 	m_nRefinementRatio(nRefinementRatio),
@@ -52,7 +58,8 @@ Grid::Grid(
 	m_eVerticalStaggering(eVerticalStaggering),
 	m_nDegreesOfFreedomPerColumn(0),
 	m_fHasReferenceState(false),
-	m_fHasRayleighFriction(false)
+	m_fHasRayleighFriction(false),
+	m_reqDiagnostics(MPI_REQUEST_NULL)
 {
 	// Assign a default vertical stretching function
 	m_pVerticalStretchF = new VerticalStretchUniform;
@@ -72,6 +79,31 @@ Grid::~Grid() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void Grid::SetExchangePrecision(
+	DataType eDataType,
+	ExchangePrecision ePrecision
+) {
+	if ((eDataType < 0) || (eDataType >= DataType_None)) {
+		_EXCEPTIONT("Invalid DataType");
+	}
+
+	m_vecExchangePrecision[(int)(eDataType)] = ePrecision;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ExchangePrecision Grid::GetExchangePrecision(
+	DataType eDataType
+) const {
+	if ((eDataType < 0) || (eDataType >= DataType_None)) {
+		_EXCEPTIONT("Invalid DataType");
+	}
+
+	return m_vecExchangePrecision[(int)(eDataType)];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void Grid::SetVerticalStretchFunction(
 	VerticalStretchFunction * pVerticalStretchF
 ) {
@@ -307,6 +339,19 @@ void Grid::EvaluateTestCase(
 		m_vecActiveGridPatches[n]->
 			EvaluateTestCase(test, time, iDataIndex);
 	}
+
+	// Locate nodes where Rayleigh friction is active
+	if (m_fHasRayleighFriction) {
+		ComputeRayleighFrictionRuns();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Grid::ComputeRayleighFrictionRuns() {
+	for (int n = 0; n < m_vecActiveGridPatches.size(); n++) {
+		m_vecActiveGridPatches[n]->ComputeRayleighFrictionRuns();
+	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -371,17 +416,47 @@ void Grid::Checksum(
 		_EXCEPTIONT("Invalid DataType");
 	}
 
+	// Initialize global checksums array at root
+	if (nRank == 0) {
+		dChecksums.Initialize(dChecksumsLocal.GetRows());
+	}
+
+	// Reproducible sums over all processors
+	if (m_fReproducibleReductions && (eChecksumType != ChecksumType_Linf)) {
+		std::vector<int64_t> iChecksumsLocal;
+		ChecksumReproducibleLocal(
+			eDataType, iChecksumsLocal, iDataIndex, eChecksumType);
+
+		std::vector<int64_t> iChecksums(iChecksumsLocal.size());
+
+		MPI_Reduce(
+			&(iChecksumsLocal[0]),
+			&(iChecksums[0]),
+			iChecksumsLocal.size(),
+			MPI_INT64_T,
+			MPI_SUM,
+			0,
+			MPI_COMM_WORLD);
+
+		if (nRank == 0) {
+			for (int c = 0; c < dChecksums.GetRows(); c++) {
+				dChecksums[c] = ReproducibleSum::ToDouble(
+					&(iChecksums[c * ReproducibleSum::BinCount]));
+
+				if (eChecksumType == ChecksumType_L2) {
+					dChecksums[c] = sqrt(dChecksums[c]);
+				}
+			}
+		}
+		return;
+	}
+
 	// Loop over all patches and calculate local checksums
 	for (int n = 0; n < m_vecActiveGridPatches.size(); n++) {
 		m_vecActiveGridPatches[n]->Checksum(
 			eDataType, dChecksumsLocal, iDataIndex, eChecksumType);
 	}
 
-	// Initialize global checksums array at root
-	if (nRank == 0) {
-		dChecksums.Initialize(dChecksumsLocal.GetRows());
-	}
-
 	// Compute sum over all processors and send to root node
 	MPI_Op nMPIOperator;
 	if (eChecksumType == ChecksumType_Linf) {
@@ -411,101 +486,306 @@ void Grid::Checksum(
 
 ///////////////////////////////////////////////////////////////////////////////
 
-double Grid::ComputeTotalEnergy(
-	int iDataIndex
+void Grid::ChecksumReproducibleLocal(
+	DataType eDataType,
+	std::vector<int64_t> & iChecksums,
+	int iDataIndex,
+	ChecksumType eChecksumType
 ) const {
-	// Compute local energy
-	double dLocalEnergy = 0.0;
-	for (int n = 0; n < m_vecActiveGridPatches.size(); n++) {
-		dLocalEnergy +=
-			m_vecActiveGridPatches[n]->ComputeTotalEnergy(iDataIndex);
+	if (eChecksumType == ChecksumType_Linf) {
+		_EXCEPTIONT("Reproducible Linf checksum not supported");
 	}
 
-	// Reduce to obtain global energy integral
-	double dGlobalEnergy = 0.0;
-	MPI_Reduce(
-		&dLocalEnergy,
-		&dGlobalEnergy,
-		1,
-		MPI_DOUBLE,
-		MPI_SUM,
-		0,
-		MPI_COMM_WORLD);
+	int nChecksums;
+	if (eDataType == DataType_State) {
+		nChecksums = m_model.GetEquationSet().GetComponents();
+	} else if (eDataType == DataType_Tracers) {
+		nChecksums = m_model.GetEquationSet().GetTracers();
+	} else {
+		_EXCEPTIONT("Invalid DataType");
+	}
+
+	iChecksums.resize(nChecksums * ReproducibleSum::BinCount);
+	for (int c = 0; c < nChecksums; c++) {
+		ReproducibleSum::Clear(&(iChecksums[c * ReproducibleSum::BinCount]));
+	}
+
+	// Accumulate the checksums of each patch exactly
+	DataVector<double> dChecksumsPatch;
+
+	for (int n = 0; n < m_vecActiveGridPatches.size(); n++) {
+		dChecksumsPatch.Initialize(nChecksums);
 
-	// Return global energy integral
-	return dGlobalEnergy;
+		m_vecActiveGridPatches[n]->Checksum(
+			eDataType, dChecksumsPatch, iDataIndex, eChecksumType);
+
+		for (int c = 0; c < nChecksums; c++) {
+			ReproducibleSum::Add(
+				&(iChecksums[c * ReproducibleSum::BinCount]),
+				dChecksumsPatch[c]);
+		}
+	}
+
+	for (int c = 0; c < nChecksums; c++) {
+		ReproducibleSum::Normalize(
+			&(iChecksums[c * ReproducibleSum::BinCount]));
+	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-double Grid::ComputeTotalPotentialEnstrophy(
+void Grid::BeginComputeDiagnostics(
 	int iDataIndex
 ) {
-	// Compute vorticity and divergence on the Grid
-	ComputeVorticityDivergence(iDataIndex);
+	if (m_reqDiagnostics != MPI_REQUEST_NULL) {
+		_EXCEPTIONT("Diagnostics reduction already in progress");
+	}
+
+	const EquationSet & eqn = m_model.GetEquationSet();
+
+	// Potential enstrophy requires the vorticity
+	if (eqn.GetType() == EquationSet::ShallowWaterEquations) {
+		ComputeVorticityDivergence(iDataIndex);
+	}
+
+	// Compute local diagnostics
+	m_dDiagnosticsLocal.Initialize(
+		DiagnosticType_Count + eqn.GetComponents());
+
+	// Reproducible sums over all processors
+	if (m_fReproducibleReductions) {
+		const int nDiagnostics = m_dDiagnosticsLocal.GetRows();
+
+		m_iDiagnosticsLocal.resize(nDiagnostics * ReproducibleSum::BinCount);
+		for (int d = 0; d < nDiagnostics; d++) {
+			ReproducibleSum::Clear(
+				&(m_iDiagnosticsLocal[d * ReproducibleSum::BinCount]));
+		}
+
+		for (int n = 0; n < m_vecActiveGridPatches.size(); n++) {
+			m_dDiagnosticsLocal.Zero();
+
+			m_vecActiveGridPatches[n]->ComputeDiagnostics(
+				iDataIndex, m_dDiagnosticsLocal);
+
+			for (int d = 0; d < nDiagnostics; d++) {
+				ReproducibleSum::Add(
+					&(m_iDiagnosticsLocal[d * ReproducibleSum::BinCount]),
+					m_dDiagnosticsLocal[d]);
+			}
+		}
+
+		for (int d = 0; d < nDiagnostics; d++) {
+			ReproducibleSum::Normalize(
+				&(m_iDiagnosticsLocal[d * ReproducibleSum::BinCount]));
+		}
+
+		m_iDiagnosticsGlobal.resize(m_iDiagnosticsLocal.size());
+
+		MPI_Iallreduce(
+			&(m_iDiagnosticsLocal[0]),
+			&(m_iDiagnosticsGlobal[0]),
+			m_iDiagnosticsLocal.size(),
+			MPI_INT64_T,
+			MPI_SUM,
+			MPI_COMM_WORLD,
+			&m_reqDiagnostics);
+
+		return;
+	}
 
-	// Compute local enstrophy
-	double dLocalPotentialEnstrophy = 0.0;
 	for (int n = 0; n < m_vecActiveGridPatches.size(); n++) {
-		dLocalPotentialEnstrophy +=
-			m_vecActiveGridPatches[n]->
-				ComputeTotalPotentialEnstrophy(iDataIndex);
+		m_vecActiveGridPatches[n]->ComputeDiagnostics(
+			iDataIndex, m_dDiagnosticsLocal);
 	}
 
-	// Reduce to obtain global energy integral
-	double dGlobalPotentialEnstrophy = 0.0;
-	MPI_Reduce(
-		&dLocalPotentialEnstrophy,
-		&dGlobalPotentialEnstrophy,
-		1,
+	// Begin reduction over all processors
+	m_dDiagnosticsGlobal.Initialize(m_dDiagnosticsLocal.GetRows());
+
+	MPI_Iallreduce(
+		&(m_dDiagnosticsLocal[0]),
+		&(m_dDiagnosticsGlobal[0]),
+		m_dDiagnosticsLocal.GetRows(),
 		MPI_DOUBLE,
 		MPI_SUM,
-		0,
-		MPI_COMM_WORLD);
+		MPI_COMM_WORLD,
+		&m_reqDiagnostics);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Grid::EndComputeDiagnostics(
+	DataVector<double> & dDiagnostics
+) {
+	if (m_reqDiagnostics == MPI_REQUEST_NULL) {
+		_EXCEPTIONT("No diagnostics reduction in progress");
+	}
+
+	MPI_Wait(&m_reqDiagnostics, MPI_STATUS_IGNORE);
 
-	// Return global energy integral
-	return dGlobalPotentialEnstrophy;
+	if (m_fReproducibleReductions) {
+		const int nDiagnostics = m_dDiagnosticsLocal.GetRows();
+
+		dDiagnostics.Initialize(nDiagnostics);
+		for (int d = 0; d < nDiagnostics; d++) {
+			dDiagnostics[d] = ReproducibleSum::ToDouble(
+				&(m_iDiagnosticsGlobal[d * ReproducibleSum::BinCount]));
+		}
+		return;
+	}
+
+	dDiagnostics = m_dDiagnosticsGlobal;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 void Grid::Exchange(
+	DataType eDataType,
+	int iDataIndex,
+	ExchangeListener * pListener
+) {
+	BeginExchange(eDataType, iDataIndex);
+
+	EndExchange(eDataType, iDataIndex, pListener);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Grid::BeginExchange(
 	DataType eDataType,
 	int iDataIndex
 ) {
+	ProfilerRegion region("Exchange");
+
 	// Block parallel exchanges
 	if (m_fBlockParallelExchange) {
 		return;
 	}
 
 	// Verify all processors are prepared to exchange
+	Profiler::Begin("Barrier");
 	MPI_Barrier(MPI_COMM_WORLD);
+	Profiler::End();
 
 	// Set up asynchronous recvs
+	ExchangePrecision ePrecision = GetExchangePrecision(eDataType);
+
 	for (int n = 0; n < m_vecActiveGridPatches.size(); n++) {
-		m_vecActiveGridPatches[n]->PrepareExchange();
+		m_vecActiveGridPatches[n]->PrepareExchange(ePrecision, eDataType);
 	}
 
-	// Send data
+	// Pack and send data to each neighbor as soon as it is ready
 	for (int n = 0; n < m_vecActiveGridPatches.size(); n++) {
 		m_vecActiveGridPatches[n]->Send(eDataType, iDataIndex);
 	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Grid::EndExchange(
+	DataType eDataType,
+	int iDataIndex,
+	ExchangeListener * pListener
+) {
+	ProfilerRegion region("Exchange");
+
+	// Block parallel exchanges; halo data is considered up to date
+	if (m_fBlockParallelExchange) {
+		if (pListener != NULL) {
+			for (int n = 0; n < m_vecActiveGridPatches.size(); n++) {
+				pListener->OnPatchReceived(m_vecActiveGridPatches[n]);
+			}
+		}
+		return;
+	}
+
+	// Gather outstanding receive requests over all active patches
+	m_vecExchangeRequests.clear();
+	m_vecExchangeNeighbors.clear();
+	m_vecExchangePatchIndex.clear();
+
+	std::vector<int> vecPatchOutstanding(m_vecActiveGridPatches.size(), 0);
 
-	// Receive data
 	for (int n = 0; n < m_vecActiveGridPatches.size(); n++) {
-		m_vecActiveGridPatches[n]->Receive(eDataType, iDataIndex);
+		const Connectivity::ExteriorNeighborVector & vecNeighbors =
+			m_vecActiveGridPatches[n]->GetConnectivity().GetExteriorNeighbors();
+
+		for (int m = 0; m < vecNeighbors.size(); m++) {
+			if (vecNeighbors[m]->IsComplete()) {
+				continue;
+			}
+			m_vecExchangeRequests.push_back(vecNeighbors[m]->m_reqRecv);
+			m_vecExchangeNeighbors.push_back(vecNeighbors[m]);
+			m_vecExchangePatchIndex.push_back(n);
+			vecPatchOutstanding[n]++;
+		}
+
+		if ((pListener != NULL) && (vecPatchOutstanding[n] == 0)) {
+			pListener->OnPatchReceived(m_vecActiveGridPatches[n]);
+		}
+	}
+
+	int nRequests = static_cast<int>(m_vecExchangeRequests.size());
+
+	m_vecExchangeCompleted.resize(nRequests);
+
+	// Unpack each message as soon as it arrives
+	int nOutstanding = nRequests;
+	while (nOutstanding > 0) {
+		double dStartTime = Profiler::GetTime();
+
+		int nCompleted;
+		MPI_Waitsome(
+			nRequests,
+			&(m_vecExchangeRequests[0]),
+			&nCompleted,
+			&(m_vecExchangeCompleted[0]),
+			MPI_STATUSES_IGNORE);
+
+		ExchangeStatistics::AddTime(
+			eDataType,
+			ExchangeStatistics::CounterType_WaitTime,
+			Profiler::GetTime() - dStartTime);
+
+		if ((nCompleted == MPI_UNDEFINED) || (nCompleted == 0)) {
+			_EXCEPTIONT("Logic error: No active receive requests");
+		}
+
+		for (int i = 0; i < nCompleted; i++) {
+			int ix = m_vecExchangeCompleted[i];
+			int n = m_vecExchangePatchIndex[ix];
+
+			GridPatch * pPatch = m_vecActiveGridPatches[n];
+			ExteriorNeighbor * pNeighbor = m_vecExchangeNeighbors[ix];
+
+			pNeighbor->m_reqRecv = MPI_REQUEST_NULL;
+			pNeighbor->SetComplete();
+
+			pPatch->Unpack(pNeighbor, eDataType, iDataIndex);
+
+			if (pListener != NULL) {
+				pListener->OnNeighborReceived(pPatch, pNeighbor);
+
+				vecPatchOutstanding[n]--;
+				if (vecPatchOutstanding[n] == 0) {
+					pListener->OnPatchReceived(pPatch);
+				}
+			}
+		}
+
+		nOutstanding -= nCompleted;
 	}
 
 	// Wait for send requests to complete
 	for (int n = 0; n < m_vecActiveGridPatches.size(); n++) {
 		m_vecActiveGridPatches[n]->CompleteExchange();
 	}
-
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 void Grid::ExchangeBuffers() {
+	ProfilerRegion region("Exchange");
 
 	// Block parallel exchanges
 	if (m_fBlockParallelExchange) {
@@ -513,7 +793,9 @@ void Grid::ExchangeBuffers() {
 	}
 
 	// Verify all processors are prepared to exchange
+	Profiler::Begin("Barrier");
 	MPI_Barrier(MPI_COMM_WORLD);
+	Profiler::End();
 
 	// Set up asynchronous recvs
 	for (int n = 0; n < m_vecActiveGridPatches.size(); n++) {
@@ -542,6 +824,7 @@ void Grid::ExchangeBuffersAndUnpack(
 	DataType eDataType,
 	int iDataIndex
 ) {
+	ProfilerRegion region("Exchange");
 
 	// Block parallel exchanges
 	if (m_fBlockParallelExchange) {
@@ -549,11 +832,14 @@ void Grid::ExchangeBuffersAndUnpack(
 	}
 
 	// Verify all processors are prepared to exchange
+	Profiler::Begin("Barrier");
 	MPI_Barrier(MPI_COMM_WORLD);
+	Profiler::End();
 
 	// Set up asynchronous recvs
 	for (int n = 0; n < m_vecActiveGridPatches.size(); n++) {
-		m_vecActiveGridPatches[n]->PrepareExchange();
+		m_vecActiveGridPatches[n]->PrepareExchange(
+			ExchangePrecision_Double, eDataType);
 	}
 
 	// Send data
@@ -702,6 +988,7 @@ void Grid::ConsolidateDataAtRoot(
 	DataType & eRecvDataType,
 	DataLocation & eRecvDataLocation
 ) const {
+	ProfilerRegion region("Consolidate");
 
 	// Get process id
 	int nRank;
@@ -761,7 +1048,8 @@ void Grid::ConsolidateDataAtRoot(
 void Grid::ConsolidateDataToRoot(
 	ConsolidationStatus & status
 ) const {
-	
+	ProfilerRegion region("Consolidate");
+
 	// Get process id
 	int nRank;
 	MPI_Comm_rank(MPI_COMM_WORLD, &nRank);
@@ -1039,113 +1327,176 @@ void Grid::ReduceInterpolate(
 		_EXCEPTIONT("Inconsistency in vector lengths.");
 	}
 
+	// Compute a temporary interpolation stencil
+	InterpolationStencil stencil;
+
+	ComputeInterpolationStencil(dAlpha, dBeta, iPatch, stencil);
+
+	ReduceInterpolate(
+		stencil,
+		eDataType,
+		eDataLocation,
+		dInterpData,
+		fIncludeReferenceState,
+		fConvertToPrimitive);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Grid::ReduceInterpolate(
+	const InterpolationStencil & stencil,
+	DataType eDataType,
+	DataLocation eDataLocation,
+	DataMatrix3D<double> & dInterpData,
+	bool fIncludeReferenceState,
+	bool fConvertToPrimitive
+) const {
 	if ((eDataType == DataType_Tracers) &&
 		(m_model.GetEquationSet().GetTracers() == 0)
 	) {
 		_EXCEPTIONT("Unable to Interpolate with no tracers.");
 	}
 	
-	// Check interpolation data array size
-	if ((eDataType == DataType_State) &&
-		(dInterpData.GetRows() != m_model.GetEquationSet().GetComponents())
-	) {
-		_EXCEPTIONT("InterpData dimension mismatch (0)");
+	// Number of variables and levels in the interpolated data
+	int nVariables = 1;
+	if (eDataType == DataType_State) {
+		nVariables = m_model.GetEquationSet().GetComponents();
+	} else if (eDataType == DataType_Tracers) {
+		nVariables = m_model.GetEquationSet().GetTracers();
 	}
 
-	if ((eDataType == DataType_Tracers) &&
-		(dInterpData.GetRows() != m_model.GetEquationSet().GetTracers())
-	) {
-		_EXCEPTIONT("InterpData dimension mismatch (0)");
+	int nLevels = 1;
+	if (eDataLocation == DataLocation_Node) {
+		nLevels = GetRElements();
+	} else if (eDataLocation == DataLocation_REdge) {
+		nLevels = GetRElements() + 1;
 	}
 
-	if ((eDataType == DataType_Topography) &&
-		(dInterpData.GetRows() != 1)
-	) {
-		_EXCEPTIONT("InterpData dimension mismatch (0)");
-	}
+	// Determine processor rank and number of processors
+	int nRank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &nRank);
 
-	if ((eDataType == DataType_Vorticity) &&
-		(dInterpData.GetRows() != 1)
-	) {
-		_EXCEPTIONT("InterpData dimension mismatch (0)");
-	}
+	int nSize;
+	MPI_Comm_size(MPI_COMM_WORLD, &nSize);
 
-	if ((eDataType == DataType_Divergence) &&
-		(dInterpData.GetRows() != 1)
-	) {
-		_EXCEPTIONT("InterpData dimension mismatch (0)");
+	// Interpolated data is only needed on root
+	if (nRank == 0) {
+		if (dInterpData.GetRows() != nVariables) {
+			_EXCEPTIONT("InterpData dimension mismatch (0)");
+		}
+		if (dInterpData.GetColumns() != nLevels) {
+			_EXCEPTIONT("InterpData dimension mismatch (1)");
+		}
+		if (dInterpData.GetSubColumns() != stencil.GetTotalPoints()) {
+			_EXCEPTIONT("InterpData dimension mismatch (2)");
+		}
 	}
 
-	if ((eDataType == DataType_Temperature) &&
-		(dInterpData.GetRows() != 1)
-	) {
-		_EXCEPTIONT("InterpData dimension mismatch (0)");
-	}
+	// Apply the stencil on points owned by this processor
+	int nLocalPoints = stencil.GetLocalPoints();
 
-	if ((eDataLocation == DataLocation_None) &&
-		(dInterpData.GetColumns() != 1)
-	) {
-		_EXCEPTIONT("InterpData dimension mismatch (1)");
-	}
+	DataMatrix3D<double> dLocalInterpData;
 
-	if ((eDataLocation == DataLocation_Node) &&
-		(dInterpData.GetColumns() != GetRElements())
-	) {
-		_EXCEPTIONT("InterpData dimension mismatch (1)");
+	double * pLocalInterpData = NULL;
+	int * pLocalPointIndex = NULL;
+
+	if (nLocalPoints != 0) {
+		dLocalInterpData.Initialize(nVariables, nLevels, nLocalPoints);
+
+		for (int n = 0; n < m_vecActiveGridPatches.size(); n++) {
+			m_vecActiveGridPatches[n]->ApplyInterpolationStencil(
+				stencil,
+				eDataType,
+				eDataLocation,
+				dLocalInterpData,
+				fIncludeReferenceState,
+				fConvertToPrimitive);
+		}
+
+		pLocalInterpData = &(dLocalInterpData[0][0][0]);
+		pLocalPointIndex = const_cast<int *>(&(stencil.m_ixPoint[0]));
 	}
 
-	if ((eDataLocation == DataLocation_REdge) &&
-		(dInterpData.GetColumns() != GetRElements() + 1)
-	) {
-		_EXCEPTIONT("InterpData dimension mismatch (1)");
+	// Gather the number of local points from each processor
+	DataVector<int> nRecvPoints;
+	DataVector<int> nRecvPointDispl;
+	DataVector<int> nRecvData;
+	DataVector<int> nRecvDataDispl;
+
+	if (nRank == 0) {
+		nRecvPoints.Initialize(nSize);
+		nRecvPointDispl.Initialize(nSize);
+		nRecvData.Initialize(nSize);
+		nRecvDataDispl.Initialize(nSize);
 	}
 
-	if (dInterpData.GetSubColumns() != dAlpha.GetRows()) {
-		_EXCEPTIONT("InterpData dimension mismatch (2)");
+	MPI_Gather(
+		&nLocalPoints,
+		1,
+		MPI_INT,
+		(nRank == 0)?(&(nRecvPoints[0])):(NULL),
+		1,
+		MPI_INT,
+		0,
+		MPI_COMM_WORLD);
+
+	int nTotalPoints = 0;
+	if (nRank == 0) {
+		for (int p = 0; p < nSize; p++) {
+			nRecvPointDispl[p] = nTotalPoints;
+			nRecvData[p] = nRecvPoints[p] * nVariables * nLevels;
+			nRecvDataDispl[p] = nTotalPoints * nVariables * nLevels;
+			nTotalPoints += nRecvPoints[p];
+		}
 	}
 
-	// Zero the interpolated data
-	dInterpData.Zero();
+	// Gather point indices and interpolated data at root
+	DataVector<int> ixRecvPoint;
+	DataVector<double> dRecvData;
 
-	// Interpolate state data
-	for (int n = 0; n < m_vecActiveGridPatches.size(); n++) {
-		m_vecActiveGridPatches[n]->InterpolateData(
-			dAlpha, dBeta, iPatch,
-			eDataType,
-			eDataLocation,
-			fInterpAllVariables,
-			dInterpData,
-			fIncludeReferenceState,
-			fConvertToPrimitive);
+	if ((nRank == 0) && (nTotalPoints != 0)) {
+		ixRecvPoint.Initialize(nTotalPoints);
+		dRecvData.Initialize(nTotalPoints * nVariables * nLevels, false);
 	}
 
-	// Perform an Reduce operation to combine all data
-	int nRank;
-	MPI_Comm_rank(MPI_COMM_WORLD, &nRank);
+	MPI_Gatherv(
+		pLocalPointIndex,
+		nLocalPoints,
+		MPI_INT,
+		(nTotalPoints != 0)?(&(ixRecvPoint[0])):(NULL),
+		(nRank == 0)?(&(nRecvPoints[0])):(NULL),
+		(nRank == 0)?(&(nRecvPointDispl[0])):(NULL),
+		MPI_INT,
+		0,
+		MPI_COMM_WORLD);
+
+	MPI_Gatherv(
+		pLocalInterpData,
+		nLocalPoints * nVariables * nLevels,
+		MPI_DOUBLE,
+		(nTotalPoints != 0)?(&(dRecvData[0])):(NULL),
+		(nRank == 0)?(&(nRecvData[0])):(NULL),
+		(nRank == 0)?(&(nRecvDataDispl[0])):(NULL),
+		MPI_DOUBLE,
+		0,
+		MPI_COMM_WORLD);
 
+	// Scatter received data into the full interpolated data array
 	if (nRank == 0) {
-		MPI_Reduce(
-			MPI_IN_PLACE,
-			&(dInterpData[0][0][0]),
-			dInterpData.GetRows()
-				* dInterpData.GetColumns()
-				* dInterpData.GetSubColumns(),
-			MPI_DOUBLE,
-			MPI_SUM,
-			0,
-			MPI_COMM_WORLD);
+		dInterpData.Zero();
 
-	} else {
-		MPI_Reduce(
-			&(dInterpData[0][0][0]),
-			NULL,
-			dInterpData.GetRows()
-				* dInterpData.GetColumns()
-				* dInterpData.GetSubColumns(),
-			MPI_DOUBLE,
-			MPI_SUM,
-			0,
-			MPI_COMM_WORLD);
+		for (int p = 0; p < nSize; p++) {
+			const int * ixPoint = &(ixRecvPoint[0]) + nRecvPointDispl[p];
+			const double * dData = &(dRecvData[0]) + nRecvDataDispl[p];
+
+			for (int c = 0; c < nVariables; c++) {
+			for (int k = 0; k < nLevels; k++) {
+				for (int i = 0; i < nRecvPoints[p]; i++) {
+					dInterpData[c][k][ixPoint[i]] = *(dData++);
+				}
+			}
+			}
+		}
 	}
 }
 
@@ -1549,6 +1900,19 @@ void Grid::FromFile(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+int Grid::GetDefaultPatchProcessors() const {
+	if (m_nDefaultPatchProcessors > 0) {
+		return m_nDefaultPatchProcessors;
+	}
+
+	int nCommSize;
+	MPI_Comm_size(MPI_COMM_WORLD, &nCommSize);
+
+	return nCommSize;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void Grid::DistributePatches() {
 
 	// Number of processors
@@ -19,6 +19,8 @@
 
 #include "GridPatch.h"
 #include "ChecksumType.h"
+#include "DiagnosticType.h"
+#include "ExchangePrecision.h"
 #include "MathHelper.h"
 
 #include "mpi.h"
@@ -26,6 +28,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <stdint.h>
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -39,6 +42,40 @@ class NcFile;
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Interface for work that depends on halo data.  During an exchange
+///		these methods are called as soon as halo data along a single edge
+///		or around an entire patch has been unpacked.
+///	</summary>
+class ExchangeListener {
+
+public:
+	///	<summary>
+	///		Virtual destructor.
+	///	</summary>
+	virtual ~ExchangeListener() { }
+
+public:
+	///	<summary>
+	///		Called after halo data from a single neighbor has been unpacked
+	///		into the given patch.
+	///	</summary>
+	virtual void OnNeighborReceived(
+		GridPatch * pPatch,
+		const ExteriorNeighbor * pNeighbor
+	) { }
+
+	///	<summary>
+	///		Called after halo data from all neighbors has been unpacked
+	///		into the given patch.
+	///	</summary>
+	virtual void OnPatchReceived(
+		GridPatch * pPatch
+	) { }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 ///	<summary>
 ///		Atmospheric model grid data.  Container for GridPatch objects.
 ///	</summary>
@@ -84,6 +121,44 @@ public:
 		m_fBlockParallelExchange = fBlockParallelExchange;
 	}
 
+	///	<summary>
+	///		Set the flag indicating that global sums in Checksum and the
+	///		diagnostics are computed reproducibly.  The partial sum of each
+	///		patch is accumulated exactly (see ReproducibleSum), so results
+	///		are bitwise identical for any number of processors and any
+	///		assignment of patches to processors, provided the patch layout
+	///		is fixed (see SetDefaultPatchProcessors).  The additional cost
+	///		is one exact accumulation per patch and value, and each
+	///		reduction exchanges 568 bytes per value instead of 8.
+	///	</summary>
+	void SetReproducibleReductions(bool fReproducibleReductions) {
+		m_fReproducibleReductions = fReproducibleReductions;
+	}
+
+	///	<summary>
+	///		Check if global sums are computed reproducibly.
+	///	</summary>
+	bool HasReproducibleReductions() const {
+		return m_fReproducibleReductions;
+	}
+
+	///	<summary>
+	///		Set the precision used to exchange halo data of the given
+	///		DataType between processors.
+	///	</summary>
+	void SetExchangePrecision(
+		DataType eDataType,
+		ExchangePrecision ePrecision
+	);
+
+	///	<summary>
+	///		Get the precision used to exchange halo data of the given
+	///		DataType between processors.
+	///	</summary>
+	ExchangePrecision GetExchangePrecision(
+		DataType eDataType
+	) const;
+
 public:
 	///	<summary>
 	///		Set the vertical stretching function.  Grid retains ownership
@@ -127,6 +202,13 @@ protected:
 		int iDataIndex = 0
 	);
 
+	///	<summary>
+	///		Locate the nodes where Rayleigh friction is active from the
+	///		Rayleigh strength on each active patch.  This must be called
+	///		whenever the Rayleigh strength is modified.
+	///	</summary>
+	void ComputeRayleighFrictionRuns();
+
 	///	<summary>
 	///		Initialize state and tracer data from a TestCase.
 	///	</summary>
@@ -173,28 +255,66 @@ public:
 	) const;
 
 	///	<summary>
-	///		Compute total energy on the grid.
+	///		Compute the checksum of each variable over the active patches
+	///		on this processor as a normalized ReproducibleSum accumulator.
+	///		The Linf checksum is not supported, since the maximum does not
+	///		depend on the order of evaluation.
 	///	</summary>
-	double ComputeTotalEnergy(
-		int iDataIndex
+	void ChecksumReproducibleLocal(
+		DataType eDataType,
+		std::vector<int64_t> & iChecksums,
+		int iDataIndex = 0,
+		ChecksumType eChecksumType = ChecksumType_Sum
 	) const;
 
 	///	<summary>
-	///		Compute total energy on the grid.
+	///		Compute local diagnostics (see DiagnosticType) in a single sweep
+	///		over the state and begin a non-blocking reduction over all
+	///		processors.  The prognostic state is not modified.
 	///	</summary>
-	double ComputeTotalPotentialEnstrophy(
+	void BeginComputeDiagnostics(
 		int iDataIndex
 	);
 
+	///	<summary>
+	///		Complete the reduction started by BeginComputeDiagnostics and
+	///		return the global diagnostics on all processors.
+	///	</summary>
+	void EndComputeDiagnostics(
+		DataVector<double> & dDiagnostics
+	);
+
 public:
 	///	<summary>
-	///		Exchange data between processors.
+	///		Exchange data between processors.  If a listener is provided
+	///		it is notified as halo data arrives from each neighbor.
 	///	</summary>
 	void Exchange(
+		DataType eDataType,
+		int iDataIndex,
+		ExchangeListener * pListener = NULL
+	);
+
+	///	<summary>
+	///		Post receives for halo data and pack and send data to each
+	///		neighbor.  Must be followed by a call to EndExchange; work
+	///		that does not depend on halo data may be performed in between.
+	///	</summary>
+	void BeginExchange(
 		DataType eDataType,
 		int iDataIndex
 	);
 
+	///	<summary>
+	///		Unpack halo data from each neighbor in the order in which it
+	///		arrives and wait for all sends to complete.
+	///	</summary>
+	void EndExchange(
+		DataType eDataType,
+		int iDataIndex,
+		ExchangeListener * pListener = NULL
+	);
+
 	///	<summary>
 	///		Exchange connectivity buffers between processors.
 	///	</summary>
@@ -325,7 +445,10 @@ public:
 
 	///	<summary>
 	///		Perform interpolation on a node array and send data to root
-	///		(generally used for serial output on reference grid)
+	///		(generally used for serial output on reference grid).  Each
+	///		processor only interpolates points on its own patches; the
+	///		result is gathered into dInterpData, which only needs to be
+	///		allocated on root.
 	///	</summary>
 	///	<param name="eDataLocation">
 	///		DataLocation_Node  = Interpolate all variables on nodes
@@ -343,6 +466,33 @@ public:
 		bool fConvertToPrimitive = true
 	) const;
 
+	///	<summary>
+	///		Compute the interpolation stencil for the points on patches
+	///		owned by this processor.  The stencil remains valid until the
+	///		grid is redistributed (see GetGridStamp).
+	///	</summary>
+	virtual void ComputeInterpolationStencil(
+		const DataVector<double> & dAlpha,
+		const DataVector<double> & dBeta,
+		const DataVector<int> & iPatch,
+		InterpolationStencil & stencil
+	) const {
+		_EXCEPTIONT("Not implemented");
+	}
+
+	///	<summary>
+	///		Perform interpolation with a precomputed stencil and send data
+	///		to root.  dInterpData only needs to be allocated on root.
+	///	</summary>
+	void ReduceInterpolate(
+		const InterpolationStencil & stencil,
+		DataType eDataType,
+		DataLocation eDataLocation,
+		DataMatrix3D<double> & dInterpData,
+		bool fIncludeReferenceState = true,
+		bool fConvertToPrimitive = true
+	) const;
+
 	///	<summary>
 	///		Convert an array of coordinate variables to coordinates on the
 	///		reference grid (RLL on the sphere, Cartesian on the plane).
@@ -385,6 +535,22 @@ public:
 	}
 
 public:
+	///	<summary>
+	///		Set the number of processors for which the default set of
+	///		patches is laid out.  By default this is the number of
+	///		processors in the run; a different value reproduces the patch
+	///		layout of a run with a different number of processors.
+	///	</summary>
+	void SetDefaultPatchProcessors(int nDefaultPatchProcessors) {
+		m_nDefaultPatchProcessors = nDefaultPatchProcessors;
+	}
+
+	///	<summary>
+	///		Get the number of processors for which the default set of
+	///		patches is laid out.
+	///	</summary>
+	int GetDefaultPatchProcessors() const;
+
 	///	<summary>
 	///		Add the default set of patches.
 	///	</summary>
@@ -749,6 +915,22 @@ protected:
 	///	</summary>
 	bool m_fBlockParallelExchange;
 
+	///	<summary>
+	///		Compute global sums reproducibly.
+	///	</summary>
+	bool m_fReproducibleReductions;
+
+	///	<summary>
+	///		Number of processors for which the default set of patches is
+	///		laid out (or zero to use the number of processors in the run).
+	///	</summary>
+	int m_nDefaultPatchProcessors;
+
+	///	<summary>
+	///		Precision used to exchange halo data of each DataType.
+	///	</summary>
+	std::vector<ExchangePrecision> m_vecExchangePrecision;
+
 	///	<summary>
 	///		Grid stamp.  This value is incremented whenever the grid changes.
 	///	</summary>
@@ -872,6 +1054,54 @@ private:
 	///		Vector of grid patches.
 	///	</summary>
 	GridPatchVector m_vecGridPatches;
+
+private:
+	///	<summary>
+	///		Outstanding receive requests used by EndExchange.
+	///	</summary>
+	std::vector<MPI_Request> m_vecExchangeRequests;
+
+	///	<summary>
+	///		Neighbors associated with each outstanding receive request.
+	///	</summary>
+	std::vector<ExteriorNeighbor *> m_vecExchangeNeighbors;
+
+	///	<summary>
+	///		Active patch index associated with each outstanding receive
+	///		request.
+	///	</summary>
+	std::vector<int> m_vecExchangePatchIndex;
+
+	///	<summary>
+	///		Indices of completed receive requests returned by MPI_Waitsome.
+	///	</summary>
+	std::vector<int> m_vecExchangeCompleted;
+
+private:
+	///	<summary>
+	///		Local diagnostics on this processor.
+	///	</summary>
+	DataVector<double> m_dDiagnosticsLocal;
+
+	///	<summary>
+	///		Global diagnostics, available once the reduction completes.
+	///	</summary>
+	DataVector<double> m_dDiagnosticsGlobal;
+
+	///	<summary>
+	///		Local diagnostics as ReproducibleSum accumulators.
+	///	</summary>
+	std::vector<int64_t> m_iDiagnosticsLocal;
+
+	///	<summary>
+	///		Global diagnostics as ReproducibleSum accumulators.
+	///	</summary>
+	std::vector<int64_t> m_iDiagnosticsGlobal;
+
+	///	<summary>
+	///		Request for the outstanding diagnostics reduction.
+	///	</summary>
+	MPI_Request m_reqDiagnostics;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -82,7 +82,8 @@ void GridCSGLL::AddDefaultPatches() {
 	int nCommSize;
 	MPI_Comm_size(MPI_COMM_WORLD, &nCommSize);
 
-	int nProcsPerDirection = Max((int)ISqrt(nCommSize / 6), 1);
+	int nProcsPerDirection =
+		Max((int)ISqrt(GetDefaultPatchProcessors() / 6), 1);
 
 	int nProcsPerPanel = nProcsPerDirection * nProcsPerDirection;
 
@@ -395,205 +396,199 @@ void GridCSGLL::GetOpposingDirection(
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void GridCSGLL::ApplyDSS(
+void GridCSGLL::ApplyPatchDSS(
+	GridPatch * pGridPatch,
 	int iDataUpdate,
 	DataType eDataType
 ) {
-	// Exchange data between nodes
-	Exchange(eDataType, iDataUpdate);
+	GridPatchCSGLL * pPatch =
+		dynamic_cast<GridPatchCSGLL*>(pGridPatch);
 
-	// Post-process velocities across panel edges and
-	// perform direct stiffness summation (DSS)
-	for (int n = 0; n < GetActivePatchCount(); n++) {
-		GridPatchCSGLL * pPatch =
-			dynamic_cast<GridPatchCSGLL*>(GetActivePatch(n));
-
-		const PatchBox & box = pPatch->GetPatchBox();
+	const PatchBox & box = pPatch->GetPatchBox();
         
         // Patch-specific quantities
-		int nElementCountA = pPatch->GetElementCountA();
-		int nElementCountB = pPatch->GetElementCountB();
+	int nElementCountA = pPatch->GetElementCountA();
+	int nElementCountB = pPatch->GetElementCountB();
         
-		// Apply panel transforms to velocity data
-		if (eDataType == DataType_State) {
-			pPatch->TransformHaloVelocities(iDataUpdate);
-		}
-		if (eDataType == DataType_TopographyDeriv) {
-			pPatch->TransformTopographyDeriv();
+	// Apply panel transforms to velocity data
+	if (eDataType == DataType_State) {
+		pPatch->TransformHaloVelocities(iDataUpdate);
+	}
+	if (eDataType == DataType_TopographyDeriv) {
+		pPatch->TransformTopographyDeriv();
 
-			const GridData3D & dataTopographyDeriv =
-				pPatch->GetTopographyDeriv();
-		}
+		const GridData3D & dataTopographyDeriv =
+			pPatch->GetTopographyDeriv();
+	}
+
+	// Panels in each coordinate direction
+	int ixRightPanel =
+		pPatch->GetNeighborPanel(Direction_Right);
+	int ixTopPanel =
+		pPatch->GetNeighborPanel(Direction_Top);
+	int ixLeftPanel =
+		pPatch->GetNeighborPanel(Direction_Left);
+	int ixBottomPanel =
+		pPatch->GetNeighborPanel(Direction_Bottom);
+
+	int ixTopRightPanel =
+		pPatch->GetNeighborPanel(Direction_TopRight);
+	int ixTopLeftPanel =
+		pPatch->GetNeighborPanel(Direction_TopLeft);
+	int ixBottomLeftPanel =
+		pPatch->GetNeighborPanel(Direction_BottomLeft);
+	int ixBottomRightPanel =
+		pPatch->GetNeighborPanel(Direction_BottomRight);
+
+	// Loop through all components associated with this DataType
+	int nComponents;
+	if (eDataType == DataType_State) {
+		nComponents = m_model.GetEquationSet().GetComponents();
+	} else if (eDataType == DataType_Tracers) {
+		nComponents = m_model.GetEquationSet().GetTracers();
+	} else if (eDataType == DataType_Vorticity) {
+		nComponents = 1;
+	} else if (eDataType == DataType_Divergence) {
+		nComponents = 1;
+	} else if (eDataType == DataType_TopographyDeriv) {
+		nComponents = 1;
+	} else {
+		_EXCEPTIONT("Invalid DataType");
+	}
 
-		// Panels in each coordinate direction
-		int ixRightPanel =
-			pPatch->GetNeighborPanel(Direction_Right);
-		int ixTopPanel =
-			pPatch->GetNeighborPanel(Direction_Top);
-		int ixLeftPanel =
-			pPatch->GetNeighborPanel(Direction_Left);
-		int ixBottomPanel =
-			pPatch->GetNeighborPanel(Direction_Bottom);
-
-		int ixTopRightPanel =
-			pPatch->GetNeighborPanel(Direction_TopRight);
-		int ixTopLeftPanel =
-			pPatch->GetNeighborPanel(Direction_TopLeft);
-		int ixBottomLeftPanel =
-			pPatch->GetNeighborPanel(Direction_BottomLeft);
-		int ixBottomRightPanel =
-			pPatch->GetNeighborPanel(Direction_BottomRight);
-
-		// Loop through all components associated with this DataType
-		int nComponents;
+	// Perform Direct Stiffness Summation (DSS)
+	for (int c = 0; c < nComponents; c++) {
+
+		// Obtain the array of working data
+		int nRElements = GetRElements();
+		double *** pDataUpdate;
 		if (eDataType == DataType_State) {
-			nComponents = m_model.GetEquationSet().GetComponents();
+			pDataUpdate =
+				pPatch->GetDataState(iDataUpdate, GetVarLocation(c))[c];
+
+			if (GetVarLocation(c) == DataLocation_REdge) {
+				nRElements++;
+			}
+
 		} else if (eDataType == DataType_Tracers) {
-			nComponents = m_model.GetEquationSet().GetTracers();
+			pDataUpdate =
+				pPatch->GetDataTracers(iDataUpdate)[c];
 		} else if (eDataType == DataType_Vorticity) {
-			nComponents = 1;
+			pDataUpdate = pPatch->GetDataVorticity();
 		} else if (eDataType == DataType_Divergence) {
-			nComponents = 1;
+			pDataUpdate = pPatch->GetDataDivergence();
 		} else if (eDataType == DataType_TopographyDeriv) {
-			nComponents = 1;
-		} else {
-			_EXCEPTIONT("Invalid DataType");
+			pDataUpdate = pPatch->GetTopographyDeriv();
+
+			nRElements = 2;
 		}
 
-		// Perform Direct Stiffness Summation (DSS)
-		for (int c = 0; c < nComponents; c++) {
+		for (int k = 0; k < nRElements; k++) {
+
+			// Average in the alpha direction
+			for (int a = 0; a <= nElementCountA; a++) {
+				int iA = a * m_nHorizontalOrder + box.GetHaloElements();
 
-			// Obtain the array of working data
-			int nRElements = GetRElements();
-			double *** pDataUpdate;
-			if (eDataType == DataType_State) {
-				pDataUpdate =
-					pPatch->GetDataState(iDataUpdate, GetVarLocation(c))[c];
+				// Do not average across cubed-sphere corners
+				int jBegin = box.GetBInteriorBegin()-1;
+				int jEnd = box.GetBInteriorEnd()+1;
 
-				if (GetVarLocation(c) == DataLocation_REdge) {
-					nRElements++;
+				if (((a == 0) &&
+						(ixTopLeftPanel == InvalidPanel)) ||
+					((a == nElementCountA) &&
+						(ixTopRightPanel == InvalidPanel))
+				) {
+					jEnd -= 2;
+				}
+				if (((a == 0) &&
+						(ixBottomLeftPanel == InvalidPanel)) ||
+					((a == nElementCountA) &&
+						(ixBottomRightPanel == InvalidPanel))
+				) {
+					jBegin += 2;
 				}
 
-			} else if (eDataType == DataType_Tracers) {
-				pDataUpdate =
-					pPatch->GetDataTracers(iDataUpdate)[c];
-			} else if (eDataType == DataType_Vorticity) {
-				pDataUpdate = pPatch->GetDataVorticity();
-			} else if (eDataType == DataType_Divergence) {
-				pDataUpdate = pPatch->GetDataDivergence();
-			} else if (eDataType == DataType_TopographyDeriv) {
-				pDataUpdate = pPatch->GetTopographyDeriv();
-
-				nRElements = 2;
-			}
+				// Perform averaging across edge
+				for (int j = jBegin; j < jEnd; j++) {
+					pDataUpdate[k][iA][j] = 0.5 * (
+						+ pDataUpdate[k][iA  ][j]
+						+ pDataUpdate[k][iA-1][j]);
 
-			for (int k = 0; k < nRElements; k++) {
-
-				// Average in the alpha direction
-				for (int a = 0; a <= nElementCountA; a++) {
-					int iA = a * m_nHorizontalOrder + box.GetHaloElements();
-
-					// Do not average across cubed-sphere corners
-					int jBegin = box.GetBInteriorBegin()-1;
-					int jEnd = box.GetBInteriorEnd()+1;
-
-					if (((a == 0) &&
-							(ixTopLeftPanel == InvalidPanel)) ||
-						((a == nElementCountA) &&
-							(ixTopRightPanel == InvalidPanel))
-					) {
-						jEnd -= 2;
-					}
-					if (((a == 0) &&
-							(ixBottomLeftPanel == InvalidPanel)) ||
-						((a == nElementCountA) &&
-							(ixBottomRightPanel == InvalidPanel))
-					) {
-						jBegin += 2;
-					}
-
-					// Perform averaging across edge
-					for (int j = jBegin; j < jEnd; j++) {
-						pDataUpdate[k][iA][j] = 0.5 * (
-							+ pDataUpdate[k][iA  ][j]
-							+ pDataUpdate[k][iA-1][j]);
-
-						pDataUpdate[k][iA-1][j] = pDataUpdate[k][iA][j];
-					}
+					pDataUpdate[k][iA-1][j] = pDataUpdate[k][iA][j];
 				}
+			}
 
-				// Average in the beta direction
-				for (int b = 0; b <= nElementCountB; b++) {
-					int iB = b * m_nHorizontalOrder + box.GetHaloElements();
-
-					// Do not average across cubed-sphere corners
-					int iBegin = box.GetAInteriorBegin()-1;
-					int iEnd = box.GetAInteriorEnd()+1;
-
-					if (((b == 0) &&
-							(ixBottomLeftPanel == InvalidPanel)) ||
-						((b == nElementCountA) &&
-							(ixTopLeftPanel == InvalidPanel))
-					) {
-						iBegin += 2;
-					}
-					if (((b == 0) &&
-							(ixBottomRightPanel == InvalidPanel)) ||
-						((b == nElementCountA) &&
-							(ixTopRightPanel == InvalidPanel))
-					) {
-						iEnd -= 2;
-					}
-
-					for (int i = iBegin; i < iEnd; i++) {
-						pDataUpdate[k][i][iB] = 0.5 * (
-							+ pDataUpdate[k][i][iB  ]
-							+ pDataUpdate[k][i][iB-1]);
-
-						pDataUpdate[k][i][iB-1] = pDataUpdate[k][i][iB];
-					}
-				}
+			// Average in the beta direction
+			for (int b = 0; b <= nElementCountB; b++) {
+				int iB = b * m_nHorizontalOrder + box.GetHaloElements();
 
-				// Average at cubed-sphere corners (nodes of connectivity 3)
-				if (ixTopRightPanel == InvalidPanel) {
-					int iA = box.GetAInteriorEnd()-1;
-					int iB = box.GetBInteriorEnd()-1;
+				// Do not average across cubed-sphere corners
+				int iBegin = box.GetAInteriorBegin()-1;
+				int iEnd = box.GetAInteriorEnd()+1;
 
-					pDataUpdate[k][iA][iB] = (1.0/3.0) * (
-						+ pDataUpdate[k][iA  ][iB  ]
-						+ pDataUpdate[k][iA+1][iB  ]
-						+ pDataUpdate[k][iA  ][iB+1]);
+				if (((b == 0) &&
+						(ixBottomLeftPanel == InvalidPanel)) ||
+					((b == nElementCountA) &&
+						(ixTopLeftPanel == InvalidPanel))
+				) {
+					iBegin += 2;
+				}
+				if (((b == 0) &&
+						(ixBottomRightPanel == InvalidPanel)) ||
+					((b == nElementCountA) &&
+						(ixTopRightPanel == InvalidPanel))
+				) {
+					iEnd -= 2;
 				}
 
-				if (ixTopLeftPanel == InvalidPanel) {
-					int iA = box.GetAInteriorBegin();
-					int iB = box.GetBInteriorEnd()-1;
+				for (int i = iBegin; i < iEnd; i++) {
+					pDataUpdate[k][i][iB] = 0.5 * (
+						+ pDataUpdate[k][i][iB  ]
+						+ pDataUpdate[k][i][iB-1]);
 
-					pDataUpdate[k][iA][iB] = (1.0/3.0) * (
-						+ pDataUpdate[k][iA  ][iB  ]
-						+ pDataUpdate[k][iA-1][iB  ]
-						+ pDataUpdate[k][iA  ][iB+1]);
+					pDataUpdate[k][i][iB-1] = pDataUpdate[k][i][iB];
 				}
+			}
 
-				if (ixBottomLeftPanel == InvalidPanel) {
-					int iA = box.GetAInteriorBegin();
-					int iB = box.GetBInteriorBegin();
+			// Average at cubed-sphere corners (nodes of connectivity 3)
+			if (ixTopRightPanel == InvalidPanel) {
+				int iA = box.GetAInteriorEnd()-1;
+				int iB = box.GetBInteriorEnd()-1;
 
-					pDataUpdate[k][iA][iB] = (1.0/3.0) * (
-						+ pDataUpdate[k][iA  ][iB  ]
-						+ pDataUpdate[k][iA-1][iB  ]
-						+ pDataUpdate[k][iA  ][iB-1]);
-				}
+				pDataUpdate[k][iA][iB] = (1.0/3.0) * (
+					+ pDataUpdate[k][iA  ][iB  ]
+					+ pDataUpdate[k][iA+1][iB  ]
+					+ pDataUpdate[k][iA  ][iB+1]);
+			}
 
-				if (ixBottomRightPanel == InvalidPanel) {
-					int iA = box.GetAInteriorEnd()-1;
-					int iB = box.GetBInteriorBegin();
+			if (ixTopLeftPanel == InvalidPanel) {
+				int iA = box.GetAInteriorBegin();
+				int iB = box.GetBInteriorEnd()-1;
 
-					pDataUpdate[k][iA][iB] = (1.0/3.0) * (
-						+ pDataUpdate[k][iA  ][iB  ]
-						+ pDataUpdate[k][iA+1][iB  ]
-						+ pDataUpdate[k][iA  ][iB-1]);
-				}
+				pDataUpdate[k][iA][iB] = (1.0/3.0) * (
+					+ pDataUpdate[k][iA  ][iB  ]
+					+ pDataUpdate[k][iA-1][iB  ]
+					+ pDataUpdate[k][iA  ][iB+1]);
+			}
+
+			if (ixBottomLeftPanel == InvalidPanel) {
+				int iA = box.GetAInteriorBegin();
+				int iB = box.GetBInteriorBegin();
+
+				pDataUpdate[k][iA][iB] = (1.0/3.0) * (
+					+ pDataUpdate[k][iA  ][iB  ]
+					+ pDataUpdate[k][iA-1][iB  ]
+					+ pDataUpdate[k][iA  ][iB-1]);
+			}
+
+			if (ixBottomRightPanel == InvalidPanel) {
+				int iA = box.GetAInteriorEnd()-1;
+				int iB = box.GetBInteriorBegin();
+
+				pDataUpdate[k][iA][iB] = (1.0/3.0) * (
+					+ pDataUpdate[k][iA  ][iB  ]
+					+ pDataUpdate[k][iA+1][iB  ]
+					+ pDataUpdate[k][iA  ][iB-1]);
 			}
 		}
 	}
@@ -99,10 +99,7 @@ void GridCartesianGLL::AddDefaultPatches() {
 	}
 
 	// Determine number of usable processors
-	int nCommSize;
-	MPI_Comm_size(MPI_COMM_WORLD, &nCommSize);
-
-	int nProcsPerDirection = nCommSize;
+	int nProcsPerDirection = GetDefaultPatchProcessors();
 
 	int nDistributedPatches = nProcsPerDirection;
 
@@ -363,112 +360,106 @@ void GridCartesianGLL::GetOpposingDirection(
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void GridCartesianGLL::ApplyDSS(
+void GridCartesianGLL::ApplyPatchDSS(
+	GridPatch * pGridPatch,
 	int iDataUpdate,
 	DataType eDataType
 ) {
-	// Exchange data between nodes
-	Exchange(eDataType, iDataUpdate);
+	GridPatchCartesianGLL * pPatch =
+		dynamic_cast<GridPatchCartesianGLL*>(pGridPatch);
 
-	// Post-process velocities across panel edges and
-	// perform direct stiffness summation (DSS)
-	for (int n = 0; n < GetActivePatchCount(); n++) {
-		GridPatchCartesianGLL * pPatch =
-			dynamic_cast<GridPatchCartesianGLL*>(GetActivePatch(n));
+	const PatchBox & box = pPatch->GetPatchBox();
 
-		const PatchBox & box = pPatch->GetPatchBox();
+	// Patch-specific quantities
+	int nElementCountA = pPatch->GetElementCountA();
+	int nElementCountB = pPatch->GetElementCountB();
 
-		// Patch-specific quantities
-		int nElementCountA = pPatch->GetElementCountA();
-		int nElementCountB = pPatch->GetElementCountB();
+	// Apply panel transforms to velocity data
+	if (eDataType == DataType_State) {
+		pPatch->TransformHaloVelocities(iDataUpdate);
+	}
+	if (eDataType == DataType_TopographyDeriv) {
+		pPatch->TransformTopographyDeriv();
+	}
 
-		// Apply panel transforms to velocity data
-		if (eDataType == DataType_State) {
-			pPatch->TransformHaloVelocities(iDataUpdate);
-		}
-		if (eDataType == DataType_TopographyDeriv) {
-			pPatch->TransformTopographyDeriv();
-		}
+	// Loop through all components associated with this DataType
+	int nComponents;
+	if (eDataType == DataType_State) {
+		nComponents = m_model.GetEquationSet().GetComponents();
+	} else if (eDataType == DataType_Tracers) {
+		nComponents = m_model.GetEquationSet().GetTracers();
+	} else if (eDataType == DataType_Vorticity) {
+		nComponents = 1;
+	} else if (eDataType == DataType_Divergence) {
+		nComponents = 1;
+	} else if (eDataType == DataType_TopographyDeriv) {
+		nComponents = 2;
+	} else {
+		_EXCEPTIONT("Invalid DataType");
+	}
+
+	// Perform Direct Stiffness Summation (DSS)
+	for (int c = 0; c < nComponents; c++) {
 
-		// Loop through all components associated with this DataType
-		int nComponents;
+		// Obtain the array of working data
+		int nRElements = GetRElements();
+		double *** pDataUpdate;
 		if (eDataType == DataType_State) {
-			nComponents = m_model.GetEquationSet().GetComponents();
+			pDataUpdate =
+				pPatch->GetDataState(iDataUpdate, GetVarLocation(c))[c];
+
+			if (GetVarLocation(c) == DataLocation_REdge) {
+				nRElements++;
+			}
+
 		} else if (eDataType == DataType_Tracers) {
-			nComponents = m_model.GetEquationSet().GetTracers();
+			pDataUpdate =
+				pPatch->GetDataTracers(iDataUpdate)[c];
 		} else if (eDataType == DataType_Vorticity) {
-			nComponents = 1;
+			pDataUpdate = pPatch->GetDataVorticity();
 		} else if (eDataType == DataType_Divergence) {
-			nComponents = 1;
+			pDataUpdate = pPatch->GetDataDivergence();
 		} else if (eDataType == DataType_TopographyDeriv) {
-			nComponents = 2;
-		} else {
-			_EXCEPTIONT("Invalid DataType");
-		}
-
-		// Perform Direct Stiffness Summation (DSS)
-		for (int c = 0; c < nComponents; c++) {
+			pDataUpdate = pPatch->GetTopographyDeriv();
 
-			// Obtain the array of working data
-			int nRElements = GetRElements();
-			double *** pDataUpdate;
-			if (eDataType == DataType_State) {
-				pDataUpdate =
-					pPatch->GetDataState(iDataUpdate, GetVarLocation(c))[c];
-
-				if (GetVarLocation(c) == DataLocation_REdge) {
-					nRElements++;
-				}
-
-			} else if (eDataType == DataType_Tracers) {
-				pDataUpdate =
-					pPatch->GetDataTracers(iDataUpdate)[c];
-			} else if (eDataType == DataType_Vorticity) {
-				pDataUpdate = pPatch->GetDataVorticity();
-			} else if (eDataType == DataType_Divergence) {
-				pDataUpdate = pPatch->GetDataDivergence();
-			} else if (eDataType == DataType_TopographyDeriv) {
-				pDataUpdate = pPatch->GetTopographyDeriv();
-
-				nRElements = 2;
-			}
+			nRElements = 2;
+		}
 
-			// Averaging DSS across patch boundaries
-			for (int k = 0; k < nRElements; k++) {
+		// Averaging DSS across patch boundaries
+		for (int k = 0; k < nRElements; k++) {
 
-				// Average in the alpha direction
-				for (int a = 0; a <= nElementCountA; a++) {
-					int iA = a * m_nHorizontalOrder + box.GetHaloElements();
+			// Average in the alpha direction
+			for (int a = 0; a <= nElementCountA; a++) {
+				int iA = a * m_nHorizontalOrder + box.GetHaloElements();
 
-					// Averaging done at the corners of the panel
-					int jBegin = box.GetBInteriorBegin()-1;
-					int jEnd = box.GetBInteriorEnd()+1;
+				// Averaging done at the corners of the panel
+				int jBegin = box.GetBInteriorBegin()-1;
+				int jEnd = box.GetBInteriorEnd()+1;
 
-					// Perform averaging across edge of patch
-					for (int j = jBegin; j < jEnd; j++) {
-						pDataUpdate[k][iA][j] = 0.5 * (
-							+ pDataUpdate[k][iA  ][j]
-							+ pDataUpdate[k][iA-1][j]);
+				// Perform averaging across edge of patch
+				for (int j = jBegin; j < jEnd; j++) {
+					pDataUpdate[k][iA][j] = 0.5 * (
+						+ pDataUpdate[k][iA  ][j]
+						+ pDataUpdate[k][iA-1][j]);
 
-						pDataUpdate[k][iA-1][j] = pDataUpdate[k][iA][j];
-					}
+					pDataUpdate[k][iA-1][j] = pDataUpdate[k][iA][j];
 				}
+			}
 
-				// Average in the beta direction
-				for (int b = 0; b <= nElementCountB; b++) {
-					int iB = b * m_nHorizontalOrder + box.GetHaloElements();
+			// Average in the beta direction
+			for (int b = 0; b <= nElementCountB; b++) {
+				int iB = b * m_nHorizontalOrder + box.GetHaloElements();
 
-					// Averaging done at the corners of the panel
-					int iBegin = box.GetAInteriorBegin()-1;
-					int iEnd = box.GetAInteriorEnd()+1;
+				// Averaging done at the corners of the panel
+				int iBegin = box.GetAInteriorBegin()-1;
+				int iEnd = box.GetAInteriorEnd()+1;
 
-					for (int i = iBegin; i < iEnd; i++) {
-						pDataUpdate[k][i][iB] = 0.5 * (
-							+ pDataUpdate[k][i][iB  ]
-							+ pDataUpdate[k][i][iB-1]);
+				for (int i = iBegin; i < iEnd; i++) {
+					pDataUpdate[k][i][iB] = 0.5 * (
+						+ pDataUpdate[k][i][iB  ]
+						+ pDataUpdate[k][i][iB-1]);
 
-						pDataUpdate[k][i][iB-1] = pDataUpdate[k][i][iB];
-					}
+					pDataUpdate[k][i][iB-1] = pDataUpdate[k][i][iB];
 				}
 			}
 		}
@@ -114,11 +114,13 @@ public:
 	);
 
 	///	<summary>
-	///		Apply the direct stiffness summation (DSS) operation on the grid.
+	///		Apply the direct stiffness summation (DSS) operation on a single
+	///		patch whose halo data is up to date.
 	///	</summary>
-	virtual void ApplyDSS(
+	virtual void ApplyPatchDSS(
+		GridPatch * pPatch,
 		int iDataUpdate,
-		DataType eDataType = DataType_State
+		DataType eDataType
 	);
 	
 private:
@@ -22,6 +22,7 @@
 #include "FluxCorrectionFunction.h"
 #include "PolynomialInterp.h"
 #include "GaussLobattoQuadrature.h"
+#include "Profiler.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -513,6 +514,70 @@ void GridGLL::PostProcessSubstage(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		ExchangeListener which applies direct stiffness summation to each
+///		patch as soon as its halo data has been received.
+///	</summary>
+class DSSExchangeListener : public ExchangeListener {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	DSSExchangeListener(
+		GridGLL & grid,
+		int iDataUpdate,
+		DataType eDataType
+	) :
+		m_grid(grid),
+		m_iDataUpdate(iDataUpdate),
+		m_eDataType(eDataType)
+	{ }
+
+public:
+	///	<summary>
+	///		Apply DSS to the patch.
+	///	</summary>
+	virtual void OnPatchReceived(
+		GridPatch * pPatch
+	) {
+		m_grid.ApplyPatchDSS(pPatch, m_iDataUpdate, m_eDataType);
+	}
+
+private:
+	///	<summary>
+	///		Grid on which DSS is applied.
+	///	</summary>
+	GridGLL & m_grid;
+
+	///	<summary>
+	///		Data index being updated.
+	///	</summary>
+	int m_iDataUpdate;
+
+	///	<summary>
+	///		DataType being updated.
+	///	</summary>
+	DataType m_eDataType;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+void GridGLL::ApplyDSS(
+	int iDataUpdate,
+	DataType eDataType
+) {
+	ProfilerRegion region("DSS");
+
+	// Exchange data between nodes and perform direct stiffness summation
+	// on each patch as soon as its halo is complete
+	DSSExchangeListener listener(*this, iDataUpdate, eDataType);
+
+	Exchange(eDataType, iDataUpdate, &listener);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void GridGLL::ComputeVorticityDivergence(
 	int iDataIndex
 ) {
@@ -532,6 +597,76 @@ void GridGLL::ComputeVorticityDivergence(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void GridGLL::ComputeInterpolationStencil(
+	const DataVector<double> & dAlpha,
+	const DataVector<double> & dBeta,
+	const DataVector<int> & iPatch,
+	InterpolationStencil & stencil
+) const {
+	if ((dAlpha.GetRows() != dBeta.GetRows()) ||
+		(dAlpha.GetRows() != iPatch.GetRows())
+	) {
+		_EXCEPTIONT("Inconsistency in vector lengths.");
+	}
+
+	// Count the points that lie on patches owned by this processor
+	DataVector<int> fPatchIsActive;
+	fPatchIsActive.Initialize(GetPatchCount());
+
+	for (int n = 0; n < GetActivePatchCount(); n++) {
+		fPatchIsActive[GetActivePatch(n)->GetPatchIndex()] = 1;
+	}
+
+	DataVector<int> nPatchPoints;
+	nPatchPoints.Initialize(GetPatchCount());
+
+	for (int i = 0; i < iPatch.GetRows(); i++) {
+		if (fPatchIsActive[iPatch[i]]) {
+			nPatchPoints[iPatch[i]]++;
+		}
+	}
+
+	// Order local points by patch index
+	stencil.m_nTotalPoints = dAlpha.GetRows();
+	stencil.m_ixPatchPointBegin.Initialize(GetPatchCount() + 1);
+
+	for (int p = 0; p < GetPatchCount(); p++) {
+		stencil.m_ixPatchPointBegin[p+1] =
+			stencil.m_ixPatchPointBegin[p] + nPatchPoints[p];
+	}
+
+	int nLocalPoints = stencil.m_ixPatchPointBegin[GetPatchCount()];
+
+	stencil.m_ixPoint.Initialize(nLocalPoints);
+	stencil.m_dAlpha.Initialize(nLocalPoints);
+	stencil.m_dBeta.Initialize(nLocalPoints);
+	stencil.m_iElementA.Initialize(nLocalPoints);
+	stencil.m_iElementB.Initialize(nLocalPoints);
+	stencil.m_dWeights.Initialize(
+		nLocalPoints, m_nHorizontalOrder * m_nHorizontalOrder);
+
+	nPatchPoints.Zero();
+	for (int i = 0; i < iPatch.GetRows(); i++) {
+		if (fPatchIsActive[iPatch[i]]) {
+			int ix = stencil.m_ixPatchPointBegin[iPatch[i]]
+				+ nPatchPoints[iPatch[i]];
+
+			stencil.m_ixPoint[ix] = i;
+			stencil.m_dAlpha[ix] = dAlpha[i];
+			stencil.m_dBeta[ix] = dBeta[i];
+
+			nPatchPoints[iPatch[i]]++;
+		}
+	}
+
+	// Compute interpolation weights on each patch
+	for (int n = 0; n < GetActivePatchCount(); n++) {
+		GetActivePatch(n)->ComputeInterpolationStencil(stencil);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 double GridGLL::InterpolateNodeToREdge(
 	const double * dDataNode,
 	const double * dDataRefNode,
@@ -78,6 +78,16 @@ public:
 	virtual void ApplyDSS(
 		int iDataUpdate,
 		DataType eDataType = DataType_State
+	);
+
+	///	<summary>
+	///		Apply the direct stiffness summation (DSS) operation on a single
+	///		patch whose halo data is up to date.
+	///	</summary>
+	virtual void ApplyPatchDSS(
+		GridPatch * pPatch,
+		int iDataUpdate,
+		DataType eDataType
 	) {
 		_EXCEPTIONT("Unimplemented");
 	}
@@ -89,6 +99,17 @@ public:
 		int iDataIndex
 	);
 
+	///	<summary>
+	///		Compute the interpolation stencil for the points on patches
+	///		owned by this processor.
+	///	</summary>
+	virtual void ComputeInterpolationStencil(
+		const DataVector<double> & dAlpha,
+		const DataVector<double> & dBeta,
+		const DataVector<int> & iPatch,
+		InterpolationStencil & stencil
+	) const;
+
 public:
 	///	<summary>
 	///		Interpolate one column of data from nodes to the given interface.
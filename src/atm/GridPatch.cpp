@@ -19,6 +19,10 @@
 #include "Model.h"
 #include "EquationSet.h"
 #include "Defines.h"
+#include "ExchangeStatistics.h"
+
+#include "MemoryTracker.h"
+#include "Profiler.h"
 
 #include "mpi.h"
 
@@ -149,199 +153,184 @@ void GridPatch::InitializeDataLocal() {
 	// Set the processor
 	MPI_Comm_rank(MPI_COMM_WORLD, &m_iProcessor);
 
-	// Jacobian at each node (2D)
-	m_dataJacobian2D.Initialize(
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth());
-
-	// Contravariant metric (2D) components at each node
-	m_dataContraMetric2DA.Initialize(
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth(),
-		2);
-
-	m_dataContraMetric2DB.Initialize(
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth(),
-		2);
-
-	// Covariant metric (2D) components at each node
-	m_dataCovMetric2DA.Initialize(
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth(),
-		2);
-
-	m_dataCovMetric2DB.Initialize(
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth(),
-		2);
-
-	// Jacobian at each node
-	m_dataJacobian.Initialize(
-		m_grid.GetRElements(),
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth());
-
-	// Jacobian at each interface
-	m_dataJacobianREdge.Initialize(
-		m_grid.GetRElements()+1,
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth());
-
-	// Contravariant metric components at each node
-	m_dataContraMetricA.Initialize(
-		m_grid.GetRElements(),
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth(),
-		3);
-
-	m_dataContraMetricB.Initialize(
-		m_grid.GetRElements(),
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth(),
-		3);
-
-	m_dataContraMetricXi.Initialize(
-		m_grid.GetRElements(),
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth(),
-		3);
-
-	// Covariant metric components at each node
-	m_dataCovMetricA.Initialize(
-		m_grid.GetRElements(),
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth(),
-		3);
-
-	m_dataCovMetricB.Initialize(
-		m_grid.GetRElements(),
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth(),
-		3);
-
-	m_dataCovMetricXi.Initialize(
-		m_grid.GetRElements(),
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth(),
-		3);
-
-	// Xi contravariant metric on interfaces
-	m_dataContraMetricAREdge.Initialize(
-		m_grid.GetRElements()+1,
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth(),
-		3);
-
-	m_dataContraMetricBREdge.Initialize(
-		m_grid.GetRElements()+1,
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth(),
-		3);
-
-	m_dataContraMetricXiREdge.Initialize(
-		m_grid.GetRElements()+1,
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth(),
-		3);
-
-	// Vertical coordinate transform (derivatives of the radius)
-	m_dataDerivRNode.Initialize(
-		m_grid.GetRElements(),
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth(),
-		3);
-
-	m_dataDerivRREdge.Initialize(
-		m_grid.GetRElements()+1,
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth(),
-		3);
-
-	// Element area at each node
-	m_dataElementArea.Initialize(
-		m_grid.GetRElements(),
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth());
-
-	// Element area at each interface
-	m_dataElementAreaREdge.Initialize(
-		m_grid.GetRElements()+1,
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth());
-
-	// Topography height at each node
-	m_dataTopography.Initialize(
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth());
-
-	// Topography derivatives at each node
-	m_dataTopographyDeriv.Initialize(
-		DataType_TopographyDeriv,
-		DataLocation_Node,
-		2,
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth(),
-		m_box.GetHaloElements());
-
-	// Longitude at each node
-	m_dataLon.Initialize(
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth());
-
-	// Latitude at each node
-	m_dataLat.Initialize(
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth());
-
-	// Coriolis parameter at each node
-	m_dataCoriolisF.Initialize(
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth());
-
-	// Radial coordinate at each level
-	m_dataZLevels.Initialize(
-		m_grid.GetRElements(),
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth());
-
-	// Radial coordinate at each interface
-	m_dataZInterfaces.Initialize(
-		m_grid.GetRElements()+1,
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth());
-
 	// Get the model
 	const Model & model = m_grid.GetModel();
 
 	// Get the equation set
 	const EquationSet & eqn = model.GetEquationSet();
 
+	// Geometric data
+	{
+		MemoryTrackerRegion memory(MemoryTag_Geometry);
+
+		// Jacobian at each node (2D)
+		m_dataJacobian2D.Initialize(
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth());
+
+		// Contravariant metric (2D) components at each node
+		m_dataContraMetric2DA.Initialize(
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth(),
+			2);
+
+		m_dataContraMetric2DB.Initialize(
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth(),
+			2);
+
+		// Covariant metric (2D) components at each node
+		m_dataCovMetric2DA.Initialize(
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth(),
+			2);
+
+		m_dataCovMetric2DB.Initialize(
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth(),
+			2);
+
+		// Jacobian at each node
+		m_dataJacobian.Initialize(
+			m_grid.GetRElements(),
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth());
+
+		// Jacobian at each interface
+		m_dataJacobianREdge.Initialize(
+			m_grid.GetRElements()+1,
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth());
+
+		// Contravariant metric components at each node
+		m_dataContraMetricA.Initialize(
+			m_grid.GetRElements(),
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth(),
+			3);
+
+		m_dataContraMetricB.Initialize(
+			m_grid.GetRElements(),
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth(),
+			3);
+
+		m_dataContraMetricXi.Initialize(
+			m_grid.GetRElements(),
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth(),
+			3);
+
+		// Covariant metric components at each node
+		m_dataCovMetricA.Initialize(
+			m_grid.GetRElements(),
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth(),
+			3);
+
+		m_dataCovMetricB.Initialize(
+			m_grid.GetRElements(),
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth(),
+			3);
+
+		m_dataCovMetricXi.Initialize(
+			m_grid.GetRElements(),
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth(),
+			3);
+
+		// Xi contravariant metric on interfaces
+		m_dataContraMetricAREdge.Initialize(
+			m_grid.GetRElements()+1,
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth(),
+			3);
+
+		m_dataContraMetricBREdge.Initialize(
+			m_grid.GetRElements()+1,
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth(),
+			3);
+
+		m_dataContraMetricXiREdge.Initialize(
+			m_grid.GetRElements()+1,
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth(),
+			3);
+
+		// Vertical coordinate transform (derivatives of the radius)
+		m_dataDerivRNode.Initialize(
+			m_grid.GetRElements(),
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth(),
+			3);
+
+		m_dataDerivRREdge.Initialize(
+			m_grid.GetRElements()+1,
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth(),
+			3);
+
+		// Element area at each node
+		m_dataElementArea.Initialize(
+			m_grid.GetRElements(),
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth());
+
+		// Element area at each interface
+		m_dataElementAreaREdge.Initialize(
+			m_grid.GetRElements()+1,
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth());
+
+		// Topography height at each node
+		m_dataTopography.Initialize(
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth());
+
+		// Topography derivatives at each node
+		m_dataTopographyDeriv.Initialize(
+			DataType_TopographyDeriv,
+			DataLocation_Node,
+			2,
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth(),
+			m_box.GetHaloElements());
+
+		// Longitude at each node
+		m_dataLon.Initialize(
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth());
+
+		// Latitude at each node
+		m_dataLat.Initialize(
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth());
+
+		// Coriolis parameter at each node
+		m_dataCoriolisF.Initialize(
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth());
+
+		// Radial coordinate at each level
+		m_dataZLevels.Initialize(
+			m_grid.GetRElements(),
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth());
+
+		// Radial coordinate at each interface
+		m_dataZInterfaces.Initialize(
+			m_grid.GetRElements()+1,
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth());
+	}
+
 	// Initialize reference state
-	m_dataRefStateNode.Initialize(
-		DataType_State,
-		DataLocation_Node,
-		eqn.GetComponents(),
-		m_grid.GetRElements(),
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth(),
-		m_box.GetHaloElements());
-
-	m_dataRefStateREdge.Initialize(
-		DataType_State,
-		DataLocation_REdge,
-		eqn.GetComponents(),
-		m_grid.GetRElements(),
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth(),
-		m_box.GetHaloElements());
-
-	// Initialize component data
-	m_datavecStateNode .resize(model.GetComponentDataInstances());
-	m_datavecStateREdge.resize(model.GetComponentDataInstances());
-
-	for (int m = 0; m < model.GetComponentDataInstances(); m++) {
-		m_datavecStateNode[m].Initialize(
+	{
+		MemoryTrackerRegion memory(MemoryTag_State);
+
+		m_dataRefStateNode.Initialize(
 			DataType_State,
 			DataLocation_Node,
 			eqn.GetComponents(),
@@ -350,7 +339,7 @@ void GridPatch::InitializeDataLocal() {
 			m_box.GetBTotalWidth(),
 			m_box.GetHaloElements());
 
-		m_datavecStateREdge[m].Initialize(
+		m_dataRefStateREdge.Initialize(
 			DataType_State,
 			DataLocation_REdge,
 			eqn.GetComponents(),
@@ -358,147 +347,178 @@ void GridPatch::InitializeDataLocal() {
 			m_box.GetATotalWidth(),
 			m_box.GetBTotalWidth(),
 			m_box.GetHaloElements());
+
+		// Initialize component data
+		m_datavecStateNode .resize(model.GetComponentDataInstances());
+		m_datavecStateREdge.resize(model.GetComponentDataInstances());
+
+		for (int m = 0; m < model.GetComponentDataInstances(); m++) {
+			m_datavecStateNode[m].Initialize(
+				DataType_State,
+				DataLocation_Node,
+				eqn.GetComponents(),
+				m_grid.GetRElements(),
+				m_box.GetATotalWidth(),
+				m_box.GetBTotalWidth(),
+				m_box.GetHaloElements());
+
+			m_datavecStateREdge[m].Initialize(
+				DataType_State,
+				DataLocation_REdge,
+				eqn.GetComponents(),
+				m_grid.GetRElements(),
+				m_box.GetATotalWidth(),
+				m_box.GetBTotalWidth(),
+				m_box.GetHaloElements());
+		}
 	}
 
 	// Initialize tracer data
-	m_datavecTracers.resize(model.GetTracerDataInstances());
+	{
+		MemoryTrackerRegion memory(MemoryTag_Tracers);
 
-	for (int m = 0; m < model.GetTracerDataInstances(); m++) {
-		m_datavecTracers[m].Initialize(
-			DataType_Tracers,
+		m_datavecTracers.resize(model.GetTracerDataInstances());
+
+		for (int m = 0; m < model.GetTracerDataInstances(); m++) {
+			m_datavecTracers[m].Initialize(
+				DataType_Tracers,
+				DataLocation_Node,
+				eqn.GetTracers(),
+				m_grid.GetRElements(),
+				m_box.GetATotalWidth(),
+				m_box.GetBTotalWidth(),
+				m_box.GetHaloElements());
+		}
+	}
+
+#pragma message "Make these processes more generic"
+	// Initialize auxiliary data
+	{
+		MemoryTrackerRegion memory(MemoryTag_Auxiliary);
+
+		m_datavecAuxNode.resize(2);
+		m_datavecAuxREdge.resize(2);
+
+		m_datavecAuxNode[0].resize(model.GetHorizontalDynamicsAuxDataCount());
+		m_datavecAuxREdge[0].resize(model.GetHorizontalDynamicsAuxDataCount());
+
+		m_datavecAuxNode[1].resize(model.GetVerticalDynamicsAuxDataCount());
+		m_datavecAuxREdge[1].resize(model.GetVerticalDynamicsAuxDataCount());
+
+		for (int m = 0; m < model.GetHorizontalDynamicsAuxDataCount(); m++) {
+			m_datavecAuxNode[0][m].Initialize(
+				DataType_Auxiliary,
+				DataLocation_Node,
+				m_grid.GetRElements(),
+				m_box.GetATotalWidth(),
+				m_box.GetBTotalWidth(),
+				m_box.GetHaloElements());
+
+			m_datavecAuxREdge[0][m].Initialize(
+				DataType_Auxiliary,
+				DataLocation_REdge,
+				m_grid.GetRElements(),
+				m_box.GetATotalWidth(),
+				m_box.GetBTotalWidth(),
+				m_box.GetHaloElements());
+		}
+
+		for (int m = 0; m < model.GetVerticalDynamicsAuxDataCount(); m++) {
+			m_datavecAuxNode[1][m].Initialize(
+				DataType_Auxiliary,
+				DataLocation_Node,
+				m_grid.GetRElements(),
+				m_box.GetATotalWidth(),
+				m_box.GetBTotalWidth(),
+				m_box.GetHaloElements());
+
+			m_datavecAuxREdge[1][m].Initialize(
+				DataType_Auxiliary,
+				DataLocation_REdge,
+				m_grid.GetRElements(),
+				m_box.GetATotalWidth(),
+				m_box.GetBTotalWidth(),
+				m_box.GetHaloElements());
+		}
+
+		// Pressure data
+		m_dataPressure.Initialize(
+			DataType_Pressure,
+			DataLocation_Node,
+			m_grid.GetRElements(),
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth(),
+			m_box.GetHaloElements());
+	/*
+		m_dataDaPressure.Initialize(
+			DataType_Pressure,
 			DataLocation_Node,
-			eqn.GetTracers(),
 			m_grid.GetRElements(),
 			m_box.GetATotalWidth(),
 			m_box.GetBTotalWidth(),
 			m_box.GetHaloElements());
-	}
-
-#pragma message "Make these processes more generic"
-	// Initialize auxiliary data
-	m_datavecAuxNode.resize(2);
-	m_datavecAuxREdge.resize(2);
 
-	m_datavecAuxNode[0].resize(model.GetHorizontalDynamicsAuxDataCount());
-	m_datavecAuxREdge[0].resize(model.GetHorizontalDynamicsAuxDataCount());
+		m_dataDbPressure.Initialize(
+			DataType_Pressure,
+			DataLocation_Node,
+			m_grid.GetRElements(),
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth(),
+			m_box.GetHaloElements());
+	*/
+		m_dataDxPressure.Initialize(
+			DataType_Pressure,
+			DataLocation_Node,
+			m_grid.GetRElements(),
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth(),
+			m_box.GetHaloElements());
 
-	m_datavecAuxNode[1].resize(model.GetVerticalDynamicsAuxDataCount());
-	m_datavecAuxREdge[1].resize(model.GetVerticalDynamicsAuxDataCount());
+		// Vorticity data
+		m_dataVorticity.Initialize(
+			DataType_Vorticity,
+			DataLocation_Node,
+			m_grid.GetRElements(),
+			m_box.GetATotalWidth(),
+			m_box.GetBTotalWidth(),
+			m_box.GetHaloElements());
 
-	for (int m = 0; m < model.GetHorizontalDynamicsAuxDataCount(); m++) {
-		m_datavecAuxNode[0][m].Initialize(
-			DataType_Auxiliary,
+		// Divergence data
+		m_dataDivergence.Initialize(
+			DataType_Divergence,
 			DataLocation_Node,
 			m_grid.GetRElements(),
 			m_box.GetATotalWidth(),
 			m_box.GetBTotalWidth(),
 			m_box.GetHaloElements());
 
-		m_datavecAuxREdge[0][m].Initialize(
-			DataType_Auxiliary,
-			DataLocation_REdge,
+		// Temperature data
+		m_dataTemperature.Initialize(
+			DataType_Temperature,
+			DataLocation_Node,
 			m_grid.GetRElements(),
 			m_box.GetATotalWidth(),
 			m_box.GetBTotalWidth(),
 			m_box.GetHaloElements());
-	}
 
-	for (int m = 0; m < model.GetVerticalDynamicsAuxDataCount(); m++) {
-		m_datavecAuxNode[1][m].Initialize(
-			DataType_Auxiliary,
+		// Rayleigh friction strength
+		m_dataRayleighStrengthNode.Initialize(
+			DataType_None,
 			DataLocation_Node,
 			m_grid.GetRElements(),
 			m_box.GetATotalWidth(),
 			m_box.GetBTotalWidth(),
 			m_box.GetHaloElements());
 
-		m_datavecAuxREdge[1][m].Initialize(
-			DataType_Auxiliary,
+		// Rayleigh friction strength
+		m_dataRayleighStrengthREdge.Initialize(
+			DataType_None,
 			DataLocation_REdge,
 			m_grid.GetRElements(),
 			m_box.GetATotalWidth(),
 			m_box.GetBTotalWidth(),
 			m_box.GetHaloElements());
 	}
-
-	// Pressure data
-	m_dataPressure.Initialize(
-		DataType_Pressure,
-		DataLocation_Node,
-		m_grid.GetRElements(),
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth(),
-		m_box.GetHaloElements());
-/*
-	m_dataDaPressure.Initialize(
-		DataType_Pressure,
-		DataLocation_Node,
-		m_grid.GetRElements(),
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth(),
-		m_box.GetHaloElements());
-
-	m_dataDbPressure.Initialize(
-		DataType_Pressure,
-		DataLocation_Node,
-		m_grid.GetRElements(),
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth(),
-		m_box.GetHaloElements());
-*/
-	m_dataDxPressure.Initialize(
-		DataType_Pressure,
-		DataLocation_Node,
-		m_grid.GetRElements(),
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth(),
-		m_box.GetHaloElements());
-
-	// Vorticity data
-	m_dataVorticity.Initialize(
-		DataType_Vorticity,
-		DataLocation_Node,
-		m_grid.GetRElements(),
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth(),
-		m_box.GetHaloElements());
-
-	// Divergence data
-	m_dataDivergence.Initialize(
-		DataType_Divergence,
-		DataLocation_Node,
-		m_grid.GetRElements(),
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth(),
-		m_box.GetHaloElements());
-
-	// Temperature data
-	m_dataTemperature.Initialize(
-		DataType_Temperature,
-		DataLocation_Node,
-		m_grid.GetRElements(),
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth(),
-		m_box.GetHaloElements());
-
-	// Rayleigh friction strength
-	m_dataRayleighStrengthNode.Initialize(
-		DataType_None,
-		DataLocation_Node,
-		m_grid.GetRElements(),
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth(),
-		m_box.GetHaloElements());
-
-	// Rayleigh friction strength
-	m_dataRayleighStrengthREdge.Initialize(
-		DataType_None,
-		DataLocation_REdge,
-		m_grid.GetRElements(),
-		m_box.GetATotalWidth(),
-		m_box.GetBTotalWidth(),
-		m_box.GetHaloElements());
-
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -558,6 +578,73 @@ void GridPatch::DeinitializeData() {
 	m_dataTemperature.Deinitialize();
 	m_dataRayleighStrengthNode.Deinitialize();
 	m_dataRayleighStrengthREdge.Deinitialize();
+	m_nRayleighFrictionRunsNode.Deinitialize();
+	m_nRayleighFrictionRunsREdge.Deinitialize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Build the list of runs in the beta direction over which the given
+///		Rayleigh friction strength is nonzero.
+///	</summary>
+static void BuildRayleighFrictionRuns(
+	const PatchBox & box,
+	const GridData3D & dataRayleighStrength,
+	DataMatrix<int> & nRuns
+) {
+	int nLevels = dataRayleighStrength.GetRElements();
+
+	// Count runs on the first pass and store them on the second pass
+	int nRunCount = 0;
+	for (int iPass = 0; iPass < 2; iPass++) {
+		int r = 0;
+
+		for (int k = 0; k < nLevels; k++) {
+		for (int i = box.GetAInteriorBegin(); i < box.GetAInteriorEnd(); i++) {
+
+			int j = box.GetBInteriorBegin();
+			while (j < box.GetBInteriorEnd()) {
+				if (dataRayleighStrength[k][i][j] == 0.0) {
+					j++;
+					continue;
+				}
+
+				int jBegin = j;
+				for (; j < box.GetBInteriorEnd(); j++) {
+					if (dataRayleighStrength[k][i][j] == 0.0) {
+						break;
+					}
+				}
+
+				if (iPass == 1) {
+					nRuns[r][0] = k;
+					nRuns[r][1] = i;
+					nRuns[r][2] = jBegin;
+					nRuns[r][3] = j;
+				}
+				r++;
+			}
+		}
+		}
+
+		if (iPass == 0) {
+			nRunCount = r;
+			nRuns.Initialize(nRunCount, 4);
+			if (nRunCount == 0) {
+				break;
+			}
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void GridPatch::ComputeRayleighFrictionRuns() {
+	BuildRayleighFrictionRuns(
+		m_box, m_dataRayleighStrengthNode, m_nRayleighFrictionRunsNode);
+	BuildRayleighFrictionRuns(
+		m_box, m_dataRayleighStrengthREdge, m_nRayleighFrictionRunsREdge);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -964,15 +1051,13 @@ void GridPatch::Checksum(
 
 ///////////////////////////////////////////////////////////////////////////////
 
-double GridPatch::ComputeTotalEnergy(
-	int iDataIndex
+void GridPatch::ComputeDiagnostics(
+	int iDataIndex,
+	DataVector<double> & dDiagnostics
 ) const {
 	// Physical constants
 	const PhysicalConstants & phys = m_grid.GetModel().GetPhysicalConstants();
 
-	// Accumulated local energy
-	double dLocalEnergy = 0.0;
-
 	// Indices of EquationSet variables
 	const int UIx = 0;
 	const int VIx = 1;
@@ -982,233 +1067,193 @@ double GridPatch::ComputeTotalEnergy(
 	const int RIx = 4;
 
 	// Determine type of energy to compute from EquationSet
-	EquationSet::Type eEquationSetType =
-		m_grid.GetModel().GetEquationSet().GetType();
+	const EquationSet & eqn = m_grid.GetModel().GetEquationSet();
+
+	EquationSet::Type eEquationSetType = eqn.GetType();
+
+	const int nComponents = eqn.GetComponents();
+	const int nRElements = m_grid.GetRElements();
+
+	if (dDiagnostics.GetRows() < DiagnosticType_Count + nComponents) {
+		_EXCEPTIONT("Invalid diagnostics count");
+	}
 
 	// Grid data
 	if ((iDataIndex < 0) || (iDataIndex >= m_datavecStateNode.size())) {
 		_EXCEPTION1("iDataIndex out of range: %i", iDataIndex);
 	}
 	const GridData4D & dataNode = m_datavecStateNode[iDataIndex];
+	const GridData4D & dataREdge = m_datavecStateREdge[iDataIndex];
 
-	// Shallow Water Energy
-	if (eEquationSetType == EquationSet::ShallowWaterEquations) {
+	const int nStride = dataNode.GetSize(2) * dataNode.GetSize(3);
 
-		// Loop over all elements
-		int k;
-		int i;
-		int j;
+	// Columns of interface variables interpolated to levels
+	DataMatrix<double> dColumnNode;
+	dColumnNode.Initialize(nComponents, nRElements);
 
-		for (k = 0; k < m_grid.GetRElements(); k++) {
-		for (i = m_box.GetAInteriorBegin(); i < m_box.GetAInteriorEnd(); i++) {
-		for (j = m_box.GetBInteriorBegin(); j < m_box.GetBInteriorEnd(); j++) {
-			double dUdotU =
-				+ m_dataContraMetric2DB[i][j][1]
-					* dataNode[UIx][k][i][j] * dataNode[UIx][k][i][j]
-				- 2.0 * m_dataContraMetric2DA[i][j][1]
-					* dataNode[UIx][k][i][j] * dataNode[VIx][k][i][j]
-				+ m_dataContraMetric2DA[i][j][0]
-					* dataNode[VIx][k][i][j] * dataNode[VIx][k][i][j];
+	// Level values of each variable in the current column
+	std::vector<const double *> vecColumn(nComponents);
+	std::vector<int> vecColumnStride(nComponents);
 
-			dUdotU *= m_dataJacobian2D[i][j] * m_dataJacobian2D[i][j];
+	// Accumulated local diagnostics
+	double dLocalEnergy = 0.0;
+	double dLocalPotentialEnstrophy = 0.0;
+	double dLocalMass = 0.0;
 
-			double dKineticEnergy =
-				0.5 * (dataNode[HIx][k][i][j] - m_dataTopography[i][j])
-					* dUdotU;
+	// Loop over all columns
+	for (int i = m_box.GetAInteriorBegin(); i < m_box.GetAInteriorEnd(); i++) {
+	for (int j = m_box.GetBInteriorBegin(); j < m_box.GetBInteriorEnd(); j++) {
 
-			double dPotentialEnergy =
-				0.5 * phys.GetG()
-					* (dataNode[HIx][k][i][j] * dataNode[HIx][k][i][j]
-						- m_dataTopography[i][j] * m_dataTopography[i][j]);
+		// Integrals of each state variable at its native location
+		for (int c = 0; c < nComponents; c++) {
+			double dIntegral = 0.0;
 
-			dLocalEnergy += m_dataElementArea[k][i][j]
-				* (dKineticEnergy + dPotentialEnergy);
-		}
-		}
-		}
+			if (m_grid.GetVarLocation(c) == DataLocation_Node) {
+				for (int k = 0; k < nRElements; k++) {
+					dIntegral +=
+						dataNode[c][k][i][j] * m_dataElementArea[k][i][j];
+				}
 
-	} else {
+				vecColumn[c] = &(dataNode[c][0][i][j]);
+				vecColumnStride[c] = nStride;
 
-		// Loop over all elements
-		int k;
-		int i;
-		int j;
-/*
-		double dTotalKineticEnergy = 0.0;
-		double dTotalInternalEnergy = 0.0;
-		double dTotalPotentialEnergy = 0.0;
-*/
-		for (k = 0; k < m_grid.GetRElements(); k++) {
-		//for (k = 0; k < 1; k++) {
-		for (i = m_box.GetAInteriorBegin(); i < m_box.GetAInteriorEnd(); i++) {
-		for (j = m_box.GetBInteriorBegin(); j < m_box.GetBInteriorEnd(); j++) {
-/*
-			double dUa = dataNode[UIx][k][i][j];
-			double dUb = dataNode[VIx][k][i][j];
-			double dUx = dataNode[WIx][k][i][j];
-
-			double dCovUa =
-				  m_dataCovMetricA[k][i][j][0] * dUa
-				+ m_dataCovMetricA[k][i][j][1] * dUb
-				+ m_dataCovMetricA[k][i][j][2] * dUx;
-
-			double dCovUb =
-				  m_dataCovMetricB[k][i][j][0] * dUa
-				+ m_dataCovMetricB[k][i][j][1] * dUb
-				+ m_dataCovMetricB[k][i][j][2] * dUx;
-
-			double dCovUx =
-				  m_dataCovMetricXi[k][i][j][0] * dUa
-				+ m_dataCovMetricXi[k][i][j][1] * dUb
-				+ m_dataCovMetricXi[k][i][j][2] * dUx;
-
-			double dUdotU =
-				dCovUa * dUa + dCovUb * dUb + dCovUx * dUx;
-*/
+			} else {
+				for (int k = 0; k <= nRElements; k++) {
+					dIntegral +=
+						dataREdge[c][k][i][j] * m_dataElementAreaREdge[k][i][j];
+				}
 
-#ifdef USE_COVARIANT_VELOCITIES
-			double dCovUa = dataNode[UIx][k][i][j];
-			double dCovUb = dataNode[VIx][k][i][j];
-			double dCovUx = dataNode[WIx][k][i][j] * m_dataDerivRNode[k][i][j][2];
-
-			double dConUa =
-				  m_dataContraMetricA[k][i][j][0] * dCovUa
-				+ m_dataContraMetricA[k][i][j][1] * dCovUb
-				+ m_dataContraMetricA[k][i][j][2] * dCovUx;
-
-			double dConUb =
-				  m_dataContraMetricB[k][i][j][0] * dCovUa
-				+ m_dataContraMetricB[k][i][j][1] * dCovUb
-				+ m_dataContraMetricB[k][i][j][2] * dCovUx;
-
-			double dConUx =
-				  m_dataContraMetricXi[k][i][j][0] * dCovUa
-				+ m_dataContraMetricXi[k][i][j][1] * dCovUb
-				+ m_dataContraMetricXi[k][i][j][2] * dCovUx;
-
-			double dUdotU = dConUa * dCovUa + dConUb * dCovUb + dConUx * dCovUx;
-#else
-			double dUdotU =
-				+ m_dataCovMetric2DA[i][j][0]
-					* dataNode[UIx][k][i][j] * dataNode[UIx][k][i][j]
-				+ (m_dataCovMetric2DA[i][j][1] + m_dataCovMetric2DB[i][j][0])
-					* dataNode[UIx][k][i][j] * dataNode[VIx][k][i][j]
-				+ m_dataCovMetric2DB[i][j][1]
-					* dataNode[VIx][k][i][j] * dataNode[VIx][k][i][j];
-
-			dUdotU += dataNode[WIx][k][i][j] * dataNode[WIx][k][i][j];
-#endif
+				InterpolateColumnREdgeToNode(
+					&(dataREdge[c][0][i][j]), nStride, dColumnNode[c]);
 
-			double dKineticEnergy =
-				0.5 * dataNode[RIx][k][i][j] * dUdotU;
+				vecColumn[c] = dColumnNode[c];
+				vecColumnStride[c] = 1;
+			}
 
-#ifdef FORMULATION_PRESSURE
-			double dPressure = dataNode[PIx][k][i][j];
-#endif
-#if defined(FORMULATION_RHOTHETA_PI) || defined(FORMULATION_RHOTHETA_P)
-			double dPressure = phys.PressureFromRhoTheta(dataNode[PIx][k][i][j]);
-#endif
-#if defined(FORMULATION_THETA) || defined(FORMULATION_THETA_FLUX)
-			double dPressure =
-				phys.PressureFromRhoTheta(
-					dataNode[RIx][k][i][j] * dataNode[PIx][k][i][j]);
-#endif
+			dDiagnostics[DiagnosticType_Count + c] += dIntegral;
+		}
 
-			double dInternalEnergy =
-				dPressure / (phys.GetGamma() - 1.0);
+		// Shallow water energy, potential enstrophy and mass
+		if (eEquationSetType == EquationSet::ShallowWaterEquations) {
 
-			double dPotentialEnergy =
-				phys.GetG() * dataNode[RIx][k][i][j] * m_dataZLevels[k][i][j];
+			double dPlanetaryVorticity =
+				2.0 * phys.GetOmega() * sin(m_dataLat[i][j]);
 
-			dLocalEnergy += m_dataElementArea[k][i][j]
-				* (dKineticEnergy + dInternalEnergy + dPotentialEnergy);
-/*
-			dTotalKineticEnergy += m_dataElementArea[k][i][j] * dKineticEnergy;
-			dTotalInternalEnergy += m_dataElementArea[k][i][j] * dInternalEnergy;
-			dTotalPotentialEnergy += m_dataElementArea[k][i][j] * dPotentialEnergy;
-*/
-		}
-		}
-		}
-/*
-		printf("%1.15e %1.15e %1.15e\n",
-			dTotalKineticEnergy,
-			dTotalInternalEnergy,
-			dTotalPotentialEnergy);
-*/
-	}
+			for (int k = 0; k < nRElements; k++) {
+				const double dU = vecColumn[UIx][k * vecColumnStride[UIx]];
+				const double dV = vecColumn[VIx][k * vecColumnStride[VIx]];
+				const double dH = vecColumn[HIx][k * vecColumnStride[HIx]];
 
-	return dLocalEnergy;
-}
+				double dUdotU =
+					+ m_dataContraMetric2DB[i][j][1] * dU * dU
+					- 2.0 * m_dataContraMetric2DA[i][j][1] * dU * dV
+					+ m_dataContraMetric2DA[i][j][0] * dV * dV;
 
-///////////////////////////////////////////////////////////////////////////////
+				dUdotU *= m_dataJacobian2D[i][j] * m_dataJacobian2D[i][j];
 
-double GridPatch::ComputeTotalPotentialEnstrophy(
-	int iDataIndex
-) {
-	// Physical constants
-	const PhysicalConstants & phys = m_grid.GetModel().GetPhysicalConstants();
+				double dKineticEnergy =
+					0.5 * (dH - m_dataTopography[i][j]) * dUdotU;
 
-	// Accumulated local energy
-	double dLocalPotentialEnstrophy = 0.0;
+				double dPotentialEnergy =
+					0.5 * phys.GetG()
+						* (dH * dH
+							- m_dataTopography[i][j] * m_dataTopography[i][j]);
 
-	// Indices of EquationSet variables
-	const int UIx = 0;
-	const int VIx = 1;
-	const int HIx = 2;
-	const int PIx = 2;
-	const int WIx = 3;
-	const int RIx = 4;
+				dLocalEnergy += m_dataElementArea[k][i][j]
+					* (dKineticEnergy + dPotentialEnergy);
 
-	// Determine type of energy to compute from EquationSet
-	EquationSet::Type eEquationSetType =
-		m_grid.GetModel().GetEquationSet().GetType();
+				double dAbsoluteVorticity =
+					m_dataVorticity[k][i][j] + dPlanetaryVorticity;
 
-	// Grid data
-	if ((iDataIndex < 0) || (iDataIndex >= m_datavecStateNode.size())) {
-		_EXCEPTION1("iDataIndex out of range: %i", iDataIndex);
-	}
-	const GridData4D & dataNode = m_datavecStateNode[iDataIndex];
+				dLocalPotentialEnstrophy +=
+					m_dataElementArea[k][i][j]
+						* 0.5 * dAbsoluteVorticity * dAbsoluteVorticity
+						/ (dH - m_dataTopography[i][j]);
 
-	// Shallow Water PotentialEnstrophy
-	if (eEquationSetType == EquationSet::ShallowWaterEquations) {
+				dLocalMass += m_dataElementArea[k][i][j]
+					* (dH - m_dataTopography[i][j]);
+			}
 
-		// Loop over all elements
-		int k;
-		int i;
-		int j;
+		// Nonhydrostatic energy and mass
+		} else {
+			for (int k = 0; k < nRElements; k++) {
+				const double dU = vecColumn[UIx][k * vecColumnStride[UIx]];
+				const double dV = vecColumn[VIx][k * vecColumnStride[VIx]];
+				const double dP = vecColumn[PIx][k * vecColumnStride[PIx]];
+				const double dW = vecColumn[WIx][k * vecColumnStride[WIx]];
+				const double dR = vecColumn[RIx][k * vecColumnStride[RIx]];
 
-		for (k = 0; k < m_grid.GetRElements(); k++) {
-		for (i = m_box.GetAInteriorBegin(); i < m_box.GetAInteriorEnd(); i++) {
-		for (j = m_box.GetBInteriorBegin(); j < m_box.GetBInteriorEnd(); j++) {
-			double dPlanetaryVorticity =
-				2.0 * phys.GetOmega() * sin(m_dataLat[i][j]);
+#ifdef USE_COVARIANT_VELOCITIES
+				double dCovUa = dU;
+				double dCovUb = dV;
+				double dCovUx = dW * m_dataDerivRNode[k][i][j][2];
+
+				double dConUa =
+					  m_dataContraMetricA[k][i][j][0] * dCovUa
+					+ m_dataContraMetricA[k][i][j][1] * dCovUb
+					+ m_dataContraMetricA[k][i][j][2] * dCovUx;
+
+				double dConUb =
+					  m_dataContraMetricB[k][i][j][0] * dCovUa
+					+ m_dataContraMetricB[k][i][j][1] * dCovUb
+					+ m_dataContraMetricB[k][i][j][2] * dCovUx;
+
+				double dConUx =
+					  m_dataContraMetricXi[k][i][j][0] * dCovUa
+					+ m_dataContraMetricXi[k][i][j][1] * dCovUb
+					+ m_dataContraMetricXi[k][i][j][2] * dCovUx;
+
+				double dUdotU =
+					dConUa * dCovUa + dConUb * dCovUb + dConUx * dCovUx;
+#else
+				double dUdotU =
+					+ m_dataCovMetric2DA[i][j][0] * dU * dU
+					+ (m_dataCovMetric2DA[i][j][1] + m_dataCovMetric2DB[i][j][0])
+						* dU * dV
+					+ m_dataCovMetric2DB[i][j][1] * dV * dV;
 
-			double dAbsoluteVorticity =
-				m_dataVorticity[k][i][j] + dPlanetaryVorticity;
+				dUdotU += dW * dW;
+#endif
 
-			dLocalPotentialEnstrophy +=
-				m_dataElementArea[k][i][j]
-					* 0.5 * dAbsoluteVorticity * dAbsoluteVorticity
-					/ (dataNode[HIx][k][i][j] - m_dataTopography[i][j]);
-		}
-		}
-		}
+				double dKineticEnergy = 0.5 * dR * dUdotU;
 
-	} else {
+#ifdef FORMULATION_PRESSURE
+				double dPressure = dP;
+#endif
+#if defined(FORMULATION_RHOTHETA_PI) || defined(FORMULATION_RHOTHETA_P)
+				double dPressure = phys.PressureFromRhoTheta(dP);
+#endif
+#if defined(FORMULATION_THETA) || defined(FORMULATION_THETA_FLUX)
+				double dPressure = phys.PressureFromRhoTheta(dR * dP);
+#endif
+
+				double dInternalEnergy =
+					dPressure / (phys.GetGamma() - 1.0);
+
+				double dPotentialEnergy =
+					phys.GetG() * dR * m_dataZLevels[k][i][j];
 
-#pragma message "Total potential enstrophy"
-		// Unimplemented
-		dLocalPotentialEnstrophy = 0.0;
+				dLocalEnergy += m_dataElementArea[k][i][j]
+					* (dKineticEnergy + dInternalEnergy + dPotentialEnergy);
+
+				dLocalMass += m_dataElementArea[k][i][j] * dR;
+			}
+		}
+	}
 	}
 
-	return dLocalPotentialEnstrophy;
+	dDiagnostics[DiagnosticType_Energy] += dLocalEnergy;
+	dDiagnostics[DiagnosticType_PotentialEnstrophy] += dLocalPotentialEnstrophy;
+	dDiagnostics[DiagnosticType_Mass] += dLocalMass;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void GridPatch::PrepareExchange() {
-	m_connect.PrepareExchange();
+void GridPatch::PrepareExchange(
+	ExchangePrecision ePrecision,
+	DataType eDataType
+) {
+	m_connect.PrepareExchange(ePrecision, eDataType);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1223,9 +1268,9 @@ void GridPatch::Send(
 			_EXCEPTIONT("Invalid state data instance.");
 		}
 
-		m_connect.Pack(m_datavecStateNode[iDataIndex]);
-		m_connect.Pack(m_datavecStateREdge[iDataIndex]);
-		m_connect.Send();
+		m_connect.PackAndSend(
+			m_datavecStateNode[iDataIndex],
+			m_datavecStateREdge[iDataIndex]);
 
 	// Tracer data
 	} else if (eDataType == DataType_Tracers) {
@@ -1233,28 +1278,23 @@ void GridPatch::Send(
 			_EXCEPTIONT("Invalid tracers data instance.");
 		}
 
-		m_connect.Pack(m_datavecTracers[iDataIndex]);
-		m_connect.Send();
+		m_connect.PackAndSend(m_datavecTracers[iDataIndex]);
 
 	// Vorticity data
 	} else if (eDataType == DataType_Vorticity) {
-		m_connect.Pack(m_dataVorticity);
-		m_connect.Send();
+		m_connect.PackAndSend(m_dataVorticity);
 
 	// Divergence data
 	} else if (eDataType == DataType_Divergence) {
-		m_connect.Pack(m_dataDivergence);
-		m_connect.Send();
+		m_connect.PackAndSend(m_dataDivergence);
 
 	// Temperature data
 	} else if (eDataType == DataType_Temperature) {
-		m_connect.Pack(m_dataTemperature);
-		m_connect.Send();
+		m_connect.PackAndSend(m_dataTemperature);
 
 	// Topography derivative data
 	} else if (eDataType == DataType_TopographyDeriv) {
-		m_connect.Pack(m_dataTopographyDeriv);
-		m_connect.Send();
+		m_connect.PackAndSend(m_dataTopographyDeriv);
 
 	// Invalid data
 	} else {
@@ -1268,17 +1308,29 @@ void GridPatch::Receive(
 	DataType eDataType,
 	int iDataIndex
 ) {
+	Neighbor * pNeighbor;
+	while ((pNeighbor = m_connect.WaitReceive()) != NULL) {
+		Unpack(pNeighbor, eDataType, iDataIndex);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void GridPatch::Unpack(
+	Neighbor * pNeighbor,
+	DataType eDataType,
+	int iDataIndex
+) {
+	double dStartTime = Profiler::GetTime();
+
 	// State data
 	if (eDataType == DataType_State) {
 		if ((iDataIndex < 0) || (iDataIndex > m_datavecStateNode.size())) {
 			_EXCEPTIONT("Invalid state data instance.");
 		}
 
-		Neighbor * pNeighbor;
-		while ((pNeighbor = m_connect.WaitReceive()) != NULL) {
-			pNeighbor->Unpack(m_datavecStateNode[iDataIndex]);
-			pNeighbor->Unpack(m_datavecStateREdge[iDataIndex]);
-		}
+		pNeighbor->Unpack(m_datavecStateNode[iDataIndex]);
+		pNeighbor->Unpack(m_datavecStateREdge[iDataIndex]);
 
 	// Tracer data
 	} else if (eDataType == DataType_Tracers) {
@@ -1286,43 +1338,33 @@ void GridPatch::Receive(
 			_EXCEPTIONT("Invalid tracers data instance.");
 		}
 
-		Neighbor * pNeighbor;
-		while ((pNeighbor = m_connect.WaitReceive()) != NULL) {
-			pNeighbor->Unpack(m_datavecTracers[iDataIndex]);
-		}
+		pNeighbor->Unpack(m_datavecTracers[iDataIndex]);
 
 	// Vorticity data
 	} else if (eDataType == DataType_Vorticity) {
-		Neighbor * pNeighbor;
-		while ((pNeighbor = m_connect.WaitReceive()) != NULL) {
-			pNeighbor->Unpack(m_dataVorticity);
-		}
+		pNeighbor->Unpack(m_dataVorticity);
 
 	// Divergence data
 	} else if (eDataType == DataType_Divergence) {
-		Neighbor * pNeighbor;
-		while ((pNeighbor = m_connect.WaitReceive()) != NULL) {
-			pNeighbor->Unpack(m_dataDivergence);
-		}
+		pNeighbor->Unpack(m_dataDivergence);
 
 	// Temperature data
 	} else if (eDataType == DataType_Temperature) {
-		Neighbor * pNeighbor;
-		while ((pNeighbor = m_connect.WaitReceive()) != NULL) {
-			pNeighbor->Unpack(m_dataTemperature);
-		}
+		pNeighbor->Unpack(m_dataTemperature);
 
 	// Topographic derivatives
 	} else if (eDataType == DataType_TopographyDeriv) {
-		Neighbor * pNeighbor;
-		while ((pNeighbor = m_connect.WaitReceive()) != NULL) {
-			pNeighbor->Unpack(m_dataTopographyDeriv);
-		}
+		pNeighbor->Unpack(m_dataTopographyDeriv);
 
 	// Invalid data
 	} else {
 		_EXCEPTIONT("Invalid DataType");
 	}
+
+	ExchangeStatistics::AddTime(
+		eDataType,
+		ExchangeStatistics::CounterType_UnpackTime,
+		Profiler::GetTime() - dStartTime);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1510,6 +1552,16 @@ void GridPatch::InterpolateREdgeToNode(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void GridPatch::InterpolateColumnREdgeToNode(
+	const double * dDataREdge,
+	int nStrideREdge,
+	double * dDataNode
+) const {
+	_EXCEPTIONT("Not implemented.");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void GridPatch::AddReferenceState(
 	int ix
 ) {
@@ -1538,3 +1590,24 @@ void GridPatch::InterpolateData(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void GridPatch::ComputeInterpolationStencil(
+	InterpolationStencil & stencil
+) const {
+	_EXCEPTIONT("Unimplemented.");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void GridPatch::ApplyInterpolationStencil(
+	const InterpolationStencil & stencil,
+	DataType eDataType,
+	DataLocation eDataLocation,
+	DataMatrix3D<double> & dInterpData,
+	bool fIncludeReferenceState,
+	bool fConvertToPrimitive
+) {
+	_EXCEPTIONT("Unimplemented.");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
@@ -25,6 +25,8 @@
 #include "PatchBox.h"
 #include "Connectivity.h"
 #include "ChecksumType.h"
+#include "DiagnosticType.h"
+#include "InterpolationStencil.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -211,24 +213,25 @@ public:
 	) const;
 
 	///	<summary>
-	///		Compute total energy over this GridPatch.
+	///		Add local diagnostics (see DiagnosticType) followed by the
+	///		integral of each state variable to dDiagnostics.  Variables
+	///		stored on interfaces are interpolated to levels column by column
+	///		without modifying the patch data.  Potential enstrophy requires
+	///		vorticity to have been computed.
 	///	</summary>
-	double ComputeTotalEnergy(
-		int iDataIndex
+	void ComputeDiagnostics(
+		int iDataIndex,
+		DataVector<double> & dDiagnostics
 	) const;
 
-	///	<summary>
-	///		Compute total potential enstrophy over this GridPatch.
-	///	</summary>
-	double ComputeTotalPotentialEnstrophy(
-		int iDataIndex
-	);
-
 public:
 	///	<summary>
 	///		Prepare for the exchange of halo data between processors.
 	///	</summary>
-	void PrepareExchange();
+	void PrepareExchange(
+		ExchangePrecision ePrecision = ExchangePrecision_Double,
+		DataType eDataType = DataType_None
+	);
 
 	///	<summary>
 	///		Send halo data to other processors.
@@ -246,6 +249,15 @@ public:
 		int iDataIndex
 	);
 
+	///	<summary>
+	///		Unpack halo data received from a single neighbor.
+	///	</summary>
+	void Unpack(
+		Neighbor * pNeighbor,
+		DataType eDataType,
+		int iDataIndex
+	);
+
 	///	<summary>
 	///		Send buffers to other processors.
 	///	</summary>
@@ -312,6 +324,15 @@ public:
 		int iDataIndex
 	);
 
+	///	<summary>
+	///		Interpolate a single column vertically from REdges to Nodes.
+	///	</summary>
+	virtual void InterpolateColumnREdgeToNode(
+		const double * dDataREdge,
+		int nStrideREdge,
+		double * dDataNode
+	) const;
+
 public:
 	///	<summary>
 	///		Linearly interpolate data horizontally to the specified points.
@@ -328,6 +349,27 @@ public:
 		bool fConvertToPrimitive = false
 	);
 
+	///	<summary>
+	///		Compute interpolation weights for the points in the stencil
+	///		that lie on this patch.
+	///	</summary>
+	virtual void ComputeInterpolationStencil(
+		InterpolationStencil & stencil
+	) const;
+
+	///	<summary>
+	///		Apply a precomputed interpolation stencil to all variables and
+	///		levels on this patch.  dInterpData is indexed by local point.
+	///	</summary>
+	virtual void ApplyInterpolationStencil(
+		const InterpolationStencil & stencil,
+		DataType eDataType,
+		DataLocation eDataLocation,
+		DataMatrix3D<double> & dInterpData,
+		bool fIncludeReferenceState = true,
+		bool fConvertToPrimitive = false
+	);
+
 public:
 	///	<summary>
 	///		Get the reference to the parent grid.
@@ -1049,6 +1091,29 @@ public:
 		}
 	}
 
+	///	<summary>
+	///		Build the lists of runs of interior nodes with nonzero Rayleigh
+	///		friction strength from the current Rayleigh friction strength.
+	///	</summary>
+	void ComputeRayleighFrictionRuns();
+
+	///	<summary>
+	///		Get the runs of interior nodes with nonzero Rayleigh friction
+	///		strength.  Each row contains the level, the alpha index and the
+	///		beginning and end (exclusive) of the run in the beta index.
+	///	</summary>
+	const DataMatrix<int> & GetRayleighFrictionRuns(
+		DataLocation loc = DataLocation_Node
+	) const {
+		if (loc == DataLocation_Node) {
+			return m_nRayleighFrictionRunsNode;
+		} else if (loc == DataLocation_REdge) {
+			return m_nRayleighFrictionRunsREdge;
+		} else {
+			_EXCEPTIONT("Invalid location");
+		}
+	}
+
 protected:
 	///	<summary>
 	///		Reference to parent grid.
@@ -1291,6 +1356,16 @@ protected:
 	///		Rayleigh friction strength on interfaces.
 	///	</summary>
 	GridData3D m_dataRayleighStrengthREdge;
+
+	///	<summary>
+	///		Runs of nodes with nonzero Rayleigh friction strength.
+	///	</summary>
+	DataMatrix<int> m_nRayleighFrictionRunsNode;
+
+	///	<summary>
+	///		Runs of interfaces with nonzero Rayleigh friction strength.
+	///	</summary>
+	DataMatrix<int> m_nRayleighFrictionRunsREdge;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
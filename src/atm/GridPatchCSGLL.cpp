@@ -1395,6 +1395,54 @@ void GridPatchCSGLL::InterpolateData(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void GridPatchCSGLL::ApplyInterpolationStencil(
+	const InterpolationStencil & stencil,
+	DataType eDataType,
+	DataLocation eDataLocation,
+	DataMatrix3D<double> & dInterpData,
+	bool fIncludeReferenceState,
+	bool fConvertToPrimitive
+) {
+	GridPatchGLL::ApplyInterpolationStencil(
+		stencil,
+		eDataType,
+		eDataLocation,
+		dInterpData,
+		fIncludeReferenceState,
+		fConvertToPrimitive);
+
+	// Convert to primitive variables
+	if ((eDataType != DataType_State) || (!fConvertToPrimitive)) {
+		return;
+	}
+
+	// Physical constants
+	const PhysicalConstants & phys = m_grid.GetModel().GetPhysicalConstants();
+
+	const int iBegin = stencil.GetPatchPointBegin(m_ixPatch);
+	const int iEnd = stencil.GetPatchPointEnd(m_ixPatch);
+
+	for (int i = iBegin; i < iEnd; i++) {
+		for (int k = 0; k < m_grid.GetRElements(); k++) {
+			double dUalpha =
+				dInterpData[0][k][i] / phys.GetEarthRadius();
+			double dUbeta =
+				dInterpData[1][k][i] / phys.GetEarthRadius();
+
+			CubedSphereTrans::CoVecTransRLLFromABP(
+				tan(stencil.m_dAlpha[i]),
+				tan(stencil.m_dBeta[i]),
+				GetPatchBox().GetPanel(),
+				dUalpha,
+				dUbeta,
+				dInterpData[0][k][i],
+				dInterpData[1][k][i]);
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void GridPatchCSGLL::TransformHaloVelocities(
 	int iDataUpdate
 ) {
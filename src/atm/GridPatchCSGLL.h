@@ -133,6 +133,20 @@ public:
 		bool fConvertToPrimitive = true
 	);
 
+	///	<summary>
+	///		Apply a precomputed interpolation stencil to all variables and
+	///		levels on this patch, optionally converting velocities to
+	///		primitive (RLL) components.
+	///	</summary>
+	virtual void ApplyInterpolationStencil(
+		const InterpolationStencil & stencil,
+		DataType eDataType,
+		DataLocation eDataLocation,
+		DataMatrix3D<double> & dInterpData,
+		bool fIncludeReferenceState = true,
+		bool fConvertToPrimitive = true
+	);
+
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -16,6 +16,8 @@
 
 #include "GridPatchGLL.h"
 
+#include "PolynomialInterp.h"
+
 ///////////////////////////////////////////////////////////////////////////////
 
 GridPatchGLL::GridPatchGLL(
@@ -139,3 +141,232 @@ void GridPatchGLL::InterpolateREdgeToNode(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void GridPatchGLL::InterpolateColumnREdgeToNode(
+	const double * dDataREdge,
+	int nStrideREdge,
+	double * dDataNode
+) const {
+
+	// Parent grid, containing the vertical remapping information
+	const GridGLL * pGLLGrid = dynamic_cast<const GridGLL*>(&m_grid);
+	if (pGLLGrid == NULL) {
+		_EXCEPTIONT("Logic error");
+	}
+
+	pGLLGrid->GetOpInterpREdgeToNode().Apply(
+		dDataREdge,
+		dDataNode,
+		nStrideREdge,
+		1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+
+void GridPatchGLL::ComputeInterpolationStencil(
+	InterpolationStencil & stencil
+) const {
+	const int iBegin = stencil.GetPatchPointBegin(m_ixPatch);
+	const int iEnd = stencil.GetPatchPointEnd(m_ixPatch);
+
+	if (stencil.m_dWeights.GetColumns() !=
+		m_nHorizontalOrder * m_nHorizontalOrder
+	) {
+		_EXCEPTIONT("Interpolation stencil size mismatch");
+	}
+
+	// Vector for storage interpolation coefficients
+	DataVector<double> dAInterpCoeffs;
+	dAInterpCoeffs.Initialize(m_nHorizontalOrder);
+
+	DataVector<double> dBInterpCoeffs;
+	dBInterpCoeffs.Initialize(m_nHorizontalOrder);
+
+	// Loop through all points on this patch
+	for (int i = iBegin; i < iEnd; i++) {
+
+		const double dAlpha = stencil.m_dAlpha[i];
+		const double dBeta = stencil.m_dBeta[i];
+
+		// Verify point lies within domain of patch
+		const double Eps = 1.0e-10;
+		if ((dAlpha < m_box.GetAEdge(m_box.GetAInteriorBegin()) - Eps) ||
+			(dAlpha > m_box.GetAEdge(m_box.GetAInteriorEnd()) + Eps) ||
+			(dBeta < m_box.GetBEdge(m_box.GetBInteriorBegin()) - Eps) ||
+			(dBeta > m_box.GetBEdge(m_box.GetBInteriorEnd()) + Eps)
+		) {
+			_EXCEPTIONT("Point out of range");
+		}
+
+		// Determine finite element index
+		int iA =
+			(dAlpha - m_box.GetAEdge(m_box.GetAInteriorBegin()))
+				/ GetElementDeltaA();
+
+		int iB =
+			(dBeta - m_box.GetBEdge(m_box.GetBInteriorBegin()))
+				/ GetElementDeltaB();
+
+		// Bound the index within the element
+		if (iA < 0) {
+			iA = 0;
+		}
+		if (iA >= m_nElementCountA) {
+			iA = m_nElementCountA - 1;
+		}
+		if (iB < 0) {
+			iB = 0;
+		}
+		if (iB >= m_nElementCountB) {
+			iB = m_nElementCountB - 1;
+		}
+
+		iA = m_box.GetHaloElements() + iA * m_nHorizontalOrder;
+		iB = m_box.GetHaloElements() + iB * m_nHorizontalOrder;
+
+		// Compute interpolation coefficients
+		PolynomialInterp::LagrangianPolynomialCoeffs(
+			m_nHorizontalOrder,
+			&(m_box.GetAEdges()[iA]),
+			dAInterpCoeffs,
+			dAlpha);
+
+		PolynomialInterp::LagrangianPolynomialCoeffs(
+			m_nHorizontalOrder,
+			&(m_box.GetBEdges()[iB]),
+			dBInterpCoeffs,
+			dBeta);
+
+		// Store the tensor product weights
+		stencil.m_iElementA[i] = iA;
+		stencil.m_iElementB[i] = iB;
+
+		double * dWeights = stencil.m_dWeights[i];
+		for (int m = 0; m < m_nHorizontalOrder; m++) {
+		for (int n = 0; n < m_nHorizontalOrder; n++) {
+			dWeights[m * m_nHorizontalOrder + n] =
+				dAInterpCoeffs[m] * dBInterpCoeffs[n];
+		}
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void GridPatchGLL::ApplyInterpolationStencil(
+	const InterpolationStencil & stencil,
+	DataType eDataType,
+	DataLocation eDataLocation,
+	DataMatrix3D<double> & dInterpData,
+	bool fIncludeReferenceState,
+	bool fConvertToPrimitive
+) {
+	const int iBegin = stencil.GetPatchPointBegin(m_ixPatch);
+	const int iEnd = stencil.GetPatchPointEnd(m_ixPatch);
+
+	if (iBegin == iEnd) {
+		return;
+	}
+
+	// Number of components and levels
+	int nComponents = 1;
+	int nRElements = m_grid.GetRElements();
+
+	if (eDataType == DataType_State) {
+		if (eDataLocation == DataLocation_Node) {
+			nComponents = m_datavecStateNode[0].GetComponents();
+		} else {
+			nComponents = m_datavecStateREdge[0].GetComponents();
+			nRElements = m_grid.GetRElements() + 1;
+		}
+
+	} else if (eDataType == DataType_Tracers) {
+		nComponents = m_datavecTracers[0].GetComponents();
+
+	} else if (eDataType == DataType_Topography) {
+		nRElements = 1;
+
+	} else if (
+		(eDataType != DataType_Vorticity) &&
+		(eDataType != DataType_Divergence) &&
+		(eDataType != DataType_Temperature)
+	) {
+		_EXCEPTIONT("Invalid DataType");
+	}
+
+	double ** pData2D = (double**)(m_dataTopography);
+
+	for (int c = 0; c < nComponents; c++) {
+
+		// Get a pointer to the 3D data structure
+		const double *** pData;
+		const double *** pRefData = NULL;
+
+		if (eDataType == DataType_State) {
+			if (eDataLocation == DataLocation_Node) {
+				pData = (const double ***)(m_datavecStateNode[0][c]);
+				if (!fIncludeReferenceState) {
+					pRefData = (const double ***)(m_dataRefStateNode[c]);
+				}
+			} else {
+				pData = (const double ***)(m_datavecStateREdge[0][c]);
+				if (!fIncludeReferenceState) {
+					pRefData = (const double ***)(m_dataRefStateREdge[c]);
+				}
+			}
+
+		} else if (eDataType == DataType_Tracers) {
+			pData = (const double ***)(m_datavecTracers[0][c]);
+
+		} else if (eDataType == DataType_Topography) {
+			pData = (const double ***)(&pData2D);
+
+		} else if (eDataType == DataType_Vorticity) {
+			pData = (const double ***)(double ***)(m_dataVorticity);
+
+		} else if (eDataType == DataType_Divergence) {
+			pData = (const double ***)(double ***)(m_dataDivergence);
+
+		} else {
+			pData = (const double ***)(double ***)(m_dataTemperature);
+		}
+
+		// Apply the stencil at each point on all levels
+		for (int i = iBegin; i < iEnd; i++) {
+
+			const int iA = stencil.m_iElementA[i];
+			const int iB = stencil.m_iElementB[i];
+
+			const double * dWeights = stencil.m_dWeights[i];
+
+			for (int k = 0; k < nRElements; k++) {
+
+				double dValue = 0.0;
+
+				for (int m = 0; m < m_nHorizontalOrder; m++) {
+				for (int n = 0; n < m_nHorizontalOrder; n++) {
+					dValue +=
+						  dWeights[m * m_nHorizontalOrder + n]
+						* pData[k][iA+m][iB+n];
+				}
+				}
+
+				// Do not include the reference state
+				if (pRefData != NULL) {
+					for (int m = 0; m < m_nHorizontalOrder; m++) {
+					for (int n = 0; n < m_nHorizontalOrder; n++) {
+						dValue -=
+							  dWeights[m * m_nHorizontalOrder + n]
+							* pRefData[k][iA+m][iB+n];
+					}
+					}
+				}
+
+				dInterpData[c][k][i] = dValue;
+			}
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
@@ -57,6 +57,15 @@ public:
 		int iDataIndex
 	);
 
+	///	<summary>
+	///		Interpolate a single column vertically from interfaces to nodes.
+	///	</summary>
+	virtual void InterpolateColumnREdgeToNode(
+		const double * dDataREdge,
+		int nStrideREdge,
+		double * dDataNode
+	) const;
+
 public:
 	///	<summary>
 	///		Transform vectors received from other panels to this panel's
@@ -67,6 +76,28 @@ public:
 	) {
 	}
 
+public:
+	///	<summary>
+	///		Compute interpolation weights for the points in the stencil
+	///		that lie on this patch.
+	///	</summary>
+	virtual void ComputeInterpolationStencil(
+		InterpolationStencil & stencil
+	) const;
+
+	///	<summary>
+	///		Apply a precomputed interpolation stencil to all variables and
+	///		levels on this patch.
+	///	</summary>
+	virtual void ApplyInterpolationStencil(
+		const InterpolationStencil & stencil,
+		DataType eDataType,
+		DataLocation eDataLocation,
+		DataMatrix3D<double> & dInterpData,
+		bool fIncludeReferenceState = true,
+		bool fConvertToPrimitive = false
+	);
+
 public:
 	///	<summary>
 	///		Get the number of finite elements in the alpha direction.
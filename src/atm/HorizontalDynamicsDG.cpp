@@ -22,6 +22,7 @@
 
 #include "GridGLL.h"
 #include "GridPatchGLL.h"
+#include "Profiler.h"
 
 #define DIFFERENTIAL_FORM
 
@@ -39,6 +40,44 @@ static const double ParamHypervisScaling = 3.2;
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Rows of the edge trace buffer used by the edge flux engine.
+///	</summary>
+enum EdgeTraceIndex {
+	EdgeTrace_UaL,
+	EdgeTrace_UbL,
+	EdgeTrace_HL,
+	EdgeTrace_UaR,
+	EdgeTrace_UbR,
+	EdgeTrace_HR,
+	EdgeTrace_Jacobian,
+	EdgeTrace_Zs,
+	EdgeTrace_ContraAL,
+	EdgeTrace_ContraBL,
+	EdgeTrace_ContraAR,
+	EdgeTrace_ContraBR,
+	EdgeTrace_Count
+};
+
+///	<summary>
+///		Rows of the edge flux buffer used by the edge flux engine.
+///	</summary>
+enum EdgeFluxIndex {
+	EdgeFlux_A,
+	EdgeFlux_H,
+	EdgeFlux_HL,
+	EdgeFlux_HR,
+	EdgeFlux_UaL,
+	EdgeFlux_UbL,
+	EdgeFlux_UaR,
+	EdgeFlux_UbR,
+	EdgeFlux_UaF,
+	EdgeFlux_UbF,
+	EdgeFlux_Count
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 HorizontalDynamicsDG::HorizontalDynamicsDG(
 	Model & model,
 	int nHorizontalOrder,
@@ -53,6 +92,30 @@ HorizontalDynamicsDG::HorizontalDynamicsDG(
 		dNuDiv,
 		dNuVort)
 {
+	// Number of nodes along the perimeter of a finite element
+	int nPerimeterNodes = m_nHorizontalOrder * m_nHorizontalOrder;
+	if (m_nHorizontalOrder > 2) {
+		nPerimeterNodes -= (m_nHorizontalOrder-2) * (m_nHorizontalOrder-2);
+	}
+
+	m_vecPerimeterNodeI.Initialize(nPerimeterNodes);
+	m_vecPerimeterNodeJ.Initialize(nPerimeterNodes);
+
+	// Perimeter nodes in the order they are visited by the boundary passes
+	int ix = 0;
+	for (int i = 0; i < m_nHorizontalOrder; i++) {
+	for (int j = 0; j < m_nHorizontalOrder; j++) {
+		if ((i != 0) && (i != m_nHorizontalOrder-1) &&
+			(j != 0) && (j != m_nHorizontalOrder-1)
+		) {
+			continue;
+		}
+
+		m_vecPerimeterNodeI[ix] = i;
+		m_vecPerimeterNodeJ[ix] = j;
+		ix++;
+	}
+	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -305,6 +368,99 @@ void HorizontalDynamicsDG::StepShallowWater(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void HorizontalDynamicsDG::EvaluateEdgeFluxesShallowWater(
+	int nTracePoints,
+	bool fAlphaEdges,
+	double dG,
+	double dEarthRadius
+) {
+	// Left and right traces
+	const double * const dUaL = m_dEdgeTraces[EdgeTrace_UaL];
+	const double * const dUbL = m_dEdgeTraces[EdgeTrace_UbL];
+	const double * const dHL  = m_dEdgeTraces[EdgeTrace_HL];
+
+	const double * const dUaR = m_dEdgeTraces[EdgeTrace_UaR];
+	const double * const dUbR = m_dEdgeTraces[EdgeTrace_UbR];
+	const double * const dHR  = m_dEdgeTraces[EdgeTrace_HR];
+
+	const double * const dPtJacobian = m_dEdgeTraces[EdgeTrace_Jacobian];
+	const double * const dZs         = m_dEdgeTraces[EdgeTrace_Zs];
+
+	const double * const dContraAL = m_dEdgeTraces[EdgeTrace_ContraAL];
+	const double * const dContraBL = m_dEdgeTraces[EdgeTrace_ContraBL];
+	const double * const dContraAR = m_dEdgeTraces[EdgeTrace_ContraAR];
+	const double * const dContraBR = m_dEdgeTraces[EdgeTrace_ContraBR];
+
+	// Velocity normal to the edge
+	const double * const dUnL = (fAlphaEdges)?(dUaL):(dUbL);
+	const double * const dUnR = (fAlphaEdges)?(dUaR):(dUbR);
+
+	// Flux corrections
+	double * const dHF = m_dEdgeFluxes[EdgeFlux_H];
+	double * const dHCorrL = m_dEdgeFluxes[EdgeFlux_HL];
+	double * const dHCorrR = m_dEdgeFluxes[EdgeFlux_HR];
+
+	double * const dUaCorrL = m_dEdgeFluxes[EdgeFlux_UaL];
+	double * const dUbCorrL = m_dEdgeFluxes[EdgeFlux_UbL];
+	double * const dUaCorrR = m_dEdgeFluxes[EdgeFlux_UaR];
+	double * const dUbCorrR = m_dEdgeFluxes[EdgeFlux_UbR];
+
+	double * const dUaF = m_dEdgeFluxes[EdgeFlux_UaF];
+	double * const dUbF = m_dEdgeFluxes[EdgeFlux_UbF];
+
+	// Upwinding coefficient (kept in its own loop since sqrt may set errno)
+	double * const dA = m_dEdgeFluxes[EdgeFlux_A];
+
+	for (int n = 0; n < nTracePoints; n++) {
+		dA[n] = fabs(0.5 * (dUnL[n] + dUnR[n]))
+			+ sqrt(dG * 0.5 * (dHL[n] + dHR[n]))
+				/ dEarthRadius;
+	}
+
+	// Branch-free loop over all trace points; trace and flux buffers never
+	// overlap, which allows this loop to be vectorized
+#pragma GCC ivdep
+	for (int n = 0; n < nTracePoints; n++) {
+
+		// Calculate pointwise height flux
+		const double dHFL = (dHL[n] - dZs[n]) * dUnL[n] * dPtJacobian[n];
+		const double dHFR = (dHR[n] - dZs[n]) * dUnR[n] * dPtJacobian[n];
+
+		double dHFn = 0.5 * (dHFL + dHFR);
+
+		// Nodal velocities and pressure
+		const double dUa = 0.5 * (dUaL[n] + dUaR[n]);
+		const double dUb = 0.5 * (dUbL[n] + dUbR[n]);
+
+		const double dPL = dG * dHL[n];
+		const double dPR = dG * dHR[n];
+		const double dP  = 0.5 * (dPL + dPR);
+
+		double dUaFn = 0.0;
+		double dUbFn = 0.0;
+
+#ifdef PENALIZE_DISCONTINUITY
+		dHFn -= 0.5 * dA[n] * dPtJacobian[n] * (dHR[n] - dHL[n]);
+		dUaFn = - 0.5 * dA[n] * (dUaR[n] - dUaL[n]);
+		dUbFn = - 0.5 * dA[n] * (dUbR[n] - dUbL[n]);
+#endif
+
+		dHF[n] = dHFn;
+		dHCorrL[n] = dHFn - dHFL;
+		dHCorrR[n] = dHFn - dHFR;
+
+		dUaCorrL[n] = dUnL[n] * (dUa - dUaL[n]) + dContraAL[n] * (dP - dPL);
+		dUbCorrL[n] = dUnL[n] * (dUb - dUbL[n]) + dContraBL[n] * (dP - dPL);
+		dUaCorrR[n] = dUnR[n] * (dUa - dUaR[n]) + dContraAR[n] * (dP - dPR);
+		dUbCorrR[n] = dUnR[n] * (dUb - dUbR[n]) + dContraBR[n] * (dP - dPR);
+
+		dUaF[n] = dUaFn;
+		dUbF[n] = dUbFn;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void HorizontalDynamicsDG::ElementFluxesShallowWater(
 	int iDataInitial,
 	int iDataUpdate,
@@ -325,6 +481,9 @@ void HorizontalDynamicsDG::ElementFluxesShallowWater(
 	// Perform a global exchange
 	pGrid->Exchange(DataType_State, iDataInitial);
 
+	// Number of radial elements
+	const int nRElements = pGrid->GetRElements();
+
 	// Perform local update
 	for (int n = 0; n < pGrid->GetActivePatchCount(); n++) {
 		GridPatchGLL * pPatch =
@@ -354,138 +513,143 @@ void HorizontalDynamicsDG::ElementFluxesShallowWater(
 		const double dElementDeltaA = pPatch->GetElementDeltaA();
 		const double dElementDeltaB = pPatch->GetElementDeltaB();
 
-		// Time over grid spacing ratio
-		double dCourantA = dDeltaT / dElementDeltaA;
-		double dCourantB = dDeltaT / dElementDeltaB;
-
 		// Get number of finite elements in each coordinate direction
 		int nElementCountA = pPatch->GetElementCountA();
 		int nElementCountB = pPatch->GetElementCountB();
 
+		// Number of nodes along each edge
+		const int nEdgeNodesA =
+			box.GetAInteriorEnd() - box.GetAInteriorBegin();
+		const int nEdgeNodesB =
+			box.GetBInteriorEnd() - box.GetBInteriorBegin();
+
+		// Number of trace points in each direction
+		const int nTracePointsA =
+			nRElements * (nElementCountA + 1) * nEdgeNodesB;
+		const int nTracePointsB =
+			nRElements * (nElementCountB + 1) * nEdgeNodesA;
+
+		// Allocate trace buffers (retained across patches and steps)
+		int nMaxTracePoints = nTracePointsA;
+		if (nTracePointsB > nMaxTracePoints) {
+			nMaxTracePoints = nTracePointsB;
+		}
+		if ((int)(m_dEdgeTraces.GetColumns()) < nMaxTracePoints) {
+			m_dEdgeTraces.Initialize(EdgeTrace_Count, nMaxTracePoints);
+			m_dEdgeFluxes.Initialize(EdgeFlux_Count, nMaxTracePoints);
+		}
+
+		double ** const dTrace = m_dEdgeTraces;
+		double ** const dFlux = m_dEdgeFluxes;
+
 		// Post-process velocities received during exchange
 		pPatch->TransformHaloVelocities(iDataInitial);
-/*
-		// Flux reconstruction update coefficient
-		double dUpdateDeriv =
-			  dDeltaT
-			* dFluxDeriv1D[m_nHorizontalOrder-1]
-			/ dElementDeltaA;
-*/
-		// Loop over edges of constant alpha
-		for (int k = 0; k < pGrid->GetRElements(); k++) {
+
+		// Gather traces along edges of constant alpha
+		int ix = 0;
+		for (int k = 0; k < nRElements; k++) {
 		for (int a = 0; a <= nElementCountA; a++) {
 
 			int i = box.GetAInteriorBegin() + a * m_nHorizontalOrder;
-			int j = box.GetBInteriorBegin();
-			for (; j < box.GetBInteriorEnd(); j++) {
-
-				double dUaL = dataInitialNode[UIx][k][i-1][j];
-				double dUbL = dataInitialNode[VIx][k][i-1][j];
-				double dHL  = dataInitialNode[HIx][k][i-1][j];
-
-				double dUaR = dataInitialNode[UIx][k][i][j];
-				double dUbR = dataInitialNode[VIx][k][i][j];
-				double dHR  = dataInitialNode[HIx][k][i][j];
-
-				// Calculate pointwise height flux
-				double dPtJacobian;
-				double dZs;
-				if (a == nElementCountA) {
-					dPtJacobian = dJacobian[k][i-1][j];
-					dZs         = dTopography[i-1][j];
-				} else {
-					dPtJacobian = dJacobian[k][i][j];
-					dZs         = dTopography[i][j];
-				}
-
-				double dHFL = (dHL - dZs) * dUaL * dPtJacobian;
-				double dHFR = (dHR - dZs) * dUaR * dPtJacobian;
-
-				double dHF = 0.5 * (dHFL + dHFR);
 
-				// Nodal velocities and pressure
-				double dUa = 0.5 * (dUaL + dUaR);
-				double dUb = 0.5 * (dUbL + dUbR);
+			// Geometric quantities are taken from the right element, except
+			// along the last edge of the patch
+			int iG = (a == nElementCountA)?(i-1):(i);
 
-				double dPL = phys.GetG() * dHL;
-				double dPR = phys.GetG() * dHR;
-				double dP  = 0.5 * (dPL + dPR);
+			int j = box.GetBInteriorBegin();
+			for (; j < box.GetBInteriorEnd(); j++, ix++) {
+				dTrace[EdgeTrace_UaL][ix] = dataInitialNode[UIx][k][i-1][j];
+				dTrace[EdgeTrace_UbL][ix] = dataInitialNode[VIx][k][i-1][j];
+				dTrace[EdgeTrace_HL ][ix] = dataInitialNode[HIx][k][i-1][j];
+
+				dTrace[EdgeTrace_UaR][ix] = dataInitialNode[UIx][k][i][j];
+				dTrace[EdgeTrace_UbR][ix] = dataInitialNode[VIx][k][i][j];
+				dTrace[EdgeTrace_HR ][ix] = dataInitialNode[HIx][k][i][j];
+
+				dTrace[EdgeTrace_Jacobian][ix] = dJacobian[k][iG][j];
+				dTrace[EdgeTrace_Zs      ][ix] = dTopography[iG][j];
+
+				dTrace[EdgeTrace_ContraAL][ix] = dContraMetricA[k][i-1][j][0];
+				dTrace[EdgeTrace_ContraBL][ix] = dContraMetricB[k][i-1][j][0];
+				dTrace[EdgeTrace_ContraAR][ix] = dContraMetricA[k][i][j][0];
+				dTrace[EdgeTrace_ContraBR][ix] = dContraMetricB[k][i][j][0];
+			}
+		}
+		}
 
-				// Upwinding
-				double dA = fabs(dUa)
-					+ sqrt(phys.GetG() * 0.5 * (dHL + dHR))
-						/ phys.GetEarthRadius();
+		// Evaluate fluxes along edges of constant alpha
+		EvaluateEdgeFluxesShallowWater(
+			nTracePointsA, true, phys.GetG(), phys.GetEarthRadius());
 
-				double dUaF = 0.0;
-				double dUbF = 0.0;
+		// Scatter corrections along edges of constant alpha
+		ix = 0;
+		for (int k = 0; k < nRElements; k++) {
+		for (int a = 0; a <= nElementCountA; a++, ix += nEdgeNodesB) {
 
-#ifdef PENALIZE_DISCONTINUITY
-				dHF -= 0.5 * dA * dPtJacobian * (dHR - dHL);
-				dUaF = - 0.5 * dA * (dUaR - dUaL);
-				dUbF = - 0.5 * dA * (dUbR - dUbL);
-#endif
+			int i = box.GetAInteriorBegin() + a * m_nHorizontalOrder;
+			int jBegin = box.GetBInteriorBegin();
 
 #ifndef DIFFERENTIAL_FORM
-				// Update the height field
-				dataUpdateNode[HIx][k][i-1][j] +=
+			// Update the height field
+			for (int j = 0; j < nEdgeNodesB; j++) {
+				double dHF = dFlux[EdgeFlux_H][ix+j];
+				double dPtJacobian = dTrace[EdgeTrace_Jacobian][ix+j];
+
+				dataUpdateNode[HIx][k][i-1][jBegin+j] +=
 					- dDeltaT
 					/ dGLLWeights1D[m_nHorizontalOrder-1]
 					/ dElementDeltaA
 					* dHF / dPtJacobian;
 
-				dataUpdateNode[HIx][k][i][j] +=
+				dataUpdateNode[HIx][k][i][jBegin+j] +=
 					+ dDeltaT
 					/ dGLLWeights1D[m_nHorizontalOrder-1]
 					/ dElementDeltaA
 					* dHF / dPtJacobian;
+			}
 #endif
 
-				for (int s = 0; s < m_nHorizontalOrder; s++) {
-					double dUpdateDeriv =
-						  dDeltaT
-						* dFluxDeriv1D[m_nHorizontalOrder - 1 - s]
-						/ dElementDeltaA;
-
-					// Calculate modified derivatives in alpha
-					if (a != 0) {
-#ifdef DIFFERENTIAL_FORM 
-						dataUpdateNode[HIx][k][i-1-s][j] +=
-							- dUpdateDeriv * (dHF - dHFL)
-							/ dJacobian[k][i-1-s][j];
+			for (int s = 0; s < m_nHorizontalOrder; s++) {
+				double dUpdateDeriv =
+					  dDeltaT
+					* dFluxDeriv1D[m_nHorizontalOrder - 1 - s]
+					/ dElementDeltaA;
+
+				// Calculate modified derivatives in alpha
+				if (a != 0) {
+					for (int j = 0; j < nEdgeNodesB; j++) {
+#ifdef DIFFERENTIAL_FORM
+						dataUpdateNode[HIx][k][i-1-s][jBegin+j] +=
+							- dUpdateDeriv * dFlux[EdgeFlux_HL][ix+j]
+							/ dJacobian[k][i-1-s][jBegin+j];
 #endif
 #ifndef ADVECTION_ONLY
-						dataUpdateNode[UIx][k][i-1-s][j] +=
-							- dUpdateDeriv * (
-								dUaL * (dUa - dUaL)
-								+ dContraMetricA[k][i-1][j][0] * (dP - dPL))
-							- dUpdateDeriv * dUaF;
-
-						dataUpdateNode[VIx][k][i-1-s][j] +=
-							- dUpdateDeriv * (
-								dUaL * (dUb - dUbL)
-								+ dContraMetricB[k][i-1][j][0] * (dP - dPL))
-							- dUpdateDeriv * dUbF;
+						dataUpdateNode[UIx][k][i-1-s][jBegin+j] +=
+							- dUpdateDeriv * dFlux[EdgeFlux_UaL][ix+j]
+							- dUpdateDeriv * dFlux[EdgeFlux_UaF][ix+j];
+
+						dataUpdateNode[VIx][k][i-1-s][jBegin+j] +=
+							- dUpdateDeriv * dFlux[EdgeFlux_UbL][ix+j]
+							- dUpdateDeriv * dFlux[EdgeFlux_UbF][ix+j];
 #endif
 					}
+				}
 
-					if (a != nElementCountA) {
+				if (a != nElementCountA) {
+					for (int j = 0; j < nEdgeNodesB; j++) {
 #ifdef DIFFERENTIAL_FORM
-						dataUpdateNode[HIx][k][i+s][j] +=
-							+ dUpdateDeriv * (dHF - dHFR)
-							/ dJacobian[k][i+s][j];
+						dataUpdateNode[HIx][k][i+s][jBegin+j] +=
+							+ dUpdateDeriv * dFlux[EdgeFlux_HR][ix+j]
+							/ dJacobian[k][i+s][jBegin+j];
 #endif
 #ifndef ADVECTION_ONLY
-						dataUpdateNode[UIx][k][i+s][j] +=
-							+ dUpdateDeriv * (
-								dUaR * (dUa - dUaR)
-								+ dContraMetricA[k][i][j][0] * (dP - dPR))
-							+ dUpdateDeriv * dUaF;
-
-						dataUpdateNode[VIx][k][i+s][j] +=
-							+ dUpdateDeriv * (
-								dUaR * (dUb - dUbR)
-								+ dContraMetricB[k][i][j][0] * (dP - dPR))
-							+ dUpdateDeriv * dUbF;
+						dataUpdateNode[UIx][k][i+s][jBegin+j] +=
+							+ dUpdateDeriv * dFlux[EdgeFlux_UaR][ix+j]
+							+ dUpdateDeriv * dFlux[EdgeFlux_UaF][ix+j];
+
+						dataUpdateNode[VIx][k][i+s][jBegin+j] +=
+							+ dUpdateDeriv * dFlux[EdgeFlux_UbR][ix+j]
+							+ dUpdateDeriv * dFlux[EdgeFlux_UbF][ix+j];
 #endif
 					}
 				}
@@ -493,69 +657,70 @@ void HorizontalDynamicsDG::ElementFluxesShallowWater(
 		}
 		}
 
-		// Loop over edges of constant beta
-		for (int k = 0; k < pGrid->GetRElements(); k++) {
+		// Gather traces along edges of constant beta
+		ix = 0;
+		for (int k = 0; k < nRElements; k++) {
 		for (int b = 0; b <= nElementCountB; b++) {
 
-			int i = box.GetAInteriorBegin();
 			int j = box.GetBInteriorBegin() + b * m_nHorizontalOrder;
-			for (; i < box.GetAInteriorEnd(); i++) {
-
-				double dUaL = dataInitialNode[UIx][k][i][j-1];
-				double dUbL = dataInitialNode[VIx][k][i][j-1];
-				double dHL  = dataInitialNode[HIx][k][i][j-1];
-
-				double dUaR = dataInitialNode[UIx][k][i][j];
-				double dUbR = dataInitialNode[VIx][k][i][j];
-				double dHR  = dataInitialNode[HIx][k][i][j];
-
-				// Calculate pointwise height flux
-				double dPtJacobian;
-				double dZs;
-				if (b == nElementCountB) {
-					dPtJacobian = dJacobian[k][i][j-1];
-					dZs = dTopography[i][j-1];
-				} else {
-					dPtJacobian = dJacobian[k][i][j];
-					dZs = dTopography[i][j];
-				}
 
-				double dHFL = (dHL - dZs) * dUbL * dPtJacobian;
-				double dHFR = (dHR - dZs) * dUbR * dPtJacobian;
+			// Geometric quantities are taken from the right element, except
+			// along the last edge of the patch
+			int jG = (b == nElementCountB)?(j-1):(j);
+
+			int i = box.GetAInteriorBegin();
+			for (; i < box.GetAInteriorEnd(); i++, ix++) {
+				dTrace[EdgeTrace_UaL][ix] = dataInitialNode[UIx][k][i][j-1];
+				dTrace[EdgeTrace_UbL][ix] = dataInitialNode[VIx][k][i][j-1];
+				dTrace[EdgeTrace_HL ][ix] = dataInitialNode[HIx][k][i][j-1];
+
+				dTrace[EdgeTrace_UaR][ix] = dataInitialNode[UIx][k][i][j];
+				dTrace[EdgeTrace_UbR][ix] = dataInitialNode[VIx][k][i][j];
+				dTrace[EdgeTrace_HR ][ix] = dataInitialNode[HIx][k][i][j];
+
+				dTrace[EdgeTrace_Jacobian][ix] = dJacobian[k][i][jG];
+				dTrace[EdgeTrace_Zs      ][ix] = dTopography[i][jG];
+
+				dTrace[EdgeTrace_ContraAL][ix] = dContraMetricA[k][i][j-1][1];
+				dTrace[EdgeTrace_ContraBL][ix] = dContraMetricB[k][i][j-1][1];
+				dTrace[EdgeTrace_ContraAR][ix] = dContraMetricA[k][i][j][1];
+				dTrace[EdgeTrace_ContraBR][ix] = dContraMetricB[k][i][j][1];
+			}
+		}
+		}
 
-				double dHF = 0.5 * (dHFL + dHFR);
+		// Evaluate fluxes along edges of constant beta
+		EvaluateEdgeFluxesShallowWater(
+			nTracePointsB, false, phys.GetG(), phys.GetEarthRadius());
 
-				// Nodal velocities and pressure
-				double dUa = 0.5 * (dUaL + dUaR);
-				double dUb = 0.5 * (dUbL + dUbR);
+		// Scatter corrections along edges of constant beta
+		ix = 0;
+		for (int k = 0; k < nRElements; k++) {
+		for (int b = 0; b <= nElementCountB; b++, ix += nEdgeNodesA) {
 
-				double dPL = phys.GetG() * dHL;
-				double dPR = phys.GetG() * dHR;
-				double dP  = 0.5 * (dPL + dPR);
+			int j = box.GetBInteriorBegin() + b * m_nHorizontalOrder;
+			int iBegin = box.GetAInteriorBegin();
 
-				// Upwinding
-				double dA = fabs(dUb)
-					+ sqrt(phys.GetG() * 0.5 * (dHL + dHR))
-						/ phys.GetEarthRadius();
+			for (int i = 0; i < nEdgeNodesA; i++) {
 
-				double dUaF = 0.0;
-				double dUbF = 0.0;
+				double * const dUpdateUa = dataUpdateNode[UIx][k][iBegin+i];
+				double * const dUpdateUb = dataUpdateNode[VIx][k][iBegin+i];
+				double * const dUpdateH  = dataUpdateNode[HIx][k][iBegin+i];
 
-#ifdef PENALIZE_DISCONTINUITY
-				dHF -= 0.5 * dA * dPtJacobian * (dHR - dHL);
-				dUaF = - 0.5 * dA * (dUaR - dUaL);
-				dUbF = - 0.5 * dA * (dUbR - dUbL);
-#endif
+				const double * const dPtJacobianRow = dJacobian[k][iBegin+i];
 
 #ifndef DIFFERENTIAL_FORM
 				// Update the height field
-				dataUpdateNode[HIx][k][i][j-1] +=
+				double dHF = dFlux[EdgeFlux_H][ix+i];
+				double dPtJacobian = dTrace[EdgeTrace_Jacobian][ix+i];
+
+				dUpdateH[j-1] +=
 					- dDeltaT
 					/ dGLLWeights1D[m_nHorizontalOrder-1]
 					/ dElementDeltaA
 					* dHF / dPtJacobian;
 
-				dataUpdateNode[HIx][k][i][j] +=
+				dUpdateH[j] +=
 					+ dDeltaT
 					/ dGLLWeights1D[m_nHorizontalOrder-1]
 					/ dElementDeltaA
@@ -570,44 +735,36 @@ void HorizontalDynamicsDG::ElementFluxesShallowWater(
 
 					// Calculate modified derivatives in beta
 					if (b != 0) {
-#ifdef DIFFERENTIAL_FORM 
-						dataUpdateNode[HIx][k][i][j-1-s] +=
-							- dUpdateDeriv * (dHF - dHFL)
-							/ dJacobian[k][i][j-1-s];
+#ifdef DIFFERENTIAL_FORM
+						dUpdateH[j-1-s] +=
+							- dUpdateDeriv * dFlux[EdgeFlux_HL][ix+i]
+							/ dPtJacobianRow[j-1-s];
 #endif
 #ifndef ADVECTION_ONLY
-						dataUpdateNode[UIx][k][i][j-1-s] +=
-							- dUpdateDeriv * (
-								dUbL * (dUa - dUaL)
-							 	+ dContraMetricA[k][i][j-1][1] * (dP - dPL))
-							- dUpdateDeriv * dUaF;
-
-						dataUpdateNode[VIx][k][i][j-1-s] +=
-							- dUpdateDeriv * (
-								dUbL * (dUb - dUbL)
-								+ dContraMetricB[k][i][j-1][1] * (dP - dPL))
-							- dUpdateDeriv * dUbF;
+						dUpdateUa[j-1-s] +=
+							- dUpdateDeriv * dFlux[EdgeFlux_UaL][ix+i]
+							- dUpdateDeriv * dFlux[EdgeFlux_UaF][ix+i];
+
+						dUpdateUb[j-1-s] +=
+							- dUpdateDeriv * dFlux[EdgeFlux_UbL][ix+i]
+							- dUpdateDeriv * dFlux[EdgeFlux_UbF][ix+i];
 #endif
 					}
 
 					if (b != nElementCountB) {
 #ifdef DIFFERENTIAL_FORM
-						dataUpdateNode[HIx][k][i][j+s] +=
-							+ dUpdateDeriv * (dHF - dHFR)
-							/ dJacobian[k][i][j+s];
+						dUpdateH[j+s] +=
+							+ dUpdateDeriv * dFlux[EdgeFlux_HR][ix+i]
+							/ dPtJacobianRow[j+s];
 #endif
 #ifndef ADVECTION_ONLY
-						dataUpdateNode[UIx][k][i][j+s] +=
-							+ dUpdateDeriv * (
-								dUbR * (dUa - dUaR)
-								+ dContraMetricA[k][i][j][1] * (dP - dPR))
-							+ dUpdateDeriv * dUaF;
-
-						dataUpdateNode[VIx][k][i][j+s] +=
-							+ dUpdateDeriv * (
-								dUbR * (dUb - dUbR)
-							 	+ dContraMetricB[k][i][j][1] * (dP - dPR))
-							+ dUpdateDeriv * dUbF;
+						dUpdateUa[j+s] +=
+							+ dUpdateDeriv * dFlux[EdgeFlux_UaR][ix+i]
+							+ dUpdateDeriv * dFlux[EdgeFlux_UaF][ix+i];
+
+						dUpdateUb[j+s] +=
+							+ dUpdateDeriv * dFlux[EdgeFlux_UbR][ix+i]
+							+ dUpdateDeriv * dFlux[EdgeFlux_UbF][ix+i];
 #endif
 					}
 				}
@@ -1088,6 +1245,8 @@ void HorizontalDynamicsDG::StepExplicit(
 	const Time & time,
 	double dDeltaT
 ) {
+	ProfilerRegion region("HorizontalDynamics");
+
 	if (iDataInitial == iDataUpdate) {
 		_EXCEPTIONT(
 			"HorizontalDynamics Step must have iDataInitial != iDataUpdate");
@@ -1120,16 +1279,58 @@ void HorizontalDynamicsDG::InitializeApplyHyperdiffusionToBoundary(
 	// Get a copy of the GLL grid
 	GridGLL * pGrid = dynamic_cast<GridGLL*>(m_model.GetGrid());
 
-	// Perform exchange
-	pGrid->Exchange(DataType_State, iDataInitial);
+	// Begin exchange; completed by WaitApplyHyperdiffusionToBoundary
+	pGrid->BeginExchange(DataType_State, iDataInitial);
+}
 
-	// Transform halo velocities
-	for (int n = 0; n < pGrid->GetActivePatchCount(); n++) {
-		GridPatchGLL * pPatch =
-			dynamic_cast<GridPatchGLL*>(pGrid->GetActivePatch(n));
+///////////////////////////////////////////////////////////////////////////////
 
-		pPatch->TransformHaloVelocities(iDataInitial);
+///	<summary>
+///		ExchangeListener which transforms halo velocities of each patch as
+///		soon as its halo data has been received.
+///	</summary>
+class TransformHaloVelocitiesListener : public ExchangeListener {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	TransformHaloVelocitiesListener(
+		int iDataIndex
+	) :
+		m_iDataIndex(iDataIndex)
+	{ }
+
+public:
+	///	<summary>
+	///		Transform halo velocities on the patch.
+	///	</summary>
+	virtual void OnPatchReceived(
+		GridPatch * pPatch
+	) {
+		dynamic_cast<GridPatchGLL*>(pPatch)->
+			TransformHaloVelocities(m_iDataIndex);
 	}
+
+private:
+	///	<summary>
+	///		Data index being exchanged.
+	///	</summary>
+	int m_iDataIndex;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+void HorizontalDynamicsDG::WaitApplyHyperdiffusionToBoundary(
+	int iDataInitial
+) {
+	// Get a copy of the GLL grid
+	GridGLL * pGrid = dynamic_cast<GridGLL*>(m_model.GetGrid());
+
+	// Complete exchange and transform halo velocities
+	TransformHaloVelocitiesListener listener(iDataInitial);
+
+	pGrid->EndExchange(DataType_State, iDataInitial, &listener);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1229,25 +1430,20 @@ void HorizontalDynamicsDG::ApplyScalarHyperdiffusionToBoundary(
 			for (int a = 0; a < nElementCountA; a++) {
 			for (int b = 0; b < nElementCountB; b++) {
 
-				// Pointwise update of scalar quantities
-				for (int i = 0; i < m_nHorizontalOrder; i++) {
-				for (int j = 0; j < m_nHorizontalOrder; j++) {
+				int iElementA =
+					a * m_nHorizontalOrder + box.GetHaloElements();
+				int iElementB =
+					b * m_nHorizontalOrder + box.GetHaloElements();
 
-					// Only perform computation on perimeter elements
-					if ((i != 0) && (i != m_nHorizontalOrder-1) &&
-						(j != 0) && (j != m_nHorizontalOrder-1)
-					) {
-						continue;
-					}
+				// Pointwise update of scalar quantities on perimeter nodes
+				for (int p = 0; p < m_vecPerimeterNodeI.GetRows(); p++) {
 
-					// Local indices
-					int iA = a * m_nHorizontalOrder + i + box.GetHaloElements();
-					int iB = b * m_nHorizontalOrder + j + box.GetHaloElements();
+					int i = m_vecPerimeterNodeI[p];
+					int j = m_vecPerimeterNodeJ[p];
 
-					int iElementA =
-						a * m_nHorizontalOrder + box.GetHaloElements();
-					int iElementB =
-						b * m_nHorizontalOrder + box.GetHaloElements();
+					// Local indices
+					int iA = iElementA + i;
+					int iB = iElementB + j;
 
 					// Calculate local derivatives
 					double dDaPsi = 0.0;
@@ -1366,7 +1562,6 @@ void HorizontalDynamicsDG::ApplyScalarHyperdiffusionToBoundary(
 						pDataUpdate[k][iA][iB] -= dUpdateB;
 					}
 				}
-				}
 			}
 			}
 			}
@@ -1483,25 +1678,20 @@ void HorizontalDynamicsDG::ApplyVectorHyperdiffusionToBoundary(
 		for (int a = 0; a < nElementCountA; a++) {
 		for (int b = 0; b < nElementCountB; b++) {
 
-			// Pointwise update of scalar quantities
-			for (int i = 0; i < m_nHorizontalOrder; i++) {
-			for (int j = 0; j < m_nHorizontalOrder; j++) {
+			int iElementA =
+				a * m_nHorizontalOrder + box.GetHaloElements();
+			int iElementB =
+				b * m_nHorizontalOrder + box.GetHaloElements();
 
-				// Only perform computation on perimeter elements
-				if ((i != 0) && (i != m_nHorizontalOrder-1) &&
-					(j != 0) && (j != m_nHorizontalOrder-1)
-				) {
-					continue;
-				}
+			// Pointwise update of vector quantities on perimeter nodes
+			for (int p = 0; p < m_vecPerimeterNodeI.GetRows(); p++) {
 
-				// Local indices
-				int iA = a * m_nHorizontalOrder + i + box.GetHaloElements();
-				int iB = b * m_nHorizontalOrder + j + box.GetHaloElements();
+				int i = m_vecPerimeterNodeI[p];
+				int j = m_vecPerimeterNodeJ[p];
 
-				int iElementA =
-					a * m_nHorizontalOrder + box.GetHaloElements();
-				int iElementB =
-					b * m_nHorizontalOrder + box.GetHaloElements();
+				// Local indices
+				int iA = iElementA + i;
+				int iB = iElementB + j;
 
 				// Calculate update due to divergence of velocity field
 				double dDivUpdateAA =
@@ -1621,7 +1811,6 @@ void HorizontalDynamicsDG::ApplyVectorHyperdiffusionToBoundary(
 					dataUpdateV[k][iA][iB] -= dUpdateV;
 				}
 			}
-			}
 		}
 		}
 		}
@@ -1757,6 +1946,7 @@ void HorizontalDynamicsDG::StepAfterSubCycle(
 	const Time & time,
 	double dDeltaT
 ) {
+	ProfilerRegion region("Hyperdiffusion");
 
 	// Check indices
 	if (iDataInitial == iDataWorking) {
@@ -1782,8 +1972,12 @@ void HorizontalDynamicsDG::StepAfterSubCycle(
 
 		InitializeApplyHyperdiffusionToBoundary(iDataInitial);
 
+		// Element-local scalar hyperdiffusion overlaps the halo exchange
 		ApplyScalarHyperdiffusion(
 			iDataInitial, iDataWorking, 1.0, 1.0, false);
+
+		WaitApplyHyperdiffusionToBoundary(iDataInitial);
+
 		ApplyVectorHyperdiffusion(
 			iDataInitial, iDataWorking, 1.0, 1.0, 1.0, false);
 
@@ -1799,8 +1993,12 @@ void HorizontalDynamicsDG::StepAfterSubCycle(
 
 		InitializeApplyHyperdiffusionToBoundary(iDataWorking);
 
+		// Element-local scalar hyperdiffusion overlaps the halo exchange
 		ApplyScalarHyperdiffusion(
 			iDataWorking, iDataUpdate, -dDeltaT, m_dNuScalar, true);
+
+		WaitApplyHyperdiffusionToBoundary(iDataWorking);
+
 		ApplyVectorHyperdiffusion(
 			iDataWorking, iDataUpdate, -dDeltaT, m_dNuDiv, m_dNuVort, true);
 
@@ -67,6 +67,18 @@ public:
 		double dDeltaT
 	);
 
+	///	<summary>
+	///		Evaluate shallow water fluxes at all trace points stored in
+	///		m_dEdgeTraces and store the resulting corrections in
+	///		m_dEdgeFluxes.
+	///	</summary>
+	void EvaluateEdgeFluxesShallowWater(
+		int nTracePoints,
+		bool fAlphaEdges,
+		double dG,
+		double dEarthRadius
+	);
+
 	///	<summary>
 	///		Perform one Forward Euler step for the element fluxes of the
 	///		shallow water equations.
@@ -102,12 +114,22 @@ public:
 
 protected:
 	///	<summary>
-	///		Initialize the application of hyperdiffusion to the boundary.
+	///		Initialize the application of hyperdiffusion to the boundary by
+	///		beginning the halo exchange.  Work which does not depend on halo
+	///		data may be performed before WaitApplyHyperdiffusionToBoundary.
 	///	</summary>
 	void InitializeApplyHyperdiffusionToBoundary(
 		int iDataInitial
 	);
 
+	///	<summary>
+	///		Complete the halo exchange begun by
+	///		InitializeApplyHyperdiffusionToBoundary.
+	///	</summary>
+	void WaitApplyHyperdiffusionToBoundary(
+		int iDataInitial
+	);
+
 	///	<summary>
 	///		Apply the scalar Laplacian operator across element boundaries.
 	///	</summary>
@@ -150,6 +172,25 @@ public:
 		const Time & time,
 		double dDeltaT
 	);
+
+protected:
+	///	<summary>
+	///		Local alpha and beta indices of the nodes along the perimeter of
+	///		a finite element, in the order visited by the boundary passes.
+	///	</summary>
+	DataVector<int> m_vecPerimeterNodeI;
+	DataVector<int> m_vecPerimeterNodeJ;
+
+	///	<summary>
+	///		Left and right traces gathered along element edges, stored
+	///		contiguously for all levels and edges of a patch.
+	///	</summary>
+	DataMatrix<double> m_dEdgeTraces;
+
+	///	<summary>
+	///		Flux corrections evaluated at each edge trace point.
+	///	</summary>
+	DataMatrix<double> m_dEdgeFluxes;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -21,6 +21,7 @@
 #include "Grid.h"
 
 #include "Announce.h"
+#include "Profiler.h"
 #include "GridGLL.h"
 #include "GridPatchGLL.h"
 
@@ -1303,6 +1304,8 @@ void HorizontalDynamicsFEM::StepExplicit(
 	const Time & time,
 	double dDeltaT
 ) {
+	ProfilerRegion region("HorizontalDynamics");
+
 	if (iDataInitial == iDataUpdate) {
 		_EXCEPTIONT(
 			"HorizontalDynamics Step must have iDataInitial != iDataUpdate");
@@ -1654,6 +1657,38 @@ void HorizontalDynamicsFEM::ApplyVectorHyperdiffusion(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Apply backwards Euler Rayleigh friction to a single component along
+///		runs of nodes with nonzero Rayleigh friction strength.
+///	</summary>
+static void ApplyRayleighFrictionToRuns(
+	const DataMatrix<int> & nRuns,
+	const GridData3D & dataRayleighStrength,
+	double *** pDataUpdate,
+	double *** pDataReference,
+	double dDeltaT
+) {
+	for (int r = 0; r < nRuns.GetRows(); r++) {
+		const int k = nRuns[r][0];
+		const int i = nRuns[r][1];
+
+		const double * const dNu = dataRayleighStrength[k][i];
+		const double * const dReference = pDataReference[k][i];
+		double * const dUpdate = pDataUpdate[k][i];
+
+		// Backwards Euler
+		for (int j = nRuns[r][2]; j < nRuns[r][3]; j++) {
+			double dNuNode = 1.0 / (1.0 + dDeltaT * dNu[j]);
+
+			dUpdate[j] =
+				dNuNode * dUpdate[j]
+				+ (1.0 - dNuNode) * dReference[j];
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void HorizontalDynamicsFEM::ApplyRayleighFriction(
 	int iDataUpdate,
 	double dDeltaT
@@ -1669,8 +1704,6 @@ void HorizontalDynamicsFEM::ApplyRayleighFriction(
 		GridPatchGLL * pPatch =
 			dynamic_cast<GridPatchGLL*>(pGrid->GetActivePatch(n));
 
-		const PatchBox & box = pPatch->GetPatchBox();
-
 		// Grid data
 		GridData4D & dataUpdateNode =
 			pPatch->GetDataState(iDataUpdate, DataLocation_Node);
@@ -1692,57 +1725,36 @@ void HorizontalDynamicsFEM::ApplyRayleighFriction(
 		const GridData3D & dataRayleighStrengthREdge =
 			pPatch->GetRayleighStrength(DataLocation_REdge);
 
-		// Loop over all nodes in patch
-		for (int i = box.GetAInteriorBegin(); i < box.GetAInteriorEnd(); i++) {
-		for (int j = box.GetBInteriorBegin(); j < box.GetBInteriorEnd(); j++) {
-
-			// Rayleigh damping on nodes
-			for (int k = 0; k < pGrid->GetRElements(); k++) {
+		// Runs of nodes where Rayleigh friction is active
+		const DataMatrix<int> & nRunsNode =
+			pPatch->GetRayleighFrictionRuns(DataLocation_Node);
 
-				double dNu = dataRayleighStrengthNode[k][i][j];
+		const DataMatrix<int> & nRunsREdge =
+			pPatch->GetRayleighFrictionRuns(DataLocation_REdge);
 
-				// Backwards Euler
-				if (dNu == 0.0) {
-					continue;
-				}
-
-				double dNuNode = 1.0 / (1.0 + dDeltaT * dNu);
+		// Loop over all components
+		for (int c = 0; c < nComponents; c++) {
 
-				// Loop over all components
-				for (int c = 0; c < nComponents; c++) {
-					if (pGrid->GetVarLocation(c) == DataLocation_Node) {
-						dataUpdateNode[c][k][i][j] =
-							dNuNode * dataUpdateNode[c][k][i][j]
-							+ (1.0 - dNuNode)
-								* dataReferenceNode[c][k][i][j];
-					}
-				}
+			// Rayleigh damping on nodes
+			if (pGrid->GetVarLocation(c) == DataLocation_Node) {
+				ApplyRayleighFrictionToRuns(
+					nRunsNode,
+					dataRayleighStrengthNode,
+					dataUpdateNode[c],
+					dataReferenceNode[c],
+					dDeltaT);
 			}
 
 			// Rayleigh damping on interfaces
-			for (int k = 0; k <= pGrid->GetRElements(); k++) {
-
-				double dNu = dataRayleighStrengthREdge[k][i][j];
-
-				// Backwards Euler
-				if (dNu == 0.0) {
-					continue;
-				}
-
-				double dNuREdge = 1.0 / (1.0 + dDeltaT * dNu);
-
-				// Loop over all components
-				for (int c = 0; c < nComponents; c++) {
-					if (pGrid->GetVarLocation(c) == DataLocation_REdge) {
-						dataUpdateREdge[c][k][i][j] =
-							dNuREdge * dataUpdateREdge[c][k][i][j]
-							+ (1.0 - dNuREdge)
-								* dataReferenceREdge[c][k][i][j];
-					}
-				}
+			if (pGrid->GetVarLocation(c) == DataLocation_REdge) {
+				ApplyRayleighFrictionToRuns(
+					nRunsREdge,
+					dataRayleighStrengthREdge,
+					dataUpdateREdge[c],
+					dataReferenceREdge[c],
+					dDeltaT);
 			}
 		}
-		}
 
 		// Apply boundary conditions
 		//pPatch->ApplyBoundaryConditions(iDataUpdate);
@@ -1758,6 +1770,7 @@ void HorizontalDynamicsFEM::StepAfterSubCycle(
 	const Time & time,
 	double dDeltaT
 ) {
+	ProfilerRegion region("Hyperdiffusion");
 
 	// Check indices
 	if (iDataInitial == iDataWorking) {
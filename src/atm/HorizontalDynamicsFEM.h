@@ -94,7 +94,7 @@ public:
 		double dDeltaT
 	);
 
-protected:
+public:
 	///	<summary>
 	///		Apply the scalar Laplacian operator.
 	///	</summary>
@@ -118,6 +118,7 @@ protected:
 		bool fScaleNuLocally
 	);
 
+protected:
 	///	<summary>
 	///		Apply Rayleigh damping.
 	///	</summary>
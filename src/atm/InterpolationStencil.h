@@ -0,0 +1,118 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    InterpolationStencil.h
+///	\author  Paul Ullrich
+///	\version October 18, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _INTERPOLATIONSTENCIL_H_
+#define _INTERPOLATIONSTENCIL_H_
+
+#include "DataVector.h"
+#include "DataMatrix.h"
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Precomputed horizontal interpolation weights from the model grid to
+///		a fixed set of points.  Only points that lie on patches owned by this
+///		processor are stored; they are ordered by patch index so that each
+///		patch operates on a contiguous range.
+///	</summary>
+class InterpolationStencil {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	InterpolationStencil() :
+		m_nTotalPoints(0)
+	{ }
+
+public:
+	///	<summary>
+	///		Get the total number of points across all processors.
+	///	</summary>
+	inline int GetTotalPoints() const {
+		return m_nTotalPoints;
+	}
+
+	///	<summary>
+	///		Get the number of points owned by this processor.
+	///	</summary>
+	inline int GetLocalPoints() const {
+		return m_ixPoint.GetRows();
+	}
+
+	///	<summary>
+	///		Get the first local point on the given patch.
+	///	</summary>
+	inline int GetPatchPointBegin(int ixPatch) const {
+		return m_ixPatchPointBegin[ixPatch];
+	}
+
+	///	<summary>
+	///		Get one past the last local point on the given patch.
+	///	</summary>
+	inline int GetPatchPointEnd(int ixPatch) const {
+		return m_ixPatchPointBegin[ixPatch+1];
+	}
+
+public:
+	///	<summary>
+	///		Total number of points across all processors.
+	///	</summary>
+	int m_nTotalPoints;
+
+	///	<summary>
+	///		Offset of the first local point on each patch (indexed by global
+	///		patch index, with one trailing entry).
+	///	</summary>
+	DataVector<int> m_ixPatchPointBegin;
+
+	///	<summary>
+	///		Index of each local point in the full array of points.
+	///	</summary>
+	DataVector<int> m_ixPoint;
+
+	///	<summary>
+	///		Alpha coordinate of each local point.
+	///	</summary>
+	DataVector<double> m_dAlpha;
+
+	///	<summary>
+	///		Beta coordinate of each local point.
+	///	</summary>
+	DataVector<double> m_dBeta;
+
+	///	<summary>
+	///		Alpha index of the first node of the element containing each
+	///		local point.
+	///	</summary>
+	DataVector<int> m_iElementA;
+
+	///	<summary>
+	///		Beta index of the first node of the element containing each
+	///		local point.
+	///	</summary>
+	DataVector<int> m_iElementB;
+
+	///	<summary>
+	///		Tensor product interpolation weights for each local point.
+	///	</summary>
+	DataMatrix<double> m_dWeights;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
@@ -19,10 +19,12 @@
 #include "Grid.h"
 #include "TestCase.h"
 #include "OutputManager.h"
+#include "ExchangeStatistics.h"
 
-#include "FunctionTimer.h"
+#include "Profiler.h"
 #include "Announce.h"
 #include "MemoryTools.h"
+#include "MemoryTracker.h"
 
 #include <cfloat>
 
@@ -88,7 +90,9 @@ void Model::SetGrid(Grid * pGrid) {
 	m_pGrid = pGrid;
 
 	// Set up patches
-	if (m_param.m_strRestartFile == "") {
+	if ((m_param.m_strRestartFile == "") ||
+		(m_param.m_fRestartFromCheckpoint)
+	) {
 		m_pGrid->AddDefaultPatches();
 	} else {
 		m_pGrid->FromFile(m_param.m_strRestartFile);
@@ -154,7 +158,9 @@ void Model::SetTestCase(
 	m_pTestCase = pTestCase;
 
 	// Evaluate physical constants and data from TestCase
-	if (m_param.m_strRestartFile == "") {
+	if ((m_param.m_strRestartFile == "") ||
+		(m_param.m_fRestartFromCheckpoint)
+	) {
 
 		// Evaluate physical constants
 		m_pTestCase->EvaluatePhysicalConstants(m_phys);
@@ -173,11 +179,18 @@ void Model::AttachOutputManager(OutputManager * pOutMan) {
 	}
 
 	// Attach output manager
+	pOutMan->SetOutputWriter(&m_writer);
 	m_vecOutMan.push_back(pOutMan);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void Model::SetAsynchronousOutput(int nMaxPendingOutputs) {
+	m_writer.Start(nMaxPendingOutputs);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void Model::AttachWorkflowProcess(WorkflowProcess * pWorkflowProcess) {
 	if (m_pGrid == NULL) {
 		_EXCEPTIONT(
@@ -211,6 +224,11 @@ void Model::EvaluateStateFromRestartFile() {
 	if (n == m_vecOutMan.size()) {
 		Announce("Warning: No input capable OutputManager found");
 	}
+
+	// Locate nodes where the Rayleigh strength loaded from file is active
+	if (m_pGrid->HasRayleighFriction()) {
+		m_pGrid->ComputeRayleighFrictionRuns();
+	}
 	AnnounceEndBlock("Done");
 }
 
@@ -272,9 +290,18 @@ void Model::Go() {
 		return;
 	}
 
+	// Record a timeline of all regions
+	if (m_param.m_strTraceFile != "") {
+		Profiler::EnableTrace(m_param.m_nTraceEvents);
+	}
+
 	// Initial output
-	for (int om = 0; om < m_vecOutMan.size(); om++) {
-		m_vecOutMan[om]->InitialOutput(m_time);
+	{
+		ProfilerRegion region("Output");
+
+		for (int om = 0; om < m_vecOutMan.size(); om++) {
+			m_vecOutMan[om]->InitialOutput(m_time);
+		}
 	}
 
 	// Initialize WorkflowProcesses
@@ -285,12 +312,17 @@ void Model::Go() {
 	// First time step
 	bool fFirstStep = true;
 
+	// Global diagnostics which are being reduced in the background
+	bool fDiagnosticsPending = false;
+
+	Time timeDiagnostics;
+
 	// Loop
 	for(int iStep = 0;; iStep++) {
 
 		//PrintMemoryLine();
 
-		FunctionTimer timerLoop("Loop");
+		Profiler::Begin("Step");
 
 		// Last time step
 		bool fLastStep = false;
@@ -311,29 +343,21 @@ void Model::Go() {
 
 		// Perform one time step
 		Announce("Step %s", m_time.ToString().c_str());
-		m_pTimestepScheme->Step(fFirstStep, fLastStep, m_time, dDeltaT);
-
-		// Energy and enstrophy
 		{
-			if (m_eqn.GetDimensionality() == 3) {
-				if (m_pGrid->GetVerticalStaggering() ==
-				    Grid::VerticalStaggering_Lorenz
-				) {
-					m_pGrid->InterpolateREdgeToNode(3, 0);
-				}
+			ProfilerRegion region("Timestep");
 
-				if (m_pGrid->GetVerticalStaggering() ==
-				    Grid::VerticalStaggering_CharneyPhillips
-				) {
-					m_pGrid->InterpolateREdgeToNode(2, 0);
-					m_pGrid->InterpolateREdgeToNode(3, 0);
-				}
-			}
+			m_pTimestepScheme->Step(fFirstStep, fLastStep, m_time, dDeltaT);
+		}
+
+		// Complete the diagnostics from the previous step, whose reduction
+		// overlapped with this time step
+		if (fDiagnosticsPending) {
+			ProfilerRegion region("Diagnostics");
 
-			Announce("%1.15e %1.15e",
-				m_pGrid->ComputeTotalEnergy(0),
-				m_pGrid->ComputeTotalPotentialEnstrophy(0));
+			EndDiagnostics(timeDiagnostics);
+			fDiagnosticsPending = false;
 		}
+
 /*
 		// L2 errors of the height field
 		{
@@ -365,25 +389,45 @@ void Model::Go() {
 			m_time = timeNext;
 		}
 
+		// Begin computing global diagnostics
+		if ((m_param.m_nDiagnosticsInterval > 0) &&
+			(((iStep + 1) % m_param.m_nDiagnosticsInterval == 0) || fLastStep)
+		) {
+			ProfilerRegion region("Diagnostics");
+
+			m_pGrid->BeginComputeDiagnostics(0);
+
+			timeDiagnostics = m_time;
+			fDiagnosticsPending = true;
+		}
+
 		// Check for WorkflowProcesses
-		for (int wfp = 0; wfp < m_vecWorkflowProcess.size(); wfp++) {
-			if (m_vecWorkflowProcess[wfp]->IsReady(m_time)) {
-				m_vecWorkflowProcess[wfp]->Perform(m_time);
+		{
+			ProfilerRegion region("Workflow");
+
+			for (int wfp = 0; wfp < m_vecWorkflowProcess.size(); wfp++) {
+				if (m_vecWorkflowProcess[wfp]->IsReady(m_time)) {
+					m_vecWorkflowProcess[wfp]->Perform(m_time);
+				}
 			}
 		}
 
 		// Check for output
-		for (int om = 0; om < m_vecOutMan.size(); om++) {
-			if (fLastStep) {
-				m_vecOutMan[om]->FinalOutput(m_time);
+		{
+			ProfilerRegion region("Output");
 
-			} else if (m_vecOutMan[om]->IsOutputNeeded(m_time)) {
-				m_vecOutMan[om]->ManageOutput(m_time);
+			for (int om = 0; om < m_vecOutMan.size(); om++) {
+				if (fLastStep) {
+					m_vecOutMan[om]->FinalOutput(m_time);
+
+				} else if (m_vecOutMan[om]->IsOutputNeeded(m_time)) {
+					m_vecOutMan[om]->ManageOutput(m_time);
+				}
 			}
 		}
 
-		// Stop the loop timer
-		timerLoop.StopTime();
+		// Stop the step timer
+		Profiler::End();
 
 		// Exit on last step
 		if (fLastStep) {
@@ -394,10 +438,73 @@ void Model::Go() {
 		fFirstStep = false;
 	}
 
-	std::cout << "Average Time Per Loop: "
-		<< FunctionTimer::GetAverageGroupTime("Loop")
-		<< "us" << std::endl;
+	// Complete any pending diagnostics
+	if (fDiagnosticsPending) {
+		ProfilerRegion region("Diagnostics");
+
+		EndDiagnostics(timeDiagnostics);
+	}
+
+	// Complete any pending output
+	{
+		ProfilerRegion region("Output");
+
+		for (int om = 0; om < m_vecOutMan.size(); om++) {
+			m_vecOutMan[om]->CompleteOutput();
+		}
+
+		m_writer.Flush();
+	}
+
+	// Problem size on this processor
+	int nColumns = 0;
+	for (int n = 0; n < m_pGrid->GetActivePatchCount(); n++) {
+		const PatchBox & box = m_pGrid->GetActivePatch(n)->GetPatchBox();
+
+		nColumns += box.GetAInteriorWidth() * box.GetBInteriorWidth();
+	}
 
+	Profiler::SetMetric("patches", m_pGrid->GetActivePatchCount());
+	Profiler::SetMetric("columns", nColumns);
+	Profiler::SetMetric("degrees_of_freedom",
+		static_cast<double>(nColumns)
+		* static_cast<double>(m_pGrid->GetDegreesOfFreedomPerColumn()));
+
+	// Summary of time spent in each region
+	Profiler::Report(m_param.m_strProfileFile);
+
+	// Summary of messages exchanged between processors
+	ExchangeStatistics::Report(m_param.m_strProfileFile);
+
+	// Summary of memory held by each subsystem
+	MemoryTracker::Report(m_param.m_strProfileFile);
+
+	// Timeline of all regions
+	if (m_param.m_strTraceFile != "") {
+		Profiler::WriteTrace(m_param.m_strTraceFile);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Model::EndDiagnostics(
+	const Time & time
+) {
+	DataVector<double> dDiagnostics;
+
+	m_pGrid->EndComputeDiagnostics(dDiagnostics);
+
+	Announce("Diagnostics %s", time.ToString().c_str());
+	Announce("  Energy %1.15e  Enstrophy %1.15e  Mass %1.15e",
+		dDiagnostics[DiagnosticType_Energy],
+		dDiagnostics[DiagnosticType_PotentialEnstrophy],
+		dDiagnostics[DiagnosticType_Mass]);
+
+	for (int c = 0; c < m_eqn.GetComponents(); c++) {
+		Announce("  %-6s %1.15e",
+			m_eqn.GetComponentShortName(c).c_str(),
+			dDiagnostics[DiagnosticType_Count + c]);
+	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -27,6 +27,7 @@
 #include "HorizontalDynamics.h"
 #include "VerticalDynamics.h"
 #include "OutputManager.h"
+#include "OutputWriter.h"
 #include "WorkflowProcess.h"
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -42,9 +43,14 @@ public:
 	///	</summary>
 	ModelParameters() :
 		m_strRestartFile(""),
+		m_fRestartFromCheckpoint(false),
 		m_timeDeltaT(),
 		m_timeStart(),
-		m_timeEnd()
+		m_timeEnd(),
+		m_strProfileFile(""),
+		m_strTraceFile(""),
+		m_nTraceEvents(100000),
+		m_nDiagnosticsInterval(1)
 	{ }
 
 public:
@@ -53,6 +59,13 @@ public:
 	///	</summary>
 	std::string m_strRestartFile;
 
+	///	<summary>
+	///		Flag indicating restart files are binary checkpoints.  A
+	///		checkpoint only contains model data, so on restart the grid and
+	///		physical constants are constructed as for a new simulation.
+	///	</summary>
+	bool m_fRestartFromCheckpoint;
+
 	///	<summary>
 	///		Time step size.
 	///	</summary>
@@ -67,6 +80,30 @@ public:
 	///		End time of the simulation.
 	///	</summary>
 	Time m_timeEnd;
+
+	///	<summary>
+	///		Prefix of the machine-readable profile output (.json, .csv,
+	///		.comm.csv, .comm_matrix.csv and .memory.csv), or empty if the
+	///		profile should only be summarized.
+	///	</summary>
+	std::string m_strProfileFile;
+
+	///	<summary>
+	///		Name of the Chrome trace file of profiled regions on all
+	///		processors, or empty if regions should not be traced.
+	///	</summary>
+	std::string m_strTraceFile;
+
+	///	<summary>
+	///		Maximum number of trace events retained on each processor.
+	///	</summary>
+	int m_nTraceEvents;
+
+	///	<summary>
+	///		Number of time steps between computations of global diagnostics,
+	///		or zero if global diagnostics should not be computed.
+	///	</summary>
+	int m_nDiagnosticsInterval;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -130,6 +167,12 @@ public:
 	///	</summary>
 	void AttachOutputManager(OutputManager * pOutMan);
 
+	///	<summary>
+	///		Perform output on a background thread, with at most the given
+	///		number of outputs pending at any time.
+	///	</summary>
+	void SetAsynchronousOutput(int nMaxPendingOutputs);
+
 	///	<summary>
 	///		Attach a WorkflowProcess to this model.  Model assumes ownership
 	///		of the pointer once it is assigned.
@@ -206,6 +249,15 @@ public:
 	///	</summary>
 	virtual void Go();
 
+protected:
+	///	<summary>
+	///		Complete the global diagnostics started at the given time and
+	///		announce the result.
+	///	</summary>
+	void EndDiagnostics(
+		const Time & time
+	);
+
 public:
 	///	<summary>
 	///		Compute error norms.
@@ -305,6 +357,13 @@ public:
 		m_param.m_timeStart = timeStart;
 	}
 
+	///	<summary>
+	///		Get the end time of the simulation.
+	///	</summary>
+	const Time & GetEndTime() const {
+		return m_param.m_timeEnd;
+	}
+
 protected:
 	///	<summary>
 	///		Model parameters.
@@ -341,6 +400,11 @@ protected:
 	///	</summary>
 	OutputManagerVector m_vecOutMan;
 
+	///	<summary>
+	///		Writer used by all OutputManagers.
+	///	</summary>
+	OutputWriter m_writer;
+
 	///	<summary>
 	///		Pointer to test case.
 	///	</summary>
@@ -0,0 +1,202 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    OutputFileFormat.cpp
+///	\author  Paul Ullrich
+///	\version October 18, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "OutputFileFormat.h"
+
+#include "Exception.h"
+
+#include <netcdfcpp.h>
+#include <netcdf.h>
+#include <netcdf_meta.h>
+
+#if NC_HAS_ZSTD
+#include <netcdf_filter.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Maximum number of dimensions of an output variable.
+///	</summary>
+static const int OutputFileFormatMaxDims = 5;
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OutputFileFormat::Validate() const {
+
+	// Compression, chunking and quantization require NetCDF-4
+	if (!m_fNetCDF4) {
+		if (m_eCompressor != OutputCompressor_None) {
+			_EXCEPTIONT("Output compression requires NetCDF-4 output");
+		}
+		if (m_eChunking != OutputChunking_Default) {
+			_EXCEPTIONT("Output chunking requires NetCDF-4 output");
+		}
+		if ((m_nSignificantDigits != 0) ||
+			(m_mapSignificantDigits.size() != 0)
+		) {
+			_EXCEPTIONT("Output quantization requires NetCDF-4 output");
+		}
+	}
+
+	// Compression level
+	if (m_eCompressor == OutputCompressor_Deflate) {
+		if ((m_nCompressionLevel < 1) || (m_nCompressionLevel > 9)) {
+			_EXCEPTIONT("Deflate compression level must be in the range [1,9]");
+		}
+	}
+
+#if !NC_HAS_ZSTD
+	if (m_eCompressor == OutputCompressor_Zstd) {
+		_EXCEPTIONT("NetCDF library does not support zstd compression");
+	}
+#endif
+
+	// Significant digits
+	if ((m_nSignificantDigits < 0) || (m_nSignificantDigits > 15)) {
+		_EXCEPTIONT("Significant digits must be in the range [0,15]");
+	}
+
+	std::map<std::string, int>::const_iterator iter =
+		m_mapSignificantDigits.begin();
+	for (; iter != m_mapSignificantDigits.end(); iter++) {
+		if ((iter->second < 0) || (iter->second > 15)) {
+			_EXCEPTION1("Significant digits for \"%s\" must be in the "
+				"range [0,15]", iter->first.c_str());
+		}
+	}
+
+#ifndef NC_QUANTIZE_BITGROOM
+	if ((m_nSignificantDigits != 0) || (m_mapSignificantDigits.size() != 0)) {
+		_EXCEPTIONT("NetCDF library does not support quantization");
+	}
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int OutputFileFormat::GetSignificantDigits(
+	const std::string & strVariableName
+) const {
+	std::map<std::string, int>::const_iterator iter =
+		m_mapSignificantDigits.find(strVariableName);
+
+	if (iter != m_mapSignificantDigits.end()) {
+		return iter->second;
+	}
+
+	return m_nSignificantDigits;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+NcFile * OutputFileFormat::CreateFile(
+	const std::string & strFileName
+) const {
+	NcFile * pNcFile;
+
+	if (m_fNetCDF4) {
+		pNcFile = new NcFile(
+			strFileName.c_str(), NcFile::Replace, NULL, 0, NcFile::Netcdf4);
+	} else {
+		pNcFile = new NcFile(strFileName.c_str(), NcFile::Replace);
+	}
+
+	if ((pNcFile == NULL) || (!pNcFile->is_valid())) {
+		_EXCEPTION1("Error opening NetCDF file \"%s\"", strFileName.c_str());
+	}
+
+	return pNcFile;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OutputFileFormat::DefineVariable(
+	NcFile * pNcFile,
+	NcVar * var,
+	const std::string & strVariableName,
+	int nDims,
+	const long * nChunkSize,
+	bool fAllowLossy
+) const {
+	if (!m_fNetCDF4) {
+		return;
+	}
+
+	if (var == NULL) {
+		_EXCEPTION1("Invalid NetCDF variable \"%s\"", strVariableName.c_str());
+	}
+	if ((nDims < 1) || (nDims > OutputFileFormatMaxDims)) {
+		_EXCEPTIONT("Invalid number of dimensions");
+	}
+
+	int ncid = pNcFile->id();
+	int varid = var->id();
+
+	int iError;
+
+	// Chunking
+	if (m_eChunking != OutputChunking_Default) {
+		size_t sChunkSize[OutputFileFormatMaxDims];
+		for (int d = 0; d < nDims; d++) {
+			sChunkSize[d] = static_cast<size_t>(nChunkSize[d]);
+		}
+
+		iError = nc_def_var_chunking(ncid, varid, NC_CHUNKED, sChunkSize);
+		if (iError != NC_NOERR) {
+			_EXCEPTION2("Unable to set chunking for \"%s\": %s",
+				strVariableName.c_str(), nc_strerror(iError));
+		}
+	}
+
+	// Quantization, which must be applied before compression
+#ifdef NC_QUANTIZE_BITGROOM
+	int nSignificantDigits = GetSignificantDigits(strVariableName);
+	if (fAllowLossy && (nSignificantDigits != 0)) {
+		iError = nc_def_var_quantize(
+			ncid, varid, NC_QUANTIZE_BITGROOM, nSignificantDigits);
+
+		if (iError != NC_NOERR) {
+			_EXCEPTION2("Unable to set quantization for \"%s\": %s",
+				strVariableName.c_str(), nc_strerror(iError));
+		}
+	}
+#endif
+
+	// Compression; the shuffle filter improves compression of doubles
+	if (m_eCompressor == OutputCompressor_Deflate) {
+		iError = nc_def_var_deflate(ncid, varid, 1, 1, m_nCompressionLevel);
+		if (iError != NC_NOERR) {
+			_EXCEPTION2("Unable to set compression for \"%s\": %s",
+				strVariableName.c_str(), nc_strerror(iError));
+		}
+
+#if NC_HAS_ZSTD
+	} else if (m_eCompressor == OutputCompressor_Zstd) {
+		iError = nc_def_var_deflate(ncid, varid, 1, 0, 0);
+		if (iError == NC_NOERR) {
+			iError = nc_def_var_zstandard(ncid, varid, m_nCompressionLevel);
+		}
+		if (iError != NC_NOERR) {
+			_EXCEPTION2("Unable to set compression for \"%s\": %s",
+				strVariableName.c_str(), nc_strerror(iError));
+		}
+#endif
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
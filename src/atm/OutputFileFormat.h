@@ -0,0 +1,141 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    OutputFileFormat.h
+///	\author  Paul Ullrich
+///	\version October 18, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _OUTPUTFILEFORMAT_H_
+#define _OUTPUTFILEFORMAT_H_
+
+#include <string>
+#include <map>
+
+///////////////////////////////////////////////////////////////////////////////
+
+class NcFile;
+class NcVar;
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Compression filters available for NetCDF-4 output.
+///	</summary>
+enum OutputCompressor {
+	OutputCompressor_None,
+	OutputCompressor_Deflate,
+	OutputCompressor_Zstd
+};
+
+///	<summary>
+///		Chunk layouts available for NetCDF-4 output.
+///	</summary>
+enum OutputChunking {
+	OutputChunking_Default,
+	OutputChunking_Level,
+	OutputChunking_Patch
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Format, compression, chunking and precision of NetCDF output files.
+///		The default is an uncompressed classic NetCDF file.
+///	</summary>
+class OutputFileFormat {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	OutputFileFormat() :
+		m_fNetCDF4(false),
+		m_eCompressor(OutputCompressor_None),
+		m_nCompressionLevel(4),
+		m_eChunking(OutputChunking_Default),
+		m_nSignificantDigits(0)
+	{ }
+
+public:
+	///	<summary>
+	///		Verify that the options are consistent.
+	///	</summary>
+	void Validate() const;
+
+	///	<summary>
+	///		Get the number of significant digits retained for the given
+	///		variable, or zero if the variable is stored at full precision.
+	///	</summary>
+	int GetSignificantDigits(
+		const std::string & strVariableName
+	) const;
+
+	///	<summary>
+	///		Create a new NetCDF file in this format, replacing any existing
+	///		file with the same name.
+	///	</summary>
+	NcFile * CreateFile(
+		const std::string & strFileName
+	) const;
+
+	///	<summary>
+	///		Apply chunking, compression and quantization to a newly defined
+	///		variable.  The chunk dimensions are used for the Level and Patch
+	///		chunk layouts; the caller chooses them to match the layout.  If
+	///		fAllowLossy is false quantization is not applied.
+	///	</summary>
+	void DefineVariable(
+		NcFile * pNcFile,
+		NcVar * var,
+		const std::string & strVariableName,
+		int nDims,
+		const long * nChunkSize,
+		bool fAllowLossy
+	) const;
+
+public:
+	///	<summary>
+	///		Write NetCDF-4 (HDF5) files instead of classic files.
+	///	</summary>
+	bool m_fNetCDF4;
+
+	///	<summary>
+	///		Compression filter.
+	///	</summary>
+	OutputCompressor m_eCompressor;
+
+	///	<summary>
+	///		Compression level.
+	///	</summary>
+	int m_nCompressionLevel;
+
+	///	<summary>
+	///		Chunk layout.
+	///	</summary>
+	OutputChunking m_eChunking;
+
+	///	<summary>
+	///		Number of significant digits retained by quantization for
+	///		variables without a specific setting (zero for full precision).
+	///	</summary>
+	int m_nSignificantDigits;
+
+	///	<summary>
+	///		Number of significant digits retained for specific variables.
+	///	</summary>
+	std::map<std::string, int> m_mapSignificantDigits;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
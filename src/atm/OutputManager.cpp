@@ -20,8 +20,10 @@
 #include "Model.h"
 #include "Grid.h"
 #include "ConsolidationStatus.h"
+#include "OutputWriter.h"
 
 #include "Announce.h"
+#include "MemoryTracker.h"
 
 #include "mpi.h"
 
@@ -41,6 +43,7 @@ OutputManager::OutputManager(
 	int nOutputsPerFile
 ) :
 	m_grid(grid),
+	m_pOutputWriter(NULL),
 	m_fFromRestartFile(false),
 	m_fIsFileOpen(false),
 	m_ixOutputTime(0),
@@ -94,9 +97,39 @@ bool OutputManager::IsOutputNeeded(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void OutputManager::SubmitOutputTask(
+	OutputWriterTask * pTask
+) {
+	if (m_pOutputWriter != NULL) {
+		m_pOutputWriter->Submit(pTask);
+		return;
+	}
+
+	// Synchronous output
+	try {
+		pTask->Execute();
+	} catch(...) {
+		delete pTask;
+		throw;
+	}
+	delete pTask;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OutputManager::FlushOutputTasks() {
+	if (m_pOutputWriter != NULL) {
+		m_pOutputWriter->Flush();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void OutputManager::PerformOutput(
 	const Time & time
 ) {
+	MemoryTrackerRegion memory(MemoryTag_Output);
+
 	// Open the file
 	if (!m_fIsFileOpen) {
 		std::string strActiveFileName;
@@ -20,12 +20,15 @@
 #include "TimeObj.h"
 #include "DataVector.h"
 #include "DataMatrix4D.h"
+#include "OutputFileFormat.h"
 
 #include "netcdfcpp.h"
 
 #include <vector>
 
 class Grid;
+class OutputWriter;
+class OutputWriterTask;
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -61,6 +64,25 @@ public:
 		return "Output";
 	}
 
+	///	<summary>
+	///		Set the OutputWriter used for asynchronous output.
+	///	</summary>
+	void SetOutputWriter(
+		OutputWriter * pOutputWriter
+	) {
+		m_pOutputWriter = pOutputWriter;
+	}
+
+	///	<summary>
+	///		Set the format of NetCDF output files.
+	///	</summary>
+	void SetFileFormat(
+		const OutputFileFormat & format
+	) {
+		format.Validate();
+		m_format = format;
+	}
+
 protected:
 	///	<summary>
 	///		Get the active file name.
@@ -96,6 +118,13 @@ public:
 	///	</summary>
 	void FinalOutput(const Time & time);
 
+	///	<summary>
+	///		Complete any output which is still in progress at the end of
+	///		the simulation.
+	///	</summary>
+	virtual void CompleteOutput()
+	{ }
+
 public:
 	///	<summary>
 	///		Returns true if this OutputManager supports the input operation.
@@ -143,12 +172,37 @@ protected:
 		const Time & time
 	) = 0;
 
+protected:
+	///	<summary>
+	///		Submit an output task to the OutputWriter, or execute it
+	///		immediately if no OutputWriter is available.
+	///	</summary>
+	void SubmitOutputTask(
+		OutputWriterTask * pTask
+	);
+
+	///	<summary>
+	///		Wait for all pending output tasks to complete.  This must be
+	///		called before any NetCDF operation outside of an output task.
+	///	</summary>
+	void FlushOutputTasks();
+
 protected:
 	///	<summary>
 	///		Grid associated with this OutputManager.
 	///	</summary>
 	Grid & m_grid;
 
+	///	<summary>
+	///		OutputWriter used for asynchronous output (or NULL).
+	///	</summary>
+	OutputWriter * m_pOutputWriter;
+
+	///	<summary>
+	///		Format of NetCDF output files.
+	///	</summary>
+	OutputFileFormat m_format;
+
 	///	<summary>
 	///		Flag indicating that the initial conditions came from a
 	///		recovery file and that output should be supressed.
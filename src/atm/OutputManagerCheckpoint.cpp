@@ -0,0 +1,676 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    OutputManagerCheckpoint.cpp
+///	\author  Paul Ullrich
+///	\version October 18, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "OutputManagerCheckpoint.h"
+
+#include "Model.h"
+#include "Grid.h"
+#include "GridPatch.h"
+
+#include "TimeObj.h"
+#include "Announce.h"
+
+#include "mpi.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <climits>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Identifier at the start of every checkpoint file.
+///	</summary>
+static const char CheckpointMagic[8] = {'T','E','M','P','E','S','T','C'};
+
+///	<summary>
+///		Version of the checkpoint format.
+///	</summary>
+static const int32_t CheckpointVersion = 1;
+
+///	<summary>
+///		Alignment of the start of the patch data in the file.
+///	</summary>
+static const int64_t CheckpointDataAlignment = 4096;
+
+///	<summary>
+///		Header of a checkpoint file.
+///	</summary>
+struct CheckpointHeader {
+	char szMagic[8];
+	int32_t iVersion;
+	int32_t nPatches;
+	int32_t nPatchProcessors;
+	int32_t nComponents;
+	int32_t nTracers;
+	int32_t nRElements;
+	int32_t fHasReferenceState;
+	int64_t nDataOffset;
+	char szTime[64];
+};
+
+///	<summary>
+///		Location and checksum of the data of one patch in a checkpoint file.
+///	</summary>
+struct CheckpointPatchRecord {
+	int32_t ixPatch;
+	int32_t nReserved;
+	int64_t nOffset;
+	int64_t nBytes;
+	uint64_t uChecksum;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Compute a 64-bit checksum of a set of buffers of doubles.
+///	</summary>
+static uint64_t ComputeCheckpointChecksum(
+	const iovec * pBuffers,
+	int nBuffers
+) {
+	uint64_t uChecksum = 14695981039346656037ULL;
+
+	for (int i = 0; i < nBuffers; i++) {
+		const uint64_t * pWords =
+			reinterpret_cast<const uint64_t *>(pBuffers[i].iov_base);
+
+		size_t nWords = pBuffers[i].iov_len / sizeof(uint64_t);
+
+		for (size_t j = 0; j < nWords; j++) {
+			uChecksum ^= pWords[j];
+			uChecksum *= 1099511628211ULL;
+		}
+	}
+
+	return uChecksum;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Write (or read) a set of buffers to (or from) a contiguous region of
+///		a file, starting at the given offset.
+///	</summary>
+static void TransferCheckpointBuffers(
+	int fd,
+	int64_t nOffset,
+	std::vector<iovec> vecBuffers,
+	bool fWrite
+) {
+	iovec * pBuffers = &(vecBuffers[0]);
+	int nBuffers = static_cast<int>(vecBuffers.size());
+
+	while (nBuffers > 0) {
+		int nCount = nBuffers;
+		if (nCount > IOV_MAX) {
+			nCount = IOV_MAX;
+		}
+
+		ssize_t nResult;
+		if (fWrite) {
+			nResult = pwritev(fd, pBuffers, nCount, nOffset);
+		} else {
+			nResult = preadv(fd, pBuffers, nCount, nOffset);
+		}
+
+		if (nResult < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			_EXCEPTION1("Error accessing checkpoint file: %s",
+				strerror(errno));
+		}
+		if (nResult == 0) {
+			_EXCEPTIONT("Unexpected end of checkpoint file");
+		}
+
+		nOffset += nResult;
+
+		// Advance past completed buffers
+		size_t nRemaining = static_cast<size_t>(nResult);
+		while ((nBuffers > 0) && (nRemaining >= pBuffers->iov_len)) {
+			nRemaining -= pBuffers->iov_len;
+			pBuffers++;
+			nBuffers--;
+		}
+		if (nRemaining > 0) {
+			pBuffers->iov_base =
+				reinterpret_cast<char *>(pBuffers->iov_base) + nRemaining;
+			pBuffers->iov_len -= nRemaining;
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Open a checkpoint file and read its header.  Returns the file
+///		descriptor.
+///	</summary>
+static int OpenCheckpointFile(
+	const std::string & strFileName,
+	CheckpointHeader & header
+) {
+	int fd = open(strFileName.c_str(), O_RDONLY);
+	if (fd < 0) {
+		_EXCEPTION2("Unable to open checkpoint file \"%s\": %s",
+			strFileName.c_str(), strerror(errno));
+	}
+
+	std::vector<iovec> vecHeader(1);
+	vecHeader[0].iov_base = &header;
+	vecHeader[0].iov_len = sizeof(CheckpointHeader);
+
+	TransferCheckpointBuffers(fd, 0, vecHeader, false);
+
+	if (memcmp(header.szMagic, CheckpointMagic, sizeof(CheckpointMagic))
+		!= 0
+	) {
+		_EXCEPTION1("\"%s\" is not a checkpoint file", strFileName.c_str());
+	}
+	if (header.iVersion != CheckpointVersion) {
+		_EXCEPTION1("Unsupported checkpoint version (%i)", header.iVersion);
+	}
+
+	return fd;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+OutputManagerCheckpoint::OutputManagerCheckpoint(
+	Grid & grid,
+	const Time & timeOutputFrequency,
+	std::string strOutputDir,
+	std::string strOutputPrefix
+) :
+	OutputManager(
+		grid,
+		timeOutputFrequency,
+		strOutputDir,
+		strOutputPrefix,
+		1),
+	m_fVerifyInput(false)
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int OutputManagerCheckpoint::GetPatchProcessors(
+	const std::string & strFileName
+) {
+	int nRank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &nRank);
+
+	int nPatchProcessors = 0;
+
+	if (nRank == 0) {
+		CheckpointHeader header;
+
+		int fd = OpenCheckpointFile(strFileName, header);
+		close(fd);
+
+		nPatchProcessors = header.nPatchProcessors;
+	}
+
+	MPI_Bcast(&nPatchProcessors, 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+	return nPatchProcessors;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool OutputManagerCheckpoint::OpenFile(
+	const std::string & strFileName
+) {
+	// The file is created by all processes during Output
+	m_strActiveFileName = strFileName + ".restart.chk";
+
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OutputManagerCheckpoint::CloseFile() {
+	m_strActiveFileName = "";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OutputManagerCheckpoint::GetPatchBuffers(
+	GridPatch * pPatch,
+	std::vector<iovec> & vecBuffers
+) const {
+	iovec buffer;
+
+	// Topography
+	DataMatrix<double> & dataTopography = pPatch->GetTopography();
+
+	buffer.iov_base = dataTopography[0];
+	buffer.iov_len =
+		dataTopography.GetRows() * dataTopography.GetColumns()
+		* sizeof(double);
+	vecBuffers.push_back(buffer);
+
+	// Rayleigh strength
+	for (int i = 0; i < 2; i++) {
+		GridData3D & dataRayleighStrength =
+			pPatch->GetRayleighStrength(
+				(i == 0)?(DataLocation_Node):(DataLocation_REdge));
+
+		if (dataRayleighStrength.GetTotalElements() != 0) {
+			buffer.iov_base = dataRayleighStrength[0][0];
+			buffer.iov_len =
+				dataRayleighStrength.GetTotalElements() * sizeof(double);
+			vecBuffers.push_back(buffer);
+		}
+	}
+
+	// State and reference state
+	for (int i = 0; i < 4; i++) {
+		DataLocation loc = (i % 2 == 0)?(DataLocation_Node):(DataLocation_REdge);
+
+		GridData4D & data =
+			(i < 2)?
+				(pPatch->GetDataState(0, loc)):
+				(pPatch->GetReferenceState(loc));
+
+		if (data.GetTotalElements() != 0) {
+			buffer.iov_base = data[0][0][0];
+			buffer.iov_len = data.GetTotalElements() * sizeof(double);
+			vecBuffers.push_back(buffer);
+		}
+	}
+
+	// Tracers
+	GridData4D & dataTracers = pPatch->GetDataTracers(0);
+
+	if (dataTracers.GetTotalElements() != 0) {
+		buffer.iov_base = dataTracers[0][0][0];
+		buffer.iov_len = dataTracers.GetTotalElements() * sizeof(double);
+		vecBuffers.push_back(buffer);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OutputManagerCheckpoint::Output(
+	const Time & time
+) {
+	// Check for open file
+	if (!IsFileOpen()) {
+		_EXCEPTIONT("No file available for output");
+	}
+
+	// Determine processor rank and number of processors
+	int nRank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &nRank);
+
+	int nSize;
+	MPI_Comm_size(MPI_COMM_WORLD, &nSize);
+
+	// Equation set
+	const EquationSet & eqn = m_grid.GetModel().GetEquationSet();
+
+	// Buffers and index records for the active patches
+	std::vector<iovec> vecBuffers;
+
+	int nActivePatches = m_grid.GetActivePatchCount();
+
+	std::vector<CheckpointPatchRecord> vecLocalRecords(nActivePatches);
+
+	int64_t nLocalBytes = 0;
+
+	for (int n = 0; n < nActivePatches; n++) {
+		GridPatch * pPatch = m_grid.GetActivePatch(n);
+
+		int ixFirstBuffer = static_cast<int>(vecBuffers.size());
+
+		GetPatchBuffers(pPatch, vecBuffers);
+
+		int nPatchBuffers = static_cast<int>(vecBuffers.size()) - ixFirstBuffer;
+
+		CheckpointPatchRecord & record = vecLocalRecords[n];
+		memset(&record, 0, sizeof(CheckpointPatchRecord));
+
+		record.ixPatch = pPatch->GetPatchIndex();
+		record.nOffset = nLocalBytes;
+
+		for (int i = ixFirstBuffer; i < vecBuffers.size(); i++) {
+			record.nBytes += vecBuffers[i].iov_len;
+		}
+
+		record.uChecksum =
+			ComputeCheckpointChecksum(
+				&(vecBuffers[ixFirstBuffer]), nPatchBuffers);
+
+		nLocalBytes += record.nBytes;
+	}
+
+	// Patch data is stored in rank order after the header and index
+	int nPatches = m_grid.GetPatchCount();
+
+	int64_t nDataOffset =
+		sizeof(CheckpointHeader)
+		+ nPatches * sizeof(CheckpointPatchRecord);
+
+	nDataOffset =
+		((nDataOffset + CheckpointDataAlignment - 1)
+			/ CheckpointDataAlignment) * CheckpointDataAlignment;
+
+	long long llLocalBytes = nLocalBytes;
+	long long llRankOffset = 0;
+
+	MPI_Exscan(
+		&llLocalBytes,
+		&llRankOffset,
+		1,
+		MPI_LONG_LONG,
+		MPI_SUM,
+		MPI_COMM_WORLD);
+
+	if (nRank == 0) {
+		llRankOffset = 0;
+	}
+
+	int64_t nRankDataOffset = nDataOffset + llRankOffset;
+
+	for (int n = 0; n < nActivePatches; n++) {
+		vecLocalRecords[n].nOffset += nRankDataOffset;
+	}
+
+	// Gather index records on the root process
+	int nLocalRecordBytes =
+		nActivePatches * static_cast<int>(sizeof(CheckpointPatchRecord));
+
+	std::vector<int> vecRecordBytes;
+	std::vector<int> vecRecordDispl;
+	std::vector<CheckpointPatchRecord> vecRecords;
+
+	if (nRank == 0) {
+		vecRecordBytes.resize(nSize);
+		vecRecordDispl.resize(nSize);
+	}
+
+	MPI_Gather(
+		&nLocalRecordBytes,
+		1,
+		MPI_INT,
+		(nRank == 0)?(&(vecRecordBytes[0])):(NULL),
+		1,
+		MPI_INT,
+		0,
+		MPI_COMM_WORLD);
+
+	if (nRank == 0) {
+		int nTotalRecordBytes = 0;
+		for (int p = 0; p < nSize; p++) {
+			vecRecordDispl[p] = nTotalRecordBytes;
+			nTotalRecordBytes += vecRecordBytes[p];
+		}
+		if (nTotalRecordBytes !=
+			nPatches * static_cast<int>(sizeof(CheckpointPatchRecord))
+		) {
+			_EXCEPTIONT("Active patches do not cover the grid");
+		}
+		vecRecords.resize(nPatches);
+	}
+
+	MPI_Gatherv(
+		(nActivePatches == 0)?(NULL):(&(vecLocalRecords[0])),
+		nLocalRecordBytes,
+		MPI_BYTE,
+		(nRank == 0)?(&(vecRecords[0])):(NULL),
+		(nRank == 0)?(&(vecRecordBytes[0])):(NULL),
+		(nRank == 0)?(&(vecRecordDispl[0])):(NULL),
+		MPI_BYTE,
+		0,
+		MPI_COMM_WORLD);
+
+	// Write the header and index, ordered by patch index
+	if (nRank == 0) {
+		std::vector<CheckpointPatchRecord> vecIndex(nPatches);
+		for (int n = 0; n < nPatches; n++) {
+			int ixPatch = vecRecords[n].ixPatch;
+			if ((ixPatch < 0) || (ixPatch >= nPatches)) {
+				_EXCEPTION1("Invalid patch index (%i)", ixPatch);
+			}
+			vecIndex[ixPatch] = vecRecords[n];
+		}
+
+		CheckpointHeader header;
+		memset(&header, 0, sizeof(CheckpointHeader));
+
+		memcpy(header.szMagic, CheckpointMagic, sizeof(CheckpointMagic));
+		header.iVersion = CheckpointVersion;
+		header.nPatches = nPatches;
+		header.nPatchProcessors = m_grid.GetDefaultPatchProcessors();
+		header.nComponents = eqn.GetComponents();
+		header.nTracers = eqn.GetTracers();
+		header.nRElements = m_grid.GetRElements();
+		header.fHasReferenceState = (m_grid.HasReferenceState())?(1):(0);
+		header.nDataOffset = nDataOffset;
+		strncpy(
+			header.szTime,
+			time.ToLongString().c_str(),
+			sizeof(header.szTime) - 1);
+
+		int fd = open(
+			m_strActiveFileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		if (fd < 0) {
+			_EXCEPTION2("Unable to open checkpoint file \"%s\": %s",
+				m_strActiveFileName.c_str(), strerror(errno));
+		}
+
+		std::vector<iovec> vecHeader(2);
+		vecHeader[0].iov_base = &header;
+		vecHeader[0].iov_len = sizeof(CheckpointHeader);
+		vecHeader[1].iov_base = &(vecIndex[0]);
+		vecHeader[1].iov_len = nPatches * sizeof(CheckpointPatchRecord);
+
+		TransferCheckpointBuffers(fd, 0, vecHeader, true);
+
+		close(fd);
+	}
+
+	// Wait for the file to be created
+	MPI_Barrier(MPI_COMM_WORLD);
+
+	// Write patch data from each process in a single call
+	if (vecBuffers.size() != 0) {
+		int fd = open(m_strActiveFileName.c_str(), O_WRONLY);
+		if (fd < 0) {
+			_EXCEPTION2("Unable to open checkpoint file \"%s\": %s",
+				m_strActiveFileName.c_str(), strerror(errno));
+		}
+
+		TransferCheckpointBuffers(fd, nRankDataOffset, vecBuffers, true);
+
+		close(fd);
+	}
+
+	// Barrier
+	MPI_Barrier(MPI_COMM_WORLD);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+Time OutputManagerCheckpoint::Input(
+	const std::string & strFileName
+) {
+	// Set the flag indicating that output came from a restart file
+	m_fFromRestartFile = true;
+
+	// Determine processor rank
+	int nRank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &nRank);
+
+	// Equation set
+	const EquationSet & eqn = m_grid.GetModel().GetEquationSet();
+
+	int nPatches = m_grid.GetPatchCount();
+
+	// Read the header and index on the root process
+	CheckpointHeader header;
+	std::vector<CheckpointPatchRecord> vecIndex(nPatches);
+
+	if (nRank == 0) {
+		int fd = OpenCheckpointFile(strFileName, header);
+
+		if (header.nPatches != nPatches) {
+			_EXCEPTION2("Checkpoint patch count mismatch (%i, expected %i)",
+				header.nPatches, nPatches);
+		}
+		if ((header.nComponents != eqn.GetComponents()) ||
+			(header.nTracers != eqn.GetTracers()) ||
+			(header.nRElements != m_grid.GetRElements()) ||
+			(header.fHasReferenceState != (m_grid.HasReferenceState()?1:0))
+		) {
+			_EXCEPTIONT("Checkpoint is incompatible with the model");
+		}
+
+		std::vector<iovec> vecIndexBuffer(1);
+		vecIndexBuffer[0].iov_base = &(vecIndex[0]);
+		vecIndexBuffer[0].iov_len = nPatches * sizeof(CheckpointPatchRecord);
+
+		TransferCheckpointBuffers(
+			fd, sizeof(CheckpointHeader), vecIndexBuffer, false);
+
+		close(fd);
+	}
+
+	MPI_Bcast(&header, sizeof(CheckpointHeader), MPI_BYTE, 0, MPI_COMM_WORLD);
+
+	MPI_Bcast(
+		&(vecIndex[0]),
+		nPatches * sizeof(CheckpointPatchRecord),
+		MPI_BYTE,
+		0,
+		MPI_COMM_WORLD);
+
+	// Order the active patches by their location in the file
+	int nActivePatches = m_grid.GetActivePatchCount();
+
+	std::vector< std::pair<int64_t, int> > vecFileOrder(nActivePatches);
+	for (int n = 0; n < nActivePatches; n++) {
+		int ixPatch = m_grid.GetActivePatch(n)->GetPatchIndex();
+		vecFileOrder[n].first = vecIndex[ixPatch].nOffset;
+		vecFileOrder[n].second = n;
+	}
+	std::sort(vecFileOrder.begin(), vecFileOrder.end());
+
+	// Patches are located through the index, so the distribution of
+	// patches among processors may differ from the one used for output.
+	// Read each contiguous range of patches in a single call; when the
+	// distribution is unchanged this is a single read.
+	int fd = -1;
+	if (nActivePatches != 0) {
+		fd = open(strFileName.c_str(), O_RDONLY);
+		if (fd < 0) {
+			_EXCEPTION2("Unable to open checkpoint file \"%s\": %s",
+				strFileName.c_str(), strerror(errno));
+		}
+	}
+
+	std::vector<iovec> vecBuffers;
+	int64_t nRangeBegin = 0;
+	int64_t nRangeEnd = 0;
+
+	for (int i = 0; i < nActivePatches; i++) {
+		GridPatch * pPatch = m_grid.GetActivePatch(vecFileOrder[i].second);
+
+		const CheckpointPatchRecord & record =
+			vecIndex[pPatch->GetPatchIndex()];
+
+		if ((vecBuffers.size() != 0) && (record.nOffset != nRangeEnd)) {
+			TransferCheckpointBuffers(fd, nRangeBegin, vecBuffers, false);
+			vecBuffers.clear();
+		}
+		if (vecBuffers.size() == 0) {
+			nRangeBegin = record.nOffset;
+			nRangeEnd = record.nOffset;
+		}
+
+		int ixFirstBuffer = static_cast<int>(vecBuffers.size());
+
+		GetPatchBuffers(pPatch, vecBuffers);
+
+		int64_t nPatchBytes = 0;
+		for (int j = ixFirstBuffer; j < vecBuffers.size(); j++) {
+			nPatchBytes += vecBuffers[j].iov_len;
+		}
+		if (nPatchBytes != record.nBytes) {
+			_EXCEPTION1("Checkpoint data size mismatch on patch %i",
+				pPatch->GetPatchIndex());
+		}
+
+		nRangeEnd += nPatchBytes;
+	}
+
+	if (vecBuffers.size() != 0) {
+		TransferCheckpointBuffers(fd, nRangeBegin, vecBuffers, false);
+	}
+
+	if (fd >= 0) {
+		close(fd);
+	}
+
+	// Verify patch checksums
+	if (m_fVerifyInput) {
+		int nLocalMismatches = 0;
+
+		for (int n = 0; n < nActivePatches; n++) {
+			GridPatch * pPatch = m_grid.GetActivePatch(n);
+
+			std::vector<iovec> vecPatchBuffers;
+			GetPatchBuffers(pPatch, vecPatchBuffers);
+
+			uint64_t uChecksum =
+				ComputeCheckpointChecksum(
+					&(vecPatchBuffers[0]),
+					static_cast<int>(vecPatchBuffers.size()));
+
+			if (uChecksum != vecIndex[pPatch->GetPatchIndex()].uChecksum) {
+				nLocalMismatches++;
+			}
+		}
+
+		int nMismatches = 0;
+		MPI_Allreduce(
+			&nLocalMismatches,
+			&nMismatches,
+			1,
+			MPI_INT,
+			MPI_SUM,
+			MPI_COMM_WORLD);
+
+		if (nMismatches != 0) {
+			_EXCEPTION1("Checkpoint verification failed on %i patches",
+				nMismatches);
+		}
+
+		Announce("Checkpoint verified (%i patches)", nPatches);
+	}
+
+	return Time(std::string(header.szTime));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,138 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    OutputManagerCheckpoint.h
+///	\author  Paul Ullrich
+///	\version October 18, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _OUTPUTMANAGERCHECKPOINT_H_
+#define _OUTPUTMANAGERCHECKPOINT_H_
+
+#include "OutputManager.h"
+
+#include <sys/uio.h>
+
+#include <vector>
+
+class Time;
+class GridPatch;
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		An OutputManager which writes restart data in a native binary
+///		format.  The file contains a small header and an index of patches,
+///		followed by the raw data arrays of each patch.  Each process writes
+///		the data for its active patches with a single vectored system call.
+///		On input the patch layout of the checkpoint is reproduced and each
+///		process reads only the patches assigned to it, so a checkpoint can
+///		be read on a different number of processors.
+///	</summary>
+class OutputManagerCheckpoint : public OutputManager {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	OutputManagerCheckpoint(
+		Grid & grid,
+		const Time & timeOutputFrequency,
+		std::string strOutputDir,
+		std::string strOutputPrefix
+	);
+
+	///	<summary>
+	///		Get the name of the OutputManager.
+	///	</summary>
+	virtual const char * GetName() const {
+		return "Checkpoint";
+	}
+
+	///	<summary>
+	///		Get the number of processors for which the patches in the given
+	///		checkpoint were laid out.  Must be called on all processors.
+	///	</summary>
+	static int GetPatchProcessors(
+		const std::string & strFileName
+	);
+
+	///	<summary>
+	///		Modify the flag which indicates whether patch checksums should
+	///		be verified when reading a checkpoint.
+	///	</summary>
+	void VerifyInput(
+		bool fVerifyInput = true
+	) {
+		m_fVerifyInput = fVerifyInput;
+	}
+
+protected:
+	///	<summary>
+	///		Open a new checkpoint file.
+	///	</summary>
+	virtual bool OpenFile(
+		const std::string & strFileName
+	);
+
+	///	<summary>
+	///		Close an existing checkpoint file.
+	///	</summary>
+	virtual void CloseFile();
+
+	///	<summary>
+	///		Write output to a file.
+	///	</summary>
+	virtual void Output(
+		const Time & time
+	);
+
+protected:
+	///	<summary>
+	///		Returns true if this OutputManager supports the input operation.
+	///	</summary>
+	virtual bool SupportsInput() const {
+		return true;
+	}
+
+	///	<summary>
+	///		Initialize the grid data from a file.
+	///	</summary>
+	virtual Time Input(
+		const std::string & strFileName
+	);
+
+protected:
+	///	<summary>
+	///		Append the data arrays of a patch, in file order, to a vector
+	///		of buffers.
+	///	</summary>
+	void GetPatchBuffers(
+		GridPatch * pPatch,
+		std::vector<iovec> & vecBuffers
+	) const;
+
+protected:
+	///	<summary>
+	///		Name of the active checkpoint file.
+	///	</summary>
+	std::string m_strActiveFileName;
+
+	///	<summary>
+	///		Flag indicating patch checksums should be verified on input.
+	///	</summary>
+	bool m_fVerifyInput;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
@@ -18,28 +18,157 @@
 
 #include "Model.h"
 #include "Grid.h"
+#include "GridPatch.h"
 
 #include "Announce.h"
+#include "ReproducibleSum.h"
 
 #include "mpi.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 ///////////////////////////////////////////////////////////////////////////////
 
 OutputManagerChecksum::OutputManagerChecksum(
 	Grid & grid,
-	const Time & timeOutputFrequency
+	const Time & timeOutputFrequency,
+	const std::string & strLogFile
 ) :
 	OutputManager(
 		grid,
 		timeOutputFrequency,
 		"",
 		"",
-		-1)
+		-1),
+	m_strLogFile(strLogFile),
+	m_fpLog(NULL),
+	m_nLogComponents(0),
+	m_nLogRecords(0),
+	m_dLogPendingTime(0.0),
+	m_reqLogSum(MPI_REQUEST_NULL),
+	m_reqLogMax(MPI_REQUEST_NULL)
 {
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
+OutputManagerChecksum::~OutputManagerChecksum() {
+	if (m_fpLog != NULL) {
+		fclose(m_fpLog);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OutputManagerChecksum::CompleteOutput() {
+	if (m_strLogFile == "") {
+		return;
+	}
+
+	EndLogReduction();
+
+	if (m_fpLog != NULL) {
+		fclose(m_fpLog);
+		m_fpLog = NULL;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool OutputManagerChecksum::OpenFile(
+	const std::string & strFileName
+) {
+	if (m_strLogFile == "") {
+		return true;
+	}
+
+	// Equation set
+	const EquationSet & eqn = m_grid.GetModel().GetEquationSet();
+
+	m_nLogComponents = eqn.GetComponents() + eqn.GetTracers();
+
+	// Only the root processor writes to the log
+	int nRank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &nRank);
+
+	if (nRank != 0) {
+		return true;
+	}
+
+	m_fpLog = fopen(m_strLogFile.c_str(), "wb");
+	if (m_fpLog == NULL) {
+		return false;
+	}
+
+	// Header
+	int nComponents = m_nLogComponents;
+
+	fwrite("TEMPCHK1", sizeof(char), 8, m_fpLog);
+	fwrite(&nComponents, sizeof(int), 1, m_fpLog);
+
+	for (int c = 0; c < m_nLogComponents; c++) {
+		char szName[16];
+		memset(szName, 0, 16);
+
+		if (c < eqn.GetComponents()) {
+			strncpy(szName, eqn.GetComponentShortName(c).c_str(), 15);
+		} else {
+			strncpy(szName,
+				eqn.GetTracerShortName(c - eqn.GetComponents()).c_str(), 15);
+		}
+
+		fwrite(szName, sizeof(char), 16, m_fpLog);
+	}
+
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OutputManagerChecksum::EndLogReduction() {
+	if (m_reqLogSum == MPI_REQUEST_NULL) {
+		return;
+	}
+
+	MPI_Wait(&m_reqLogSum, MPI_STATUS_IGNORE);
+	MPI_Wait(&m_reqLogMax, MPI_STATUS_IGNORE);
+
+	if (m_fpLog == NULL) {
+		return;
+	}
+
+	// Convert exact sums
+	if (m_grid.HasReproducibleReductions()) {
+		for (int c = 0; c < 2 * m_nLogComponents; c++) {
+			m_dLogGlobalSum[c] = ReproducibleSum::ToDouble(
+				&(m_iLogGlobalSum[c * ReproducibleSum::BinCount]));
+		}
+	}
+
+	// Take the square root for the L2 norm
+	for (int c = 0; c < m_nLogComponents; c++) {
+		m_dLogGlobalSum[m_nLogComponents + c] =
+			sqrt(m_dLogGlobalSum[m_nLogComponents + c]);
+	}
+
+	int iRecord[2];
+	iRecord[0] = m_nLogRecords - 1;
+	iRecord[1] = 0;
+
+	fwrite(iRecord, sizeof(int), 2, m_fpLog);
+	fwrite(&m_dLogPendingTime, sizeof(double), 1, m_fpLog);
+	fwrite(&(m_dLogGlobalSum[0]), sizeof(double),
+		2 * m_nLogComponents, m_fpLog);
+	fwrite(&(m_dLogGlobalMax[0]), sizeof(double),
+		m_nLogComponents, m_fpLog);
+
+	fflush(m_fpLog);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void OutputManagerChecksum::Output(
 	const Time & time
 ) {
@@ -50,6 +179,145 @@ void OutputManagerChecksum::Output(
 	// Equation set
 	const EquationSet & eqn = m_grid.GetModel().GetEquationSet();
 
+	// Regression log
+	if (m_strLogFile != "") {
+
+		// Complete the reduction from the previous output, which has
+		// overlapped with the time steps since then
+		EndLogReduction();
+
+		if (m_nLogRecords == 0) {
+			m_timeLogStart = time;
+		}
+
+		// Compute local checksums; sums and squared L2 norms are stored
+		// in a single array so that they can be reduced together
+		int nComponents = eqn.GetComponents();
+		int nTracers = eqn.GetTracers();
+
+		const bool fReproducible = m_grid.HasReproducibleReductions();
+
+		const int nBins = ReproducibleSum::BinCount;
+
+		m_dLogLocalSum.Initialize(2 * m_nLogComponents);
+		m_dLogLocalMax.Initialize(m_nLogComponents);
+
+		if (fReproducible) {
+			m_iLogLocalSum.resize(2 * m_nLogComponents * nBins);
+		}
+
+		DataVector<double> dState;
+		DataVector<double> dTracers;
+
+		std::vector<int64_t> iState;
+		std::vector<int64_t> iTracers;
+
+		for (int t = 0; t < 3; t++) {
+			ChecksumType eChecksumType = ChecksumType_Sum;
+			if (t == 1) {
+				eChecksumType = ChecksumType_L2;
+			} else if (t == 2) {
+				eChecksumType = ChecksumType_Linf;
+			}
+
+			// Sums and L2 norms are accumulated exactly
+			if (fReproducible && (t != 2)) {
+				m_grid.ChecksumReproducibleLocal(
+					DataType_State, iState, 0, eChecksumType);
+
+				std::copy(iState.begin(), iState.end(),
+					m_iLogLocalSum.begin() + t * m_nLogComponents * nBins);
+
+				if (nTracers != 0) {
+					m_grid.ChecksumReproducibleLocal(
+						DataType_Tracers, iTracers, 0, eChecksumType);
+
+					std::copy(iTracers.begin(), iTracers.end(),
+						m_iLogLocalSum.begin()
+							+ (t * m_nLogComponents + nComponents) * nBins);
+				}
+				continue;
+			}
+
+			dState.Initialize(nComponents);
+			if (nTracers != 0) {
+				dTracers.Initialize(nTracers);
+			}
+
+			for (int n = 0; n < m_grid.GetActivePatchCount(); n++) {
+				const GridPatch * pPatch = m_grid.GetActivePatch(n);
+
+				pPatch->Checksum(
+					DataType_State, dState, 0, eChecksumType);
+
+				if (nTracers != 0) {
+					pPatch->Checksum(
+						DataType_Tracers, dTracers, 0, eChecksumType);
+				}
+			}
+
+			double * dLocal = &(m_dLogLocalSum[t * m_nLogComponents]);
+			if (t == 2) {
+				dLocal = &(m_dLogLocalMax[0]);
+			}
+
+			for (int c = 0; c < nComponents; c++) {
+				dLocal[c] = dState[c];
+			}
+			for (int c = 0; c < nTracers; c++) {
+				dLocal[nComponents + c] = dTracers[c];
+			}
+		}
+
+		// Begin reduction to the root processor
+		if (nRank == 0) {
+			m_dLogGlobalSum.Initialize(2 * m_nLogComponents);
+			m_dLogGlobalMax.Initialize(m_nLogComponents);
+		}
+
+		if (fReproducible) {
+			if (nRank == 0) {
+				m_iLogGlobalSum.resize(m_iLogLocalSum.size());
+			}
+
+			MPI_Ireduce(
+				&(m_iLogLocalSum[0]),
+				(nRank == 0)?(&(m_iLogGlobalSum[0])):(NULL),
+				m_iLogLocalSum.size(),
+				MPI_INT64_T,
+				MPI_SUM,
+				0,
+				MPI_COMM_WORLD,
+				&m_reqLogSum);
+
+		} else {
+			MPI_Ireduce(
+				&(m_dLogLocalSum[0]),
+				(nRank == 0)?(&(m_dLogGlobalSum[0])):(NULL),
+				2 * m_nLogComponents,
+				MPI_DOUBLE,
+				MPI_SUM,
+				0,
+				MPI_COMM_WORLD,
+				&m_reqLogSum);
+		}
+
+		MPI_Ireduce(
+			&(m_dLogLocalMax[0]),
+			(nRank == 0)?(&(m_dLogGlobalMax[0])):(NULL),
+			m_nLogComponents,
+			MPI_DOUBLE,
+			MPI_MAX,
+			0,
+			MPI_COMM_WORLD,
+			&m_reqLogMax);
+
+		m_dLogPendingTime = time - m_timeLogStart;
+		m_nLogRecords++;
+
+		return;
+	}
+
 	// Compute checksums
 	DataVector<double> dChecksum;
 
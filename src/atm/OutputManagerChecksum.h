@@ -19,6 +19,12 @@
 
 #include "OutputManager.h"
 
+#include <mpi.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
 class Time;
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -27,6 +33,29 @@ class Time;
 ///		An OutputManager which provides checksums to standard output.  This
 ///		type of OutputManager is used to verify conservation properties.
 ///	</summary>
+///	<remarks>
+///		If a log file is given the checksums are instead written to a binary
+///		regression log which can be compared with ChecksumCompare.  The sum,
+///		L2 norm and maximum norm of each state variable and tracer are
+///		reduced with a non-blocking reduction which completes at the next
+///		output, so that the reduction overlaps with the intervening time
+///		steps.  If the Grid computes reductions reproducibly the sums and
+///		L2 norms in the log are also reproducible.  The log is laid out as
+///		follows (native byte order):
+///
+///		char[8]    "TEMPCHK1"
+///		int32      number of components N
+///		char[16]   short name of each component
+///
+///		followed by one record per output:
+///
+///		int32      output index
+///		int32      (reserved)
+///		double     time since the first output (in seconds)
+///		double[N]  sum of each component
+///		double[N]  L2 norm of each component
+///		double[N]  maximum norm of each component
+///	</remarks>
 class OutputManagerChecksum : public OutputManager {
 
 public:
@@ -35,23 +64,121 @@ public:
 	///	</summary>
 	OutputManagerChecksum(
 		Grid & grid,
-		const Time & timeOutputFrequency
+		const Time & timeOutputFrequency,
+		const std::string & strLogFile = ""
 	);
 
+	///	<summary>
+	///		Destructor.
+	///	</summary>
+	virtual ~OutputManagerChecksum();
+
 	///	<summary>
 	///		Get the name of the OutputManager.
 	///	</summary>
 	virtual const char * GetName() const {
+		if (m_strLogFile != "") {
+			return "Checksum log";
+		}
 		return "Checksum ";
 	}
 
+	///	<summary>
+	///		Complete the pending reduction and close the log.
+	///	</summary>
+	virtual void CompleteOutput();
+
 protected:
+	///	<summary>
+	///		Open the log file and write its header.
+	///	</summary>
+	virtual bool OpenFile(
+		const std::string & strFileName
+	);
+
 	///	<summary>
 	///		Perform an output.
 	///	</summary>
 	void Output(
 		const Time & time
 	);
+
+protected:
+	///	<summary>
+	///		Wait for the pending reduction and write its record to the log.
+	///	</summary>
+	void EndLogReduction();
+
+protected:
+	///	<summary>
+	///		Name of the regression log, or empty if checksums are written
+	///		to standard output.
+	///	</summary>
+	std::string m_strLogFile;
+
+	///	<summary>
+	///		Regression log (only open on the root processor).
+	///	</summary>
+	FILE * m_fpLog;
+
+	///	<summary>
+	///		Number of components in the regression log.
+	///	</summary>
+	int m_nLogComponents;
+
+	///	<summary>
+	///		Number of records started.
+	///	</summary>
+	int m_nLogRecords;
+
+	///	<summary>
+	///		Time of the first output.
+	///	</summary>
+	Time m_timeLogStart;
+
+	///	<summary>
+	///		Time associated with the pending reduction.
+	///	</summary>
+	double m_dLogPendingTime;
+
+	///	<summary>
+	///		Local sums and squared L2 norms of each component.
+	///	</summary>
+	DataVector<double> m_dLogLocalSum;
+
+	///	<summary>
+	///		Local maximum norms of each component.
+	///	</summary>
+	DataVector<double> m_dLogLocalMax;
+
+	///	<summary>
+	///		Global sums and squared L2 norms of each component (on root).
+	///	</summary>
+	DataVector<double> m_dLogGlobalSum;
+
+	///	<summary>
+	///		Global maximum norms of each component (on root).
+	///	</summary>
+	DataVector<double> m_dLogGlobalMax;
+
+	///	<summary>
+	///		Local sums and squared L2 norms as ReproducibleSum accumulators,
+	///		used if the Grid computes reductions reproducibly.
+	///	</summary>
+	std::vector<int64_t> m_iLogLocalSum;
+
+	///	<summary>
+	///		Global sums and squared L2 norms as ReproducibleSum accumulators
+	///		(on root).
+	///	</summary>
+	std::vector<int64_t> m_iLogGlobalSum;
+
+	///	<summary>
+	///		Requests for the pending reductions.
+	///	</summary>
+	MPI_Request m_reqLogSum;
+
+	MPI_Request m_reqLogMax;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -18,13 +18,22 @@
 
 #include "Model.h"
 #include "Grid.h"
-#include "ConsolidationStatus.h"
 
 #include "TimeObj.h"
 #include "Announce.h"
 
 #include "mpi.h"
 
+#ifdef USE_PARALLEL_NETCDF
+#include <netcdf.h>
+#include <netcdf_meta.h>
+#include <netcdf_par.h>
+
+#if !NC_HAS_PARALLEL4
+#error "USE_PARALLEL_NETCDF requires NetCDF built with parallel HDF5"
+#endif
+#endif
+
 #include <iostream>
 #include <cstdio>
 #include <cmath>
@@ -77,10 +86,13 @@ bool OutputManagerComposite::OpenFile(
 	NcVar * varRayleighStrengthNode;
 	NcVar * varRayleighStrengthREdge;
 
-	if (nRank == 0) {
+	// NetCDF calls may not overlap with asynchronous output
+	FlushOutputTasks();
 
-		// Allocate receive buffer
-		m_vecRecvBuffer.Initialize(m_grid.GetMaxDegreesOfFreedom());
+	// Name of the NetCDF file, which is reopened by all processes for output
+	m_strActiveNcFileName = strFileName + ".restart.nc";
+
+	if (nRank == 0) {
 
 		// Check for existing NetCDF file
 		if (m_pActiveNcOutput != NULL) {
@@ -88,11 +100,7 @@ bool OutputManagerComposite::OpenFile(
 		}
 
 		// Open new NetCDF file
-		std::string strNcFileName = strFileName + ".restart.nc";
-		m_pActiveNcOutput = new NcFile(strNcFileName.c_str(), NcFile::Replace);
-		if (m_pActiveNcOutput == NULL) {
-			_EXCEPTIONT("Error opening NetCDF file");
-		}
+		m_pActiveNcOutput = m_format.CreateFile(m_strActiveNcFileName);
 
 		// Create nodal index dimension
 		NcDim * dimNodeIndex2D =
@@ -183,6 +191,44 @@ bool OutputManagerComposite::OpenFile(
 		m_varRayleighStrengthREdge =
 			m_pActiveNcOutput->add_var(
 				"Rayleigh_REdge", ncDouble, dimREdgeIndex);
+
+		// Chunking and compression of output variables; restart data is
+		// never quantized
+		const int nRElements = m_grid.GetRElements();
+
+		for (int c = 0; c < eqn.GetComponents(); c++) {
+			std::string strComponentName = eqn.GetComponentShortName(c);
+
+			if (m_grid.GetVarLocation(c) == DataLocation_Node) {
+				DefineOutputVariable(
+					m_vecStateVar[c], strComponentName, nRElements);
+			} else {
+				DefineOutputVariable(
+					m_vecStateVar[c], strComponentName, nRElements+1);
+			}
+
+			if (m_grid.HasReferenceState()) {
+				DefineOutputVariable(
+					m_vecRefStateVarNode[c],
+					strComponentName + "_RefNode",
+					nRElements);
+				DefineOutputVariable(
+					m_vecRefStateVarREdge[c],
+					strComponentName + "_RefREdge",
+					nRElements+1);
+			}
+		}
+
+		for (int c = 0; c < eqn.GetTracers(); c++) {
+			DefineOutputVariable(
+				m_vecTracersVar[c], eqn.GetTracerShortName(c), nRElements);
+		}
+
+		DefineOutputVariable(m_varZs, "ZS", 1);
+		DefineOutputVariable(
+			m_varRayleighStrengthNode, "Rayleigh_Node", nRElements);
+		DefineOutputVariable(
+			m_varRayleighStrengthREdge, "Rayleigh_REdge", nRElements+1);
 	}
 
 	// Wait for all processes to complete
@@ -193,7 +239,38 @@ bool OutputManagerComposite::OpenFile(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void OutputManagerComposite::DefineOutputVariable(
+	NcVar * var,
+	const std::string & strVariableName,
+	int nLevels
+) {
+	// Largest number of 2D nodes on any patch
+	long nMaxPatchNodes2D = 0;
+	for (int n = 0; n < m_grid.GetPatchCount(); n++) {
+		long nPatchNodes2D =
+			m_grid.GetCumulativePatch2DNodeIndex(n+1)
+			- m_grid.GetCumulativePatch2DNodeIndex(n);
+
+		if (nPatchNodes2D > nMaxPatchNodes2D) {
+			nMaxPatchNodes2D = nPatchNodes2D;
+		}
+	}
+
+	// Chunks contain one level or all levels of a patch
+	long nChunkSize = nMaxPatchNodes2D;
+	if (m_format.m_eChunking == OutputChunking_Patch) {
+		nChunkSize *= static_cast<long>(nLevels);
+	}
+
+	m_format.DefineVariable(
+		m_pActiveNcOutput, var, strVariableName, 1, &nChunkSize, false);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void OutputManagerComposite::CloseFile() {
+	FlushOutputTasks();
+
 	if (m_pActiveNcOutput != NULL) {
 		delete(m_pActiveNcOutput);
 		m_pActiveNcOutput = NULL;
@@ -202,9 +279,65 @@ void OutputManagerComposite::CloseFile() {
 		m_vecRefStateVarNode.clear();
 		m_vecRefStateVarREdge.clear();
 		m_vecTracersVar.clear();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OutputManagerComposite::ReopenFile() {
+
+	// Check for existing NetCDF file
+	if (m_pActiveNcOutput != NULL) {
+		_EXCEPTIONT("NetCDF file already open");
+	}
+
+	// Open existing NetCDF file for writing
+	m_pActiveNcOutput =
+		new NcFile(m_strActiveNcFileName.c_str(), NcFile::Write);
+	if ((m_pActiveNcOutput == NULL) || (!m_pActiveNcOutput->is_valid())) {
+		_EXCEPTION1("Error opening NetCDF file \"%s\"",
+			m_strActiveNcFileName.c_str());
+	}
+
+	// Equation set
+	const EquationSet & eqn = m_grid.GetModel().GetEquationSet();
+
+	// Retrieve variables from the NetCDF file
+	for (int c = 0; c < eqn.GetComponents(); c++) {
+		std::string strComponentName = eqn.GetComponentShortName(c);
+
+		m_vecStateVar.push_back(
+			GetVariable(strComponentName));
+
+		if (m_grid.HasReferenceState()) {
+			m_vecRefStateVarNode.push_back(
+				GetVariable(strComponentName + "_RefNode"));
+			m_vecRefStateVarREdge.push_back(
+				GetVariable(strComponentName + "_RefREdge"));
+		}
+	}
+
+	for (int c = 0; c < eqn.GetTracers(); c++) {
+		m_vecTracersVar.push_back(
+			GetVariable(eqn.GetTracerShortName(c)));
+	}
+
+	m_varZs = GetVariable("ZS");
+	m_varRayleighStrengthNode = GetVariable("Rayleigh_Node");
+	m_varRayleighStrengthREdge = GetVariable("Rayleigh_REdge");
+}
 
-		m_vecRecvBuffer.Deinitialize();
+///////////////////////////////////////////////////////////////////////////////
+
+NcVar * OutputManagerComposite::GetVariable(
+	const std::string & strVariableName
+) {
+	NcVar * var = m_pActiveNcOutput->get_var(strVariableName.c_str());
+	if (var == NULL) {
+		_EXCEPTION1("Cannot find variable \'%s\' in file",
+			strVariableName.c_str());
 	}
+	return var;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -222,10 +355,16 @@ void OutputManagerComposite::Output(
 		_EXCEPTIONT("Only one Composite output allowed per file");
 	}
 
-	// Determine processor rank
+	// Determine processor rank and number of processors
 	int nRank;
 	MPI_Comm_rank(MPI_COMM_WORLD, &nRank);
 
+	int nSize;
+	MPI_Comm_size(MPI_COMM_WORLD, &nSize);
+
+	// NetCDF calls may not overlap with asynchronous output
+	FlushOutputTasks();
+
 	// Equation set
 	const EquationSet & eqn = m_grid.GetModel().GetEquationSet();
 
@@ -235,231 +374,366 @@ void OutputManagerComposite::Output(
 			"current_time", time.ToLongString().c_str());
 	}
 
-	// Begin data consolidation
-	std::vector<DataTypeLocationPair> vecDataTypes;
-	vecDataTypes.push_back(DataType_Topography);
-	vecDataTypes.push_back(
-		DataTypeLocationPair(DataType_RayleighStrength, DataLocation_Node));
-	vecDataTypes.push_back(
-		DataTypeLocationPair(DataType_RayleighStrength, DataLocation_REdge));
+#ifdef USE_PARALLEL_NETCDF
+	// NetCDF-4 files are written by all processes simultaneously
+	if (m_format.m_fNetCDF4) {
+		CloseFile();
 
-	if (m_grid.GetVarsAtLocation(DataLocation_Node) != 0) {
-		vecDataTypes.push_back(
-			DataTypeLocationPair(DataType_State, DataLocation_Node));
-	}
-	if (m_grid.GetVarsAtLocation(DataLocation_REdge) != 0) {
-		vecDataTypes.push_back(
-			DataTypeLocationPair(DataType_State, DataLocation_REdge));
-	}
+		OutputCollective();
 
-	if (m_grid.HasReferenceState()) {
-		vecDataTypes.push_back(
-			DataTypeLocationPair(DataType_RefState, DataLocation_Node));
-		vecDataTypes.push_back(
-			DataTypeLocationPair(DataType_RefState, DataLocation_REdge));
+		MPI_Barrier(MPI_COMM_WORLD);
+		return;
 	}
+#endif
 
-	if (eqn.GetTracers() != 0) {
-		vecDataTypes.push_back(DataType_Tracers);
-	}
+	// Each process writes its own patches directly to the file.  The
+	// NetCDF file is handed from one process to the next in rank order.
+	const int CompositeOutputTokenTag = 0x7FFF;
 
-	ConsolidationStatus status(m_grid, vecDataTypes);
+	int iToken = 0;
 
-	m_grid.ConsolidateDataToRoot(status);
+	if (nRank != 0) {
+		MPI_Recv(
+			&iToken,
+			1,
+			MPI_INT,
+			nRank - 1,
+			CompositeOutputTokenTag,
+			MPI_COMM_WORLD,
+			MPI_STATUS_IGNORE);
+
+		ReopenFile();
+	}
 
-	// Receive all data objects from neighbors
-	while ((nRank == 0) && (!status.Done())) {
-		int nRecvCount;
-		int ixRecvPatch;
-		DataType eRecvDataType;
-		DataLocation eRecvDataLocation;
+	for (int n = 0; n < m_grid.GetActivePatchCount(); n++) {
+		const GridPatch * pPatch = m_grid.GetActivePatch(n);
 
-		m_grid.ConsolidateDataAtRoot(
-			status,
-			m_vecRecvBuffer,
-			nRecvCount,
-			ixRecvPatch,
-			eRecvDataType,
-			eRecvDataLocation);
+		int ixCumulative2DNode =
+			m_grid.GetCumulativePatch2DNodeIndex(pPatch->GetPatchIndex());
 
 		// Store topography data
-		if (eRecvDataType == DataType_Topography) {
-			int nPatchIx = m_grid.GetCumulativePatch2DNodeIndex(ixRecvPatch);
-			m_varZs->set_cur(nPatchIx);
-			m_varZs->put(&(m_vecRecvBuffer[0]), nRecvCount);
+		const DataMatrix<double> & dataTopography = pPatch->GetTopography();
+
+		m_varZs->set_cur(ixCumulative2DNode);
+		m_varZs->put(
+			dataTopography[0],
+			pPatch->GetTotalNodeCount2D());
 
 		// Store Rayleigh strength data at nodes and edges
-		} else if (eRecvDataType == DataType_RayleighStrength) {
-			if (eRecvDataLocation == DataLocation_Node) {
-				if (nRecvCount % m_grid.GetRElements() != 0) {
-					_EXCEPTIONT("Invalid message length");
-				}
+		const GridData3D & dataRayleighStrengthNode =
+			pPatch->GetRayleighStrength(DataLocation_Node);
+		const GridData3D & dataRayleighStrengthREdge =
+			pPatch->GetRayleighStrength(DataLocation_REdge);
 
-			} else if (eRecvDataLocation == DataLocation_REdge) {
-				if (nRecvCount % (m_grid.GetRElements()+1) != 0) {
-					_EXCEPTIONT("Invalid message length");
-				}
+		m_varRayleighStrengthNode->set_cur(
+			ixCumulative2DNode * m_grid.GetRElements());
+		m_varRayleighStrengthNode->put(
+			dataRayleighStrengthNode[0][0],
+			pPatch->GetTotalNodeCount(DataLocation_Node));
+
+		m_varRayleighStrengthREdge->set_cur(
+			ixCumulative2DNode * (m_grid.GetRElements()+1));
+		m_varRayleighStrengthREdge->put(
+			dataRayleighStrengthREdge[0][0],
+			pPatch->GetTotalNodeCount(DataLocation_REdge));
+
+		// Store state variable data (only at relevant location)
+		const GridData4D & dataStateNode =
+			pPatch->GetDataState(0, DataLocation_Node);
+		const GridData4D & dataStateREdge =
+			pPatch->GetDataState(0, DataLocation_REdge);
+
+		for (int c = 0; c < eqn.GetComponents(); c++) {
+			if (m_grid.GetVarLocation(c) == DataLocation_Node) {
+				m_vecStateVar[c]->set_cur(
+					ixCumulative2DNode * m_grid.GetRElements());
+				m_vecStateVar[c]->put(
+					dataStateNode[c][0][0],
+					pPatch->GetTotalNodeCount(DataLocation_Node));
+
+			} else if (m_grid.GetVarLocation(c) == DataLocation_REdge) {
+				m_vecStateVar[c]->set_cur(
+					ixCumulative2DNode * (m_grid.GetRElements()+1));
+				m_vecStateVar[c]->put(
+					dataStateREdge[c][0][0],
+					pPatch->GetTotalNodeCount(DataLocation_REdge));
 
 			} else {
 				_EXCEPTIONT("Invalid DataLocation");
 			}
+		}
 
-			int ixCumulative2DNode =
-				m_grid.GetCumulativePatch2DNodeIndex(ixRecvPatch);
-
-			int nComponentSize =
-				m_grid.GetPatch(ixRecvPatch)->GetTotalNodeCount(
-					eRecvDataLocation);
+		// Store reference state variable data (at all locations)
+		if (m_grid.HasReferenceState()) {
+			const GridData4D & dataRefStateNode =
+				pPatch->GetReferenceState(DataLocation_Node);
+			const GridData4D & dataRefStateREdge =
+				pPatch->GetReferenceState(DataLocation_REdge);
 
-			if (eRecvDataLocation == DataLocation_Node) {
-				m_varRayleighStrengthNode->set_cur(
+			for (int c = 0; c < eqn.GetComponents(); c++) {
+				m_vecRefStateVarNode[c]->set_cur(
 					ixCumulative2DNode * m_grid.GetRElements());
-				m_varRayleighStrengthNode->put(
-					&(m_vecRecvBuffer[0]), nComponentSize);
+				m_vecRefStateVarNode[c]->put(
+					dataRefStateNode[c][0][0],
+					pPatch->GetTotalNodeCount(DataLocation_Node));
 
-			} else if (eRecvDataLocation == DataLocation_REdge) {
-				m_varRayleighStrengthREdge->set_cur(
+				m_vecRefStateVarREdge[c]->set_cur(
 					ixCumulative2DNode * (m_grid.GetRElements()+1));
-				m_varRayleighStrengthREdge->put(
-					&(m_vecRecvBuffer[0]), nComponentSize);
-
-			} else {
-				_EXCEPTION();
+				m_vecRefStateVarREdge[c]->put(
+					dataRefStateREdge[c][0][0],
+					pPatch->GetTotalNodeCount(DataLocation_REdge));
 			}
+		}
 
-		// Store state variable data
-		} else if (eRecvDataType == DataType_State) {
-			if (eRecvDataLocation == DataLocation_Node) {
-				if (nRecvCount % m_grid.GetRElements() != 0) {
-					_EXCEPTIONT("Invalid message length");
-				}
+		// Store tracer variable data
+		if (eqn.GetTracers() != 0) {
+			const GridData4D & dataTracers = pPatch->GetDataTracers(0);
 
-			} else if (eRecvDataLocation == DataLocation_REdge) {
-				if (nRecvCount % (m_grid.GetRElements()+1) != 0) {
-					_EXCEPTIONT("Invalid message length");
-				}
+			int nCumulative3DNodeIx =
+				m_grid.GetCumulativePatch3DNodeIndex(pPatch->GetPatchIndex());
 
-			} else {
-				_EXCEPTIONT("Invalid DataLocation");
+			for (int c = 0; c < eqn.GetTracers(); c++) {
+				m_vecTracersVar[c]->set_cur(nCumulative3DNodeIx);
+				m_vecTracersVar[c]->put(
+					dataTracers[c][0][0],
+					pPatch->GetTotalNodeCount(DataLocation_Node));
 			}
+		}
+	}
 
-			int ixRecvPtr = 0;
+	// Flush data to disk and pass the file on to the next process
+	CloseFile();
 
-			int ixCumulative2DNode =
-				m_grid.GetCumulativePatch2DNodeIndex(ixRecvPatch);
+	if (nRank != nSize - 1) {
+		MPI_Send(
+			&iToken,
+			1,
+			MPI_INT,
+			nRank + 1,
+			CompositeOutputTokenTag,
+			MPI_COMM_WORLD);
+	}
 
-			for (int c = 0; c < eqn.GetComponents(); c++) {
+	// Barrier
+	MPI_Barrier(MPI_COMM_WORLD);
+}
 
-				// Advance the pointer in the receive buffer
-				int nComponentSize =
-					m_grid.GetPatch(ixRecvPatch)->GetTotalNodeCount(
-						eRecvDataLocation);
-
-				// Only output data at relevant location
-				if (m_grid.GetVarLocation(c) == eRecvDataLocation) {
-					int nRadialDegreesOfFreedom;
-					if (eRecvDataLocation == DataLocation_Node) {
-						nRadialDegreesOfFreedom = m_grid.GetRElements();
-					} else if (eRecvDataLocation == DataLocation_REdge) {
-						nRadialDegreesOfFreedom = m_grid.GetRElements()+1;
-					} else {
-						_EXCEPTION();
-					}
-
-					m_vecStateVar[c]->set_cur(
-						ixCumulative2DNode * nRadialDegreesOfFreedom);
-					m_vecStateVar[c]->put(
-						&(m_vecRecvBuffer[ixRecvPtr]), nComponentSize);
-				}
+///////////////////////////////////////////////////////////////////////////////
 
-				ixRecvPtr += nComponentSize;
-			}
+#ifdef USE_PARALLEL_NETCDF
 
-		// Store reference state variable data
-		} else if (eRecvDataType == DataType_RefState) {
-			if (eRecvDataLocation == DataLocation_Node) {
-				if (nRecvCount % m_grid.GetRElements() != 0) {
-					_EXCEPTIONT("Invalid message length");
-				}
+void OutputManagerComposite::OutputCollective() {
 
-			} else if (eRecvDataLocation == DataLocation_REdge) {
-				if (nRecvCount % (m_grid.GetRElements()+1) != 0) {
-					_EXCEPTIONT("Invalid message length");
-				}
+	// Equation set
+	const EquationSet & eqn = m_grid.GetModel().GetEquationSet();
 
-			} else {
-				_EXCEPTIONT("Invalid DataLocation");
-			}
+	// Number of radial elements
+	const int nRElements = m_grid.GetRElements();
+
+	// Every process must take part in each collective write, so the
+	// number of writes per variable is the largest active patch count
+	int nActivePatches = m_grid.GetActivePatchCount();
+
+	int nMaxActivePatches;
+	MPI_Allreduce(
+		&nActivePatches,
+		&nMaxActivePatches,
+		1,
+		MPI_INT,
+		MPI_MAX,
+		MPI_COMM_WORLD);
+
+	// Open the NetCDF file on all processes
+	int ncid;
+	int iError =
+		nc_open_par(
+			m_strActiveNcFileName.c_str(),
+			NC_WRITE,
+			MPI_COMM_WORLD,
+			MPI_INFO_NULL,
+			&ncid);
+
+	if (iError != NC_NOERR) {
+		_EXCEPTION2("Error opening NetCDF file \"%s\" for parallel output: %s",
+			m_strActiveNcFileName.c_str(), nc_strerror(iError));
+	}
 
-			int ixRecvPtr = 0;
+	// Hyperslab of each active patch in the 2D, 3D and 3D interface indices
+	std::vector<size_t> vecStart2D(nActivePatches);
+	std::vector<size_t> vecCount2D(nActivePatches);
+	std::vector<size_t> vecStartNode(nActivePatches);
+	std::vector<size_t> vecCountNode(nActivePatches);
+	std::vector<size_t> vecStartREdge(nActivePatches);
+	std::vector<size_t> vecCountREdge(nActivePatches);
+	std::vector<size_t> vecStart3D(nActivePatches);
 
-			int ixCumulative2DNode =
-				m_grid.GetCumulativePatch2DNodeIndex(ixRecvPatch);
+	for (int n = 0; n < nActivePatches; n++) {
+		const GridPatch * pPatch = m_grid.GetActivePatch(n);
 
-			for (int c = 0; c < eqn.GetComponents(); c++) {
+		size_t ixCumulative2DNode =
+			m_grid.GetCumulativePatch2DNodeIndex(pPatch->GetPatchIndex());
 
-				// Advance the pointer in the receive buffer
-				int nComponentSize =
-					m_grid.GetPatch(ixRecvPatch)->GetTotalNodeCount(
-						eRecvDataLocation);
+		vecStart2D[n] = ixCumulative2DNode;
+		vecCount2D[n] = pPatch->GetTotalNodeCount2D();
 
-				// Write data to file
-				int nRadialDegreesOfFreedom;
-				if (eRecvDataLocation == DataLocation_Node) {
-					nRadialDegreesOfFreedom = m_grid.GetRElements();
+		vecStartNode[n] = ixCumulative2DNode * nRElements;
+		vecCountNode[n] = pPatch->GetTotalNodeCount(DataLocation_Node);
 
-					m_vecRefStateVarNode[c]->set_cur(
-						ixCumulative2DNode * nRadialDegreesOfFreedom);
-					m_vecRefStateVarNode[c]->put(
-						&(m_vecRecvBuffer[ixRecvPtr]), nComponentSize);
+		vecStartREdge[n] = ixCumulative2DNode * (nRElements+1);
+		vecCountREdge[n] = pPatch->GetTotalNodeCount(DataLocation_REdge);
 
-				} else if (eRecvDataLocation == DataLocation_REdge) {
-					nRadialDegreesOfFreedom = m_grid.GetRElements()+1;
+		vecStart3D[n] =
+			m_grid.GetCumulativePatch3DNodeIndex(pPatch->GetPatchIndex());
+	}
 
-					m_vecRefStateVarREdge[c]->set_cur(
-						ixCumulative2DNode * nRadialDegreesOfFreedom);
-					m_vecRefStateVarREdge[c]->put(
-						&(m_vecRecvBuffer[ixRecvPtr]), nComponentSize);
+	// Data of each active patch
+	std::vector<const double *> vecData(nActivePatches);
 
-				} else {
-					_EXCEPTION();
-				}
+	// Store topography data
+	for (int n = 0; n < nActivePatches; n++) {
+		vecData[n] = m_grid.GetActivePatch(n)->GetTopography()[0];
+	}
+	PutVariableCollective(
+		ncid, "ZS", vecStart2D, vecCount2D, vecData, nMaxActivePatches);
 
-				ixRecvPtr += nComponentSize;
-			}
+	// Store Rayleigh strength data at nodes and edges
+	for (int n = 0; n < nActivePatches; n++) {
+		vecData[n] = m_grid.GetActivePatch(n)->
+			GetRayleighStrength(DataLocation_Node)[0][0];
+	}
+	PutVariableCollective(
+		ncid, "Rayleigh_Node",
+		vecStartNode, vecCountNode, vecData, nMaxActivePatches);
 
-		// Store tracer variable data
-		} else if (eRecvDataType == DataType_Tracers) {
-			int nComponentSize =
-				nRecvCount / eqn.GetTracers();
+	for (int n = 0; n < nActivePatches; n++) {
+		vecData[n] = m_grid.GetActivePatch(n)->
+			GetRayleighStrength(DataLocation_REdge)[0][0];
+	}
+	PutVariableCollective(
+		ncid, "Rayleigh_REdge",
+		vecStartREdge, vecCountREdge, vecData, nMaxActivePatches);
 
-			if (nRecvCount % eqn.GetTracers() != 0) {
-				_EXCEPTIONT("Invalid message length");
-			}
+	// Store state variable data (only at relevant location) and
+	// reference state variable data (at all locations)
+	for (int c = 0; c < eqn.GetComponents(); c++) {
+		std::string strComponentName = eqn.GetComponentShortName(c);
 
-			int nCumulative3DNodeIx =
-				m_grid.GetCumulativePatch3DNodeIndex(ixRecvPatch);
+		DataLocation loc = m_grid.GetVarLocation(c);
 
-			for (int c = 0; c < eqn.GetTracers(); c++) {
-				m_vecTracersVar[c]->set_cur(nCumulative3DNodeIx);
-				m_vecTracersVar[c]->put(
-					&(m_vecRecvBuffer[nComponentSize * c]), nComponentSize);
+		for (int n = 0; n < nActivePatches; n++) {
+			vecData[n] = m_grid.GetActivePatch(n)->
+				GetDataState(0, loc)[c][0][0];
+		}
+
+		if (loc == DataLocation_Node) {
+			PutVariableCollective(
+				ncid, strComponentName,
+				vecStartNode, vecCountNode, vecData, nMaxActivePatches);
+
+		} else if (loc == DataLocation_REdge) {
+			PutVariableCollective(
+				ncid, strComponentName,
+				vecStartREdge, vecCountREdge, vecData, nMaxActivePatches);
+
+		} else {
+			_EXCEPTIONT("Invalid DataLocation");
+		}
+
+		if (m_grid.HasReferenceState()) {
+			for (int n = 0; n < nActivePatches; n++) {
+				vecData[n] = m_grid.GetActivePatch(n)->
+					GetReferenceState(DataLocation_Node)[c][0][0];
+			}
+			PutVariableCollective(
+				ncid, strComponentName + "_RefNode",
+				vecStartNode, vecCountNode, vecData, nMaxActivePatches);
+
+			for (int n = 0; n < nActivePatches; n++) {
+				vecData[n] = m_grid.GetActivePatch(n)->
+					GetReferenceState(DataLocation_REdge)[c][0][0];
 			}
+			PutVariableCollective(
+				ncid, strComponentName + "_RefREdge",
+				vecStartREdge, vecCountREdge, vecData, nMaxActivePatches);
 		}
 	}
 
-	// Barrier
-	MPI_Barrier(MPI_COMM_WORLD);
+	// Store tracer variable data
+	for (int c = 0; c < eqn.GetTracers(); c++) {
+		for (int n = 0; n < nActivePatches; n++) {
+			vecData[n] = m_grid.GetActivePatch(n)->GetDataTracers(0)[c][0][0];
+		}
+		PutVariableCollective(
+			ncid, eqn.GetTracerShortName(c),
+			vecStart3D, vecCountNode, vecData, nMaxActivePatches);
+	}
+
+	// Flush data to disk
+	iError = nc_close(ncid);
+	if (iError != NC_NOERR) {
+		_EXCEPTION2("Error closing NetCDF file \"%s\": %s",
+			m_strActiveNcFileName.c_str(), nc_strerror(iError));
+	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void OutputManagerComposite::PutVariableCollective(
+	int ncid,
+	const std::string & strVariableName,
+	const std::vector<size_t> & vecStart,
+	const std::vector<size_t> & vecCount,
+	const std::vector<const double *> & vecData,
+	int nMaxActivePatches
+) {
+	int varid;
+	int iError = nc_inq_varid(ncid, strVariableName.c_str(), &varid);
+	if (iError != NC_NOERR) {
+		_EXCEPTION1("Cannot find variable \'%s\' in file",
+			strVariableName.c_str());
+	}
+
+	iError = nc_var_par_access(ncid, varid, NC_COLLECTIVE);
+	if (iError != NC_NOERR) {
+		_EXCEPTION2("Unable to set collective access on \"%s\": %s",
+			strVariableName.c_str(), nc_strerror(iError));
+	}
+
+	// Processes with fewer active patches write empty hyperslabs
+	const double dEmpty = 0.0;
+
+	for (int n = 0; n < nMaxActivePatches; n++) {
+		size_t sStart = 0;
+		size_t sCount = 0;
+		const double * pData = &dEmpty;
+
+		if (n < vecData.size()) {
+			sStart = vecStart[n];
+			sCount = vecCount[n];
+			pData = vecData[n];
+		}
+
+		iError = nc_put_vara_double(ncid, varid, &sStart, &sCount, pData);
+		if (iError != NC_NOERR) {
+			_EXCEPTION2("Error writing \"%s\": %s",
+				strVariableName.c_str(), nc_strerror(iError));
+		}
+	}
+}
+
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
 Time OutputManagerComposite::Input(
 	const std::string & strFileName
 ) {
 	// Set the flag indicating that output came from a restart file
 	m_fFromRestartFile = true;
 
+	// NetCDF calls may not overlap with asynchronous output
+	FlushOutputTasks();
+
 	// Determine processor rank
 	int nRank;
 	MPI_Comm_rank(MPI_COMM_WORLD, &nRank);
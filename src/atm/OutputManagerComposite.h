@@ -63,11 +63,34 @@ public:
 		const std::string & strFileName
 	);
 
+	///	<summary>
+	///		Apply the output file format to a newly created variable with
+	///		the given number of levels per node.
+	///	</summary>
+	void DefineOutputVariable(
+		NcVar * var,
+		const std::string & strVariableName,
+		int nLevels
+	);
+
 	///	<summary>
 	///		Close an existing NetCDF file.
 	///	</summary>
 	virtual void CloseFile();
 
+protected:
+	///	<summary>
+	///		Reopen the active NetCDF file on this process for writing.
+	///	</summary>
+	void ReopenFile();
+
+	///	<summary>
+	///		Get a variable from the active NetCDF file.
+	///	</summary>
+	NcVar * GetVariable(
+		const std::string & strVariableName
+	);
+
 protected:
 	///	<summary>
 	///		Write output to a file.
@@ -76,6 +99,28 @@ protected:
 		const Time & time
 	);
 
+#ifdef USE_PARALLEL_NETCDF
+	///	<summary>
+	///		Write the active patches on all processes to the active NetCDF
+	///		file using collective parallel I/O.
+	///	</summary>
+	void OutputCollective();
+
+	///	<summary>
+	///		Write one hyperslab per active patch of the given variable using
+	///		collective parallel I/O.  Processes with fewer than
+	///		nMaxActivePatches active patches write empty hyperslabs.
+	///	</summary>
+	void PutVariableCollective(
+		int ncid,
+		const std::string & strVariableName,
+		const std::vector<size_t> & vecStart,
+		const std::vector<size_t> & vecCount,
+		const std::vector<const double *> & vecData,
+		int nMaxActivePatches
+	);
+#endif
+
 protected:
 	///	<summary>
 	///		Returns true if this OutputManager supports the input operation.
@@ -98,6 +143,11 @@ protected:
 	std::string m_strRestartFile;
 
 protected:
+	///	<summary>
+	///		Name of the active output file.
+	///	</summary>
+	std::string m_strActiveNcFileName;
+
 	///	<summary>
 	///		Active output file.
 	///	</summary>
@@ -142,12 +192,6 @@ protected:
 	///		Vector of tracer variables.
 	///	</summary>
 	std::vector<NcVar *> m_vecTracersVar;
-
-private:
-	///	<summary>
-	///		Vector used at root node for storage of received data.
-	///	</summary>
-	DataVector<double> m_vecRecvBuffer;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -15,6 +15,7 @@
 ///	</remarks
 
 #include "OutputManagerReference.h"
+#include "OutputWriter.h"
 
 #include "Model.h"
 #include "Grid.h"
@@ -29,10 +30,123 @@
 #include <cstdio>
 #include <cmath>
 #include <cfloat>
+#include <cstring>
+#include <vector>
 #include <sys/stat.h>
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		A set of NetCDF writes for one reference output.  All data is copied
+///		into the task so that the model can continue while it is written.
+///	</summary>
+class ReferenceOutputTask : public OutputWriterTask {
+
+public:
+	///	<summary>
+	///		Write a single value of a time-indexed variable.
+	///	</summary>
+	void AddTimeValue(
+		NcVar * var,
+		int ixTime,
+		double dValue
+	) {
+		AddPut(var, ixTime, 1, 1, 1, &dValue);
+	}
+
+	///	<summary>
+	///		Write a horizontal field that is not time-indexed.
+	///	</summary>
+	void AddField2D(
+		NcVar * var,
+		int nY,
+		int nX,
+		const double * pData
+	) {
+		AddPut(var, (-1), 1, nY, nX, pData);
+	}
+
+	///	<summary>
+	///		Write a time-indexed three-dimensional field.
+	///	</summary>
+	void AddField3D(
+		NcVar * var,
+		int ixTime,
+		int nLev,
+		int nY,
+		int nX,
+		const double * pData
+	) {
+		AddPut(var, ixTime, nLev, nY, nX, pData);
+	}
+
+	///	<summary>
+	///		Perform all writes in the order they were added.
+	///	</summary>
+	virtual void Execute() {
+		for (int i = 0; i < m_vecPuts.size(); i++) {
+			const Put & put = m_vecPuts[i];
+
+			if (put.ixTime == (-1)) {
+				put.var->put(&(put.vecData[0]), put.nY, put.nX);
+
+			} else if (put.vecData.size() == 1) {
+				put.var->set_cur(put.ixTime);
+				put.var->put(&(put.vecData[0]), 1);
+
+			} else {
+				put.var->set_cur(put.ixTime, 0, 0, 0);
+				put.var->put(
+					&(put.vecData[0]), 1, put.nLev, put.nY, put.nX);
+			}
+		}
+	}
+
+protected:
+	///	<summary>
+	///		Copy data for a single write.
+	///	</summary>
+	void AddPut(
+		NcVar * var,
+		int ixTime,
+		int nLev,
+		int nY,
+		int nX,
+		const double * pData
+	) {
+		m_vecPuts.resize(m_vecPuts.size() + 1);
+
+		Put & put = m_vecPuts.back();
+		put.var = var;
+		put.ixTime = ixTime;
+		put.nLev = nLev;
+		put.nY = nY;
+		put.nX = nX;
+		put.vecData.resize(nLev * nY * nX);
+		memcpy(&(put.vecData[0]), pData, nLev * nY * nX * sizeof(double));
+	}
+
+protected:
+	///	<summary>
+	///		A single write to a NetCDF variable.
+	///	</summary>
+	struct Put {
+		NcVar * var;
+		int ixTime;
+		int nLev;
+		int nY;
+		int nX;
+		std::vector<double> vecData;
+	};
+
+	///	<summary>
+	///		Writes to perform.
+	///	</summary>
+	std::vector<Put> m_vecPuts;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 OutputManagerReference::OutputManagerReference(
 	Grid & grid,
 	const Time & timeOutputFrequency,
@@ -169,58 +283,70 @@ bool OutputManagerReference::CalculatePatchCoordinates() {
 		m_dBeta,
 		m_iPatch);
 
-	// Allocate data arrays
-	m_dataTopography.Initialize(
-		1,
-		1,
-		m_nXReference * m_nYReference);
-
-	m_dataStateNode.Initialize(
-		m_grid.GetModel().GetEquationSet().GetComponents(),
-		m_grid.GetRElements(),
-		m_nXReference * m_nYReference);
+	// Determine processor rank
+	int nRank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &nRank);
 
-	if (!m_fOutputAllVarsOnNodes) {
-		m_dataStateREdge.Initialize(
-			m_grid.GetModel().GetEquationSet().GetComponents(),
-			m_grid.GetRElements() + 1,
+	// Allocate data arrays (only needed on root)
+	if (nRank == 0) {
+		m_dataTopography.Initialize(
+			1,
+			1,
 			m_nXReference * m_nYReference);
-	}
 
-	if (m_grid.GetModel().GetEquationSet().GetTracers() != 0) {
-		m_dataTracers.Initialize(
-			m_grid.GetModel().GetEquationSet().GetTracers(),
+		m_dataStateNode.Initialize(
+			m_grid.GetModel().GetEquationSet().GetComponents(),
 			m_grid.GetRElements(),
 			m_nXReference * m_nYReference);
-	}
 
-	if (m_fOutputVorticity) {
-		m_dataVorticity.Initialize(
-			1,
-			m_grid.GetRElements(),
-			m_nXReference * m_nYReference);
-	}
+		if (!m_fOutputAllVarsOnNodes) {
+			m_dataStateREdge.Initialize(
+				m_grid.GetModel().GetEquationSet().GetComponents(),
+				m_grid.GetRElements() + 1,
+				m_nXReference * m_nYReference);
+		}
 
-	if (m_fOutputDivergence) {
-		m_dataDivergence.Initialize(
-			1,
-			m_grid.GetRElements(),
-			m_nXReference * m_nYReference);
-	}
+		if (m_grid.GetModel().GetEquationSet().GetTracers() != 0) {
+			m_dataTracers.Initialize(
+				m_grid.GetModel().GetEquationSet().GetTracers(),
+				m_grid.GetRElements(),
+				m_nXReference * m_nYReference);
+		}
 
-	if (m_fOutputTemperature) {
-		m_dataTemperature.Initialize(
-			1,
-			m_grid.GetRElements(),
-			m_nXReference * m_nYReference);
+		if (m_fOutputVorticity) {
+			m_dataVorticity.Initialize(
+				1,
+				m_grid.GetRElements(),
+				m_nXReference * m_nYReference);
+		}
+
+		if (m_fOutputDivergence) {
+			m_dataDivergence.Initialize(
+				1,
+				m_grid.GetRElements(),
+				m_nXReference * m_nYReference);
+		}
+
+		if (m_fOutputTemperature) {
+			m_dataTemperature.Initialize(
+				1,
+				m_grid.GetRElements(),
+				m_nXReference * m_nYReference);
+		}
 	}
 
+	// Compute interpolation stencil (reused by all subsequent outputs)
+	m_grid.ComputeInterpolationStencil(
+		m_dAlpha,
+		m_dBeta,
+		m_iPatch,
+		m_stencil);
+
 	// Reduce/Interpolate topography array
 	m_grid.ReduceInterpolate(
-		m_dAlpha, m_dBeta, m_iPatch,
+		m_stencil,
 		DataType_Topography,
 		DataLocation_None,
-		m_fOutputAllVarsOnNodes,
 		m_dataTopography,
 		false);
 
@@ -243,6 +369,9 @@ bool OutputManagerReference::OpenFile(
 	// The active model
 	const Model & model = m_grid.GetModel();
 
+	// NetCDF calls may not overlap with asynchronous output
+	FlushOutputTasks();
+
 	// Open NetCDF file on root process
 	if (nRank == 0) {
 
@@ -255,10 +384,7 @@ bool OutputManagerReference::OpenFile(
 		std::string strNcFileName = strFileName + ".nc";
 
 		// Open new NetCDF file
-		m_pActiveNcOutput = new NcFile(strNcFileName.c_str(), NcFile::Replace);
-		if (m_pActiveNcOutput == NULL) {
-			_EXCEPTIONT("Error opening NetCDF file");
-		}
+		m_pActiveNcOutput = m_format.CreateFile(strNcFileName);
 
 		// Create nodal time dimension
 		NcDim * dimTime =
@@ -361,6 +487,39 @@ bool OutputManagerReference::OpenFile(
 					"T", ncDouble, dimTime, dimLev, dimLat, dimLon);
 		}
 
+		// Chunking, compression and quantization of output variables
+		for (int c = 0; c < eqn.GetComponents(); c++) {
+			int nLevels = m_grid.GetRElements();
+			if ((!m_fOutputAllVarsOnNodes) &&
+				(m_grid.GetVarLocation(c) == DataLocation_REdge)
+			) {
+				nLevels = m_grid.GetRElements() + 1;
+			}
+
+			DefineOutputVariable(
+				m_vecComponentVar[c], eqn.GetComponentShortName(c), nLevels);
+		}
+
+		for (int c = 0; c < eqn.GetTracers(); c++) {
+			DefineOutputVariable(
+				m_vecTracersVar[c],
+				eqn.GetTracerShortName(c),
+				m_grid.GetRElements());
+		}
+
+		if (m_fOutputVorticity) {
+			DefineOutputVariable(
+				m_varVorticity, "ZETA", m_grid.GetRElements());
+		}
+		if (m_fOutputDivergence) {
+			DefineOutputVariable(
+				m_varDivergence, "DELTA", m_grid.GetRElements());
+		}
+		if (m_fOutputTemperature) {
+			DefineOutputVariable(
+				m_varTemperature, "T", m_grid.GetRElements());
+		}
+
 		// Output longitudes and latitudes
 		NcVar * varLon = m_pActiveNcOutput->add_var("lon", ncDouble, dimLon);
 		NcVar * varLat = m_pActiveNcOutput->add_var("lat", ncDouble, dimLat);
@@ -400,6 +559,14 @@ bool OutputManagerReference::OpenFile(
 		m_varTopography =
 			m_pActiveNcOutput->add_var("Zs", ncDouble, dimLat, dimLon);
 
+		long nTopographyChunkSize[2];
+		nTopographyChunkSize[0] = m_nYReference;
+		nTopographyChunkSize[1] = m_nXReference;
+
+		m_format.DefineVariable(
+			m_pActiveNcOutput, m_varTopography, "Zs",
+			2, nTopographyChunkSize, false);
+
 		// Fresh output file
 		m_fFreshOutputFile = true;
 	}
@@ -412,7 +579,31 @@ bool OutputManagerReference::OpenFile(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void OutputManagerReference::DefineOutputVariable(
+	NcVar * var,
+	const std::string & strVariableName,
+	int nLevels
+) {
+	// Chunks contain one time and either one level or all levels
+	long nChunkSize[4];
+	nChunkSize[0] = 1;
+	nChunkSize[1] = nLevels;
+	nChunkSize[2] = m_nYReference;
+	nChunkSize[3] = m_nXReference;
+
+	if (m_format.m_eChunking == OutputChunking_Level) {
+		nChunkSize[1] = 1;
+	}
+
+	m_format.DefineVariable(
+		m_pActiveNcOutput, var, strVariableName, 4, nChunkSize, true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void OutputManagerReference::CloseFile() {
+	FlushOutputTasks();
+
 	if (m_pActiveNcOutput != NULL) {
 		delete(m_pActiveNcOutput);
 		m_pActiveNcOutput = NULL;
@@ -439,27 +630,9 @@ void OutputManagerReference::Output(
 	// Update reference grid
 	CalculatePatchCoordinates();
 
-	// Initial outputs to a new Output file
-	if ((nRank == 0) && (m_fFreshOutputFile)) {
-
-		// Output topography
-		m_varTopography->put(
-			&(m_dataTopography[0][0][0]),
-			m_dYCoord.GetRows(),
-			m_dXCoord.GetRows());
-	}
-
 	// Equation set
 	const EquationSet & eqn = m_grid.GetModel().GetEquationSet();
 
-	// Add new time
-	if (nRank == 0) {
-#pragma message "FIX: Doesn't give correct count of days"
-		double dTimeDays = (time - m_grid.GetModel().GetStartTime()) / 86400.0;
-		m_varTime->set_cur(m_ixOutputTime);
-		m_varTime->put(&dTimeDays, 1);
-	}
-
 	// Vertically interpolate data to model levels
 	if (m_fOutputAllVarsOnNodes) {
 		for (int c = 0; c < eqn.GetComponents(); c++) {
@@ -470,31 +643,25 @@ void OutputManagerReference::Output(
 	}
 
 	// Perform Interpolate / Reduction on state data
-	m_dataStateNode.Zero();
-
 	m_grid.ReduceInterpolate(
-		m_dAlpha, m_dBeta, m_iPatch,
-		DataType_State, DataLocation_Node, m_fOutputAllVarsOnNodes,
+		m_stencil,
+		DataType_State, DataLocation_Node,
 		m_dataStateNode,
 		!m_fRemoveReferenceProfile);
 
 	if (!m_fOutputAllVarsOnNodes) {
-		m_dataStateREdge.Zero();
-
 		m_grid.ReduceInterpolate(
-			m_dAlpha, m_dBeta, m_iPatch,
-			DataType_State, DataLocation_REdge, false,
+			m_stencil,
+			DataType_State, DataLocation_REdge,
 			m_dataStateREdge,
 			!m_fRemoveReferenceProfile);
 	}
 
 	// Perform Interpolate / Reduction on tracers data
 	if (m_grid.GetModel().GetEquationSet().GetTracers() != 0) {
-		m_dataTracers.Zero();
-
 		m_grid.ReduceInterpolate(
-			m_dAlpha, m_dBeta, m_iPatch,
-			DataType_Tracers, DataLocation_Node, false,
+			m_stencil,
+			DataType_Tracers, DataLocation_Node,
 			m_dataTracers, true);
 	}
 
@@ -504,14 +671,14 @@ void OutputManagerReference::Output(
 
 		if (m_fOutputVorticity) {
 			m_grid.ReduceInterpolate(
-				m_dAlpha, m_dBeta, m_iPatch,
-				DataType_Vorticity, DataLocation_Node, false,
+				m_stencil,
+				DataType_Vorticity, DataLocation_Node,
 				m_dataVorticity);
 		}
 		if (m_fOutputDivergence) {
 			m_grid.ReduceInterpolate(
-				m_dAlpha, m_dBeta, m_iPatch,
-				DataType_Divergence, DataLocation_Node, false,
+				m_stencil,
+				DataType_Divergence, DataLocation_Node,
 				m_dataDivergence);
 		}
 	}
@@ -521,89 +688,88 @@ void OutputManagerReference::Output(
 		m_grid.ComputeTemperature(0);
 
 		m_grid.ReduceInterpolate(
-			m_dAlpha, m_dBeta, m_iPatch,
-			DataType_Temperature, DataLocation_Node, false,
+			m_stencil,
+			DataType_Temperature, DataLocation_Node,
 			m_dataTemperature);
 	}
 
-	// Store state variable data
+	// Stage output data on the root process; the data is written to the
+	// file by the OutputWriter, which may overlap with the next timestep
 	if (nRank == 0) {
+		const int nY = m_dYCoord.GetRows();
+		const int nX = m_dXCoord.GetRows();
+
+		ReferenceOutputTask * pTask = new ReferenceOutputTask;
+
+		// Initial outputs to a new Output file
+		if (m_fFreshOutputFile) {
+			pTask->AddField2D(
+				m_varTopography, nY, nX,
+				&(m_dataTopography[0][0][0]));
+		}
+
+		// Add new time
+#pragma message "FIX: Doesn't give correct count of days"
+		double dTimeDays = (time - m_grid.GetModel().GetStartTime()) / 86400.0;
+		pTask->AddTimeValue(m_varTime, m_ixOutputTime, dTimeDays);
+
+		// Store state variable data
 		for (int c = 0; c < eqn.GetComponents(); c++) {
 			if ((m_fOutputAllVarsOnNodes) ||
 				(m_grid.GetVarLocation(c) == DataLocation_Node)
 			) {
-				m_vecComponentVar[c]->set_cur(m_ixOutputTime, 0, 0, 0);
-				m_vecComponentVar[c]->put(
-					&(m_dataStateNode[c][0][0]),
-					1,
-					m_dataStateNode.GetColumns(),
-					m_dYCoord.GetRows(),
-					m_dXCoord.GetRows());
+				pTask->AddField3D(
+					m_vecComponentVar[c], m_ixOutputTime,
+					m_dataStateNode.GetColumns(), nY, nX,
+					&(m_dataStateNode[c][0][0]));
 
 			} else {
-				m_vecComponentVar[c]->set_cur(m_ixOutputTime, 0, 0, 0);
-				m_vecComponentVar[c]->put(
-					&(m_dataStateREdge[c][0][0]),
-					1,
-					m_dataStateREdge.GetColumns(),
-					m_dYCoord.GetRows(),
-					m_dXCoord.GetRows());
+				pTask->AddField3D(
+					m_vecComponentVar[c], m_ixOutputTime,
+					m_dataStateREdge.GetColumns(), nY, nX,
+					&(m_dataStateREdge[c][0][0]));
 			}
 		}
 
 		// Store tracer variable data
 		if (m_grid.GetModel().GetEquationSet().GetTracers() != 0) {
 			for (int c = 0; c < eqn.GetTracers(); c++) {
-				m_vecTracersVar[c]->set_cur(m_ixOutputTime, 0, 0, 0);
-				m_vecTracersVar[c]->put(
-					&(m_dataTracers[c][0][0]),
-					1,
-					m_dataTracers.GetColumns(),
-					m_dYCoord.GetRows(),
-					m_dXCoord.GetRows());
+				pTask->AddField3D(
+					m_vecTracersVar[c], m_ixOutputTime,
+					m_dataTracers.GetColumns(), nY, nX,
+					&(m_dataTracers[c][0][0]));
 			}
 		}
 
 		// Store vorticity data
 		if (m_fOutputVorticity) {
-			m_varVorticity->set_cur(m_ixOutputTime, 0, 0, 0);
-			m_varVorticity->put(
-				&(m_dataVorticity[0][0][0]),
-				1,
-				m_dataVorticity.GetColumns(),
-				m_dYCoord.GetRows(),
-				m_dXCoord.GetRows());
+			pTask->AddField3D(
+				m_varVorticity, m_ixOutputTime,
+				m_dataVorticity.GetColumns(), nY, nX,
+				&(m_dataVorticity[0][0][0]));
 		}
 
 		// Store divergence data
 		if (m_fOutputDivergence) {
-			m_varDivergence->set_cur(m_ixOutputTime, 0, 0, 0);
-			m_varDivergence->put(
-				&(m_dataDivergence[0][0][0]),
-				1,
-				m_dataDivergence.GetColumns(),
-				m_dYCoord.GetRows(),
-				m_dXCoord.GetRows());
+			pTask->AddField3D(
+				m_varDivergence, m_ixOutputTime,
+				m_dataDivergence.GetColumns(), nY, nX,
+				&(m_dataDivergence[0][0][0]));
 		}
 
 		// Store temperature data
 		if (m_fOutputTemperature) {
-			m_varTemperature->set_cur(m_ixOutputTime, 0, 0, 0);
-			m_varTemperature->put(
-				&(m_dataTemperature[0][0][0]),
-				1,
-				m_dataTemperature.GetColumns(),
-				m_dYCoord.GetRows(),
-				m_dXCoord.GetRows());
+			pTask->AddField3D(
+				m_varTemperature, m_ixOutputTime,
+				m_dataTemperature.GetColumns(), nY, nX,
+				&(m_dataTemperature[0][0][0]));
 		}
 
+		SubmitOutputTask(pTask);
 	}
 
 	// No longer fresh file
 	m_fFreshOutputFile = false;
-
-	// Barrier
-	MPI_Barrier(MPI_COMM_WORLD);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -20,6 +20,7 @@
 #include "OutputManager.h"
 
 #include "DataMatrix3D.h"
+#include "InterpolationStencil.h"
 
 class Time;
 
@@ -97,6 +98,16 @@ protected:
 		const std::string & strFileName
 	);
 
+	///	<summary>
+	///		Apply the output file format to a newly created variable with
+	///		dimensions (time, lev, lat, lon).
+	///	</summary>
+	void DefineOutputVariable(
+		NcVar * var,
+		const std::string & strVariableName,
+		int nLevels
+	);
+
 	///	<summary>
 	///		Close an existing NetCDF file.
 	///	</summary>
@@ -166,6 +177,11 @@ protected:
 	///	</summary>
 	DataVector<int> m_iPatch;
 
+	///	<summary>
+	///		Interpolation stencil from the model grid to the reference points.
+	///	</summary>
+	InterpolationStencil m_stencil;
+
 	///	<summary>
 	///		Active output file.
 	///	</summary>
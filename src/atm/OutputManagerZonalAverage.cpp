@@ -0,0 +1,748 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    OutputManagerZonalAverage.cpp
+///	\author  Paul Ullrich
+///	\version October 18, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "OutputManagerZonalAverage.h"
+#include "OutputWriter.h"
+
+#include "Model.h"
+#include "Grid.h"
+#include "GridPatch.h"
+
+#include "TimeObj.h"
+#include "Announce.h"
+
+#include "mpi.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A set of NetCDF writes for one averaging period.  All data is copied
+///		into the task so that the model can continue while it is written.
+///	</summary>
+class ZonalAverageOutputTask : public OutputWriterTask {
+
+public:
+	///	<summary>
+	///		Write a single value of a time-indexed variable.
+	///	</summary>
+	void AddTimeValue(
+		NcVar * var,
+		int ixTime,
+		double dValue
+	) {
+		AddPut(var, ixTime, 1, 1, &dValue);
+	}
+
+	///	<summary>
+	///		Write the bounds of a time-indexed interval.
+	///	</summary>
+	void AddTimeBounds(
+		NcVar * var,
+		int ixTime,
+		double dBegin,
+		double dEnd
+	) {
+		double dBounds[2];
+		dBounds[0] = dBegin;
+		dBounds[1] = dEnd;
+
+		AddPut(var, ixTime, 1, 2, dBounds);
+	}
+
+	///	<summary>
+	///		Write a time-indexed (lev, lat) field.
+	///	</summary>
+	void AddField(
+		NcVar * var,
+		int ixTime,
+		int nLev,
+		int nLat,
+		const double * pData
+	) {
+		AddPut(var, ixTime, nLev, nLat, pData);
+	}
+
+	///	<summary>
+	///		Perform all writes in the order they were added.
+	///	</summary>
+	virtual void Execute() {
+		for (int i = 0; i < m_vecPuts.size(); i++) {
+			const Put & put = m_vecPuts[i];
+
+			if (put.vecData.size() == 1) {
+				put.var->set_cur(put.ixTime);
+				put.var->put(&(put.vecData[0]), 1);
+
+			} else if (put.nLev == 1) {
+				put.var->set_cur(put.ixTime, 0);
+				put.var->put(&(put.vecData[0]), 1, put.nLat);
+
+			} else {
+				put.var->set_cur(put.ixTime, 0, 0);
+				put.var->put(&(put.vecData[0]), 1, put.nLev, put.nLat);
+			}
+		}
+	}
+
+protected:
+	///	<summary>
+	///		Copy data for a single write.
+	///	</summary>
+	void AddPut(
+		NcVar * var,
+		int ixTime,
+		int nLev,
+		int nLat,
+		const double * pData
+	) {
+		m_vecPuts.resize(m_vecPuts.size() + 1);
+
+		Put & put = m_vecPuts.back();
+		put.var = var;
+		put.ixTime = ixTime;
+		put.nLev = nLev;
+		put.nLat = nLat;
+		put.vecData.resize(nLev * nLat);
+		memcpy(&(put.vecData[0]), pData, nLev * nLat * sizeof(double));
+	}
+
+protected:
+	///	<summary>
+	///		A single write to a NetCDF variable.
+	///	</summary>
+	struct Put {
+		NcVar * var;
+		int ixTime;
+		int nLev;
+		int nLat;
+		std::vector<double> vecData;
+	};
+
+	///	<summary>
+	///		Writes to perform.
+	///	</summary>
+	std::vector<Put> m_vecPuts;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+OutputManagerZonalAverage::OutputManagerZonalAverage(
+	Grid & grid,
+	const Time & timeSampleFrequency,
+	const Time & timeAveragePeriod,
+	std::string strOutputDir,
+	std::string strOutputPrefix,
+	int nXReference,
+	int nYReference
+) :
+	OutputManager(
+		grid,
+		timeSampleFrequency,
+		strOutputDir,
+		strOutputPrefix,
+		-1),
+	m_timeAveragePeriod(timeAveragePeriod),
+	m_iGridStamp(-1),
+	m_nXReference(nXReference),
+	m_nYReference(nYReference),
+	m_fOutputTemperature(false),
+	m_fAverageActive(false),
+	m_dAverageBeginDays(0.0),
+	m_nSamples(0),
+	m_ixAverage(0),
+	m_pActiveNcOutput(NULL),
+	m_varTime(NULL),
+	m_varTimeBounds(NULL),
+	m_varSamples(NULL)
+{
+	if (timeAveragePeriod.IsZero()) {
+		_EXCEPTIONT("Averaging period must be nonzero");
+	}
+
+	// Get the reference box
+	double dX0;
+	double dX1;
+	double dY0;
+	double dY1;
+
+	grid.GetReferenceGridBounds(dX0, dX1, dY0, dY1);
+
+	// Initialize the coordinate arrays
+	m_dXCoord.Initialize(m_nXReference);
+	double dDeltaX = (dX1 - dX0) / static_cast<double>(m_nXReference);
+	for (int i = 0; i < m_nXReference; i++) {
+		m_dXCoord[i] =
+			dDeltaX * (static_cast<double>(i) + 0.5) + dX0;
+	}
+
+	m_dYCoord.Initialize(m_nYReference);
+	double dDeltaY = (dY1 - dY0) / static_cast<double>(m_nYReference);
+	for (int j = 0; j < m_nYReference; j++) {
+		m_dYCoord[j] =
+			dDeltaY * (static_cast<double>(j) + 0.5) + dY0;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+OutputManagerZonalAverage::~OutputManagerZonalAverage() {
+	CloseFile();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool OutputManagerZonalAverage::CalculatePatchCoordinates() {
+
+	if (m_grid.GetGridStamp() == m_iGridStamp) {
+		return false;
+	}
+
+	// Recalculate patch coordinates
+	Announce("..Recalculating patch coordinates");
+
+	// Construct array of reference coordinates
+	DataVector<double> dXReference;
+	dXReference.Initialize(m_nXReference * m_nYReference);
+
+	DataVector<double> dYReference;
+	dYReference.Initialize(m_nXReference * m_nYReference);
+
+	int ix = 0;
+	for (int j = 0; j < m_nYReference; j++) {
+	for (int i = 0; i < m_nXReference; i++) {
+		dXReference[ix] = m_dXCoord[i];
+		dYReference[ix] = m_dYCoord[j];
+		ix++;
+	}
+	}
+
+	// Convert reference points to patch coordinates
+	DataVector<double> dAlpha;
+	dAlpha.Initialize(dXReference.GetRows());
+
+	DataVector<double> dBeta;
+	dBeta.Initialize(dXReference.GetRows());
+
+	DataVector<int> iPatch;
+	iPatch.Initialize(dXReference.GetRows());
+
+	m_grid.ConvertReferenceToPatchCoord(
+		dXReference,
+		dYReference,
+		dAlpha,
+		dBeta,
+		iPatch);
+
+	// Compute interpolation stencil (reused by all subsequent samples)
+	m_grid.ComputeInterpolationStencil(
+		dAlpha,
+		dBeta,
+		iPatch,
+		m_stencil);
+
+	// Update grid stamp
+	m_iGridStamp = m_grid.GetGridStamp();
+
+	// Patch coordinates updated
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OutputManagerZonalAverage::InterpolateLocalData() {
+
+	const EquationSet & eqn = m_grid.GetModel().GetEquationSet();
+
+	const int nLocalPoints = m_stencil.GetLocalPoints();
+
+	if (nLocalPoints == 0) {
+		return;
+	}
+
+	const int nLevels = m_grid.GetRElements();
+
+	// Allocate local data (only reallocated if the stencil changes)
+	int nComponentRows = eqn.GetComponents();
+	if (eqn.GetTracers() > nComponentRows) {
+		nComponentRows = eqn.GetTracers();
+	}
+
+	m_dataLocal.Initialize(
+		m_vecVariableNames.size(), nLevels, nLocalPoints, false);
+
+	m_dataLocalComponents.Initialize(
+		nComponentRows, nLevels, nLocalPoints, false);
+
+	// State variables on nodes
+	for (int n = 0; n < m_grid.GetActivePatchCount(); n++) {
+		m_grid.GetActivePatch(n)->ApplyInterpolationStencil(
+			m_stencil,
+			DataType_State,
+			DataLocation_Node,
+			m_dataLocalComponents,
+			true,
+			true);
+	}
+
+	int v = 0;
+	for (int c = 0; c < eqn.GetComponents(); c++, v++) {
+		memcpy(
+			m_dataLocal[v][0],
+			m_dataLocalComponents[c][0],
+			nLevels * nLocalPoints * sizeof(double));
+	}
+
+	// Tracers
+	if (eqn.GetTracers() != 0) {
+		for (int n = 0; n < m_grid.GetActivePatchCount(); n++) {
+			m_grid.GetActivePatch(n)->ApplyInterpolationStencil(
+				m_stencil,
+				DataType_Tracers,
+				DataLocation_Node,
+				m_dataLocalComponents,
+				true,
+				true);
+		}
+
+		for (int c = 0; c < eqn.GetTracers(); c++, v++) {
+			memcpy(
+				m_dataLocal[v][0],
+				m_dataLocalComponents[c][0],
+				nLevels * nLocalPoints * sizeof(double));
+		}
+	}
+
+	// Temperature
+	if (m_fOutputTemperature) {
+		for (int n = 0; n < m_grid.GetActivePatchCount(); n++) {
+			m_grid.GetActivePatch(n)->ApplyInterpolationStencil(
+				m_stencil,
+				DataType_Temperature,
+				DataLocation_Node,
+				m_dataLocalComponents,
+				true,
+				true);
+		}
+
+		memcpy(
+			m_dataLocal[v][0],
+			m_dataLocalComponents[0][0],
+			nLevels * nLocalPoints * sizeof(double));
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OutputManagerZonalAverage::AccumulateSample() {
+
+	const EquationSet & eqn = m_grid.GetModel().GetEquationSet();
+
+	// Update reference grid
+	CalculatePatchCoordinates();
+
+	// Vertically interpolate data to model levels
+	for (int c = 0; c < eqn.GetComponents(); c++) {
+		if (m_grid.GetVarLocation(c) == DataLocation_REdge) {
+			m_grid.InterpolateREdgeToNode(c, 0);
+		}
+	}
+
+	// Compute temperature
+	if (m_fOutputTemperature) {
+		m_grid.ComputeTemperature(0);
+	}
+
+	// Interpolate to the local reference points
+	InterpolateLocalData();
+
+	const int nVariables = m_dataSum.GetRows();
+	const int nLevels = m_dataSum.GetColumns();
+	const int nLocalPoints = m_stencil.GetLocalPoints();
+
+	// The zonal mean of the first sample is used as the shift for all
+	// samples in this averaging period
+	if (m_nSamples == 0) {
+		m_dataSum.Zero();
+		m_dataSumSq.Zero();
+
+		for (int v = 0; v < nVariables; v++) {
+		for (int k = 0; k < nLevels; k++) {
+			for (int i = 0; i < nLocalPoints; i++) {
+				int j = m_stencil.m_ixPoint[i] / m_nXReference;
+				m_dataSum[v][k][j] += m_dataLocal[v][k][i];
+			}
+		}
+		}
+
+		MPI_Allreduce(
+			&(m_dataSum[0][0][0]),
+			&(m_dataShift[0][0][0]),
+			m_dataSum.GetTotalElements(),
+			MPI_DOUBLE,
+			MPI_SUM,
+			MPI_COMM_WORLD);
+
+		for (int v = 0; v < nVariables; v++) {
+		for (int k = 0; k < nLevels; k++) {
+		for (int j = 0; j < m_nYReference; j++) {
+			m_dataShift[v][k][j] /= static_cast<double>(m_nXReference);
+		}
+		}
+		}
+
+		m_dataSum.Zero();
+	}
+
+	// Add this sample to the running sums
+	for (int v = 0; v < nVariables; v++) {
+	for (int k = 0; k < nLevels; k++) {
+		for (int i = 0; i < nLocalPoints; i++) {
+			int j = m_stencil.m_ixPoint[i] / m_nXReference;
+
+			double dValue = m_dataLocal[v][k][i] - m_dataShift[v][k][j];
+
+			m_dataSum[v][k][j] += dValue;
+			m_dataSumSq[v][k][j] += dValue * dValue;
+		}
+	}
+	}
+
+	m_nSamples++;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OutputManagerZonalAverage::WriteAverage(
+	const Time & time
+) {
+	// Get processor rank
+	int nRank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &nRank);
+
+	const int nVariables = m_dataSum.GetRows();
+	const int nLevels = m_dataSum.GetColumns();
+
+	// Reduce the running sums to root
+	DataMatrix3D<double> dataMean;
+	DataMatrix3D<double> dataVariance;
+
+	if (nRank == 0) {
+		dataMean.Initialize(nVariables, nLevels, m_nYReference);
+		dataVariance.Initialize(nVariables, nLevels, m_nYReference);
+	}
+
+	MPI_Reduce(
+		&(m_dataSum[0][0][0]),
+		(nRank == 0)?(&(dataMean[0][0][0])):(NULL),
+		m_dataSum.GetTotalElements(),
+		MPI_DOUBLE,
+		MPI_SUM,
+		0,
+		MPI_COMM_WORLD);
+
+	MPI_Reduce(
+		&(m_dataSumSq[0][0][0]),
+		(nRank == 0)?(&(dataVariance[0][0][0])):(NULL),
+		m_dataSumSq.GetTotalElements(),
+		MPI_DOUBLE,
+		MPI_SUM,
+		0,
+		MPI_COMM_WORLD);
+
+	// Compute the mean and variance over longitude and time and stage
+	// output data on the root process
+	if (nRank == 0) {
+		const double dCount =
+			static_cast<double>(m_nXReference)
+			* static_cast<double>(m_nSamples);
+
+		for (int v = 0; v < nVariables; v++) {
+		for (int k = 0; k < nLevels; k++) {
+		for (int j = 0; j < m_nYReference; j++) {
+			double dShiftedMean = dataMean[v][k][j] / dCount;
+
+			double dVariance =
+				dataVariance[v][k][j] / dCount
+				- dShiftedMean * dShiftedMean;
+
+			if (dVariance < 0.0) {
+				dVariance = 0.0;
+			}
+
+			dataMean[v][k][j] = dShiftedMean + m_dataShift[v][k][j];
+			dataVariance[v][k][j] = dVariance;
+		}
+		}
+		}
+
+		double dTimeDays = (time - m_grid.GetModel().GetStartTime()) / 86400.0;
+
+		ZonalAverageOutputTask * pTask = new ZonalAverageOutputTask;
+
+		pTask->AddTimeValue(
+			m_varTime, m_ixAverage,
+			0.5 * (m_dAverageBeginDays + dTimeDays));
+
+		pTask->AddTimeBounds(
+			m_varTimeBounds, m_ixAverage,
+			m_dAverageBeginDays, dTimeDays);
+
+		pTask->AddTimeValue(
+			m_varSamples, m_ixAverage,
+			static_cast<double>(m_nSamples));
+
+		for (int v = 0; v < nVariables; v++) {
+			pTask->AddField(
+				m_vecMeanVar[v], m_ixAverage,
+				nLevels, m_nYReference,
+				&(dataMean[v][0][0]));
+
+			pTask->AddField(
+				m_vecVarianceVar[v], m_ixAverage,
+				nLevels, m_nYReference,
+				&(dataVariance[v][0][0]));
+		}
+
+		SubmitOutputTask(pTask);
+	}
+
+	m_ixAverage++;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool OutputManagerZonalAverage::OpenFile(
+	const std::string & strFileName
+) {
+	// Determine processor rank
+	int nRank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &nRank);
+
+	// The active model
+	const Model & model = m_grid.GetModel();
+
+	// Equation set
+	const EquationSet & eqn = model.GetEquationSet();
+
+	// Names of all averaged variables
+	m_vecVariableNames.clear();
+	for (int c = 0; c < eqn.GetComponents(); c++) {
+		m_vecVariableNames.push_back(eqn.GetComponentShortName(c));
+	}
+	for (int c = 0; c < eqn.GetTracers(); c++) {
+		m_vecVariableNames.push_back(eqn.GetTracerShortName(c));
+	}
+	if (m_fOutputTemperature) {
+		m_vecVariableNames.push_back("T");
+	}
+
+	// Allocate running sums
+	m_dataShift.Initialize(
+		m_vecVariableNames.size(), m_grid.GetRElements(), m_nYReference);
+	m_dataSum.Initialize(
+		m_vecVariableNames.size(), m_grid.GetRElements(), m_nYReference);
+	m_dataSumSq.Initialize(
+		m_vecVariableNames.size(), m_grid.GetRElements(), m_nYReference);
+
+	m_ixAverage = 0;
+
+	// NetCDF calls may not overlap with asynchronous output
+	FlushOutputTasks();
+
+	// Open NetCDF file on root process
+	if (nRank == 0) {
+
+		// Check for existing NetCDF file
+		if (m_pActiveNcOutput != NULL) {
+			_EXCEPTIONT("NetCDF file already open");
+		}
+
+		// Append .nc extension to file
+		std::string strNcFileName = strFileName + ".nc";
+
+		// Open new NetCDF file
+		m_pActiveNcOutput = m_format.CreateFile(strNcFileName);
+
+		// Create time dimension
+		NcDim * dimTime =
+			m_pActiveNcOutput->add_dim("time");
+
+		NcDim * dimBounds =
+			m_pActiveNcOutput->add_dim("nbnd", 2);
+
+		m_varTime = m_pActiveNcOutput->add_var("time", ncDouble, dimTime);
+
+		std::string strUnits =
+			"days since " + model.GetStartTime().ToDateString();
+
+		std::string strCalendarName = model.GetStartTime().GetCalendarName();
+
+		m_varTime->add_att("long_name", "time");
+		m_varTime->add_att("units", strUnits.c_str());
+		m_varTime->add_att("calendar", strCalendarName.c_str());
+		m_varTime->add_att("bounds", "time_bnds");
+
+		m_varTimeBounds =
+			m_pActiveNcOutput->add_var(
+				"time_bnds", ncDouble, dimTime, dimBounds);
+
+		m_varSamples =
+			m_pActiveNcOutput->add_var("samples", ncDouble, dimTime);
+
+		m_varSamples->add_att("long_name", "number of samples in average");
+
+		// Create levels dimension
+		NcDim * dimLev =
+			m_pActiveNcOutput->add_dim("lev", m_grid.GetRElements());
+
+		// Create latitude dimension
+		NcDim * dimLat =
+			m_pActiveNcOutput->add_dim("lat", m_nYReference);
+
+		// Output grid parameters
+		m_pActiveNcOutput->add_att("Ztop", m_grid.GetZtop());
+		m_pActiveNcOutput->add_att("lon_points", m_nXReference);
+
+		// Output equation set
+		m_pActiveNcOutput->add_att("equation_set", eqn.GetName().c_str());
+
+		// Create mean and variance variables
+		for (int v = 0; v < m_vecVariableNames.size(); v++) {
+			std::string strVarianceName = m_vecVariableNames[v] + "_var";
+
+			NcVar * varMean =
+				m_pActiveNcOutput->add_var(
+					m_vecVariableNames[v].c_str(),
+					ncDouble, dimTime, dimLev, dimLat);
+
+			NcVar * varVariance =
+				m_pActiveNcOutput->add_var(
+					strVarianceName.c_str(),
+					ncDouble, dimTime, dimLev, dimLat);
+
+			if (varMean != NULL) {
+				varMean->add_att("cell_methods", "lon: mean time: mean");
+			}
+			if (varVariance != NULL) {
+				varVariance->add_att(
+					"cell_methods", "lon: variance time: variance");
+			}
+
+			m_vecMeanVar.push_back(varMean);
+			m_vecVarianceVar.push_back(varVariance);
+		}
+
+		// Chunking, compression and quantization of output variables
+		long nChunkSize[3];
+		nChunkSize[0] = 1;
+		nChunkSize[1] = m_grid.GetRElements();
+		nChunkSize[2] = m_nYReference;
+
+		if (m_format.m_eChunking == OutputChunking_Level) {
+			nChunkSize[1] = 1;
+		}
+
+		for (int v = 0; v < m_vecVariableNames.size(); v++) {
+			m_format.DefineVariable(
+				m_pActiveNcOutput, m_vecMeanVar[v],
+				m_vecVariableNames[v], 3, nChunkSize, true);
+
+			m_format.DefineVariable(
+				m_pActiveNcOutput, m_vecVarianceVar[v],
+				m_vecVariableNames[v] + "_var", 3, nChunkSize, true);
+		}
+
+		// Output latitudes
+		NcVar * varLat = m_pActiveNcOutput->add_var("lat", ncDouble, dimLat);
+
+		varLat->put(m_dYCoord, m_dYCoord.GetRows());
+
+		varLat->add_att("long_name", "latitude");
+		varLat->add_att("units", "degrees_north");
+
+		// Output levels
+		NcVar * varLev =
+			m_pActiveNcOutput->add_var("lev", ncDouble, dimLev);
+
+		varLev->put(
+			m_grid.GetREtaStretchLevels(),
+			m_grid.GetREtaStretchLevels().GetRows());
+
+		varLev->add_att("long_name", "level");
+		varLev->add_att("units", "level");
+	}
+
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OutputManagerZonalAverage::CloseFile() {
+	FlushOutputTasks();
+
+	if (m_pActiveNcOutput != NULL) {
+		delete(m_pActiveNcOutput);
+		m_pActiveNcOutput = NULL;
+
+		m_vecMeanVar.clear();
+		m_vecVarianceVar.clear();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OutputManagerZonalAverage::Output(
+	const Time & time
+) {
+	// Check for open file
+	if (!IsFileOpen()) {
+		_EXCEPTIONT("No file available for output");
+	}
+
+	const Model & model = m_grid.GetModel();
+
+	double dTimeDays = (time - model.GetStartTime()) / 86400.0;
+
+	// Begin the first averaging period at the initial time; the initial
+	// state is not included in the averages
+	if (!m_fAverageActive) {
+		m_fAverageActive = true;
+		m_dAverageBeginDays = dTimeDays;
+		m_timeAverageEnd = time;
+		m_timeAverageEnd += m_timeAveragePeriod;
+		return;
+	}
+
+	// Add this sample to the running sums
+	AccumulateSample();
+
+	// Write averages at the end of each averaging period and at the end
+	// of the simulation
+	if ((time >= m_timeAverageEnd) || (time >= model.GetEndTime())) {
+		WriteAverage(time);
+
+		m_nSamples = 0;
+		m_dAverageBeginDays = dTimeDays;
+		m_timeAverageEnd += m_timeAveragePeriod;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
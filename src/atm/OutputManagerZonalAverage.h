@@ -0,0 +1,259 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    OutputManagerZonalAverage.h
+///	\author  Paul Ullrich
+///	\version October 18, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _OUTPUTMANAGERZONALAVERAGE_H_
+#define _OUTPUTMANAGERZONALAVERAGE_H_
+
+#include "OutputManager.h"
+
+#include "DataMatrix3D.h"
+#include "InterpolationStencil.h"
+
+#include <string>
+#include <vector>
+
+class Time;
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		OutputManager that accumulates zonal and temporal means and
+///		variances on the reference grid during the simulation.  The model
+///		state is sampled at the output frequency and interpolated to the
+///		reference grid on each processor; only the per-latitude sums are
+///		retained.  At the end of each averaging period the sums are reduced
+///		to root and the mean and variance over longitude and time of each
+///		variable are written as a single record.  The initial state is not
+///		included in the averages.
+///	</summary>
+class OutputManagerZonalAverage : public OutputManager {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	OutputManagerZonalAverage(
+		Grid & grid,
+		const Time & timeSampleFrequency,
+		const Time & timeAveragePeriod,
+		std::string strOutputDir,
+		std::string strOutputPrefix,
+		int nXReference,
+		int nYReference
+	);
+
+	///	<summary>
+	///		Destructor.
+	///	</summary>
+	virtual ~OutputManagerZonalAverage();
+
+	///	<summary>
+	///		Get the name of the OutputManager.
+	///	</summary>
+	virtual const char * GetName() const {
+		return "ZonalAverage";
+	}
+
+	///	<summary>
+	///		Modify the flag which indicates whether temperature should be
+	///		computed and averaged.
+	///	</summary>
+	void OutputTemperature(
+		bool fOutputTemperature = true
+	) {
+		m_fOutputTemperature = fOutputTemperature;
+	}
+
+private:
+	///	<summary>
+	///		Calculate the interpolation stencil to the reference points.
+	///	</summary>
+	bool CalculatePatchCoordinates();
+
+	///	<summary>
+	///		Interpolate all averaged variables to the reference points on
+	///		patches owned by this processor.
+	///	</summary>
+	void InterpolateLocalData();
+
+	///	<summary>
+	///		Add the current state to the running sums.
+	///	</summary>
+	void AccumulateSample();
+
+	///	<summary>
+	///		Reduce the running sums and write the averages for the active
+	///		averaging period.
+	///	</summary>
+	void WriteAverage(
+		const Time & time
+	);
+
+protected:
+	///	<summary>
+	///		Open a new NetCDF file.
+	///	</summary>
+	virtual bool OpenFile(
+		const std::string & strFileName
+	);
+
+	///	<summary>
+	///		Close an existing NetCDF file.
+	///	</summary>
+	virtual void CloseFile();
+
+	///	<summary>
+	///		Sample the model state and write averages when an averaging
+	///		period is complete.
+	///	</summary>
+	virtual void Output(
+		const Time & time
+	);
+
+protected:
+	///	<summary>
+	///		Length of each averaging period.
+	///	</summary>
+	Time m_timeAveragePeriod;
+
+	///	<summary>
+	///		Grid stamp.
+	///	</summary>
+	int m_iGridStamp;
+
+	///	<summary>
+	///		Number of reference points in the X direction.
+	///	</summary>
+	int m_nXReference;
+
+	///	<summary>
+	///		Number of reference points in the Y direction.
+	///	</summary>
+	int m_nYReference;
+
+	///	<summary>
+	///		Vector of longitudes.
+	///	</summary>
+	DataVector<double> m_dXCoord;
+
+	///	<summary>
+	///		Vector of latitudes.
+	///	</summary>
+	DataVector<double> m_dYCoord;
+
+	///	<summary>
+	///		Interpolation stencil from the model grid to the reference points.
+	///	</summary>
+	InterpolationStencil m_stencil;
+
+	///	<summary>
+	///		Flag indicating whether temperature should be averaged.
+	///	</summary>
+	bool m_fOutputTemperature;
+
+	///	<summary>
+	///		Short names of the averaged variables.
+	///	</summary>
+	std::vector<std::string> m_vecVariableNames;
+
+protected:
+	///	<summary>
+	///		Flag indicating that the first averaging period has begun.
+	///	</summary>
+	bool m_fAverageActive;
+
+	///	<summary>
+	///		Start of the active averaging period (in days).
+	///	</summary>
+	double m_dAverageBeginDays;
+
+	///	<summary>
+	///		End of the active averaging period.
+	///	</summary>
+	Time m_timeAverageEnd;
+
+	///	<summary>
+	///		Number of samples in the active averaging period.
+	///	</summary>
+	int m_nSamples;
+
+	///	<summary>
+	///		Index of the next averaging record in the output file.
+	///	</summary>
+	int m_ixAverage;
+
+	///	<summary>
+	///		Interpolated data at the local reference points.
+	///	</summary>
+	DataMatrix3D<double> m_dataLocal;
+
+	///	<summary>
+	///		Interpolated state or tracer data at the local reference points.
+	///	</summary>
+	DataMatrix3D<double> m_dataLocalComponents;
+
+	///	<summary>
+	///		Zonal mean of the first sample in the averaging period, which is
+	///		subtracted from all samples to avoid cancellation in the variance.
+	///	</summary>
+	DataMatrix3D<double> m_dataShift;
+
+	///	<summary>
+	///		Local sum of shifted samples on each level and latitude.
+	///	</summary>
+	DataMatrix3D<double> m_dataSum;
+
+	///	<summary>
+	///		Local sum of squared shifted samples on each level and latitude.
+	///	</summary>
+	DataMatrix3D<double> m_dataSumSq;
+
+protected:
+	///	<summary>
+	///		Active output file.
+	///	</summary>
+	NcFile * m_pActiveNcOutput;
+
+	///	<summary>
+	///		Time variable.
+	///	</summary>
+	NcVar * m_varTime;
+
+	///	<summary>
+	///		Time bounds variable.
+	///	</summary>
+	NcVar * m_varTimeBounds;
+
+	///	<summary>
+	///		Number of samples variable.
+	///	</summary>
+	NcVar * m_varSamples;
+
+	///	<summary>
+	///		Vector of mean variables.
+	///	</summary>
+	std::vector<NcVar *> m_vecMeanVar;
+
+	///	<summary>
+	///		Vector of variance variables.
+	///	</summary>
+	std::vector<NcVar *> m_vecVarianceVar;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
@@ -0,0 +1,209 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    OutputWriter.cpp
+///	\author  Paul Ullrich
+///	\version October 18, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "OutputWriter.h"
+
+#include "Exception.h"
+
+#include <cstdio>
+
+///////////////////////////////////////////////////////////////////////////////
+
+OutputWriter::OutputWriter() :
+	m_fRunning(false),
+	m_fStop(false),
+	m_fTaskActive(false),
+	m_nMaxPendingTasks(1)
+{
+	pthread_mutex_init(&m_mutex, NULL);
+	pthread_cond_init(&m_condTaskQueued, NULL);
+	pthread_cond_init(&m_condTaskDone, NULL);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+OutputWriter::~OutputWriter() {
+
+	// Complete all pending tasks and stop the background thread
+	if (m_fRunning) {
+		pthread_mutex_lock(&m_mutex);
+		m_fStop = true;
+		pthread_cond_signal(&m_condTaskQueued);
+		pthread_mutex_unlock(&m_mutex);
+
+		pthread_join(m_thread, NULL);
+
+		if (m_strError != "") {
+			fprintf(stderr, "%s\n", m_strError.c_str());
+		}
+	}
+
+	pthread_cond_destroy(&m_condTaskDone);
+	pthread_cond_destroy(&m_condTaskQueued);
+	pthread_mutex_destroy(&m_mutex);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OutputWriter::Start(
+	int nMaxPendingTasks
+) {
+	if (m_fRunning) {
+		_EXCEPTIONT("OutputWriter already started");
+	}
+	if (nMaxPendingTasks < 1) {
+		_EXCEPTIONT("OutputWriter requires at least one pending task");
+	}
+
+	m_nMaxPendingTasks = nMaxPendingTasks;
+	m_fStop = false;
+
+	int iError = pthread_create(&m_thread, NULL, ThreadMain, this);
+	if (iError != 0) {
+		_EXCEPTION1("Unable to create output thread (%i)", iError);
+	}
+
+	m_fRunning = true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OutputWriter::Submit(
+	OutputWriterTask * pTask
+) {
+	// Synchronous output
+	if (!m_fRunning) {
+		try {
+			pTask->Execute();
+		} catch(...) {
+			delete pTask;
+			throw;
+		}
+		delete pTask;
+		return;
+	}
+
+	// Wait for space in the queue
+	pthread_mutex_lock(&m_mutex);
+
+	while (static_cast<int>(m_queueTasks.size() + (m_fTaskActive?1:0))
+		>= m_nMaxPendingTasks
+	) {
+		pthread_cond_wait(&m_condTaskDone, &m_mutex);
+	}
+
+	m_queueTasks.push_back(pTask);
+
+	pthread_cond_signal(&m_condTaskQueued);
+	pthread_mutex_unlock(&m_mutex);
+
+	CheckError();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OutputWriter::Flush() {
+	if (!m_fRunning) {
+		return;
+	}
+
+	pthread_mutex_lock(&m_mutex);
+
+	while ((m_queueTasks.size() != 0) || (m_fTaskActive)) {
+		pthread_cond_wait(&m_condTaskDone, &m_mutex);
+	}
+
+	pthread_mutex_unlock(&m_mutex);
+
+	CheckError();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void * OutputWriter::ThreadMain(
+	void * pOutputWriter
+) {
+	reinterpret_cast<OutputWriter *>(pOutputWriter)->Run();
+
+	return NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OutputWriter::Run() {
+
+	pthread_mutex_lock(&m_mutex);
+
+	for (;;) {
+
+		// Wait for a task
+		while ((m_queueTasks.size() == 0) && (!m_fStop)) {
+			pthread_cond_wait(&m_condTaskQueued, &m_mutex);
+		}
+
+		if (m_queueTasks.size() == 0) {
+			break;
+		}
+
+		OutputWriterTask * pTask = m_queueTasks.front();
+		m_queueTasks.pop_front();
+		m_fTaskActive = true;
+
+		pthread_mutex_unlock(&m_mutex);
+
+		// Execute the task; errors are reported on the main thread
+		std::string strError;
+		try {
+			pTask->Execute();
+
+		} catch(Exception & e) {
+			strError = e.ToString();
+
+		} catch(...) {
+			strError = "Unknown error in output thread";
+		}
+
+		delete pTask;
+
+		pthread_mutex_lock(&m_mutex);
+
+		if ((strError != "") && (m_strError == "")) {
+			m_strError = strError;
+		}
+
+		m_fTaskActive = false;
+		pthread_cond_broadcast(&m_condTaskDone);
+	}
+
+	pthread_mutex_unlock(&m_mutex);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OutputWriter::CheckError() {
+
+	pthread_mutex_lock(&m_mutex);
+	std::string strError = m_strError;
+	m_strError = "";
+	pthread_mutex_unlock(&m_mutex);
+
+	if (strError != "") {
+		_EXCEPTION1("Asynchronous output failed: %s", strError.c_str());
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,171 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    OutputWriter.h
+///	\author  Paul Ullrich
+///	\version October 18, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _OUTPUTWRITER_H_
+#define _OUTPUTWRITER_H_
+
+#include <pthread.h>
+
+#include <deque>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A unit of output work (typically a set of NetCDF writes from a
+///		staging buffer) that is executed by the OutputWriter.  Tasks must
+///		not perform any MPI communication.
+///	</summary>
+class OutputWriterTask {
+
+public:
+	///	<summary>
+	///		Virtual destructor.
+	///	</summary>
+	virtual ~OutputWriterTask()
+	{ }
+
+	///	<summary>
+	///		Perform the output.
+	///	</summary>
+	virtual void Execute() = 0;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A background thread which executes OutputWriterTasks in the order
+///		they are submitted.  The number of pending tasks is bounded so that
+///		memory used for staging buffers remains predictable; with one
+///		pending task output is double buffered.  If the writer has not been
+///		started, tasks are executed immediately on submission.
+///	</summary>
+class OutputWriter {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	OutputWriter();
+
+	///	<summary>
+	///		Destructor.  Completes all pending tasks.
+	///	</summary>
+	~OutputWriter();
+
+public:
+	///	<summary>
+	///		Start the background thread.
+	///	</summary>
+	void Start(
+		int nMaxPendingTasks
+	);
+
+	///	<summary>
+	///		Determine if the background thread is running.
+	///	</summary>
+	bool IsRunning() const {
+		return m_fRunning;
+	}
+
+	///	<summary>
+	///		Submit a task for execution.  The OutputWriter assumes ownership
+	///		of the task.  Blocks while the maximum number of tasks are
+	///		pending.
+	///	</summary>
+	void Submit(
+		OutputWriterTask * pTask
+	);
+
+	///	<summary>
+	///		Wait for all pending tasks to complete.
+	///	</summary>
+	void Flush();
+
+protected:
+	///	<summary>
+	///		Entry point for the background thread.
+	///	</summary>
+	static void * ThreadMain(
+		void * pOutputWriter
+	);
+
+	///	<summary>
+	///		Execute tasks until the writer is stopped.
+	///	</summary>
+	void Run();
+
+	///	<summary>
+	///		Rethrow an error encountered by the background thread.
+	///	</summary>
+	void CheckError();
+
+private:
+	///	<summary>
+	///		Flag indicating the background thread is running.
+	///	</summary>
+	bool m_fRunning;
+
+	///	<summary>
+	///		Flag indicating the background thread should exit.
+	///	</summary>
+	bool m_fStop;
+
+	///	<summary>
+	///		Flag indicating a task is being executed.
+	///	</summary>
+	bool m_fTaskActive;
+
+	///	<summary>
+	///		Maximum number of pending tasks (queued or being executed).
+	///	</summary>
+	int m_nMaxPendingTasks;
+
+	///	<summary>
+	///		Queue of tasks waiting to be executed.
+	///	</summary>
+	std::deque<OutputWriterTask *> m_queueTasks;
+
+	///	<summary>
+	///		Error message from a failed task.
+	///	</summary>
+	std::string m_strError;
+
+	///	<summary>
+	///		Background thread.
+	///	</summary>
+	pthread_t m_thread;
+
+	///	<summary>
+	///		Mutex protecting the task queue.
+	///	</summary>
+	pthread_mutex_t m_mutex;
+
+	///	<summary>
+	///		Condition signalled when a task is queued or the writer stops.
+	///	</summary>
+	pthread_cond_t m_condTaskQueued;
+
+	///	<summary>
+	///		Condition signalled when a task completes.
+	///	</summary>
+	pthread_cond_t m_condTaskDone;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
@@ -27,17 +27,22 @@
 #include "VerticalDynamicsStub.h"
 #include "VerticalDynamicsFEM.h"
 #include "OutputManagerComposite.h"
+#include "OutputManagerCheckpoint.h"
 #include "OutputManagerReference.h"
 #include "OutputManagerChecksum.h"
+#include "OutputManagerZonalAverage.h"
 #include "GridCSGLL.h"
 #include "GridCartesianGLL.h"
 #include "VerticalStretch.h"
 
+#include "HardwareCounters.h"
+
 #include "TimeObj.h"
 #include "Announce.h"
 #include "CommandLine.h"
 #include "STLStringHelper.h"
 #include <string>
+#include <cstdlib>
 #include "mpi.h"
 
 #ifdef USE_PETSC
@@ -52,8 +57,23 @@ struct _TempestCommandLineVariables {
 	std::string strOutputDir;
 	std::string strOutputPrefix;
 	int nOutputsPerFile;
+	int nOutputAsync;
+	std::string strOutputFormat;
+	std::string strOutputCompress;
+	int nOutputCompressLevel;
+	std::string strOutputChunk;
+	std::string strOutputDigits;
 	Time timeOutputDeltaT;
+	std::string strChecksumLog;
 	Time timeOutputRestartDeltaT;
+	std::string strOutputRestartFormat;
+	bool fRestartVerify;
+	int nPatchProcessors;
+	bool fReproducibleSum;
+	bool fHardwareCounters;
+	std::string strHardwareFPEvent;
+	Time timeOutputZonalDeltaT;
+	Time timeOutputZonalSampleDeltaT;
 	int nOutputResX;
 	int nOutputResY;
 	bool fOutputVorticity;
@@ -76,6 +96,8 @@ struct _TempestCommandLineVariables {
 	int nLevels;
 	int nHorizontalOrder;
 	int nVerticalOrder;
+	std::string strExchangeReduced;
+	std::string strExchangePrecision;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -86,7 +108,26 @@ struct _TempestCommandLineVariables {
 	CommandLineString(_tempestvars.strOutputPrefix, "output_prefix", "out"); \
 	CommandLineString(_tempestvars.param.m_strRestartFile, "restart_file", ""); \
 	CommandLineInt(_tempestvars.nOutputsPerFile, "output_perfile", -1); \
+	CommandLineInt(_tempestvars.nOutputAsync, "output_async", 0); \
+	CommandLineStringD(_tempestvars.strOutputFormat, "output_format", "classic", "(classic | netcdf4)"); \
+	CommandLineStringD(_tempestvars.strOutputCompress, "output_compress", "none", "(none | deflate | zstd)"); \
+	CommandLineInt(_tempestvars.nOutputCompressLevel, "output_compress_level", 4); \
+	CommandLineStringD(_tempestvars.strOutputChunk, "output_chunk", "default", "(default | level | patch)"); \
+	CommandLineStringD(_tempestvars.strOutputDigits, "output_digits", "", "([var:]digits,...)"); \
 	CommandLineDeltaTime(_tempestvars.timeOutputRestartDeltaT, "output_restart_dt", ""); \
+	CommandLineStringD(_tempestvars.strOutputRestartFormat, "output_restart_format", "netcdf", "(netcdf | binary)"); \
+	CommandLineBool(_tempestvars.fRestartVerify, "restart_verify"); \
+	CommandLineInt(_tempestvars.nPatchProcessors, "patch_procs", 0); \
+	CommandLineBool(_tempestvars.fReproducibleSum, "reproducible_sum"); \
+	CommandLineString(_tempestvars.param.m_strProfileFile, "profile_out", ""); \
+	CommandLineString(_tempestvars.param.m_strTraceFile, "trace_out", ""); \
+	CommandLineInt(_tempestvars.param.m_nTraceEvents, "trace_events", 100000); \
+	CommandLineString(_tempestvars.strChecksumLog, "checksum_log", ""); \
+	CommandLineBool(_tempestvars.fHardwareCounters, "perf_counters"); \
+	CommandLineStringD(_tempestvars.strHardwareFPEvent, "perf_fp_event", "", "(raw event code)"); \
+	CommandLineInt(_tempestvars.param.m_nDiagnosticsInterval, "diag_interval", 1); \
+	CommandLineDeltaTime(_tempestvars.timeOutputZonalDeltaT, "output_zonal_dt", ""); \
+	CommandLineDeltaTime(_tempestvars.timeOutputZonalSampleDeltaT, "output_zonal_sample_dt", ""); \
 	CommandLineInt(_tempestvars.nOutputResX, "output_x", 360); \
 	CommandLineInt(_tempestvars.nOutputResY, "output_y", 180); \
 	CommandLineBool(_tempestvars.fOutputVorticity, "output_vort"); \
@@ -103,7 +144,9 @@ struct _TempestCommandLineVariables {
 	CommandLineString(_tempestvars.strVerticalStretch, "vstretch", "uniform"); \
 	CommandLineInt(_tempestvars.nVerticalHyperdiffOrder, "verthypervisorder", 0); \
 	CommandLineString(_tempestvars.strTimestepScheme, "timescheme", "strang"); \
-	CommandLineStringD(_tempestvars.strHorizontalDynamics, "method", "SE", "(SE | DG)");
+	CommandLineStringD(_tempestvars.strHorizontalDynamics, "method", "SE", "(SE | DG)"); \
+	CommandLineStringD(_tempestvars.strExchangeReduced, "exchange_reduced", "", "(state,tracers,vort,div,temp)"); \
+	CommandLineStringD(_tempestvars.strExchangePrecision, "exchange_precision", "single", "(single | scaled16)");
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -265,10 +308,180 @@ void _TempestSetupMethodOfLines(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void _TempestSetupRestartFormat(
+	_TempestCommandLineVariables & vars
+) {
+	STLStringHelper::ToLower(vars.strOutputRestartFormat);
+	if (vars.strOutputRestartFormat == "netcdf") {
+		vars.param.m_fRestartFromCheckpoint = false;
+
+	} else if (vars.strOutputRestartFormat == "binary") {
+		vars.param.m_fRestartFromCheckpoint = true;
+
+	} else {
+		_EXCEPTIONT("Invalid value for --output_restart_format");
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void _TempestSetupHardwareCounters(
+	_TempestCommandLineVariables & vars
+) {
+	if (!vars.fHardwareCounters) {
+		if (vars.strHardwareFPEvent != "") {
+			_EXCEPTIONT("--perf_fp_event requires --perf_counters");
+		}
+		return;
+	}
+
+	// Processor-specific raw event used to count floating point operations
+	unsigned long long ullFloatingPointEvent = 0;
+	if (vars.strHardwareFPEvent != "") {
+		char * szEnd;
+		ullFloatingPointEvent =
+			strtoull(vars.strHardwareFPEvent.c_str(), &szEnd, 0);
+
+		if ((*szEnd != '\0') || (ullFloatingPointEvent == 0)) {
+			_EXCEPTIONT("Invalid value for --perf_fp_event");
+		}
+	}
+
+	// Counters are optional; the model runs without them if the kernel
+	// does not permit access
+	if (!HardwareCounters::Enable(ullFloatingPointEvent)) {
+		Announce("WARNING: Hardware counters are not available "
+			"(see /proc/sys/kernel/perf_event_paranoid)");
+		return;
+	}
+
+	if ((ullFloatingPointEvent != 0) &&
+		(!HardwareCounters::IsCounted(HardwareCounters::Counter_FloatingPoint))
+	) {
+		Announce("WARNING: Event in --perf_fp_event is not supported");
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void _TempestSetupPatchLayout(
+	Grid * pGrid,
+	_TempestCommandLineVariables & vars
+) {
+	// Patches are laid out as in the run which wrote the checkpoint and
+	// then distributed among the current processors
+	if ((vars.param.m_strRestartFile != "") &&
+		(vars.param.m_fRestartFromCheckpoint)
+	) {
+		int nPatchProcessors =
+			OutputManagerCheckpoint::GetPatchProcessors(
+				vars.param.m_strRestartFile);
+
+		pGrid->SetDefaultPatchProcessors(nPatchProcessors);
+
+	// Patches are laid out for the specified number of processors
+	} else if (vars.nPatchProcessors > 0) {
+		pGrid->SetDefaultPatchProcessors(vars.nPatchProcessors);
+
+	} else if (vars.nPatchProcessors < 0) {
+		_EXCEPTIONT("Invalid value for --patch_procs");
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void _TempestSetupOutputFileFormat(
+	OutputFileFormat & format,
+	_TempestCommandLineVariables & vars
+) {
+	// File format
+	STLStringHelper::ToLower(vars.strOutputFormat);
+	if (vars.strOutputFormat == "classic") {
+		format.m_fNetCDF4 = false;
+
+	} else if (vars.strOutputFormat == "netcdf4") {
+		format.m_fNetCDF4 = true;
+
+	} else {
+		_EXCEPTIONT("Invalid value for --output_format");
+	}
+
+	// Compression
+	STLStringHelper::ToLower(vars.strOutputCompress);
+	if (vars.strOutputCompress == "none") {
+		format.m_eCompressor = OutputCompressor_None;
+
+	} else if (vars.strOutputCompress == "deflate") {
+		format.m_eCompressor = OutputCompressor_Deflate;
+
+	} else if (vars.strOutputCompress == "zstd") {
+		format.m_eCompressor = OutputCompressor_Zstd;
+
+	} else {
+		_EXCEPTIONT("Invalid value for --output_compress");
+	}
+
+	format.m_nCompressionLevel = vars.nOutputCompressLevel;
+
+	// Chunking
+	STLStringHelper::ToLower(vars.strOutputChunk);
+	if (vars.strOutputChunk == "default") {
+		format.m_eChunking = OutputChunking_Default;
+
+	} else if (vars.strOutputChunk == "level") {
+		format.m_eChunking = OutputChunking_Level;
+
+	} else if (vars.strOutputChunk == "patch") {
+		format.m_eChunking = OutputChunking_Patch;
+
+	} else {
+		_EXCEPTIONT("Invalid value for --output_chunk");
+	}
+
+	// Comma-separated list of significant digits, either for all
+	// variables or for a named variable (var:digits)
+	int iLast = 0;
+	for (int i = 0; i <= vars.strOutputDigits.length(); i++) {
+		if ((i != vars.strOutputDigits.length()) &&
+			(vars.strOutputDigits[i] != ',')
+		) {
+			continue;
+		}
+
+		std::string strEntry =
+			vars.strOutputDigits.substr(iLast, i - iLast);
+
+		iLast = i + 1;
+
+		if (strEntry == "") {
+			continue;
+		}
+
+		size_t iColon = strEntry.find(':');
+		if (iColon == std::string::npos) {
+			format.m_nSignificantDigits = atoi(strEntry.c_str());
+
+		} else {
+			std::string strVariable = strEntry.substr(0, iColon);
+			int nDigits = atoi(strEntry.substr(iColon + 1).c_str());
+
+			format.m_mapSignificantDigits[strVariable] = nDigits;
+		}
+	}
+
+	format.Validate();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void _TempestSetupOutputManagers(
 	Model & model,
 	_TempestCommandLineVariables & vars
 ) {
+	// Format of NetCDF output files
+	OutputFileFormat format;
+	_TempestSetupOutputFileFormat(format, vars);
+
 	// Set the reference output manager for the model
 	if (!vars.fNoOutput) {
 		AnnounceStartBlock("Creating reference output manager");
@@ -294,21 +507,75 @@ void _TempestSetupOutputManagers(
 			pOutmanRef->OutputTemperature();
 		}
 
+		pOutmanRef->SetFileFormat(format);
+
 		model.AttachOutputManager(pOutmanRef);
 		AnnounceEndBlock("Done");
 	}
 
-	// Set the composite output manager for the model
+	// Set the restart output manager for the model
 	if ((! vars.timeOutputRestartDeltaT.IsZero()) ||
 		(vars.param.m_strRestartFile != "")
 	) {
-		AnnounceStartBlock("Creating composite output manager");
-		model.AttachOutputManager(
-			new OutputManagerComposite(
+		if (vars.param.m_fRestartFromCheckpoint) {
+			AnnounceStartBlock("Creating checkpoint output manager");
+			OutputManagerCheckpoint * pOutmanCheckpoint =
+				new OutputManagerCheckpoint(
+					*(model.GetGrid()),
+					vars.timeOutputRestartDeltaT,
+					vars.strOutputDir,
+					vars.strOutputPrefix);
+
+			if (vars.fRestartVerify) {
+				pOutmanCheckpoint->VerifyInput();
+			}
+
+			model.AttachOutputManager(pOutmanCheckpoint);
+			AnnounceEndBlock("Done");
+
+		} else {
+			AnnounceStartBlock("Creating composite output manager");
+			OutputManagerComposite * pOutmanComposite =
+				new OutputManagerComposite(
+					*(model.GetGrid()),
+					vars.timeOutputRestartDeltaT,
+					vars.strOutputDir,
+					vars.strOutputPrefix);
+
+			pOutmanComposite->SetFileFormat(format);
+
+			model.AttachOutputManager(pOutmanComposite);
+			AnnounceEndBlock("Done");
+		}
+	}
+
+	// Set the zonal average output manager for the model
+	if (! vars.timeOutputZonalDeltaT.IsZero()) {
+		AnnounceStartBlock("Creating zonal average output manager");
+
+		// Sample every time step by default
+		Time timeSampleDeltaT = vars.timeOutputZonalSampleDeltaT;
+		if (timeSampleDeltaT.IsZero()) {
+			timeSampleDeltaT = vars.param.m_timeDeltaT;
+		}
+
+		OutputManagerZonalAverage * pOutmanZonal =
+			new OutputManagerZonalAverage(
 				*(model.GetGrid()),
-				vars.timeOutputRestartDeltaT,
+				timeSampleDeltaT,
+				vars.timeOutputZonalDeltaT,
 				vars.strOutputDir,
-				vars.strOutputPrefix));
+				vars.strOutputPrefix + ".zonal",
+				vars.nOutputResX,
+				vars.nOutputResY);
+
+		if (vars.fOutputTemperature) {
+			pOutmanZonal->OutputTemperature();
+		}
+
+		pOutmanZonal->SetFileFormat(format);
+
+		model.AttachOutputManager(pOutmanZonal);
 		AnnounceEndBlock("Done");
 	}
 
@@ -319,6 +586,83 @@ void _TempestSetupOutputManagers(
 			*(model.GetGrid()),
 			vars.timeOutputDeltaT));
 	AnnounceEndBlock("Done");
+
+	// Log checksums at every time step for regression testing
+	if (vars.strChecksumLog != "") {
+		AnnounceStartBlock("Creating checksum log");
+		model.AttachOutputManager(
+			new OutputManagerChecksum(
+				*(model.GetGrid()),
+				vars.param.m_timeDeltaT,
+				vars.strChecksumLog));
+		AnnounceEndBlock("Done");
+	}
+
+	// Write output on a background thread
+	if (vars.nOutputAsync > 0) {
+		model.SetAsynchronousOutput(vars.nOutputAsync);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void _TempestSetupExchangePrecision(
+	Grid * pGrid,
+	_TempestCommandLineVariables & vars
+) {
+	if (vars.strExchangeReduced == "") {
+		return;
+	}
+
+	// Reduced precision representation
+	ExchangePrecision ePrecision;
+	STLStringHelper::ToLower(vars.strExchangePrecision);
+	if (vars.strExchangePrecision == "single") {
+		ePrecision = ExchangePrecision_Single;
+
+	} else if (vars.strExchangePrecision == "scaled16") {
+		ePrecision = ExchangePrecision_Scaled16;
+
+	} else {
+		_EXCEPTIONT("Invalid value for --exchange_precision");
+	}
+
+	// Comma-separated list of DataTypes exchanged at reduced precision
+	STLStringHelper::ToLower(vars.strExchangeReduced);
+
+	int iLast = 0;
+	for (int i = 0; i <= vars.strExchangeReduced.length(); i++) {
+		if ((i != vars.strExchangeReduced.length()) &&
+			(vars.strExchangeReduced[i] != ',')
+		) {
+			continue;
+		}
+
+		std::string strType =
+			vars.strExchangeReduced.substr(iLast, i - iLast);
+
+		iLast = i + 1;
+
+		if (strType == "state") {
+			pGrid->SetExchangePrecision(DataType_State, ePrecision);
+
+		} else if (strType == "tracers") {
+			pGrid->SetExchangePrecision(DataType_Tracers, ePrecision);
+
+		} else if (strType == "vort") {
+			pGrid->SetExchangePrecision(DataType_Vorticity, ePrecision);
+
+		} else if (strType == "div") {
+			pGrid->SetExchangePrecision(DataType_Divergence, ePrecision);
+
+		} else if (strType == "temp") {
+			pGrid->SetExchangePrecision(DataType_Temperature, ePrecision);
+
+		} else {
+			_EXCEPTION1("Invalid DataType \"%s\" in --exchange_reduced",
+				strType.c_str());
+		}
+	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -328,6 +672,8 @@ void _TempestSetupCubedSphereModel(
 	_TempestCommandLineVariables & vars
 ) {
 	// Set the parameters
+	_TempestSetupRestartFormat(vars);
+	_TempestSetupHardwareCounters(vars);
 	model.SetParameters(vars.param);
 
 	// Setup Method of Lines
@@ -381,6 +727,15 @@ void _TempestSetupCubedSphereModel(
 		_EXCEPTIONT("Invalid value for --vstretch");
 	}
 
+	// Set the precision of halo exchanges
+	_TempestSetupExchangePrecision(pGrid, vars);
+
+	// Set the patch layout
+	_TempestSetupPatchLayout(pGrid, vars);
+
+	// Compute global sums reproducibly
+	pGrid->SetReproducibleReductions(vars.fReproducibleSum);
+
 	// Set the Model Grid
 	model.SetGrid(pGrid);
 
@@ -400,6 +755,8 @@ void _TempestSetupCartesianModel(
 	_TempestCommandLineVariables & vars
 ) {
 	// Set the parameters
+	_TempestSetupRestartFormat(vars);
+	_TempestSetupHardwareCounters(vars);
 	model.SetParameters(vars.param);
 
 	// Setup Method of Lines
@@ -458,6 +815,15 @@ void _TempestSetupCartesianModel(
 
 	}
 
+	// Set the precision of halo exchanges
+	_TempestSetupExchangePrecision(pGrid, vars);
+
+	// Set the patch layout
+	_TempestSetupPatchLayout(pGrid, vars);
+
+	// Compute global sums reproducibly
+	pGrid->SetReproducibleReductions(vars.fReproducibleSum);
+
 	// Set the Model Grid
 	model.SetGrid(pGrid);
 
@@ -483,8 +849,9 @@ void TempestInitialize(int * argc, char*** argv) {
 	// Initialize PetSc
 	PetscInitialize(argc, argv, NULL, NULL);
 #else
-	// Initialize MPI
-	MPI_Init(argc, argv);
+	// Initialize MPI; only the main thread makes MPI calls
+	int iThreadSupport;
+	MPI_Init_thread(argc, argv, MPI_THREAD_FUNNELED, &iThreadSupport);
 #endif
 
 }
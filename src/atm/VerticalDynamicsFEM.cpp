@@ -25,6 +25,8 @@
 #include "TimeObj.h"
 #include "PolynomialInterp.h"
 #include "LinearAlgebra.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -107,81 +109,86 @@ void VerticalDynamicsFEM::Initialize() {
 	// Number of degrees of freedom per column in u/v/rho/w/theta
 	m_nColumnStateSize = FTot * (nRElements + 1);
 
+	// Memory held by the implicit solver
+	{
+		MemoryTrackerRegion memory(MemoryTag_Jacobian);
+
 #ifdef USE_JFNK_PETSC
-	// Initialize the PetSc solver context
-	SNESCreate(PETSC_COMM_SELF, &m_snes);
-
-	// Create vectors
-	VecCreate(PETSC_COMM_SELF, &m_vecX);
-	VecSetSizes(m_vecX, PETSC_DECIDE, m_nColumnStateSize);
-	VecSetFromOptions(m_vecX);
-	VecDuplicate(m_vecX, &m_vecR);
-
-	// Set tolerances
-	SNESSetTolerances(
-		m_snes,
-		1.0e-8,
-		1.0e-8,
-		1.0e-8,
-		1,
-		50);
-
-	// Set the function
-	SNESSetFunction(
-		m_snes,
-		m_vecR,
-		VerticalDynamicsFEM_FormFunction,
-		(void*)(this));
-
-	MatCreateSNESMF(m_snes, &m_matJ);
-
-	SNESSetJacobian(m_snes, m_matJ, m_matJ, MatMFFDComputeJacobian, NULL);
-
-	// Set the SNES context from options
-	SNESSetFromOptions(m_snes);
+		// Initialize the PetSc solver context
+		SNESCreate(PETSC_COMM_SELF, &m_snes);
+
+		// Create vectors
+		VecCreate(PETSC_COMM_SELF, &m_vecX);
+		VecSetSizes(m_vecX, PETSC_DECIDE, m_nColumnStateSize);
+		VecSetFromOptions(m_vecX);
+		VecDuplicate(m_vecX, &m_vecR);
+
+		// Set tolerances
+		SNESSetTolerances(
+			m_snes,
+			1.0e-8,
+			1.0e-8,
+			1.0e-8,
+			1,
+			50);
+
+		// Set the function
+		SNESSetFunction(
+			m_snes,
+			m_vecR,
+			VerticalDynamicsFEM_FormFunction,
+			(void*)(this));
+
+		MatCreateSNESMF(m_snes, &m_matJ);
+
+		SNESSetJacobian(m_snes, m_matJ, m_matJ, MatMFFDComputeJacobian, NULL);
+
+		// Set the SNES context from options
+		SNESSetFromOptions(m_snes);
 #endif
 #ifdef USE_JFNK_GMRES
-	// Initialize JFNK
-	InitializeJFNK(m_nColumnStateSize, m_nColumnStateSize, 1.0e-5);
+		// Initialize JFNK
+		InitializeJFNK(m_nColumnStateSize, m_nColumnStateSize, 1.0e-5);
 #endif
 #ifdef USE_DIRECTSOLVE_APPROXJ
-	// Initialize Jacobian matrix
-	m_matJacobianF.Initialize(m_nColumnStateSize, m_nColumnStateSize);
+		// Initialize Jacobian matrix
+		m_matJacobianF.Initialize(m_nColumnStateSize, m_nColumnStateSize);
 
-	// Initialize pivot vector
-	m_vecIPiv.Initialize(m_nColumnStateSize);
+		// Initialize pivot vector
+		m_vecIPiv.Initialize(m_nColumnStateSize);
 #endif
 #ifdef USE_DIRECTSOLVE
-	// Initialize Jacobian matrix
-	m_matJacobianF.Initialize(m_nColumnStateSize, m_nColumnStateSize);
+		// Initialize Jacobian matrix
+		m_matJacobianF.Initialize(m_nColumnStateSize, m_nColumnStateSize);
 
-	// Initialize pivot vector
-	m_vecIPiv.Initialize(m_nColumnStateSize);
+		// Initialize pivot vector
+		m_vecIPiv.Initialize(m_nColumnStateSize);
 #endif
 #ifdef USE_JACOBIAN_DIAGONAL
-	if (m_nHypervisOrder > 2) {
-		_EXCEPTIONT("Diagonal Jacobian only implemented for "
-			"Hypervis order <= 2");
-	}
-	if (m_nVerticalOrder == 1) {
-		m_nJacobianFKL = 4;
-		m_nJacobianFKU = 4;
-	} else if (m_nVerticalOrder == 2) {
-		m_nJacobianFKL = 9;
-		m_nJacobianFKU = 9;
-	} else if (m_nVerticalOrder == 3) {
-		m_nJacobianFKL = 15;
-		m_nJacobianFKU = 15;
-	} else if (m_nVerticalOrder == 4) {
-		m_nJacobianFKL = 22;
-		m_nJacobianFKU = 22;
-	} else if (m_nVerticalOrder == 5) {
-		m_nJacobianFKL = 30;
-		m_nJacobianFKU = 30;
-	} else {
-		_EXCEPTIONT("UNIMPLEMENTED: At this vertical order");
-	}
+		if (m_nHypervisOrder > 2) {
+			_EXCEPTIONT("Diagonal Jacobian only implemented for "
+				"Hypervis order <= 2");
+		}
+		if (m_nVerticalOrder == 1) {
+			m_nJacobianFKL = 4;
+			m_nJacobianFKU = 4;
+		} else if (m_nVerticalOrder == 2) {
+			m_nJacobianFKL = 9;
+			m_nJacobianFKU = 9;
+		} else if (m_nVerticalOrder == 3) {
+			m_nJacobianFKL = 15;
+			m_nJacobianFKU = 15;
+		} else if (m_nVerticalOrder == 4) {
+			m_nJacobianFKL = 22;
+			m_nJacobianFKU = 22;
+		} else if (m_nVerticalOrder == 5) {
+			m_nJacobianFKL = 30;
+			m_nJacobianFKU = 30;
+		} else {
+			_EXCEPTIONT("UNIMPLEMENTED: At this vertical order");
+		}
 #endif
+	}
 
 	// Allocate column for JFNK
 	m_dColumnState.Initialize(m_nColumnStateSize);
@@ -707,6 +714,8 @@ void VerticalDynamicsFEM::StepExplicit(
 	const Time & time,
 	double dDeltaT
 ) {
+	ProfilerRegion region("VerticalDynamics");
+
 	// Get a copy of the grid
 	GridGLL * pGrid = dynamic_cast<GridGLL *>(m_model.GetGrid());
 
@@ -973,6 +982,8 @@ void VerticalDynamicsFEM::StepImplicit(
 	const Time & time,
 	double dDeltaT
 ) {
+	ProfilerRegion region("VerticalImplicit");
+
 	// If fully explicit do nothing
 	if (m_fFullyExplicit) {
 		return;
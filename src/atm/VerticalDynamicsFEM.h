@@ -74,6 +74,13 @@ public:
 	///	</summary>
 	virtual void Initialize();
 
+	///	<summary>
+	///		Check if all vertical terms are advanced explicitly.
+	///	</summary>
+	bool IsFullyExplicit() const {
+		return m_fFullyExplicit;
+	}
+
 protected:
 	///	<summary>
 	///		Component indices into the F vector.
@@ -20,6 +20,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "Exception.h"
+#include "MemoryTracker.h"
 
 #include <sstream>
 #include <iostream>
@@ -83,7 +84,7 @@ class DataMatrix {
 		///	</summary>
 		virtual ~DataMatrix() {
 			if (m_data != NULL) {
-				free(reinterpret_cast<void*>(m_data));
+				MemoryTracker::Free(reinterpret_cast<void*>(m_data));
 			}
 		}
 
@@ -105,7 +106,7 @@ class DataMatrix {
 		///	</summary>
 		void Deinitialize() {
 			if (m_data != NULL) {
-				free(reinterpret_cast<void*>(m_data));
+				MemoryTracker::Free(reinterpret_cast<void*>(m_data));
 			}
 
 			m_data = NULL;
@@ -159,7 +160,8 @@ class DataMatrix {
 
 			// Allocate memory
 			char *rawdata = reinterpret_cast<char*>(
-				malloc(sRowPtrFootprint + sPadding + sRows * sRowFootprint));
+				MemoryTracker::Allocate(
+					sRowPtrFootprint + sPadding + sRows * sRowFootprint));
 
 			if (rawdata == NULL) {
 				_EXCEPTIONT("Out of memory.");
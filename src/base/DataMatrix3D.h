@@ -21,6 +21,7 @@
 
 #include "DataVector.h"
 #include "Exception.h"
+#include "MemoryTracker.h"
 
 #include <iostream>
 #include <cstdlib>
@@ -111,7 +112,7 @@ class DataMatrix3D {
 		///	</summary>
 		virtual ~DataMatrix3D() {
 			if (!m_fAttached && (m_data != NULL)) {
-				free(reinterpret_cast<void*>(m_data));
+				MemoryTracker::Free(reinterpret_cast<void*>(m_data));
 			}
 		}
 
@@ -133,7 +134,7 @@ class DataMatrix3D {
 		///	</summary>
 		void Deinitialize() {
 			if (!m_fAttached && (m_data != NULL)) {
-				free(reinterpret_cast<void*>(m_data));
+				MemoryTracker::Free(reinterpret_cast<void*>(m_data));
 			}
 
 			m_fAttached = false;
@@ -188,7 +189,7 @@ class DataMatrix3D {
 
 			// Allocate memory
 			char *rawdata = reinterpret_cast<char*>(
-				malloc(
+				MemoryTracker::Allocate(
 					sRowPtrFootprint +
 					sRows * sColumnPtrFootprint +
 					sRows * sColumns * sColumnFootprint
@@ -20,6 +20,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "Exception.h"
+#include "MemoryTracker.h"
 
 #include <iostream>
 #include <cstdlib>
@@ -86,7 +87,7 @@ class DataMatrix4D {
 		///	</summary>
 		virtual ~DataMatrix4D() {
 			if (m_data != NULL) {
-				free(reinterpret_cast<void*>(m_data));
+				MemoryTracker::Free(reinterpret_cast<void*>(m_data));
 			}
 		}
 
@@ -108,7 +109,7 @@ class DataMatrix4D {
 		///	</summary>
 		void Deinitialize() {
 			if (m_data != NULL) {
-				free(reinterpret_cast<void*>(m_data));
+				MemoryTracker::Free(reinterpret_cast<void*>(m_data));
 			}
 
 			m_data = NULL;
@@ -172,7 +173,8 @@ class DataMatrix4D {
 				sSize0 * sSize1 * sSize2 * sSize3 * sizeof(DataType);
 
 			// Allocate memory
-			char *rawdata = reinterpret_cast<char*>(malloc(sTotalSize));
+			char *rawdata =
+				reinterpret_cast<char*>(MemoryTracker::Allocate(sTotalSize));
 
 			if (rawdata == NULL) {
 				_EXCEPTIONT("Out of memory.");
@@ -20,6 +20,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "Exception.h"
+#include "MemoryTracker.h"
 
 #include <sstream>
 #include <iostream>
@@ -33,9 +34,10 @@
 ///		Arithmetic operations are supported for this datatype.
 ///	</summary>
 ///	<warning>
-///		Memory is allocated using malloc and deallocated using free, so no
-///		calls will be made to the constructor or destructor of DataType.  This
-///		class is primarily designed to efficiently handle primitive types.
+///		Memory is allocated using malloc and deallocated using free (through
+///		MemoryTracker), so no calls will be made to the constructor or
+///		destructor of DataType.  This class is primarily designed to
+///		efficiently handle primitive types.
 ///	</warning>
 
 template <typename DataType>
@@ -79,7 +81,7 @@ class DataVector {
 		///	</summary>
 		virtual ~DataVector() {
 			if (m_data != NULL) {
-				free(reinterpret_cast<void*>(m_data));
+				MemoryTracker::Free(reinterpret_cast<void*>(m_data));
 			}
 		}
 
@@ -101,7 +103,7 @@ class DataVector {
 		///	</summary>
 		void Deinitialize() {
 			if (m_data != NULL) {
-				free(reinterpret_cast<void*>(m_data));
+				MemoryTracker::Free(reinterpret_cast<void*>(m_data));
 			}
 
 			m_data = NULL;
@@ -138,7 +140,7 @@ class DataVector {
 
 			// Allocate memory
 			m_data = reinterpret_cast<DataType*>(
-				malloc(sRows * sizeof(DataType)));
+				MemoryTracker::Allocate(sRows * sizeof(DataType)));
 
 			if (m_data == NULL) {
 				_EXCEPTIONT("Out of memory.");
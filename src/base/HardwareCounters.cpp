@@ -0,0 +1,256 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    HardwareCounters.cpp
+///	\author  Paul Ullrich
+///	\version October 18, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "HardwareCounters.h"
+
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Names of all counters.
+///	</summary>
+static const char * HardwareCountersNames[HardwareCounters::Counter_Count] = {
+	"cycles",
+	"instructions",
+	"cache_references",
+	"cache_misses",
+	"floating_point"
+};
+
+///	<summary>
+///		File descriptor of each counter, or -1 if it is not counted.  The
+///		cycle counter is the leader of the group.
+///	</summary>
+static int s_iFileDescriptor[HardwareCounters::Counter_Count] =
+	{ -1, -1, -1, -1, -1 };
+
+///	<summary>
+///		Position of each counter in the group, or -1 if it is not counted.
+///	</summary>
+static int s_iGroupIndex[HardwareCounters::Counter_Count] =
+	{ -1, -1, -1, -1, -1 };
+
+///	<summary>
+///		Number of counters in the group.
+///	</summary>
+static int s_nGroupSize = 0;
+
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef __linux__
+static int OpenCounter(
+	unsigned int uType,
+	unsigned long long ullConfig,
+	int iGroupFileDescriptor
+) {
+	perf_event_attr attr;
+	memset(&attr, 0, sizeof(perf_event_attr));
+
+	attr.size = sizeof(perf_event_attr);
+	attr.type = uType;
+	attr.config = ullConfig;
+	attr.disabled = (iGroupFileDescriptor == -1)?(1):(0);
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.read_format =
+		  PERF_FORMAT_GROUP
+		| PERF_FORMAT_TOTAL_TIME_ENABLED
+		| PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+	// Count events on this thread on any processor
+	return static_cast<int>(
+		syscall(__NR_perf_event_open, &attr, 0, -1, iGroupFileDescriptor, 0));
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool HardwareCounters::Enable(
+	unsigned long long ullFloatingPointEvent
+) {
+	if (IsEnabled()) {
+		return true;
+	}
+
+#ifdef __linux__
+	unsigned int uType[Counter_Count] = {
+		PERF_TYPE_HARDWARE,
+		PERF_TYPE_HARDWARE,
+		PERF_TYPE_HARDWARE,
+		PERF_TYPE_HARDWARE,
+		PERF_TYPE_RAW
+	};
+
+	unsigned long long ullConfig[Counter_Count] = {
+		PERF_COUNT_HW_CPU_CYCLES,
+		PERF_COUNT_HW_INSTRUCTIONS,
+		PERF_COUNT_HW_CACHE_REFERENCES,
+		PERF_COUNT_HW_CACHE_MISSES,
+		ullFloatingPointEvent
+	};
+
+	s_nGroupSize = 0;
+
+	for (int c = 0; c < Counter_Count; c++) {
+		if ((c == Counter_FloatingPoint) && (ullFloatingPointEvent == 0)) {
+			continue;
+		}
+
+		int iFileDescriptor =
+			OpenCounter(uType[c], ullConfig[c],
+				s_iFileDescriptor[Counter_Cycles]);
+
+		// Without the group leader no counters are available
+		if (iFileDescriptor == -1) {
+			if (c == Counter_Cycles) {
+				return false;
+			}
+			continue;
+		}
+
+		s_iFileDescriptor[c] = iFileDescriptor;
+		s_iGroupIndex[c] = s_nGroupSize;
+		s_nGroupSize++;
+	}
+
+	// Start counting
+	int iLeader = s_iFileDescriptor[Counter_Cycles];
+
+	ioctl(iLeader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+	ioctl(iLeader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void HardwareCounters::Disable() {
+#ifdef __linux__
+	if (!IsEnabled()) {
+		return;
+	}
+
+	ioctl(s_iFileDescriptor[Counter_Cycles],
+		PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+	// Close the group leader last
+	for (int c = Counter_Count - 1; c >= 0; c--) {
+		if (s_iFileDescriptor[c] != -1) {
+			close(s_iFileDescriptor[c]);
+		}
+		s_iFileDescriptor[c] = -1;
+		s_iGroupIndex[c] = -1;
+	}
+
+	s_nGroupSize = 0;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool HardwareCounters::IsEnabled() {
+	return (s_iFileDescriptor[Counter_Cycles] != -1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool HardwareCounters::IsCounted(
+	Counter eCounter
+) {
+	return (s_iFileDescriptor[eCounter] != -1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+const char * HardwareCounters::GetName(
+	Counter eCounter
+) {
+	return HardwareCountersNames[eCounter];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void HardwareCounters::Read(
+	Sample & sample
+) {
+	memset(&sample, 0, sizeof(Sample));
+
+#ifdef __linux__
+	if (!IsEnabled()) {
+		return;
+	}
+
+	// Group format: number of counters, time enabled, time running and
+	// then the value of each counter in the order they were opened
+	unsigned long long ullBuffer[3 + Counter_Count];
+
+	ssize_t sRead =
+		read(s_iFileDescriptor[Counter_Cycles],
+			ullBuffer, sizeof(ullBuffer));
+
+	if (sRead < static_cast<ssize_t>(
+		(3 + s_nGroupSize) * sizeof(unsigned long long))
+	) {
+		return;
+	}
+
+	sample.dTimeEnabled = static_cast<double>(ullBuffer[1]);
+	sample.dTimeRunning = static_cast<double>(ullBuffer[2]);
+
+	for (int c = 0; c < Counter_Count; c++) {
+		if (s_iGroupIndex[c] != -1) {
+			sample.dValue[c] =
+				static_cast<double>(ullBuffer[3 + s_iGroupIndex[c]]);
+		}
+	}
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void HardwareCounters::Accumulate(
+	const Sample & sampleBegin,
+	const Sample & sampleEnd,
+	double * dTotal
+) {
+	double dRunning = sampleEnd.dTimeRunning - sampleBegin.dTimeRunning;
+	double dEnabled = sampleEnd.dTimeEnabled - sampleBegin.dTimeEnabled;
+
+	// The group was never scheduled during this interval
+	if (dRunning <= 0.0) {
+		return;
+	}
+
+	double dScale = dEnabled / dRunning;
+
+	for (int c = 0; c < Counter_Count; c++) {
+		dTotal[c] += dScale * (sampleEnd.dValue[c] - sampleBegin.dValue[c]);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,121 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    HardwareCounters.h
+///	\author  Paul Ullrich
+///	\version October 18, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _HARDWARECOUNTERS_H_
+#define _HARDWARECOUNTERS_H_
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		HardwareCounters reads processor performance counters for the main
+///		thread using the Linux perf_event interface.  All counters are
+///		opened as a single group so that they are always scheduled together.
+///		Counters are only available on Linux, and only if the kernel allows
+///		unprivileged processes to count user-space events.
+///	</summary>
+class HardwareCounters {
+
+public:
+	///	<summary>
+	///		Counters which are read.
+	///	</summary>
+	enum Counter {
+		Counter_Cycles,
+		Counter_Instructions,
+		Counter_CacheReferences,
+		Counter_CacheMisses,
+		Counter_FloatingPoint,
+		Counter_Count
+	};
+
+	///	<summary>
+	///		Values of all counters at one point in time.
+	///	</summary>
+	struct Sample {
+		///	<summary>
+		///		Time for which the counters have been enabled (in ns).
+		///	</summary>
+		double dTimeEnabled;
+
+		///	<summary>
+		///		Time for which the counters have been running (in ns).
+		///	</summary>
+		double dTimeRunning;
+
+		///	<summary>
+		///		Value of each counter.
+		///	</summary>
+		double dValue[Counter_Count];
+	};
+
+public:
+	///	<summary>
+	///		Open and start the counters.  The floating point counter uses
+	///		the given processor-specific raw event code, or is not counted
+	///		if the code is zero.  Counters which are not supported are
+	///		skipped.  Returns false if no counters could be opened.
+	///	</summary>
+	static bool Enable(
+		unsigned long long ullFloatingPointEvent = 0
+	);
+
+	///	<summary>
+	///		Stop and close the counters.
+	///	</summary>
+	static void Disable();
+
+	///	<summary>
+	///		Determine if the counters are enabled.
+	///	</summary>
+	static bool IsEnabled();
+
+	///	<summary>
+	///		Determine if the given counter is being counted.
+	///	</summary>
+	static bool IsCounted(
+		Counter eCounter
+	);
+
+	///	<summary>
+	///		Get the name of a counter.
+	///	</summary>
+	static const char * GetName(
+		Counter eCounter
+	);
+
+	///	<summary>
+	///		Read the current value of all counters.
+	///	</summary>
+	static void Read(
+		Sample & sample
+	);
+
+	///	<summary>
+	///		Add the change in all counters between two samples to dTotal.
+	///		If the counters were multiplexed with other events the change is
+	///		scaled to an estimate of the full count.
+	///	</summary>
+	static void Accumulate(
+		const Sample & sampleBegin,
+		const Sample & sampleEnd,
+		double * dTotal
+	);
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
@@ -38,3 +38,19 @@ void PrintMemoryLine(const char * szString) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+size_t GetPeakResidentMemory() {
+	rusage ruse;
+
+	getrusage(RUSAGE_SELF, &ruse);
+
+#ifdef __APPLE__
+	// Reported in bytes
+	return static_cast<size_t>(ruse.ru_maxrss);
+#else
+	// Reported in kilobytes
+	return static_cast<size_t>(ruse.ru_maxrss) * 1024;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
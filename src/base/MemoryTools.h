@@ -30,5 +30,12 @@ void PrintMemoryLine(const char * szString = NULL);
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Get the peak resident memory of this process (in bytes).
+///	</summary>
+size_t GetPeakResidentMemory();
+
+///////////////////////////////////////////////////////////////////////////////
+
 #endif
 
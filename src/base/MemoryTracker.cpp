@@ -0,0 +1,317 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    MemoryTracker.cpp
+///	\author  Paul Ullrich
+///	\version October 18, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "MemoryTracker.h"
+#include "Announce.h"
+#include "Exception.h"
+
+#include <mpi.h>
+#include <pthread.h>
+#include <cstdio>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Header stored in front of each allocation.  The header is padded to
+///		16 bytes so that the alignment of the memory returned by malloc is
+///		preserved.
+///	</summary>
+union MemoryTrackerHeader {
+	struct {
+		size_t sBytes;
+		int iTag;
+	} info;
+
+	char cPadding[16];
+};
+
+///	<summary>
+///		Maximum depth of nested tags.
+///	</summary>
+static const int MemoryTrackerMaxDepth = 32;
+
+///	<summary>
+///		Names of all tags.
+///	</summary>
+static const char * MemoryTrackerTagNames[MemoryTag_Count] = {
+	"Other",
+	"State",
+	"Tracers",
+	"Geometry",
+	"Auxiliary",
+	"Jacobian",
+	"Exchange",
+	"Output"
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// The following are plain data so that they are valid before any static
+// constructor which allocates memory is run.
+
+static size_t s_sCurrentBytes[MemoryTag_Count];
+
+static size_t s_sPeakBytes[MemoryTag_Count];
+
+static size_t s_sTotalCurrentBytes = 0;
+
+static size_t s_sTotalPeakBytes = 0;
+
+static MemoryTag s_eTagStack[MemoryTrackerMaxDepth];
+
+static int s_nTagDepth = 0;
+
+static pthread_mutex_t s_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+///////////////////////////////////////////////////////////////////////////////
+
+void * MemoryTracker::Allocate(
+	size_t sBytes
+) {
+	char * pRaw = reinterpret_cast<char *>(
+		malloc(sizeof(MemoryTrackerHeader) + sBytes));
+
+	if (pRaw == NULL) {
+		return NULL;
+	}
+
+	int iTag = MemoryTag_Other;
+	if (s_nTagDepth > 0) {
+		iTag = static_cast<int>(s_eTagStack[s_nTagDepth-1]);
+	}
+
+	MemoryTrackerHeader * pHeader =
+		reinterpret_cast<MemoryTrackerHeader *>(pRaw);
+
+	pHeader->info.sBytes = sBytes;
+	pHeader->info.iTag = iTag;
+
+	pthread_mutex_lock(&s_mutex);
+
+	s_sCurrentBytes[iTag] += sBytes;
+	if (s_sCurrentBytes[iTag] > s_sPeakBytes[iTag]) {
+		s_sPeakBytes[iTag] = s_sCurrentBytes[iTag];
+	}
+
+	s_sTotalCurrentBytes += sBytes;
+	if (s_sTotalCurrentBytes > s_sTotalPeakBytes) {
+		s_sTotalPeakBytes = s_sTotalCurrentBytes;
+	}
+
+	pthread_mutex_unlock(&s_mutex);
+
+	return reinterpret_cast<void *>(pRaw + sizeof(MemoryTrackerHeader));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void MemoryTracker::Free(
+	void * pData
+) {
+	if (pData == NULL) {
+		return;
+	}
+
+	char * pRaw =
+		reinterpret_cast<char *>(pData) - sizeof(MemoryTrackerHeader);
+
+	const MemoryTrackerHeader * pHeader =
+		reinterpret_cast<const MemoryTrackerHeader *>(pRaw);
+
+	pthread_mutex_lock(&s_mutex);
+
+	s_sCurrentBytes[pHeader->info.iTag] -= pHeader->info.sBytes;
+	s_sTotalCurrentBytes -= pHeader->info.sBytes;
+
+	pthread_mutex_unlock(&s_mutex);
+
+	free(pRaw);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void MemoryTracker::Begin(
+	MemoryTag eTag
+) {
+	if ((eTag < 0) || (eTag >= MemoryTag_Count)) {
+		_EXCEPTIONT("Invalid MemoryTag");
+	}
+	if (s_nTagDepth == MemoryTrackerMaxDepth) {
+		_EXCEPTIONT("Maximum depth of nested MemoryTags exceeded");
+	}
+
+	s_eTagStack[s_nTagDepth] = eTag;
+	s_nTagDepth++;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void MemoryTracker::End() {
+	if (s_nTagDepth == 0) {
+		_EXCEPTIONT("Logic error: No active MemoryTag");
+	}
+
+	s_nTagDepth--;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+const char * MemoryTracker::GetTagName(
+	MemoryTag eTag
+) {
+	if ((eTag < 0) || (eTag >= MemoryTag_Count)) {
+		_EXCEPTIONT("Invalid MemoryTag");
+	}
+	return MemoryTrackerTagNames[eTag];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+size_t MemoryTracker::GetCurrentBytes(
+	MemoryTag eTag
+) {
+	pthread_mutex_lock(&s_mutex);
+	size_t sBytes = s_sCurrentBytes[eTag];
+	pthread_mutex_unlock(&s_mutex);
+
+	return sBytes;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+size_t MemoryTracker::GetPeakBytes(
+	MemoryTag eTag
+) {
+	pthread_mutex_lock(&s_mutex);
+	size_t sBytes = s_sPeakBytes[eTag];
+	pthread_mutex_unlock(&s_mutex);
+
+	return sBytes;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void MemoryTracker::Report(
+	const std::string & strFile
+) {
+	int nRank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &nRank);
+
+	int nSize;
+	MPI_Comm_size(MPI_COMM_WORLD, &nSize);
+
+	// Current and peak bytes of each tag on this processor; the final
+	// entry contains the totals over all tags
+	const int nEntries = MemoryTag_Count + 1;
+
+	std::vector<double> vecLocal(2 * nEntries);
+
+	pthread_mutex_lock(&s_mutex);
+	for (int t = 0; t < MemoryTag_Count; t++) {
+		vecLocal[2*t  ] = static_cast<double>(s_sCurrentBytes[t]);
+		vecLocal[2*t+1] = static_cast<double>(s_sPeakBytes[t]);
+	}
+	vecLocal[2*MemoryTag_Count  ] = static_cast<double>(s_sTotalCurrentBytes);
+	vecLocal[2*MemoryTag_Count+1] = static_cast<double>(s_sTotalPeakBytes);
+	pthread_mutex_unlock(&s_mutex);
+
+	// Gather on root
+	std::vector<double> vecAll;
+	if (nRank == 0) {
+		vecAll.resize(2 * nEntries * nSize);
+	}
+
+	MPI_Gather(
+		&(vecLocal[0]), 2 * nEntries, MPI_DOUBLE,
+		(nRank == 0)?(&(vecAll[0])):(NULL), 2 * nEntries, MPI_DOUBLE,
+		0, MPI_COMM_WORLD);
+
+	if (nRank != 0) {
+		return;
+	}
+
+	// Summary table
+	const double dMB = 1024.0 * 1024.0;
+
+	AnnounceStartBlock("Memory");
+	Announce("Aggregated over %i processors", nSize);
+	Announce("%-12s %14s %14s %14s %14s %14s",
+		"Tag", "Current (MB)", "Max Cur (MB)",
+		"Peak (MB)", "Max Peak (MB)", "Total Peak (MB)");
+
+	for (int t = 0; t < nEntries; t++) {
+		double dCurrentSum = 0.0;
+		double dCurrentMax = 0.0;
+		double dPeakSum = 0.0;
+		double dPeakMax = 0.0;
+
+		for (int p = 0; p < nSize; p++) {
+			double dCurrent = vecAll[2 * (p * nEntries + t)];
+			double dPeak = vecAll[2 * (p * nEntries + t) + 1];
+
+			dCurrentSum += dCurrent;
+			dPeakSum += dPeak;
+
+			if (dCurrent > dCurrentMax) {
+				dCurrentMax = dCurrent;
+			}
+			if (dPeak > dPeakMax) {
+				dPeakMax = dPeak;
+			}
+		}
+
+		if ((t != MemoryTag_Count) && (dPeakMax == 0.0)) {
+			continue;
+		}
+
+		Announce("%-12s %14.3f %14.3f %14.3f %14.3f %14.3f",
+			(t == MemoryTag_Count)?("Total"):(MemoryTrackerTagNames[t]),
+			dCurrentSum / static_cast<double>(nSize) / dMB,
+			dCurrentMax / dMB,
+			dPeakSum / static_cast<double>(nSize) / dMB,
+			dPeakMax / dMB,
+			dPeakSum / dMB);
+	}
+	AnnounceEndBlock("Done");
+
+	if (strFile == "") {
+		return;
+	}
+
+	// Machine-readable output
+	std::string strCSVFile = strFile + ".memory.csv";
+	FILE * fpCSV = fopen(strCSVFile.c_str(), "w");
+	if (fpCSV == NULL) {
+		_EXCEPTION1("Unable to open memory file \"%s\"",
+			strCSVFile.c_str());
+	}
+
+	fprintf(fpCSV, "rank,tag,current_bytes,peak_bytes\n");
+	for (int p = 0; p < nSize; p++) {
+	for (int t = 0; t < nEntries; t++) {
+		fprintf(fpCSV, "%i,%s,%.0f,%.0f\n",
+			p,
+			(t == MemoryTag_Count)?("Total"):(MemoryTrackerTagNames[t]),
+			vecAll[2 * (p * nEntries + t)],
+			vecAll[2 * (p * nEntries + t) + 1]);
+	}
+	}
+	fclose(fpCSV);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
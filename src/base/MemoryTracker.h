@@ -0,0 +1,140 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    MemoryTracker.h
+///	\author  Paul Ullrich
+///	\version October 18, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _MEMORYTRACKER_H_
+#define _MEMORYTRACKER_H_
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <cstdlib>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Owners to which tracked memory is attributed.
+///	</summary>
+enum MemoryTag {
+	MemoryTag_Other,
+	MemoryTag_State,
+	MemoryTag_Tracers,
+	MemoryTag_Geometry,
+	MemoryTag_Auxiliary,
+	MemoryTag_Jacobian,
+	MemoryTag_Exchange,
+	MemoryTag_Output,
+	MemoryTag_Count
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		MemoryTracker accounts for the memory held by DataVector, DataMatrix,
+///		DataMatrix3D and DataMatrix4D.  Each allocation is attributed to the
+///		active tag when it is made, and the current and peak number of bytes
+///		are recorded for each tag.  Tags must only be entered and exited on
+///		the main thread, but memory may be released on any thread.
+///	</summary>
+class MemoryTracker {
+
+public:
+	///	<summary>
+	///		Allocate memory attributed to the active tag.  Returns NULL if
+	///		the allocation fails.
+	///	</summary>
+	static void * Allocate(
+		size_t sBytes
+	);
+
+	///	<summary>
+	///		Release memory obtained from Allocate.
+	///	</summary>
+	static void Free(
+		void * pData
+	);
+
+	///	<summary>
+	///		Make the given tag active until the matching call to End.
+	///	</summary>
+	static void Begin(
+		MemoryTag eTag
+	);
+
+	///	<summary>
+	///		Restore the previously active tag.
+	///	</summary>
+	static void End();
+
+	///	<summary>
+	///		Get the name of a tag.
+	///	</summary>
+	static const char * GetTagName(
+		MemoryTag eTag
+	);
+
+	///	<summary>
+	///		Get the number of bytes currently held by a tag on this
+	///		processor.
+	///	</summary>
+	static size_t GetCurrentBytes(
+		MemoryTag eTag
+	);
+
+	///	<summary>
+	///		Get the largest number of bytes held by a tag on this processor.
+	///	</summary>
+	static size_t GetPeakBytes(
+		MemoryTag eTag
+	);
+
+	///	<summary>
+	///		Aggregate memory use over all processors and output a summary
+	///		table.  If strFile is not empty the current and peak bytes of
+	///		each tag on each processor are written to strFile.memory.csv.
+	///		This function must be called on all processors.
+	///	</summary>
+	static void Report(
+		const std::string & strFile = ""
+	);
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A tag which is active from construction until it goes out of scope.
+///	</summary>
+class MemoryTrackerRegion {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	MemoryTrackerRegion(MemoryTag eTag) {
+		MemoryTracker::Begin(eTag);
+	}
+
+	///	<summary>
+	///		Destructor.
+	///	</summary>
+	~MemoryTrackerRegion() {
+		MemoryTracker::End();
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
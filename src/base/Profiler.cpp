@@ -0,0 +1,785 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    Profiler.cpp
+///	\author  Paul Ullrich
+///	\version October 18, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "Profiler.h"
+#include "Announce.h"
+#include "Exception.h"
+#include "MemoryTools.h"
+
+#include <mpi.h>
+#include <cstdio>
+#include <ctime>
+
+///////////////////////////////////////////////////////////////////////////////
+
+std::vector<Profiler::Region> Profiler::m_vecRegions(
+	1, Profiler::Region("", -1));
+
+int Profiler::m_iActive = 0;
+
+bool Profiler::m_fTrace = false;
+
+std::vector<Profiler::TraceEvent> Profiler::m_vecTraceEvents;
+
+long long Profiler::m_nTraceEventCount = 0;
+
+double Profiler::m_dTraceOrigin = 0.0;
+
+std::vector<std::string> Profiler::m_vecMetricNames;
+
+std::vector<double> Profiler::m_vecMetricValues;
+
+///////////////////////////////////////////////////////////////////////////////
+
+double Profiler::GetTime() {
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return static_cast<double>(ts.tv_sec)
+		+ 1.0e-9 * static_cast<double>(ts.tv_nsec);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Profiler::Begin(const char * szName) {
+	int iRegion = FindOrCreateChild(m_iActive, szName);
+
+	Region & region = m_vecRegions[iRegion];
+	region.nCalls++;
+
+	if (HardwareCounters::IsEnabled()) {
+		HardwareCounters::Read(region.sampleStart);
+	}
+
+	region.dStartTime = GetTime();
+
+	m_iActive = iRegion;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Profiler::End() {
+	if (m_iActive == 0) {
+		_EXCEPTIONT("Profiler::End called outside of any region");
+	}
+
+	Region & region = m_vecRegions[m_iActive];
+
+	double dEndTime = GetTime();
+	region.dTime += dEndTime - region.dStartTime;
+
+	if (m_fTrace) {
+		TraceEvent & event =
+			m_vecTraceEvents[m_nTraceEventCount % m_vecTraceEvents.size()];
+
+		event.iRegion = m_iActive;
+		event.dBeginTime = region.dStartTime;
+		event.dEndTime = dEndTime;
+
+		m_nTraceEventCount++;
+	}
+
+	if (HardwareCounters::IsEnabled()) {
+		HardwareCounters::Sample sampleEnd;
+		HardwareCounters::Read(sampleEnd);
+		HardwareCounters::Accumulate(
+			region.sampleStart, sampleEnd, region.dCounters);
+	}
+
+	m_iActive = region.iParent;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Profiler::Reset() {
+	if (m_iActive != 0) {
+		_EXCEPTION1("Profiler::Reset called within region \"%s\"",
+			m_vecRegions[m_iActive].strName.c_str());
+	}
+
+	m_vecRegions.clear();
+	m_vecRegions.push_back(Region("", -1));
+
+	m_fTrace = false;
+	m_vecTraceEvents.clear();
+	m_nTraceEventCount = 0;
+
+	m_vecMetricNames.clear();
+	m_vecMetricValues.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Profiler::SetMetric(
+	const std::string & strName,
+	double dValue
+) {
+	for (int i = 0; i < m_vecMetricNames.size(); i++) {
+		if (m_vecMetricNames[i] == strName) {
+			m_vecMetricValues[i] = dValue;
+			return;
+		}
+	}
+
+	m_vecMetricNames.push_back(strName);
+	m_vecMetricValues.push_back(dValue);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Profiler::EnableTrace(
+	int nMaxEvents
+) {
+	if (nMaxEvents <= 0) {
+		_EXCEPTIONT("Trace buffer must contain at least one event");
+	}
+
+	m_vecTraceEvents.resize(nMaxEvents);
+	m_nTraceEventCount = 0;
+
+	// Start the trace clock on all processors at the same time, so that
+	// events on different processors can be compared
+	MPI_Barrier(MPI_COMM_WORLD);
+
+	m_dTraceOrigin = GetTime();
+	m_fTrace = true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Profiler::WriteTrace(
+	const std::string & strFile
+) {
+	int nRank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &nRank);
+
+	int nSize;
+	MPI_Comm_size(MPI_COMM_WORLD, &nSize);
+
+	m_fTrace = false;
+
+	// Path of each region
+	std::vector<std::string> vecPaths;
+	std::vector<int> vecRegions;
+
+	BuildPathList(0, "", vecPaths, vecRegions);
+
+	std::vector<std::string> vecRegionPaths(m_vecRegions.size());
+	for (int i = 0; i < vecRegions.size(); i++) {
+		vecRegionPaths[vecRegions[i]] = vecPaths[i];
+	}
+
+	// Events on this processor from oldest to newest, in microseconds
+	// since the trace was enabled
+	long long nMaxEvents = static_cast<long long>(m_vecTraceEvents.size());
+
+	long long nFirstEvent = 0;
+	if (m_nTraceEventCount > nMaxEvents) {
+		nFirstEvent = m_nTraceEventCount - nMaxEvents;
+	}
+
+	std::string strEvents;
+	char szEvent[1024];
+
+	if (m_nTraceEventCount > nMaxEvents) {
+		snprintf(szEvent, 1024,
+			",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, "
+			"\"tid\": %i, \"args\": {\"name\": \"Rank %i (%lli events "
+			"dropped)\"}}",
+			nRank, nRank, nFirstEvent);
+	} else {
+		snprintf(szEvent, 1024,
+			",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, "
+			"\"tid\": %i, \"args\": {\"name\": \"Rank %i\"}}",
+			nRank, nRank);
+	}
+	strEvents += szEvent;
+
+	for (long long n = nFirstEvent; n < m_nTraceEventCount; n++) {
+		const TraceEvent & event = m_vecTraceEvents[n % nMaxEvents];
+
+		snprintf(szEvent, 1024,
+			",\n{\"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"X\", "
+			"\"ts\": %.3f, \"dur\": %.3f, \"pid\": 0, \"tid\": %i}",
+			m_vecRegions[event.iRegion].strName.c_str(),
+			vecRegionPaths[event.iRegion].c_str(),
+			1.0e6 * (event.dBeginTime - m_dTraceOrigin),
+			1.0e6 * (event.dEndTime - event.dBeginTime),
+			nRank);
+
+		strEvents += szEvent;
+	}
+
+	// Gather events on root
+	int nLength = static_cast<int>(strEvents.length());
+
+	std::vector<int> vecLengths(nSize, 0);
+	MPI_Gather(
+		&nLength, 1, MPI_INT,
+		&(vecLengths[0]), 1, MPI_INT,
+		0, MPI_COMM_WORLD);
+
+	std::vector<int> vecDispls(nSize, 0);
+	for (int p = 1; p < nSize; p++) {
+		vecDispls[p] = vecDispls[p-1] + vecLengths[p-1];
+	}
+
+	std::vector<char> vecAllEvents;
+	if (nRank == 0) {
+		vecAllEvents.resize(vecDispls[nSize-1] + vecLengths[nSize-1] + 1, '\0');
+	}
+
+	MPI_Gatherv(
+		const_cast<char *>(strEvents.c_str()), nLength, MPI_CHAR,
+		(nRank == 0)?(&(vecAllEvents[0])):(NULL),
+		&(vecLengths[0]), &(vecDispls[0]), MPI_CHAR,
+		0, MPI_COMM_WORLD);
+
+	if (nRank != 0) {
+		return;
+	}
+
+	FILE * fpTrace = fopen(strFile.c_str(), "w");
+	if (fpTrace == NULL) {
+		_EXCEPTION1("Unable to open trace file \"%s\"", strFile.c_str());
+	}
+
+	fprintf(fpTrace, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+	fprintf(fpTrace, "{\"name\": \"process_name\", \"ph\": \"M\", "
+		"\"pid\": 0, \"args\": {\"name\": \"Tempest\"}}");
+	fputs(&(vecAllEvents[0]), fpTrace);
+	fprintf(fpTrace, "\n]}\n");
+	fclose(fpTrace);
+
+	Announce("Trace of %i processors written to \"%s\"",
+		nSize, strFile.c_str());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int Profiler::FindOrCreateChild(
+	int iParent,
+	const char * szName
+) {
+	const std::vector<int> & vecChildren = m_vecRegions[iParent].vecChildren;
+
+	for (int i = 0; i < vecChildren.size(); i++) {
+		if (m_vecRegions[vecChildren[i]].strName == szName) {
+			return vecChildren[i];
+		}
+	}
+
+	int iRegion = static_cast<int>(m_vecRegions.size());
+
+	m_vecRegions.push_back(Region(szName, iParent));
+	m_vecRegions[iParent].vecChildren.push_back(iRegion);
+
+	return iRegion;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Profiler::BuildPathList(
+	int iRegion,
+	const std::string & strPrefix,
+	std::vector<std::string> & vecPaths,
+	std::vector<int> & vecRegions
+) {
+	const std::vector<int> & vecChildren = m_vecRegions[iRegion].vecChildren;
+
+	for (int i = 0; i < vecChildren.size(); i++) {
+		std::string strPath =
+			strPrefix + m_vecRegions[vecChildren[i]].strName;
+
+		vecPaths.push_back(strPath);
+		vecRegions.push_back(vecChildren[i]);
+
+		BuildPathList(vecChildren[i], strPath + "/", vecPaths, vecRegions);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int Profiler::FindOrCreatePath(
+	const std::string & strPath
+) {
+	int iRegion = 0;
+
+	int iBegin = 0;
+	for (int i = 0; i <= strPath.length(); i++) {
+		if ((i == strPath.length()) || (strPath[i] == '/')) {
+			std::string strName = strPath.substr(iBegin, i - iBegin);
+			iRegion = FindOrCreateChild(iRegion, strName.c_str());
+			iBegin = i + 1;
+		}
+	}
+
+	return iRegion;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void SplitPaths(
+	const std::string & strPaths,
+	std::vector<std::string> & vecPaths
+) {
+	vecPaths.clear();
+
+	int iBegin = 0;
+	for (int i = 0; i < strPaths.length(); i++) {
+		if (strPaths[i] == '\n') {
+			vecPaths.push_back(strPaths.substr(iBegin, i - iBegin));
+			iBegin = i + 1;
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Profiler::Report(
+	const std::string & strFile
+) {
+	int nRank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &nRank);
+
+	int nSize;
+	MPI_Comm_size(MPI_COMM_WORLD, &nSize);
+
+	// Peak memory use on this processor
+	SetMetric("peak_memory_mb",
+		static_cast<double>(GetPeakResidentMemory()) / (1024.0 * 1024.0));
+
+	// Reduce metrics over all processors
+	const int nMetrics = static_cast<int>(m_vecMetricNames.size());
+
+	std::vector<double> vecMetricMin(nMetrics);
+	std::vector<double> vecMetricMax(nMetrics);
+	std::vector<double> vecMetricSum(nMetrics);
+
+	MPI_Reduce(
+		&(m_vecMetricValues[0]), &(vecMetricMin[0]), nMetrics,
+		MPI_DOUBLE, MPI_MIN, 0, MPI_COMM_WORLD);
+	MPI_Reduce(
+		&(m_vecMetricValues[0]), &(vecMetricMax[0]), nMetrics,
+		MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+	MPI_Reduce(
+		&(m_vecMetricValues[0]), &(vecMetricSum[0]), nMetrics,
+		MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+
+	// Collect the region paths on this processor
+	std::vector<std::string> vecPaths;
+	std::vector<int> vecRegions;
+
+	BuildPathList(0, "", vecPaths, vecRegions);
+
+	std::string strPaths;
+	for (int i = 0; i < vecPaths.size(); i++) {
+		strPaths += vecPaths[i];
+		strPaths += "\n";
+	}
+
+	// Gather paths on root, so that regions which were only entered on
+	// some processors are included in the report
+	int nLength = static_cast<int>(strPaths.length());
+
+	std::vector<int> vecLengths(nSize, 0);
+	MPI_Gather(
+		&nLength, 1, MPI_INT,
+		&(vecLengths[0]), 1, MPI_INT,
+		0, MPI_COMM_WORLD);
+
+	std::vector<int> vecDispls(nSize, 0);
+	for (int p = 1; p < nSize; p++) {
+		vecDispls[p] = vecDispls[p-1] + vecLengths[p-1];
+	}
+
+	std::vector<char> vecAllPaths(
+		vecDispls[nSize-1] + vecLengths[nSize-1] + 1, '\0');
+
+	MPI_Gatherv(
+		const_cast<char *>(strPaths.c_str()), nLength, MPI_CHAR,
+		&(vecAllPaths[0]), &(vecLengths[0]), &(vecDispls[0]), MPI_CHAR,
+		0, MPI_COMM_WORLD);
+
+	// Combine all paths into the region hierarchy on root
+	if (nRank == 0) {
+		std::vector<std::string> vecAllPathList;
+		SplitPaths(std::string(&(vecAllPaths[0])), vecAllPathList);
+
+		for (int i = 0; i < vecAllPathList.size(); i++) {
+			FindOrCreatePath(vecAllPathList[i]);
+		}
+
+		vecPaths.clear();
+		vecRegions.clear();
+		BuildPathList(0, "", vecPaths, vecRegions);
+
+		strPaths = "";
+		for (int i = 0; i < vecPaths.size(); i++) {
+			strPaths += vecPaths[i];
+			strPaths += "\n";
+		}
+	}
+
+	// Broadcast the combined path list from root
+	nLength = static_cast<int>(strPaths.length());
+	MPI_Bcast(&nLength, 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+	std::vector<char> vecCombined(nLength + 1, '\0');
+	if (nRank == 0) {
+		strPaths.copy(&(vecCombined[0]), nLength);
+	}
+	MPI_Bcast(&(vecCombined[0]), nLength, MPI_CHAR, 0, MPI_COMM_WORLD);
+
+	SplitPaths(std::string(&(vecCombined[0])), vecPaths);
+
+	const int nRegions = static_cast<int>(vecPaths.size());
+	if (nRegions == 0) {
+		return;
+	}
+
+	// Local timing data in the combined order
+	const int nCounters = HardwareCounters::Counter_Count;
+
+	std::vector<double> vecTime(nRegions);
+	std::vector<double> vecCalls(nRegions);
+	std::vector<double> vecCounters(nRegions * nCounters);
+
+	for (int i = 0; i < nRegions; i++) {
+		int iRegion = FindOrCreatePath(vecPaths[i]);
+
+		vecTime[i] = m_vecRegions[iRegion].dTime;
+		vecCalls[i] = static_cast<double>(m_vecRegions[iRegion].nCalls);
+
+		for (int c = 0; c < nCounters; c++) {
+			vecCounters[i * nCounters + c] =
+				m_vecRegions[iRegion].dCounters[c];
+		}
+	}
+
+	// Reduce over all processors
+	std::vector<double> vecTimeMin(nRegions);
+	std::vector<double> vecTimeMax(nRegions);
+	std::vector<double> vecTimeSum(nRegions);
+	std::vector<double> vecCallsSum(nRegions);
+
+	MPI_Reduce(
+		&(vecTime[0]), &(vecTimeMin[0]), nRegions,
+		MPI_DOUBLE, MPI_MIN, 0, MPI_COMM_WORLD);
+	MPI_Reduce(
+		&(vecTime[0]), &(vecTimeMax[0]), nRegions,
+		MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+	MPI_Reduce(
+		&(vecTime[0]), &(vecTimeSum[0]), nRegions,
+		MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+	MPI_Reduce(
+		&(vecCalls[0]), &(vecCallsSum[0]), nRegions,
+		MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+
+	// Hardware counters are only reported if they are counted on all
+	// processors
+	std::vector<int> vecLocalCounted(nCounters);
+	for (int c = 0; c < nCounters; c++) {
+		vecLocalCounted[c] =
+			HardwareCounters::IsCounted(
+				static_cast<HardwareCounters::Counter>(c))?(1):(0);
+	}
+
+	std::vector<int> vecCounted(nCounters);
+	MPI_Allreduce(
+		&(vecLocalCounted[0]), &(vecCounted[0]), nCounters,
+		MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+
+	std::vector<double> vecCountersSum(nRegions * nCounters);
+	if (vecCounted[HardwareCounters::Counter_Cycles]) {
+		MPI_Reduce(
+			&(vecCounters[0]), &(vecCountersSum[0]), nRegions * nCounters,
+			MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+	}
+
+	if (nRank != 0) {
+		return;
+	}
+
+	// Derived quantities
+	std::vector<std::string> vecNames(nRegions);
+	std::vector<int> vecDepth(nRegions);
+	std::vector<double> vecTimeMean(nRegions);
+	std::vector<double> vecCallsMean(nRegions);
+	std::vector<double> vecImbalance(nRegions);
+
+	for (int i = 0; i < nRegions; i++) {
+		size_t iSlash = vecPaths[i].rfind('/');
+		if (iSlash == std::string::npos) {
+			vecNames[i] = vecPaths[i];
+		} else {
+			vecNames[i] = vecPaths[i].substr(iSlash + 1);
+		}
+
+		vecDepth[i] = 0;
+		for (int j = 0; j < vecPaths[i].length(); j++) {
+			if (vecPaths[i][j] == '/') {
+				vecDepth[i]++;
+			}
+		}
+
+		vecTimeMean[i] = vecTimeSum[i] / static_cast<double>(nSize);
+		vecCallsMean[i] = vecCallsSum[i] / static_cast<double>(nSize);
+
+		if (vecTimeMean[i] > 0.0) {
+			vecImbalance[i] = vecTimeMax[i] / vecTimeMean[i] - 1.0;
+		} else {
+			vecImbalance[i] = 0.0;
+		}
+	}
+
+	// Summary table
+	AnnounceStartBlock("Profile");
+	Announce("Aggregated over %i processors", nSize);
+	Announce("%-36s %10s %12s %12s %12s %8s",
+		"Region", "Calls", "Mean (s)", "Min (s)", "Max (s)", "Imbal");
+
+	for (int i = 0; i < nRegions; i++) {
+		std::string strIndentName =
+			std::string(2 * vecDepth[i], ' ') + vecNames[i];
+
+		Announce("%-36s %10.0f %12.4e %12.4e %12.4e %7.1f%%",
+			strIndentName.c_str(),
+			vecCallsMean[i],
+			vecTimeMean[i],
+			vecTimeMin[i],
+			vecTimeMax[i],
+			100.0 * vecImbalance[i]);
+	}
+
+	Announce("%-36s %10s %12s %12s %12s",
+		"Metric", "", "Mean", "Min", "Max");
+	for (int i = 0; i < nMetrics; i++) {
+		Announce("%-36s %10s %12.4e %12.4e %12.4e",
+			m_vecMetricNames[i].c_str(),
+			"",
+			vecMetricSum[i] / static_cast<double>(nSize),
+			vecMetricMin[i],
+			vecMetricMax[i]);
+	}
+	AnnounceEndBlock("Done");
+
+	if (vecCounted[HardwareCounters::Counter_Cycles]) {
+		ReportCounters(strFile, vecPaths, vecCountersSum, vecCounted);
+	}
+
+	if (strFile == "") {
+		return;
+	}
+
+	// Machine-readable output
+	std::string strCSVFile = strFile + ".csv";
+	FILE * fpCSV = fopen(strCSVFile.c_str(), "w");
+	if (fpCSV == NULL) {
+		_EXCEPTION1("Unable to open profile file \"%s\"",
+			strCSVFile.c_str());
+	}
+
+	fprintf(fpCSV, "region,depth,calls,mean,min,max,imbalance\n");
+	for (int i = 0; i < nRegions; i++) {
+		fprintf(fpCSV, "%s,%i,%.17g,%.17g,%.17g,%.17g,%.17g\n",
+			vecPaths[i].c_str(),
+			vecDepth[i],
+			vecCallsMean[i],
+			vecTimeMean[i],
+			vecTimeMin[i],
+			vecTimeMax[i],
+			vecImbalance[i]);
+	}
+	fclose(fpCSV);
+
+	std::string strJSONFile = strFile + ".json";
+	FILE * fpJSON = fopen(strJSONFile.c_str(), "w");
+	if (fpJSON == NULL) {
+		_EXCEPTION1("Unable to open profile file \"%s\"",
+			strJSONFile.c_str());
+	}
+
+	fprintf(fpJSON, "{\n  \"processors\": %i,\n  \"metrics\": [\n", nSize);
+	for (int i = 0; i < nMetrics; i++) {
+		fprintf(fpJSON,
+			"    {\"name\": \"%s\", \"mean\": %.17g, \"min\": %.17g, "
+			"\"max\": %.17g}%s\n",
+			m_vecMetricNames[i].c_str(),
+			vecMetricSum[i] / static_cast<double>(nSize),
+			vecMetricMin[i],
+			vecMetricMax[i],
+			(i == nMetrics - 1)?(""):(","));
+	}
+	fprintf(fpJSON, "  ],\n  \"regions\": [\n");
+	for (int i = 0; i < nRegions; i++) {
+		fprintf(fpJSON,
+			"    {\"region\": \"%s\", \"name\": \"%s\", \"depth\": %i, "
+			"\"calls\": %.17g, \"mean\": %.17g, \"min\": %.17g, "
+			"\"max\": %.17g, \"imbalance\": %.17g}%s\n",
+			vecPaths[i].c_str(),
+			vecNames[i].c_str(),
+			vecDepth[i],
+			vecCallsMean[i],
+			vecTimeMean[i],
+			vecTimeMin[i],
+			vecTimeMax[i],
+			vecImbalance[i],
+			(i == nRegions - 1)?(""):(","));
+	}
+	fprintf(fpJSON, "  ]\n}\n");
+	fclose(fpJSON);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+
+void Profiler::ReportCounters(
+	const std::string & strFile,
+	const std::vector<std::string> & vecPaths,
+	const std::vector<double> & vecCounters,
+	const std::vector<int> & vecCounted
+) {
+	// Each cache miss is assumed to transfer one 64 byte cache line from
+	// memory
+	const double dCacheLineBytes = 64.0;
+
+	const int nCounters = HardwareCounters::Counter_Count;
+	const int nRegions = static_cast<int>(vecPaths.size());
+
+	const bool fMisses = vecCounted[HardwareCounters::Counter_CacheMisses];
+	const bool fFloatingPoint =
+		vecCounted[HardwareCounters::Counter_FloatingPoint];
+
+	// Derived quantities
+	std::vector<double> vecIPC(nRegions, 0.0);
+	std::vector<double> vecBytes(nRegions, 0.0);
+	std::vector<double> vecIntensity(nRegions, 0.0);
+
+	for (int i = 0; i < nRegions; i++) {
+		const double * dCounters = &(vecCounters[i * nCounters]);
+
+		if (dCounters[HardwareCounters::Counter_Cycles] > 0.0) {
+			vecIPC[i] =
+				dCounters[HardwareCounters::Counter_Instructions]
+				/ dCounters[HardwareCounters::Counter_Cycles];
+		}
+
+		vecBytes[i] =
+			dCacheLineBytes * dCounters[HardwareCounters::Counter_CacheMisses];
+
+		if (vecBytes[i] > 0.0) {
+			vecIntensity[i] =
+				dCounters[HardwareCounters::Counter_FloatingPoint]
+				/ vecBytes[i];
+		}
+	}
+
+	// Summary table
+	AnnounceStartBlock("Hardware counters");
+	Announce("%-36s %12s %12s %6s %12s %12s %12s %10s",
+		"Region", "Cycles", "Instructions", "IPC",
+		"Misses", "Bytes", "FP Events", "FP/Byte");
+
+	for (int i = 0; i < nRegions; i++) {
+		const double * dCounters = &(vecCounters[i * nCounters]);
+
+		int nDepth = 0;
+		for (int j = 0; j < vecPaths[i].length(); j++) {
+			if (vecPaths[i][j] == '/') {
+				nDepth++;
+			}
+		}
+
+		size_t iSlash = vecPaths[i].rfind('/');
+		std::string strIndentName = std::string(2 * nDepth, ' ')
+			+ ((iSlash == std::string::npos)?
+				(vecPaths[i]):(vecPaths[i].substr(iSlash + 1)));
+
+		char szFloatingPoint[32];
+		char szIntensity[32];
+		if (fFloatingPoint) {
+			snprintf(szFloatingPoint, 32, "%12.4e",
+				dCounters[HardwareCounters::Counter_FloatingPoint]);
+		} else {
+			snprintf(szFloatingPoint, 32, "%12s", "-");
+		}
+		if (fMisses && fFloatingPoint) {
+			snprintf(szIntensity, 32, "%10.3f", vecIntensity[i]);
+		} else {
+			snprintf(szIntensity, 32, "%10s", "-");
+		}
+
+		Announce("%-36s %12.4e %12.4e %6.2f %12.4e %12.4e %s %s",
+			strIndentName.c_str(),
+			dCounters[HardwareCounters::Counter_Cycles],
+			dCounters[HardwareCounters::Counter_Instructions],
+			vecIPC[i],
+			dCounters[HardwareCounters::Counter_CacheMisses],
+			vecBytes[i],
+			szFloatingPoint,
+			szIntensity);
+	}
+	AnnounceEndBlock("Done");
+
+	if (strFile == "") {
+		return;
+	}
+
+	// Machine-readable output; counters which were not counted are empty
+	std::string strCSVFile = strFile + ".counters.csv";
+	FILE * fpCSV = fopen(strCSVFile.c_str(), "w");
+	if (fpCSV == NULL) {
+		_EXCEPTION1("Unable to open profile file \"%s\"",
+			strCSVFile.c_str());
+	}
+
+	fprintf(fpCSV, "region");
+	for (int c = 0; c < nCounters; c++) {
+		fprintf(fpCSV, ",%s", HardwareCounters::GetName(
+			static_cast<HardwareCounters::Counter>(c)));
+	}
+	fprintf(fpCSV, ",ipc,bytes,intensity\n");
+
+	for (int i = 0; i < nRegions; i++) {
+		fprintf(fpCSV, "%s", vecPaths[i].c_str());
+		for (int c = 0; c < nCounters; c++) {
+			if (vecCounted[c]) {
+				fprintf(fpCSV, ",%.17g", vecCounters[i * nCounters + c]);
+			} else {
+				fprintf(fpCSV, ",");
+			}
+		}
+
+		fprintf(fpCSV, ",%.17g", vecIPC[i]);
+
+		if (fMisses) {
+			fprintf(fpCSV, ",%.17g", vecBytes[i]);
+		} else {
+			fprintf(fpCSV, ",");
+		}
+
+		if (fMisses && fFloatingPoint) {
+			fprintf(fpCSV, ",%.17g\n", vecIntensity[i]);
+		} else {
+			fprintf(fpCSV, ",\n");
+		}
+	}
+	fclose(fpCSV);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
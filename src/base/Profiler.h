@@ -0,0 +1,301 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    Profiler.h
+///	\author  Paul Ullrich
+///	\version October 18, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _PROFILER_H_
+#define _PROFILER_H_
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "HardwareCounters.h"
+
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Profiler is a hierarchical timer for named regions of code.  Regions
+///		may be nested, and each distinct path of nested regions is timed
+///		separately.  Timing uses a monotonic clock.  Regions must only be
+///		entered and exited on the main thread.  If HardwareCounters have
+///		been enabled before the first region is entered, the change in each
+///		counter is also accumulated for each region.
+///	</summary>
+class Profiler {
+
+public:
+	///	<summary>
+	///		Timing data for one region.
+	///	</summary>
+	struct Region {
+		///	<summary>
+		///		Constructor.
+		///	</summary>
+		Region(
+			const std::string & strName,
+			int iParent
+		) :
+			strName(strName),
+			iParent(iParent),
+			nCalls(0),
+			dTime(0.0),
+			dStartTime(0.0)
+		{
+			for (int c = 0; c < HardwareCounters::Counter_Count; c++) {
+				dCounters[c] = 0.0;
+			}
+		}
+
+		///	<summary>
+		///		Name of this region.
+		///	</summary>
+		std::string strName;
+
+		///	<summary>
+		///		Index of the enclosing region.
+		///	</summary>
+		int iParent;
+
+		///	<summary>
+		///		Indices of regions nested in this region.
+		///	</summary>
+		std::vector<int> vecChildren;
+
+		///	<summary>
+		///		Number of times this region has been entered.
+		///	</summary>
+		int nCalls;
+
+		///	<summary>
+		///		Total time spent in this region (in seconds).
+		///	</summary>
+		double dTime;
+
+		///	<summary>
+		///		Time at which this region was last entered.
+		///	</summary>
+		double dStartTime;
+
+		///	<summary>
+		///		Total change in each hardware counter in this region.
+		///	</summary>
+		double dCounters[HardwareCounters::Counter_Count];
+
+		///	<summary>
+		///		Hardware counters when this region was last entered.
+		///	</summary>
+		HardwareCounters::Sample sampleStart;
+	};
+
+	///	<summary>
+	///		One completed visit to a region, recorded when tracing.
+	///	</summary>
+	struct TraceEvent {
+		///	<summary>
+		///		Index of the region.
+		///	</summary>
+		int iRegion;
+
+		///	<summary>
+		///		Time at which the region was entered.
+		///	</summary>
+		double dBeginTime;
+
+		///	<summary>
+		///		Time at which the region was exited.
+		///	</summary>
+		double dEndTime;
+	};
+
+public:
+	///	<summary>
+	///		Get the current value of the monotonic clock (in seconds).
+	///	</summary>
+	static double GetTime();
+
+	///	<summary>
+	///		Enter a region nested within the active region.
+	///	</summary>
+	static void Begin(const char * szName);
+
+	///	<summary>
+	///		Exit the active region.
+	///	</summary>
+	static void End();
+
+	///	<summary>
+	///		Remove all timing data.
+	///	</summary>
+	static void Reset();
+
+	///	<summary>
+	///		Set the value of a named metric on this processor, such as a
+	///		problem size.  Metrics are reported with their minimum, mean
+	///		and maximum over all processors, and so must be set with the
+	///		same names on all processors.
+	///	</summary>
+	static void SetMetric(
+		const std::string & strName,
+		double dValue
+	);
+
+	///	<summary>
+	///		Record every visit to a region from now on.  Events are kept in
+	///		a ring buffer of nMaxEvents entries on each processor, so only
+	///		the most recent events are retained.  All processors synchronize
+	///		before the trace clock is started.  This function must be called
+	///		on all processors.
+	///	</summary>
+	static void EnableTrace(
+		int nMaxEvents
+	);
+
+	///	<summary>
+	///		Stop recording events and write the events of all processors to
+	///		strFile in the Chrome trace event format, which can be viewed
+	///		with chrome://tracing or Perfetto.  Each processor is shown as
+	///		one thread of the timeline.  This function must be called on all
+	///		processors.
+	///	</summary>
+	static void WriteTrace(
+		const std::string & strFile
+	);
+
+	///	<summary>
+	///		Aggregate timing data over all processors and output a summary
+	///		table.  If strFile is not empty the aggregated data is also
+	///		written to strFile.json and strFile.csv.  The peak resident
+	///		memory of each processor is included as a metric.  If hardware
+	///		counters are enabled on all processors they are summarized and
+	///		written to strFile.counters.csv.  This function must be called
+	///		on all processors.
+	///	</summary>
+	static void Report(
+		const std::string & strFile = ""
+	);
+
+private:
+	///	<summary>
+	///		Find the child of a region with the given name, or create it if
+	///		it does not exist.
+	///	</summary>
+	static int FindOrCreateChild(
+		int iParent,
+		const char * szName
+	);
+
+	///	<summary>
+	///		Build the list of region paths below the given region in
+	///		depth-first order.
+	///	</summary>
+	static void BuildPathList(
+		int iRegion,
+		const std::string & strPrefix,
+		std::vector<std::string> & vecPaths,
+		std::vector<int> & vecRegions
+	);
+
+	///	<summary>
+	///		Find the region with the given path, or create it if it does
+	///		not exist.
+	///	</summary>
+	static int FindOrCreatePath(
+		const std::string & strPath
+	);
+
+	///	<summary>
+	///		Output a summary table of hardware counters summed over all
+	///		processors, and write them to strFile.counters.csv if strFile
+	///		is not empty.
+	///	</summary>
+	static void ReportCounters(
+		const std::string & strFile,
+		const std::vector<std::string> & vecPaths,
+		const std::vector<double> & vecCounters,
+		const std::vector<int> & vecCounted
+	);
+
+private:
+	///	<summary>
+	///		All regions.  The first region is the root of the hierarchy.
+	///	</summary>
+	static std::vector<Region> m_vecRegions;
+
+	///	<summary>
+	///		Index of the active region.
+	///	</summary>
+	static int m_iActive;
+
+	///	<summary>
+	///		Flag indicating that visits to regions are being recorded.
+	///	</summary>
+	static bool m_fTrace;
+
+	///	<summary>
+	///		Ring buffer of recorded events.
+	///	</summary>
+	static std::vector<TraceEvent> m_vecTraceEvents;
+
+	///	<summary>
+	///		Total number of events recorded, including those which have
+	///		been overwritten.
+	///	</summary>
+	static long long m_nTraceEventCount;
+
+	///	<summary>
+	///		Time at which tracing was enabled.
+	///	</summary>
+	static double m_dTraceOrigin;
+
+	///	<summary>
+	///		Names of all metrics.
+	///	</summary>
+	static std::vector<std::string> m_vecMetricNames;
+
+	///	<summary>
+	///		Values of all metrics on this processor.
+	///	</summary>
+	static std::vector<double> m_vecMetricValues;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A region which is entered on construction and exited when it goes
+///		out of scope.
+///	</summary>
+class ProfilerRegion {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	ProfilerRegion(const char * szName) {
+		Profiler::Begin(szName);
+	}
+
+	///	<summary>
+	///		Destructor.
+	///	</summary>
+	~ProfilerRegion() {
+		Profiler::End();
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
@@ -0,0 +1,132 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    ReproducibleSum.cpp
+///	\author  Paul Ullrich
+///	\version October 18, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "ReproducibleSum.h"
+
+#include <cmath>
+#include <limits>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Mask of the bits held by one bin.
+///	</summary>
+static const int64_t ReproducibleSumBinMask = 0xFFFFFFFFLL;
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ReproducibleSum::Clear(
+	int64_t * iBins
+) {
+	for (int b = 0; b < BinCount; b++) {
+		iBins[b] = 0;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ReproducibleSum::Add(
+	int64_t * iBins,
+	double dValue
+) {
+	if (dValue == 0.0) {
+		return;
+	}
+	if (!std::isfinite(dValue)) {
+		iBins[ValueBins]++;
+		return;
+	}
+
+	// The magnitude is an integer mantissa of at most 53 bits multiplied
+	// by a power of two which is at least 2^-1126 (for subnormals)
+	int iExponent;
+	double dFraction = frexp(fabs(dValue), &iExponent);
+
+	uint64_t uMantissa = static_cast<uint64_t>(ldexp(dFraction, 53));
+
+	int iBit = iExponent - 53 + BinExponentOffset;
+	int iBin = iBit / BinBits;
+	int iShift = iBit % BinBits;
+
+	int64_t iSign = (dValue < 0.0)?(-1):(1);
+
+	// Split the mantissa among at most three bins
+	iBins[iBin] += iSign * static_cast<int64_t>(
+		(uMantissa << iShift) & ReproducibleSumBinMask);
+
+	uMantissa >>= (BinBits - iShift);
+
+	while (uMantissa != 0) {
+		iBin++;
+		iBins[iBin] += iSign * static_cast<int64_t>(
+			uMantissa & ReproducibleSumBinMask);
+		uMantissa >>= BinBits;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ReproducibleSum::Normalize(
+	int64_t * iBins
+) {
+	for (int b = 0; b < ValueBins - 1; b++) {
+		int64_t iLow = iBins[b] & ReproducibleSumBinMask;
+		int64_t iCarry = (iBins[b] - iLow) / (ReproducibleSumBinMask + 1);
+
+		iBins[b] = iLow;
+		iBins[b+1] += iCarry;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+double ReproducibleSum::ToDouble(
+	const int64_t * iBins
+) {
+	if (iBins[ValueBins] != 0) {
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+
+	int64_t iMagnitude[ValueBins];
+	for (int b = 0; b < ValueBins; b++) {
+		iMagnitude[b] = iBins[b];
+	}
+	Normalize(iMagnitude);
+
+	// Only the most significant bin is negative after normalization; work
+	// with the magnitude so that the bins do not cancel when converted
+	double dSign = 1.0;
+	if (iMagnitude[ValueBins-1] < 0) {
+		for (int b = 0; b < ValueBins; b++) {
+			iMagnitude[b] = -iMagnitude[b];
+		}
+		Normalize(iMagnitude);
+		dSign = -1.0;
+	}
+
+	double dValue = 0.0;
+	for (int b = ValueBins - 1; b >= 0; b--) {
+		if (iMagnitude[b] != 0) {
+			dValue += ldexp(static_cast<double>(iMagnitude[b]),
+				b * BinBits - BinExponentOffset);
+		}
+	}
+
+	return (dSign * dValue);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    ReproducibleSum.h
+///	\author  Paul Ullrich
+///	\version October 18, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _REPRODUCIBLESUM_H_
+#define _REPRODUCIBLESUM_H_
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		ReproducibleSum accumulates doubles exactly in fixed point, so that
+///		the result does not depend on the order in which values are added.
+///		An accumulator is an array of BinCount integers: each of the first
+///		ValueBins integers holds 32 bits of the full range of double
+///		precision values, with the remaining bits used for carries, and the
+///		final integer counts values which were not finite.  Accumulators
+///		which have been normalized can be summed elementwise (for instance
+///		with MPI_SUM over MPI_INT64_T) to obtain the exact sum of their
+///		values.
+///	</summary>
+///	<remarks>
+///		At most 2^31 values may be added to an accumulator, or normalized
+///		accumulators summed, between calls to Normalize.
+///	</remarks>
+class ReproducibleSum {
+
+public:
+	///	<summary>
+	///		Number of bits held by each bin.
+	///	</summary>
+	static const int BinBits = 32;
+
+	///	<summary>
+	///		Power of two of the least significant bit of the first bin.
+	///	</summary>
+	static const int BinExponentOffset = 1126;
+
+	///	<summary>
+	///		Number of bins holding the value.
+	///	</summary>
+	static const int ValueBins = 70;
+
+	///	<summary>
+	///		Total number of integers in an accumulator.
+	///	</summary>
+	static const int BinCount = ValueBins + 1;
+
+public:
+	///	<summary>
+	///		Set an accumulator to zero.
+	///	</summary>
+	static void Clear(
+		int64_t * iBins
+	);
+
+	///	<summary>
+	///		Add a value to an accumulator.
+	///	</summary>
+	static void Add(
+		int64_t * iBins,
+		double dValue
+	);
+
+	///	<summary>
+	///		Propagate carries so that every bin except the most significant
+	///		holds a value in [0, 2^32).
+	///	</summary>
+	static void Normalize(
+		int64_t * iBins
+	);
+
+	///	<summary>
+	///		Convert an accumulator to the nearest double.  The result only
+	///		depends on the exact value of the accumulator.  Returns NaN if
+	///		any value which was not finite was added.
+	///	</summary>
+	static double ToDouble(
+		const int64_t * iBins
+	);
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
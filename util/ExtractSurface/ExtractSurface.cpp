@@ -19,8 +19,13 @@
 #include "DataMatrix3D.h"
 #include "CommandLine.h"
 #include "Announce.h"
+#include "OutputWriter.h"
 
 #include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <deque>
+#include <pthread.h>
 #include <netcdfcpp.h>
 
 #include "PolynomialInterp.h"
@@ -309,10 +314,680 @@ void InterpolationWeightsLinear(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+
+///	<summary>
+///		Grid, levels and options shared by all blocks.
+///	</summary>
+struct ExtractParameters {
+
+	///	<summary>
+	///		Number of input levels, latitudes and longitudes.
+	///	</summary>
+	int nLev;
+	int nLat;
+	int nLon;
+
+	///	<summary>
+	///		Number of latitudes in each block.
+	///	</summary>
+	int nLatPerBlock;
+
+	///	<summary>
+	///		Number of blocks in each time slice.
+	///	</summary>
+	int nBlocksPerTime;
+
+	///	<summary>
+	///		Input levels, latitudes and topography.
+	///	</summary>
+	DataVector<double> dLev;
+	DataVector<double> dLat;
+	DataMatrix<double> dZs;
+
+	///	<summary>
+	///		Pressure and height levels to extract.
+	///	</summary>
+	std::vector<double> vecPressureLevels;
+	std::vector<double> vecHeightLevels;
+
+	///	<summary>
+	///		Number of variables to extract.
+	///	</summary>
+	int nVariables;
+
+	///	<summary>
+	///		Output options.
+	///	</summary>
+	bool fExtractSurface;
+	bool fGeopotentialHeight;
+	bool fExtractTotalEnergy;
+
+	///	<summary>
+	///		Physical constants.
+	///	</summary>
+	double dEarthRadius;
+	double dGamma;
+	double dZtop;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Input variables used by each block.
+///	</summary>
+struct ExtractInputVars {
+	std::vector<NcVar *> vecNcVar;
+	NcVar * varP;
+	NcVar * varRho;
+	NcVar * varU;
+	NcVar * varV;
+	NcVar * varW;
+};
+
+///	<summary>
+///		Output variables written by each block.
+///	</summary>
+struct ExtractOutputVars {
+	std::vector<NcVar *> vecOutNcVarS;
+	std::vector<NcVar *> vecOutNcVarP;
+	std::vector<NcVar *> vecOutNcVarZ;
+	NcVar * varOutPHIZ;
+	NcVar * varOutPHIZS;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A block of whole columns, consisting of a band of latitudes at a
+///		single time.  All output of the block is stored in a single packed
+///		array so that it can be sent to the root process in one message;
+///		the last entry holds the contribution of the block to total energy.
+///	</summary>
+class ExtractBlock {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	ExtractBlock(
+		const ExtractParameters & param,
+		int ixBlock,
+		bool fAllocateInput
+	) :
+		m_ixBlock(ixBlock)
+	{
+		m_iTime = ixBlock / param.nBlocksPerTime;
+		m_iLatBegin =
+			(ixBlock % param.nBlocksPerTime) * param.nLatPerBlock;
+
+		m_nLatRows = param.nLatPerBlock;
+		if (m_iLatBegin + m_nLatRows > param.nLat) {
+			m_nLatRows = param.nLat - m_iLatBegin;
+		}
+
+		const int nColumns = m_nLatRows * param.nLon;
+		const int nPressureLevels = param.vecPressureLevels.size();
+		const int nHeightLevels = param.vecHeightLevels.size();
+
+		// Offsets of all output fields in the packed output array
+		int ix = 0;
+
+		m_ixOutS.resize(param.nVariables);
+		m_ixOutP.resize(param.nVariables);
+		m_ixOutZ.resize(param.nVariables);
+
+		for (int v = 0; v < param.nVariables; v++) {
+			m_ixOutS[v] = ix;
+			if (param.fExtractSurface) {
+				ix += nColumns;
+			}
+			m_ixOutP[v] = ix;
+			ix += nPressureLevels * nColumns;
+
+			m_ixOutZ[v] = ix;
+			ix += nHeightLevels * nColumns;
+		}
+
+		m_ixOutPHIZ = ix;
+		if (param.fGeopotentialHeight) {
+			ix += nPressureLevels * nColumns;
+		}
+
+		m_ixOutPHIZS = ix;
+		if (param.fGeopotentialHeight && param.fExtractSurface) {
+			ix += nColumns;
+		}
+
+		m_ixOutEnergy = ix;
+		ix++;
+
+		m_dataOut.Initialize(ix);
+
+		// Input data
+		if (fAllocateInput) {
+			m_vecDataIn.resize(param.nVariables);
+			for (int v = 0; v < param.nVariables; v++) {
+				m_vecDataIn[v].Initialize(
+					param.nLev, m_nLatRows, param.nLon);
+			}
+
+			if ((nPressureLevels > 0) || (param.fExtractTotalEnergy)) {
+				m_dataP.Initialize(param.nLev, m_nLatRows, param.nLon);
+			}
+
+			if (param.fExtractTotalEnergy) {
+				m_dataRho.Initialize(param.nLev, m_nLatRows, param.nLon);
+				m_dataU.Initialize(param.nLev, m_nLatRows, param.nLon);
+				m_dataV.Initialize(param.nLev, m_nLatRows, param.nLon);
+				m_dataW.Initialize(param.nLev, m_nLatRows, param.nLon);
+			}
+		}
+	}
+
+public:
+	///	<summary>
+	///		Read all input data for this block.
+	///	</summary>
+	void Read(
+		const ExtractInputVars & vars
+	) {
+		for (int v = 0; v < m_vecDataIn.size(); v++) {
+			ReadVariable(vars.vecNcVar[v], m_vecDataIn[v]);
+		}
+
+		ReadVariable(vars.varP, m_dataP);
+		ReadVariable(vars.varRho, m_dataRho);
+		ReadVariable(vars.varU, m_dataU);
+		ReadVariable(vars.varV, m_dataV);
+		ReadVariable(vars.varW, m_dataW);
+	}
+
+	///	<summary>
+	///		Interpolate all variables in this block.
+	///	</summary>
+	void Compute(
+		const ExtractParameters & param
+	) {
+		const int nLev = param.nLev;
+		const int nLon = param.nLon;
+		const int nColumns = m_nLatRows * nLon;
+		const int nPressureLevels = param.vecPressureLevels.size();
+		const int nHeightLevels = param.vecHeightLevels.size();
+
+		// Pressure and height in column
+		DataVector<double> dataColumnP;
+		dataColumnP.Initialize(nLev);
+
+		DataVector<double> dataColumnZ;
+		dataColumnZ.Initialize(nLev);
+
+		// Column weights
+		DataVector<double> dW;
+		dW.Initialize(nLev);
+
+		// Weights at the physical surface
+		DataVector<double> dWSurf;
+		dWSurf.Initialize(nLev);
+
+		PolynomialInterp::LagrangianPolynomialCoeffs(
+			3, param.dLev, dWSurf, 0.0);
+
+		// Loop through all columns
+		for (int i = 0; i < m_nLatRows; i++) {
+		for (int j = 0; j < nLon; j++) {
+
+			const int iLat = m_iLatBegin + i;
+			const int ixColumn = i * nLon + j;
+
+			// Store column pressure and height
+			if (nPressureLevels > 0) {
+				for (int k = 0; k < nLev; k++) {
+					dataColumnP[k] = m_dataP[k][i][j];
+				}
+			}
+
+			if ((nHeightLevels > 0) || (param.fGeopotentialHeight)) {
+				for (int k = 0; k < nLev; k++) {
+					dataColumnZ[k] =
+						param.dZs[iLat][j]
+						+ param.dLev[k] * (param.dZtop - param.dZs[iLat][j]);
+				}
+			}
+
+			// Loop through all variables
+			for (int v = 0; v < param.nVariables; v++) {
+				const DataMatrix3D<double> & dataIn = m_vecDataIn[v];
+
+				// At the physical surface
+				if (param.fExtractSurface) {
+					double dValue = 0.0;
+					for (int k = 0; k < 3; k++) {
+						dValue += dWSurf[k] * dataIn[k][i][j];
+					}
+					m_dataOut[m_ixOutS[v] + ixColumn] = dValue;
+				}
+
+				// On pressure surfaces
+				for (int p = 0; p < nPressureLevels; p++) {
+					int kBegin = 0;
+					int kEnd = 0;
+
+					InterpolationWeightsLinear(
+						param.vecPressureLevels[p],
+						dataColumnP,
+						kBegin,
+						kEnd,
+						dW);
+
+					double dValue = 0.0;
+					for (int k = kBegin; k < kEnd; k++) {
+						dValue += dW[k] * dataIn[k][i][j];
+					}
+					m_dataOut[m_ixOutP[v] + p * nColumns + ixColumn] = dValue;
+				}
+
+				// On height surfaces
+				for (int z = 0; z < nHeightLevels; z++) {
+					int kBegin = 0;
+					int kEnd = 0;
+
+					InterpolationWeightsLinear(
+						param.vecHeightLevels[z],
+						dataColumnZ,
+						kBegin,
+						kEnd,
+						dW);
+
+					double dValue = 0.0;
+					for (int k = kBegin; k < kEnd; k++) {
+						dValue += dW[k] * dataIn[k][i][j];
+					}
+					m_dataOut[m_ixOutZ[v] + z * nColumns + ixColumn] = dValue;
+				}
+			}
+
+			// Geopotential height
+			if (param.fGeopotentialHeight) {
+				for (int p = 0; p < nPressureLevels; p++) {
+					int kBegin = 0;
+					int kEnd = 0;
+
+					InterpolationWeightsLinear(
+						param.vecPressureLevels[p],
+						dataColumnP,
+						kBegin,
+						kEnd,
+						dW);
+
+					double dValue = 0.0;
+					for (int k = kBegin; k < kEnd; k++) {
+						dValue += dW[k] * dataColumnZ[k];
+					}
+					m_dataOut[m_ixOutPHIZ + p * nColumns + ixColumn] = dValue;
+				}
+
+				if (param.fExtractSurface) {
+					double dValue = 0.0;
+					for (int k = 0; k < 3; k++) {
+						dValue += dWSurf[k] * dataColumnZ[k];
+					}
+					m_dataOut[m_ixOutPHIZS + ixColumn] = dValue;
+				}
+			}
+		}
+		}
+
+		// Contribution to total energy
+		double dTotalEnergy = 0.0;
+
+		if (param.fExtractTotalEnergy) {
+			double dElementRefArea =
+				param.dEarthRadius * param.dEarthRadius
+				* M_PI / static_cast<double>(param.nLat)
+				* 2.0 * M_PI / static_cast<double>(nLon);
+
+			for (int k = 0; k < nLev; k++) {
+			for (int i = 0; i < m_nLatRows; i++) {
+			for (int j = 0; j < nLon; j++) {
+				const int iLat = m_iLatBegin + i;
+
+				double dKineticEnergy =
+					0.5 * m_dataRho[k][i][j] *
+						( m_dataU[k][i][j] * m_dataU[k][i][j]
+						+ m_dataV[k][i][j] * m_dataV[k][i][j]
+						+ m_dataW[k][i][j] * m_dataW[k][i][j]);
+
+				double dInternalEnergy =
+					m_dataP[k][i][j] / (param.dGamma - 1.0);
+
+				dTotalEnergy +=
+					(dKineticEnergy + dInternalEnergy)
+						* cos(M_PI * param.dLat[iLat] / 180.0)
+						* dElementRefArea
+						* (param.dZtop - param.dZs[iLat][j])
+						/ static_cast<double>(nLev);
+			}
+			}
+			}
+		}
+
+		m_dataOut[m_ixOutEnergy] = dTotalEnergy;
+	}
+
+	///	<summary>
+	///		Free the input data for this block.
+	///	</summary>
+	void FreeInput() {
+		m_vecDataIn.clear();
+		m_dataP.Deinitialize();
+		m_dataRho.Deinitialize();
+		m_dataU.Deinitialize();
+		m_dataV.Deinitialize();
+		m_dataW.Deinitialize();
+	}
+
+	///	<summary>
+	///		Write all output data for this block.
+	///	</summary>
+	void Write(
+		const ExtractParameters & param,
+		const ExtractOutputVars & vars
+	) {
+		const int nLon = param.nLon;
+		const int nPressureLevels = param.vecPressureLevels.size();
+		const int nHeightLevels = param.vecHeightLevels.size();
+
+		for (int v = 0; v < param.nVariables; v++) {
+			if (param.fExtractSurface) {
+				vars.vecOutNcVarS[v]->set_cur(m_iTime, m_iLatBegin, 0);
+				vars.vecOutNcVarS[v]->put(
+					&(m_dataOut[m_ixOutS[v]]), 1, m_nLatRows, nLon);
+			}
+			if (nPressureLevels > 0) {
+				vars.vecOutNcVarP[v]->set_cur(m_iTime, 0, m_iLatBegin, 0);
+				vars.vecOutNcVarP[v]->put(
+					&(m_dataOut[m_ixOutP[v]]),
+					1, nPressureLevels, m_nLatRows, nLon);
+			}
+			if (nHeightLevels > 0) {
+				vars.vecOutNcVarZ[v]->set_cur(m_iTime, 0, m_iLatBegin, 0);
+				vars.vecOutNcVarZ[v]->put(
+					&(m_dataOut[m_ixOutZ[v]]),
+					1, nHeightLevels, m_nLatRows, nLon);
+			}
+		}
+
+		if (param.fGeopotentialHeight) {
+			if (nPressureLevels > 0) {
+				vars.varOutPHIZ->set_cur(m_iTime, 0, m_iLatBegin, 0);
+				vars.varOutPHIZ->put(
+					&(m_dataOut[m_ixOutPHIZ]),
+					1, nPressureLevels, m_nLatRows, nLon);
+			}
+			if (param.fExtractSurface) {
+				vars.varOutPHIZS->set_cur(m_iTime, m_iLatBegin, 0);
+				vars.varOutPHIZS->put(
+					&(m_dataOut[m_ixOutPHIZS]), 1, m_nLatRows, nLon);
+			}
+		}
+	}
+
+protected:
+	///	<summary>
+	///		Read a single variable for this block, if it is needed.
+	///	</summary>
+	void ReadVariable(
+		NcVar * var,
+		DataMatrix3D<double> & data
+	) {
+		if (data.GetRows() == 0) {
+			return;
+		}
+		if (var == NULL) {
+			_EXCEPTIONT("Unable to load variable from file");
+		}
+
+		var->set_cur(m_iTime, 0, m_iLatBegin, 0);
+		var->get(
+			&(data[0][0][0]),
+			1, data.GetRows(), data.GetColumns(), data.GetSubColumns());
+	}
+
+public:
+	///	<summary>
+	///		Global index of this block.
+	///	</summary>
+	int m_ixBlock;
+
+	///	<summary>
+	///		Time index of this block.
+	///	</summary>
+	int m_iTime;
+
+	///	<summary>
+	///		First latitude index and number of latitudes in this block.
+	///	</summary>
+	int m_iLatBegin;
+	int m_nLatRows;
+
+	///	<summary>
+	///		Input data for each variable.
+	///	</summary>
+	std::vector< DataMatrix3D<double> > m_vecDataIn;
+
+	///	<summary>
+	///		Input pressure, density and velocity.
+	///	</summary>
+	DataMatrix3D<double> m_dataP;
+	DataMatrix3D<double> m_dataRho;
+	DataMatrix3D<double> m_dataU;
+	DataMatrix3D<double> m_dataV;
+	DataMatrix3D<double> m_dataW;
+
+	///	<summary>
+	///		Offsets of output fields in the packed output array.
+	///	</summary>
+	std::vector<int> m_ixOutS;
+	std::vector<int> m_ixOutP;
+	std::vector<int> m_ixOutZ;
+	int m_ixOutPHIZ;
+	int m_ixOutPHIZS;
+	int m_ixOutEnergy;
+
+	///	<summary>
+	///		Packed output data.
+	///	</summary>
+	DataVector<double> m_dataOut;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Completion status of a ReadBlockTask, which allows the main thread
+///		to wait for a single read without waiting for queued writes.
+///	</summary>
+class ReadBlockStatus {
+
+public:
+	ReadBlockStatus() :
+		m_fDone(false),
+		m_fSuccess(false)
+	{
+		pthread_mutex_init(&m_mutex, NULL);
+		pthread_cond_init(&m_condDone, NULL);
+	}
+
+	~ReadBlockStatus() {
+		pthread_cond_destroy(&m_condDone);
+		pthread_mutex_destroy(&m_mutex);
+	}
+
+	///	<summary>
+	///		Prepare for a new read.
+	///	</summary>
+	void Reset() {
+		pthread_mutex_lock(&m_mutex);
+		m_fDone = false;
+		m_fSuccess = false;
+		pthread_mutex_unlock(&m_mutex);
+	}
+
+	///	<summary>
+	///		Mark the read as complete.
+	///	</summary>
+	void Complete(bool fSuccess) {
+		pthread_mutex_lock(&m_mutex);
+		m_fDone = true;
+		m_fSuccess = fSuccess;
+		pthread_cond_broadcast(&m_condDone);
+		pthread_mutex_unlock(&m_mutex);
+	}
+
+	///	<summary>
+	///		Wait for the read to complete.  Returns false if it failed.
+	///	</summary>
+	bool Wait() {
+		pthread_mutex_lock(&m_mutex);
+		while (!m_fDone) {
+			pthread_cond_wait(&m_condDone, &m_mutex);
+		}
+		bool fSuccess = m_fSuccess;
+		pthread_mutex_unlock(&m_mutex);
+
+		return fSuccess;
+	}
+
+protected:
+	bool m_fDone;
+	bool m_fSuccess;
+
+	pthread_mutex_t m_mutex;
+	pthread_cond_t m_condDone;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Read the input data of a block on the I/O thread.  Completion is
+///		signalled when the task is destroyed, so that a failed read does
+///		not leave the main thread waiting.
+///	</summary>
+class ReadBlockTask : public OutputWriterTask {
+
+public:
+	ReadBlockTask(
+		ExtractBlock * pBlock,
+		const ExtractInputVars & vars,
+		ReadBlockStatus & status
+	) :
+		m_pBlock(pBlock),
+		m_vars(vars),
+		m_status(status),
+		m_fRead(false)
+	{ }
+
+	virtual ~ReadBlockTask() {
+		m_status.Complete(m_fRead);
+	}
+
+	virtual void Execute() {
+		m_pBlock->Read(m_vars);
+		m_fRead = true;
+	}
+
+protected:
+	ExtractBlock * m_pBlock;
+	const ExtractInputVars & m_vars;
+	ReadBlockStatus & m_status;
+	bool m_fRead;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Write the output data of a block on the I/O thread.  The task takes
+///		ownership of the block.
+///	</summary>
+class WriteBlockTask : public OutputWriterTask {
+
+public:
+	WriteBlockTask(
+		ExtractBlock * pBlock,
+		const ExtractParameters & param,
+		const ExtractOutputVars & vars
+	) :
+		m_pBlock(pBlock),
+		m_param(param),
+		m_vars(vars)
+	{ }
+
+	virtual ~WriteBlockTask() {
+		delete m_pBlock;
+	}
+
+	virtual void Execute() {
+		m_pBlock->Write(m_param, m_vars);
+	}
+
+protected:
+	ExtractBlock * m_pBlock;
+	const ExtractParameters & m_param;
+	const ExtractOutputVars & m_vars;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		On the root process, receive all blocks computed by other processes
+///		up to (but not including) the given block and queue them for output.
+///	</summary>
+void ReceiveBlocks(
+	const ExtractParameters & param,
+	const ExtractOutputVars & vars,
+	int nSize,
+	int ixBlockEnd,
+	int & ixNextBlock,
+	DataVector<double> & dTotalEnergy,
+	OutputWriter & writer
+) {
+	for (; ixNextBlock < ixBlockEnd; ixNextBlock++) {
+		int iOwner = ixNextBlock % nSize;
+		if (iOwner == 0) {
+			continue;
+		}
+
+		ExtractBlock * pBlock = new ExtractBlock(param, ixNextBlock, false);
+
+		MPI_Status status;
+		MPI_Recv(
+			&(pBlock->m_dataOut[0]),
+			pBlock->m_dataOut.GetRows(),
+			MPI_DOUBLE,
+			iOwner,
+			ixNextBlock % 32768,
+			MPI_COMM_WORLD,
+			&status);
+
+		dTotalEnergy[pBlock->m_iTime] +=
+			pBlock->m_dataOut[pBlock->m_ixOutEnergy];
+
+		writer.Submit(new WriteBlockTask(pBlock, param, vars));
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 int main(int argc, char ** argv) {
 
-	// Initialize MPI
-	MPI_Init(&argc, &argv);
+	// Initialize MPI; NetCDF calls are made on a separate I/O thread
+	int iProvided;
+	MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &iProvided);
+
+	if (iProvided < MPI_THREAD_FUNNELED) {
+		fprintf(stderr, "ERROR: MPI library does not provide "
+			"MPI_THREAD_FUNNELED, which is required for the I/O thread\n");
+		MPI_Abort(MPI_COMM_WORLD, 1);
+	}
 
 try {
 
@@ -343,6 +1018,9 @@ try {
 	// Extract total energy
 	bool fExtractTotalEnergy;
 
+	// Memory for the input data of each block (in MB)
+	double dBlockMemory;
+
 	// Parse the command line
 	BeginCommandLine()
 		CommandLineString(strInputFile, "in", "");
@@ -353,12 +1031,20 @@ try {
 		CommandLineString(strPressureLevels, "p", "");
 		CommandLineString(strHeightLevels, "z", "");
 		CommandLineBool(fExtractSurface, "surf");
+		CommandLineDouble(dBlockMemory, "block_mem", 64.0);
 
 		ParseCommandLine(argc, argv);
 	EndCommandLine(argv)
 
 	AnnounceBanner();
 
+	// Determine processor rank and number of processors
+	int nRank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &nRank);
+
+	int nSize;
+	MPI_Comm_size(MPI_COMM_WORLD, &nSize);
+
 	// Check command line arguments
 	if (strInputFile == "") {
 		_EXCEPTIONT("No input file specified");
@@ -369,6 +1055,16 @@ try {
 	if (strVariables == "") {
 		_EXCEPTIONT("No variables specified");
 	}
+	if (dBlockMemory <= 0.0) {
+		_EXCEPTIONT("Block memory must be positive");
+	}
+
+	// Grid and options shared by all blocks
+	ExtractParameters param;
+
+	param.fGeopotentialHeight = fGeopotentialHeight;
+	param.fExtractSurface = fExtractSurface;
+	param.fExtractTotalEnergy = fExtractTotalEnergy;
 
 	// Parse variable string
 	std::vector< std::string > vecVariableStrings;
@@ -380,8 +1076,10 @@ try {
 		_EXCEPTIONT("No variables specified");
 	}
 
+	param.nVariables = vecVariableStrings.size();
+
 	// Parse pressure level string
-	std::vector<double> vecPressureLevels;
+	std::vector<double> & vecPressureLevels = param.vecPressureLevels;
 
 	ParseLevelArray(strPressureLevels, vecPressureLevels);
 
@@ -394,7 +1092,7 @@ try {
 	}
 
 	// Parse height level string
-	std::vector<double> vecHeightLevels;
+	std::vector<double> & vecHeightLevels = param.vecHeightLevels;
 
 	ParseLevelArray(strHeightLevels, vecHeightLevels);
 
@@ -431,7 +1129,7 @@ try {
 	NcVar * varLat = ncdf_in.get_var("lat");
 	int nLat = varLat->get_dim(0)->size();
 
-	DataVector<double> dLat;
+	DataVector<double> & dLat = param.dLat;
 	dLat.Initialize(nLat);
 	varLat->set_cur((long)0);
 	varLat->get(&(dLat[0]), nLat);
@@ -451,7 +1149,7 @@ try {
 	NcVar * varLev = ncdf_in.get_var("lev");
 	int nLev = varLev->get_dim(0)->size();
 
-	DataVector<double> dLev;
+	DataVector<double> & dLev = param.dLev;
 	dLev.Initialize(nLev);
 	varLev->set_cur((long)0);
 	varLev->get(&(dLev[0]), nLev);
@@ -460,89 +1158,28 @@ try {
 	Announce("Topography");
 	NcVar * varZs = ncdf_in.get_var("Zs");
 
-	DataMatrix<double> dZs;
+	DataMatrix<double> & dZs = param.dZs;
 	dZs.Initialize(nLat, nLon);
 	varZs->set_cur((long)0, (long)0);
 	varZs->get(&(dZs[0][0]), nLat, nLon);
 
 	AnnounceEndBlock("Done");
 
-	// Open output file
-	AnnounceStartBlock("Constructing output file");
-
-	NcFile ncdf_out(strOutputFile.c_str(), NcFile::Replace);
-	if (!ncdf_out.is_valid()) {
-		_EXCEPTION1("Unable to open file \"%s\" for writing",
-			strOutputFile.c_str());
-	}
-
-	CopyNcFileAttributes(&ncdf_in, &ncdf_out);
-
-	// Output time array
-	Announce("Time");
-	NcDim * dimOutTime = ncdf_out.add_dim("time");
-	NcVar * varOutTime = ncdf_out.add_var("time", ncDouble, dimOutTime);
-	varOutTime->set_cur((long)0);
-	varOutTime->put(&(dTime[0]), nTime);
-
-	CopyNcVarAttributes(varTime, varOutTime);
-
-	// Output pressure array
-	NcDim * dimOutP = NULL;
-	NcVar * varOutP = NULL;
-	if (nPressureLevels > 0) {
-		Announce("Pressure");
-		dimOutP = ncdf_out.add_dim("p", nPressureLevels);
-		varOutP = ncdf_out.add_var("p", ncDouble, dimOutP);
-		varOutP->set_cur((long)0);
-		varOutP->put(&(vecPressureLevels[0]), nPressureLevels);
-	}
-
-	// Output height array
-	NcDim * dimOutZ = NULL;
-	NcVar * varOutZ = NULL;
-	if (nHeightLevels > 0) {
-		Announce("Height");
-		dimOutZ = ncdf_out.add_dim("z", nHeightLevels);
-		varOutZ = ncdf_out.add_var("z", ncDouble, dimOutZ);
-		varOutZ->set_cur((long)0);
-		varOutZ->put(&(vecHeightLevels[0]), nHeightLevels);
-	}
-
-	// Output latitude and longitude array
-	Announce("Latitude");
-	NcDim * dimOutLat = ncdf_out.add_dim("lat", nLat);
-	NcVar * varOutLat = ncdf_out.add_var("lat", ncDouble, dimOutLat);
-	varOutLat->set_cur((long)0);
-	varOutLat->put(&(dLat[0]), nLat);
-
-	CopyNcVarAttributes(varLat, varOutLat);
-
-	Announce("Longitude");
-	NcDim * dimOutLon = ncdf_out.add_dim("lon", nLon);
-	NcVar * varOutLon = ncdf_out.add_var("lon", ncDouble, dimOutLon);
-	varOutLon->set_cur((long)0);
-	varOutLon->put(&(dLon[0]), nLon);
-
-	CopyNcVarAttributes(varLon, varOutLon);
-
-	// Output topography
-	Announce("Topography");
-	NcVar * varOutZs = ncdf_out.add_var(
-		"Zs", ncDouble, dimOutLat, dimOutLon);
-
-	varOutZs->set_cur((long)0, (long)0);
-	varOutZs->put(&(dZs[0][0]), nLat, nLon);
-
-	AnnounceEndBlock("Done");
-
-	// Done
-	AnnounceEndBlock("Done");
+	param.nLev = nLev;
+	param.nLat = nLat;
+	param.nLon = nLon;
 
 	// Load all variables
 	Announce("Loading variables");
 
-	std::vector<NcVar *> vecNcVar;
+	ExtractInputVars varsIn;
+	varsIn.varP = NULL;
+	varsIn.varRho = NULL;
+	varsIn.varU = NULL;
+	varsIn.varV = NULL;
+	varsIn.varW = NULL;
+
+	std::vector<NcVar *> & vecNcVar = varsIn.vecNcVar;
 	for (int v = 0; v < vecVariableStrings.size(); v++) {
 		vecNcVar.push_back(ncdf_in.get_var(vecVariableStrings[v].c_str()));
 		if (vecNcVar[v] == NULL) {
@@ -551,11 +1188,21 @@ try {
 		}
 	}
 
+	if ((nPressureLevels > 0) || (fExtractTotalEnergy)) {
+		varsIn.varP = ncdf_in.get_var("P");
+	}
+	if (fExtractTotalEnergy) {
+		varsIn.varRho = ncdf_in.get_var("Rho");
+		varsIn.varU = ncdf_in.get_var("U");
+		varsIn.varV = ncdf_in.get_var("V");
+		varsIn.varW = ncdf_in.get_var("W");
+	}
+
 	// Physical constants
 	Announce("Initializing thermodynamic variables");
 
 	NcAtt * attEarthRadius = ncdf_in.get_att("earth_radius");
-	double dEarthRadius = attEarthRadius->as_double(0);
+	param.dEarthRadius = attEarthRadius->as_double(0);
 
 	NcAtt * attRd = ncdf_in.get_att("Rd");
 	double dRd = attRd->as_double(0);
@@ -563,408 +1210,323 @@ try {
 	NcAtt * attCp = ncdf_in.get_att("Cp");
 	double dCp = attCp->as_double(0);
 
-	double dGamma = dCp / (dCp - dRd);
-
-	NcAtt * attP0 = ncdf_in.get_att("P0");
-	double dP0 = attP0->as_double(0);
-
-	double dPressureScaling = dP0 * pow(dRd / dP0, dGamma);
+	param.dGamma = dCp / (dCp - dRd);
 
 	NcAtt * attZtop = ncdf_in.get_att("Ztop");
-	double dZtop = attZtop->as_double(0);
-
-	// Input data
-	DataMatrix3D<double> dataIn;
-	dataIn.Initialize(nLev, nLat, nLon);
-
-	// Output data
-	DataMatrix<double> dataOut;
-	dataOut.Initialize(nLat, nLon);
-
-	// Pressure in column
-	DataVector<double> dataColumnP;
-	dataColumnP.Initialize(nLev);
-
-	// Height in column
-	DataVector<double> dataColumnZ;
-	dataColumnZ.Initialize(nLev);
-
-	// Column weights
-	DataVector<double> dW;
-	dW.Initialize(nLev);
-
-	// Loop through all times, pressure levels and variables
-	AnnounceStartBlock("Interpolating");
+	param.dZtop = attZtop->as_double(0);
 
-	// Add energy variable
-	NcVar * varEnergy;
+	// Divide each time slice into bands of latitudes, so that the input
+	// data for each block fits in the requested amount of memory
+	int nInputFields = param.nVariables;
+	if ((nPressureLevels > 0) || (fExtractTotalEnergy)) {
+		nInputFields++;
+	}
 	if (fExtractTotalEnergy) {
-		varEnergy = ncdf_out.add_var("TE", ncDouble, dimOutTime);
+		nInputFields += 4;
 	}
 
-	// Create output pressure variables
-	std::vector<NcVar *> vecOutNcVarP;
-	if (nPressureLevels > 0) {
-		for (int v = 0; v < vecVariableStrings.size(); v++) {
-			vecOutNcVarP.push_back(
-				ncdf_out.add_var(
-					vecVariableStrings[v].c_str(), ncDouble,
-						dimOutTime, dimOutP, dimOutLat, dimOutLon));
-
-			// Copy attributes
-			CopyNcVarAttributes(vecNcVar[v], vecOutNcVarP[v]);
-		}
-	}
+	double dRowMemory =
+		static_cast<double>(nInputFields)
+		* static_cast<double>(nLev)
+		* static_cast<double>(nLon)
+		* static_cast<double>(sizeof(double));
 
-	// Create output height variables
-	std::vector<NcVar *> vecOutNcVarZ;
-	if (nHeightLevels > 0) {
-		for (int v = 0; v < vecVariableStrings.size(); v++) {
-			std::string strVarName = vecVariableStrings[v];
-			if (nPressureLevels > 0) {
-				strVarName += "z";
-			}
-			vecOutNcVarZ.push_back(
-				ncdf_out.add_var(
-					strVarName.c_str(), ncDouble,
-						dimOutTime, dimOutZ, dimOutLat, dimOutLon));
+	param.nLatPerBlock = static_cast<int>(
+		dBlockMemory * 1048576.0 / dRowMemory);
 
-			// Copy attributes
-			CopyNcVarAttributes(vecNcVar[v], vecOutNcVarZ[v]);
-		}
+	if (param.nLatPerBlock < 1) {
+		param.nLatPerBlock = 1;
 	}
-
-	// Create output surface variable
-	std::vector<NcVar *> vecOutNcVarS;
-	if (fExtractSurface) {
-		for (int v = 0; v < vecVariableStrings.size(); v++) {
-			std::string strVarName = vecVariableStrings[v];
-			strVarName += "S";
-
-			vecOutNcVarS.push_back(
-				ncdf_out.add_var(
-					strVarName.c_str(), ncDouble,
-						dimOutTime, dimOutLat, dimOutLon));
-
-			// Copy attributes
-			CopyNcVarAttributes(vecNcVar[v], vecOutNcVarS[v]);
-		}
+	if (param.nLatPerBlock > nLat) {
+		param.nLatPerBlock = nLat;
 	}
 
-	// Loop over all times
-	for (int t = 0; t < nTime; t++) {
+	param.nBlocksPerTime =
+		(nLat + param.nLatPerBlock - 1) / param.nLatPerBlock;
 
-		char szAnnounce[256];
-		sprintf(szAnnounce, "Time %i", t); 
-		AnnounceStartBlock(szAnnounce);
+	int nBlocks = nTime * param.nBlocksPerTime;
 
-		// Rho
-		DataMatrix3D<double> dataRho;
-		dataRho.Initialize(nLev, nLat, nLon);
+	Announce("Processing %i blocks of %i latitudes on %i processors",
+		nBlocks, param.nLatPerBlock, nSize);
 
-		NcVar * varRho = ncdf_in.get_var("Rho");
-		varRho->set_cur(t, 0, 0, 0);
-		varRho->get(&(dataRho[0][0][0]), 1, nLev, nLat, nLon);
+	// Open output file on root
+	NcFile * pncdf_out = NULL;
 
-		// Pressure
-		DataMatrix3D<double> dataP;
-		dataP.Initialize(nLev, nLat, nLon);
+	ExtractOutputVars varsOut;
+	varsOut.varOutPHIZ = NULL;
+	varsOut.varOutPHIZS = NULL;
 
-		NcVar * varP = ncdf_in.get_var("P");
-		varP->set_cur(t, 0, 0, 0);
-		varP->get(&(dataP[0][0][0]), 1, nLev, nLat, nLon);
-/*
-		// Populate pressure array
-		if (nPressureLevels > 0) {
+	NcVar * varEnergy = NULL;
 
-			// Calculate pointwise pressure
-			for (int k = 0; k < nLev; k++) {
-			for (int i = 0; i < nLat; i++) {
-			for (int j = 0; j < nLon; j++) {
-				dataP[k][i][j] = dPressureScaling
-					* exp(log(dataRho[k][i][j] * dataP[k][i][j]) * dGamma);
-			}
-			}
-			}
-		}
-*/
-		// Height everywhere
-		DataMatrix3D<double> dataZ;
-		dataZ.Initialize(nLev, nLat, nLon);
+	if (nRank == 0) {
+		AnnounceStartBlock("Constructing output file");
 
-		// Populate height array
-		if ((nHeightLevels > 0) || (fGeopotentialHeight)) {
-			for (int k = 0; k < nLev; k++) {
-			for (int i = 0; i < nLat; i++) {
-			for (int j = 0; j < nLon; j++) {
-				dataZ[k][i][j] = dZs[i][j] + dLev[k] * (dZtop - dZs[i][j]);
-			}
-			}
-			}
+		pncdf_out = new NcFile(strOutputFile.c_str(), NcFile::Replace);
+		if (!pncdf_out->is_valid()) {
+			_EXCEPTION1("Unable to open file \"%s\" for writing",
+				strOutputFile.c_str());
 		}
 
-		// Loop through all pressure levels and variables
-		for (int v = 0; v < vecNcVar.size(); v++) {
-
-			Announce(vecVariableStrings[v].c_str());
-
-			// Load in the data array
-			vecNcVar[v]->set_cur(t, 0, 0, 0);
-			vecNcVar[v]->get(&(dataIn[0][0][0]), 1, nLev, nLat, nLon);
-
-			// At the physical surface
-			if (fExtractSurface) {
+		NcFile & ncdf_out = *pncdf_out;
 
-				int kBegin = 0;
-				int kEnd = 3;
+		CopyNcFileAttributes(&ncdf_in, &ncdf_out);
 
-				PolynomialInterp::LagrangianPolynomialCoeffs(
-					3, dLev, dW, 0.0);
+		// Output time array
+		Announce("Time");
+		NcDim * dimOutTime = ncdf_out.add_dim("time");
+		NcVar * varOutTime = ncdf_out.add_var("time", ncDouble, dimOutTime);
+		varOutTime->set_cur((long)0);
+		varOutTime->put(&(dTime[0]), nTime);
 
-				//dW[0] =   dLev[1] / (dLev[1] - dLev[0]);
-				//dW[1] = - dLev[0] / (dLev[1] - dLev[0]);
+		CopyNcVarAttributes(varTime, varOutTime);
 
-				// Loop thorugh all latlon indices
-				for (int i = 0; i < nLat; i++) {
-				for (int j = 0; j < nLon; j++) {
+		// Output pressure array
+		NcDim * dimOutP = NULL;
+		NcVar * varOutP = NULL;
+		if (nPressureLevels > 0) {
+			Announce("Pressure");
+			dimOutP = ncdf_out.add_dim("p", nPressureLevels);
+			varOutP = ncdf_out.add_var("p", ncDouble, dimOutP);
+			varOutP->set_cur((long)0);
+			varOutP->put(&(vecPressureLevels[0]), nPressureLevels);
+		}
 
-					// Interpolate in the vertical
-					dataOut[i][j] = 0.0;
-					for (int k = kBegin; k < kEnd; k++) {
-						dataOut[i][j] += dW[k] * dataIn[k][i][j];
-					}
-				}
-				}
+		// Output height array
+		NcDim * dimOutZ = NULL;
+		NcVar * varOutZ = NULL;
+		if (nHeightLevels > 0) {
+			Announce("Height");
+			dimOutZ = ncdf_out.add_dim("z", nHeightLevels);
+			varOutZ = ncdf_out.add_var("z", ncDouble, dimOutZ);
+			varOutZ->set_cur((long)0);
+			varOutZ->put(&(vecHeightLevels[0]), nHeightLevels);
+		}
 
-				// Write variable
-				vecOutNcVarS[v]->set_cur(t, 0, 0);
-				vecOutNcVarS[v]->put(&(dataOut[0][0]), 1, nLat, nLon);
+		// Output latitude and longitude array
+		Announce("Latitude");
+		NcDim * dimOutLat = ncdf_out.add_dim("lat", nLat);
+		NcVar * varOutLat = ncdf_out.add_var("lat", ncDouble, dimOutLat);
+		varOutLat->set_cur((long)0);
+		varOutLat->put(&(dLat[0]), nLat);
 
-			}
+		CopyNcVarAttributes(varLat, varOutLat);
 
-			// Loop through all pressure levels
-			for (int p = 0; p < nPressureLevels; p++) {
+		Announce("Longitude");
+		NcDim * dimOutLon = ncdf_out.add_dim("lon", nLon);
+		NcVar * varOutLon = ncdf_out.add_var("lon", ncDouble, dimOutLon);
+		varOutLon->set_cur((long)0);
+		varOutLon->put(&(dLon[0]), nLon);
 
-				// Loop thorugh all latlon indices
-				for (int i = 0; i < nLat; i++) {
-				for (int j = 0; j < nLon; j++) {
+		CopyNcVarAttributes(varLon, varOutLon);
 
-					// Store column pressure
-					for (int k = 0; k < nLev; k++) {
-						dataColumnP[k] = dataP[k][i][j];
-					}
+		// Output topography
+		Announce("Topography");
+		NcVar * varOutZs = ncdf_out.add_var(
+			"Zs", ncDouble, dimOutLat, dimOutLon);
 
-					// Find weights
-					int kBegin = 0;
-					int kEnd = 0;
+		varOutZs->set_cur((long)0, (long)0);
+		varOutZs->put(&(dZs[0][0]), nLat, nLon);
 
-					// On a pressure surface
-					InterpolationWeightsLinear(
-						vecPressureLevels[p],
-						dataColumnP,
-						kBegin,
-						kEnd,
-						dW);
+		// Add energy variable
+		if (fExtractTotalEnergy) {
+			varEnergy = ncdf_out.add_var("TE", ncDouble, dimOutTime);
+		}
 
-					// Interpolate in the vertical
-					dataOut[i][j] = 0.0;
-					for (int k = kBegin; k < kEnd; k++) {
-						dataOut[i][j] += dW[k] * dataIn[k][i][j];
-					}
+		// Create output pressure variables
+		if (nPressureLevels > 0) {
+			for (int v = 0; v < vecVariableStrings.size(); v++) {
+				varsOut.vecOutNcVarP.push_back(
+					ncdf_out.add_var(
+						vecVariableStrings[v].c_str(), ncDouble,
+							dimOutTime, dimOutP, dimOutLat, dimOutLon));
+
+				// Copy attributes
+				CopyNcVarAttributes(vecNcVar[v], varsOut.vecOutNcVarP[v]);
+			}
+		}
 
+		// Create output height variables
+		if (nHeightLevels > 0) {
+			for (int v = 0; v < vecVariableStrings.size(); v++) {
+				std::string strVarName = vecVariableStrings[v];
+				if (nPressureLevels > 0) {
+					strVarName += "z";
 				}
-				}
+				varsOut.vecOutNcVarZ.push_back(
+					ncdf_out.add_var(
+						strVarName.c_str(), ncDouble,
+							dimOutTime, dimOutZ, dimOutLat, dimOutLon));
 
-				// Write variable
-				vecOutNcVarP[v]->set_cur(t, p, 0, 0);
-				vecOutNcVarP[v]->put(&(dataOut[0][0]), 1, 1, nLat, nLon);
+				// Copy attributes
+				CopyNcVarAttributes(vecNcVar[v], varsOut.vecOutNcVarZ[v]);
 			}
+		}
 
-			// Loop through all height levels
-			for (int z = 0; z < nHeightLevels; z++) {
-
-				// Loop thorugh all latlon indices
-				for (int i = 0; i < nLat; i++) {
-				for (int j = 0; j < nLon; j++) {
-
-					// Store column height
-					for (int k = 0; k < nLev; k++) {
-						dataColumnZ[k] = dataZ[k][i][j];
-					}
-
-					// Find weights
-					int kBegin = 0;
-					int kEnd = 0;
-
-					// On a pressure surface
-					InterpolationWeightsLinear(
-						vecHeightLevels[z],
-						dataColumnZ,
-						kBegin,
-						kEnd,
-						dW);
+		// Create output surface variable
+		if (fExtractSurface) {
+			for (int v = 0; v < vecVariableStrings.size(); v++) {
+				std::string strVarName = vecVariableStrings[v];
+				strVarName += "S";
 
-					// Interpolate in the vertical
-					dataOut[i][j] = 0.0;
-					for (int k = kBegin; k < kEnd; k++) {
-						dataOut[i][j] += dW[k] * dataIn[k][i][j];
-					}
-				}
-				}
+				varsOut.vecOutNcVarS.push_back(
+					ncdf_out.add_var(
+						strVarName.c_str(), ncDouble,
+							dimOutTime, dimOutLat, dimOutLon));
 
-				// Write variable
-				vecOutNcVarZ[v]->set_cur(t, z, 0, 0);
-				vecOutNcVarZ[v]->put(&(dataOut[0][0]), 1, 1, nLat, nLon);
+				// Copy attributes
+				CopyNcVarAttributes(vecNcVar[v], varsOut.vecOutNcVarS[v]);
 			}
 		}
 
-		// Output geopotential height
+		// Create geopotential height variables
 		if (fGeopotentialHeight) {
-
-			Announce("Geopotential height");
-
-			// Output variables
-			NcVar * varOutZ;
-			NcVar * varOutZs;
-
 			if (nPressureLevels > 0) {
-				varOutZ = ncdf_out.add_var(
-					"PHIZ", ncDouble, dimOutTime, dimOutP, dimOutLat, dimOutLon);
+				varsOut.varOutPHIZ = ncdf_out.add_var(
+					"PHIZ", ncDouble,
+						dimOutTime, dimOutP, dimOutLat, dimOutLon);
 			}
 			if (fExtractSurface) {
-				varOutZs = ncdf_out.add_var(
+				varsOut.varOutPHIZS = ncdf_out.add_var(
 					"PHIZS", ncDouble, dimOutTime, dimOutLat, dimOutLon);
 			}
+		}
 
-			// Interpolate onto pressure levels
-			for (int p = 0; p < nPressureLevels; p++) {
-
-				// Loop thorugh all latlon indices
-				for (int i = 0; i < nLat; i++) {
-				for (int j = 0; j < nLon; j++) {
-
-					int kBegin = 0;
-					int kEnd = 0;
-
-					for (int k = 0; k < nLev; k++) {
-						dataColumnP[k] = dataP[k][i][j];
-					}
-
-					InterpolationWeightsLinear(
-						vecPressureLevels[p],
-						dataColumnP,
-						kBegin,
-						kEnd,
-						dW);
-
-					// Interpolate in the vertical
-					dataOut[i][j] = 0.0;
-					for (int k = kBegin; k < kEnd; k++) {
-						dataOut[i][j] += dW[k] * dataZ[k][i][j];
-					}
-				}
-				}
-
-				// Write variable
-				varOutZ->set_cur(t, p, 0, 0);
-				varOutZ->put(&(dataOut[0][0]), 1, 1, nLat, nLon);
+		AnnounceEndBlock("Done");
+	}
 
-			}
+	// Total energy at each time (only accumulated on root)
+	DataVector<double> dTotalEnergy;
+	dTotalEnergy.Initialize(nTime);
 
-			// Interpolate onto the physical surface
-			if (fExtractSurface) {
+	// Blocks are assigned to processors cyclically.  All NetCDF calls are
+	// made on the I/O thread, which reads the next block while the current
+	// block is computed; on root it also writes completed blocks.
+	AnnounceStartBlock("Interpolating");
 
-				int kBegin = 0;
-				int kEnd = 3;
+	std::vector<int> vecLocalBlocks;
+	for (int b = nRank; b < nBlocks; b += nSize) {
+		vecLocalBlocks.push_back(b);
+	}
 
-				PolynomialInterp::LagrangianPolynomialCoeffs(
-					3, dLev, dW, 0.0);
+	{
+		// Status of the read of the next block; this must outlive the
+		// writer, whose pending tasks refer to it
+		ReadBlockStatus statusRead;
 
-				// Loop thorugh all latlon indices
-				for (int i = 0; i < nLat; i++) {
-				for (int j = 0; j < nLon; j++) {
+		OutputWriter writer;
+		writer.Start(4);
 
-					// Interpolate in the vertical
-					dataOut[i][j] = 0.0;
-					for (int k = kBegin; k < kEnd; k++) {
-						dataOut[i][j] += dW[k] * dataZ[k][i][j];
-					}
-				}
-				}
+		// Index of the next block to be written by root
+		int ixNextBlock = 0;
 
-				// Write variable
-				varOutZs->set_cur(t, 0, 0);
-				varOutZs->put(&(dataOut[0][0]), 1, nLat, nLon);
+		// Blocks sent to root that have not yet completed
+		std::deque<ExtractBlock *> queueSendBlocks;
+		std::deque<MPI_Request> queueSendRequests;
 
-			}
+		// Start reading the first block
+		ExtractBlock * pNextBlock = NULL;
+		if (vecLocalBlocks.size() != 0) {
+			pNextBlock = new ExtractBlock(param, vecLocalBlocks[0], true);
+			writer.Submit(new ReadBlockTask(pNextBlock, varsIn, statusRead));
 		}
 
-		// Extract total energy
-		if (fExtractTotalEnergy) {
-			Announce("Total Energy");
-
-			// Zonal velocity
-			DataMatrix3D<double> dataU;
-			dataU.Initialize(nLev, nLat, nLon);
-
-			NcVar * varU = ncdf_in.get_var("U");
-			varU->set_cur(t, 0, 0, 0);
-			varU->get(&(dataU[0][0][0]), 1, nLev, nLat, nLon);
-
-			// Meridional velocity
-			DataMatrix3D<double> dataV;
-			dataV.Initialize(nLev, nLat, nLon);
+		for (int n = 0; n < vecLocalBlocks.size(); n++) {
 
-			NcVar * varV = ncdf_in.get_var("V");
-			varV->set_cur(t, 0, 0, 0);
-			varV->get(&(dataV[0][0][0]), 1, nLev, nLat, nLon);
-
-			// Vertical velocity
-			DataMatrix3D<double> dataW;
-			dataW.Initialize(nLev, nLat, nLon);
-
-			NcVar * varW = ncdf_in.get_var("W");
-			varW->set_cur(t, 0, 0, 0);
-			varW->get(&(dataW[0][0][0]), 1, nLev, nLat, nLon);
-
-			// Calculate total energy
-			double dTotalEnergy = 0.0;
-
-			double dElementRefArea =
-				dEarthRadius * dEarthRadius
-				* M_PI / static_cast<double>(nLat)
-				* 2.0 * M_PI / static_cast<double>(nLon);
+			// Wait for this block to be read; writes queued ahead of the
+			// read have completed, but later writes continue while this
+			// block is computed
+			if (!statusRead.Wait()) {
+				writer.Flush();
+				_EXCEPTIONT("Unable to read input block");
+			}
 
-			for (int k = 0; k < nLev; k++) {
-			for (int i = 0; i < nLat; i++) {
-			for (int j = 0; j < nLon; j++) {
-				double dKineticEnergy =
-					0.5 * dataRho[k][i][j] *
-						( dataU[k][i][j] * dataU[k][i][j]
-						+ dataV[k][i][j] * dataV[k][i][j]
-						+ dataW[k][i][j] * dataW[k][i][j]);
+			ExtractBlock * pBlock = pNextBlock;
 
-				double dInternalEnergy =
-					dataP[k][i][j] / (dGamma - 1.0);
+			// Start reading the next block
+			if (n + 1 < vecLocalBlocks.size()) {
+				pNextBlock =
+					new ExtractBlock(param, vecLocalBlocks[n+1], true);
 
-				dTotalEnergy +=
-					(dKineticEnergy + dInternalEnergy)
-						* cos(M_PI * dLat[i] / 180.0) * dElementRefArea
-						* (dZtop - dZs[i][j]) / static_cast<double>(nLev);
+				statusRead.Reset();
+				writer.Submit(
+					new ReadBlockTask(pNextBlock, varsIn, statusRead));
 			}
+
+			// Interpolate
+			if (nRank == 0) {
+				Announce("Time %i, latitudes %i-%i",
+					pBlock->m_iTime,
+					pBlock->m_iLatBegin,
+					pBlock->m_iLatBegin + pBlock->m_nLatRows - 1);
 			}
+
+			pBlock->Compute(param);
+			pBlock->FreeInput();
+
+			// Write the block from root
+			if (nRank == 0) {
+				ReceiveBlocks(
+					param, varsOut, nSize, pBlock->m_ixBlock,
+					ixNextBlock, dTotalEnergy, writer);
+
+				dTotalEnergy[pBlock->m_iTime] +=
+					pBlock->m_dataOut[pBlock->m_ixOutEnergy];
+
+				writer.Submit(new WriteBlockTask(pBlock, param, varsOut));
+				ixNextBlock = pBlock->m_ixBlock + 1;
+
+			// Send the block to root
+			} else {
+				MPI_Request request;
+				MPI_Isend(
+					&(pBlock->m_dataOut[0]),
+					pBlock->m_dataOut.GetRows(),
+					MPI_DOUBLE,
+					0,
+					pBlock->m_ixBlock % 32768,
+					MPI_COMM_WORLD,
+					&request);
+
+				queueSendBlocks.push_back(pBlock);
+				queueSendRequests.push_back(request);
+
+				if (queueSendBlocks.size() > 2) {
+					MPI_Wait(&(queueSendRequests.front()), MPI_STATUS_IGNORE);
+					delete queueSendBlocks.front();
+					queueSendBlocks.pop_front();
+					queueSendRequests.pop_front();
+				}
 			}
+		}
 
-			// Put total energy into file
-			varEnergy->set_cur(t);
-			varEnergy->put(&dTotalEnergy, 1);
+		// Receive all remaining blocks on root
+		if (nRank == 0) {
+			ReceiveBlocks(
+				param, varsOut, nSize, nBlocks,
+				ixNextBlock, dTotalEnergy, writer);
 		}
 
-		AnnounceEndBlock("Done");
+		// Complete all sends
+		while (queueSendBlocks.size() != 0) {
+			MPI_Wait(&(queueSendRequests.front()), MPI_STATUS_IGNORE);
+			delete queueSendBlocks.front();
+			queueSendBlocks.pop_front();
+			queueSendRequests.pop_front();
+		}
+
+		writer.Flush();
+	}
+
+	// Put total energy into file
+	if ((nRank == 0) && (fExtractTotalEnergy)) {
+		varEnergy->set_cur((long)0);
+		varEnergy->put(&(dTotalEnergy[0]), nTime);
 	}
 
 	AnnounceEndBlock("Done");
 
+	delete pncdf_out;
+
 } catch(Exception & e) {
 	Announce(e.ToString().c_str());
 }
@@ -148,9 +148,332 @@ void ParseVariableList(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Number of eddy statistics.
+///	</summary>
+static const int EddyStatisticsCount = 5;
+
+///	<summary>
+///		Names of the eddy statistics.
+///	</summary>
+static const char * EddyStatisticsNames[EddyStatisticsCount] =
+	{ "UU", "UV", "VV", "VT", "TT" };
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Running zonal and temporal sums of a set of variables on (lev, lat).
+///		All samples are taken relative to a fixed shift (the zonal mean of
+///		the first sample) to avoid cancellation in the eddy statistics.
+///		Since the eddy statistics are accumulated as products of shifted
+///		samples they only require a single pass through the data, and sums
+///		from different processors or different runs can simply be added.
+///	</summary>
+class ZonalTemporalAccumulator {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	ZonalTemporalAccumulator() :
+		m_nLon(0),
+		m_dSamples(0.0),
+		m_ixU(-1),
+		m_ixV(-1),
+		m_ixT(-1)
+	{ }
+
+public:
+	///	<summary>
+	///		Allocate the running sums.
+	///	</summary>
+	void Initialize(
+		int nVariables,
+		int nLev,
+		int nLat,
+		int nLon,
+		bool fEddyStatistics
+	) {
+		m_nLon = nLon;
+		m_dSamples = 0.0;
+
+		m_dataShift.Initialize(nVariables, nLev, nLat);
+		m_dataSum.Initialize(nVariables, nLev, nLat);
+
+		if (fEddyStatistics) {
+			m_dataEddySum.Initialize(EddyStatisticsCount, nLev, nLat);
+		}
+	}
+
+	///	<summary>
+	///		Set the indices of U, V and T for eddy statistics.
+	///	</summary>
+	void SetEddyVariables(
+		int ixU,
+		int ixV,
+		int ixT
+	) {
+		m_ixU = ixU;
+		m_ixV = ixV;
+		m_ixT = ixT;
+	}
+
+	///	<summary>
+	///		Determine if eddy statistics are accumulated.
+	///	</summary>
+	bool HasEddyStatistics() const {
+		return (m_dataEddySum.GetRows() != 0);
+	}
+
+	///	<summary>
+	///		Set the shift to the zonal mean of the given time slice.
+	///	</summary>
+	void SetShift(
+		const std::vector< DataMatrix3D<double> > & vecSlice
+	) {
+		for (int v = 0; v < m_dataShift.GetRows(); v++) {
+		for (int k = 0; k < m_dataShift.GetColumns(); k++) {
+		for (int i = 0; i < m_dataShift.GetSubColumns(); i++) {
+			double dSum = 0.0;
+			for (int j = 0; j < m_nLon; j++) {
+				dSum += vecSlice[v][k][i][j];
+			}
+			m_dataShift[v][k][i] = dSum / static_cast<double>(m_nLon);
+		}
+		}
+		}
+	}
+
+	///	<summary>
+	///		Add a time slice to the running sums.
+	///	</summary>
+	void AddSlice(
+		const std::vector< DataMatrix3D<double> > & vecSlice
+	) {
+		const int nVariables = m_dataSum.GetRows();
+		const int nLev = m_dataSum.GetColumns();
+		const int nLat = m_dataSum.GetSubColumns();
+
+		for (int v = 0; v < nVariables; v++) {
+		for (int k = 0; k < nLev; k++) {
+		for (int i = 0; i < nLat; i++) {
+			const double dShift = m_dataShift[v][k][i];
+
+			double dSum = 0.0;
+			for (int j = 0; j < m_nLon; j++) {
+				dSum += vecSlice[v][k][i][j] - dShift;
+			}
+			m_dataSum[v][k][i] += dSum;
+		}
+		}
+		}
+
+		if (HasEddyStatistics()) {
+			for (int k = 0; k < nLev; k++) {
+			for (int i = 0; i < nLat; i++) {
+				const double dShiftU = m_dataShift[m_ixU][k][i];
+				const double dShiftV = m_dataShift[m_ixV][k][i];
+				const double dShiftT = m_dataShift[m_ixT][k][i];
+
+				for (int j = 0; j < m_nLon; j++) {
+					double dU = vecSlice[m_ixU][k][i][j] - dShiftU;
+					double dV = vecSlice[m_ixV][k][i][j] - dShiftV;
+					double dT = vecSlice[m_ixT][k][i][j] - dShiftT;
+
+					m_dataEddySum[0][k][i] += dU * dU;
+					m_dataEddySum[1][k][i] += dU * dV;
+					m_dataEddySum[2][k][i] += dV * dV;
+					m_dataEddySum[3][k][i] += dV * dT;
+					m_dataEddySum[4][k][i] += dT * dT;
+				}
+			}
+			}
+		}
+
+		m_dSamples += 1.0;
+	}
+
+	///	<summary>
+	///		Add the running sums of another accumulator with the same shift.
+	///	</summary>
+	void Add(
+		const ZonalTemporalAccumulator & acc
+	) {
+		AddArray(acc.m_dataSum, m_dataSum);
+		AddArray(acc.m_dataEddySum, m_dataEddySum);
+
+		m_dSamples += acc.m_dSamples;
+	}
+
+	///	<summary>
+	///		Sum the running sums over all processors onto root.
+	///	</summary>
+	void Reduce() {
+		int nRank;
+		MPI_Comm_rank(MPI_COMM_WORLD, &nRank);
+
+		ReduceArray(nRank, m_dataSum);
+		ReduceArray(nRank, m_dataEddySum);
+
+		double dSamples = 0.0;
+		MPI_Reduce(
+			&m_dSamples, &dSamples, 1,
+			MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+
+		m_dSamples = dSamples;
+	}
+
+	///	<summary>
+	///		Broadcast the shift from root.
+	///	</summary>
+	void BroadcastShift() {
+		MPI_Bcast(
+			&(m_dataShift[0][0][0]),
+			m_dataShift.GetTotalElements(),
+			MPI_DOUBLE,
+			0,
+			MPI_COMM_WORLD);
+	}
+
+	///	<summary>
+	///		Get the zonal and temporal mean of a variable.
+	///	</summary>
+	void GetMean(
+		int v,
+		DataMatrix<double> & dataMean
+	) const {
+		const double dCount = m_dSamples * static_cast<double>(m_nLon);
+
+		dataMean.Initialize(m_dataSum.GetColumns(), m_dataSum.GetSubColumns());
+
+		for (int k = 0; k < m_dataSum.GetColumns(); k++) {
+		for (int i = 0; i < m_dataSum.GetSubColumns(); i++) {
+			dataMean[k][i] = m_dataShift[v][k][i] + m_dataSum[v][k][i] / dCount;
+		}
+		}
+	}
+
+	///	<summary>
+	///		Get an eddy statistic, the zonal and temporal mean of the product
+	///		of deviations from the zonal and temporal means.
+	///	</summary>
+	void GetEddyStatistic(
+		int e,
+		DataMatrix<double> & dataEddy
+	) const {
+		static const int EddyFirst[EddyStatisticsCount] = { 0, 0, 1, 1, 2 };
+		static const int EddySecond[EddyStatisticsCount] = { 0, 1, 1, 2, 2 };
+
+		const int ixVar[3] = { m_ixU, m_ixV, m_ixT };
+
+		const int ixFirst = ixVar[EddyFirst[e]];
+		const int ixSecond = ixVar[EddySecond[e]];
+
+		const double dCount = m_dSamples * static_cast<double>(m_nLon);
+
+		dataEddy.Initialize(
+			m_dataSum.GetColumns(), m_dataSum.GetSubColumns());
+
+		for (int k = 0; k < m_dataSum.GetColumns(); k++) {
+		for (int i = 0; i < m_dataSum.GetSubColumns(); i++) {
+			dataEddy[k][i] =
+				m_dataEddySum[e][k][i] / dCount
+				- (m_dataSum[ixFirst][k][i] / dCount)
+				* (m_dataSum[ixSecond][k][i] / dCount);
+		}
+		}
+	}
+
+protected:
+	///	<summary>
+	///		Add one array of sums to another.
+	///	</summary>
+	static void AddArray(
+		const DataMatrix3D<double> & dataIn,
+		DataMatrix3D<double> & dataOut
+	) {
+		for (int v = 0; v < dataOut.GetRows(); v++) {
+		for (int k = 0; k < dataOut.GetColumns(); k++) {
+		for (int i = 0; i < dataOut.GetSubColumns(); i++) {
+			dataOut[v][k][i] += dataIn[v][k][i];
+		}
+		}
+		}
+	}
+
+	///	<summary>
+	///		Sum an array over all processors onto root.
+	///	</summary>
+	static void ReduceArray(
+		int nRank,
+		DataMatrix3D<double> & data
+	) {
+		if (data.GetRows() == 0) {
+			return;
+		}
+
+		DataMatrix3D<double> dataReduced;
+		if (nRank == 0) {
+			dataReduced.Initialize(
+				data.GetRows(), data.GetColumns(), data.GetSubColumns());
+		}
+
+		MPI_Reduce(
+			&(data[0][0][0]),
+			(nRank == 0)?(&(dataReduced[0][0][0])):(NULL),
+			data.GetTotalElements(),
+			MPI_DOUBLE,
+			MPI_SUM,
+			0,
+			MPI_COMM_WORLD);
+
+		if (nRank == 0) {
+			memcpy(
+				&(data[0][0][0]),
+				&(dataReduced[0][0][0]),
+				data.GetTotalElements() * sizeof(double));
+		}
+	}
+
+public:
+	///	<summary>
+	///		Number of longitudes in each sample.
+	///	</summary>
+	int m_nLon;
+
+	///	<summary>
+	///		Number of time slices added.
+	///	</summary>
+	double m_dSamples;
+
+	///	<summary>
+	///		Indices of U, V and T among the variables.
+	///	</summary>
+	int m_ixU;
+	int m_ixV;
+	int m_ixT;
+
+	///	<summary>
+	///		Shift applied to all samples of each variable.
+	///	</summary>
+	DataMatrix3D<double> m_dataShift;
+
+	///	<summary>
+	///		Sum of shifted samples of each variable.
+	///	</summary>
+	DataMatrix3D<double> m_dataSum;
+
+	///	<summary>
+	///		Sum of products of shifted samples for each eddy statistic.
+	///	</summary>
+	DataMatrix3D<double> m_dataEddySum;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 void SetupArraysFromFile(
 	const std::string & strSourceFile,
-	const std::vector<std::string> & vecVariableStrings, 
+	const std::vector<std::string> & vecVariableStrings,
 	NcFile & ncdf_out,
 	std::vector<NcVar *> & vecOutputVars,
 	NcDim ** pDimOutLev,
@@ -174,19 +497,15 @@ void SetupArraysFromFile(
 	// Dimension names
 	NcDim * dimLev = varIn->get_dim(1);
 	NcDim * dimLat = varIn->get_dim(2);
-	NcDim * dimLon = varIn->get_dim(3);
 
 	NcToken szDimLevName = dimLev->name();
 	NcToken szDimLatName = dimLat->name();
-	NcToken szDimLonName = dimLon->name();
 
 	int nLev = dimLev->size();
 	int nLat = dimLat->size();
-	int nLon = dimLon->size();
 
 	NcVar * varLev = ncdf_in.get_var(szDimLevName);
 	NcVar * varLat = ncdf_in.get_var(szDimLatName);
-	NcVar * varLon = ncdf_in.get_var(szDimLonName);
 
 	// Load level array
 	DataVector<double> dLev;
@@ -200,12 +519,6 @@ void SetupArraysFromFile(
 	varLat->set_cur((long)0);
 	varLat->get(&(dLat[0]), nLat);
 
-	// Load longitude array
-	DataVector<double> dLon;
-	dLon.Initialize(nLon);
-	varLon->set_cur((long)0);
-	varLon->get(&(dLon[0]), nLon);
-
 	// Add level array
 	NcDim * dimOutLev = ncdf_out.add_dim(szDimLevName, nLev);
 	NcVar * varOutLev = ncdf_out.add_var(szDimLevName, ncDouble, dimOutLev);
@@ -222,13 +535,6 @@ void SetupArraysFromFile(
 	(*pDimOutLev) = dimOutLev;
 	(*pDimOutLat) = dimOutLat;
 
-/*
-	// Add longitude array
-	NcDim * dimOutLon = ncdf_out.add_dim(szDimLonName, nLon);
-	NcVar * varOutLon = ncdf_out.add_var(szDimLonName, ncDouble, dimOutLon);
-	varOutLon->set_cur((long)0);
-	varOutLon->put(&(dLon[0]), nLon);
-*/
 	// Add variable array
 	for (int v = 0; v < vecVariableStrings.size(); v++) {
 		NcVar * varIn =
@@ -251,329 +557,186 @@ void SetupArraysFromFile(
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void AddToAverage(
-	const DataMatrix3D<double> & dataIn,
-	DataMatrix3D<double> & dataRunningAvg
-) {
-	for (int k = 0; k < dataIn.GetRows(); k++) {
-	for (int i = 0; i < dataIn.GetColumns(); i++) {
-	for (int j = 0; j < dataIn.GetSubColumns(); j++) {
-		dataRunningAvg[k][i][j] += dataIn[k][i][j];
-	}
-	}
-	}
-}
-
-///////////////////////////////////////////////////////////////////////////////
-
-void TimeAverage(
-	const std::vector<std::string> & strFileList,
+void LoadRunningAverage(
+	const std::string & strRunningFile,
 	const std::vector<std::string> & vecVariableStrings,
-	std::vector< DataMatrix3D<double> > & vecDataAverage
+	bool fEddyStatistics,
+	ZonalTemporalAccumulator & acc,
+	std::vector<std::string> & vecSourceFiles
 ) {
-	AnnounceStartBlock("Temporal Average");
+	AnnounceStartBlock("Loading running average");
 
-	// Check input parameters
-	if (vecVariableStrings.size() != vecDataAverage.size()) {
-		_EXCEPTIONT("Array size mismatch");
-	}
-	if (vecDataAverage.size() == 0) {
-		_EXCEPTIONT("Zero size DataAverage array received");
+	NcFile ncdf_run(strRunningFile.c_str(), NcFile::ReadOnly);
+	if (!ncdf_run.is_valid()) {
+		_EXCEPTION1("Unable to open file \"%s\" for reading",
+			strRunningFile.c_str());
 	}
 
-	// Total time 
-	int nTotalTime = 0;
+	// Number of samples and longitudes
+	NcAtt * attSamples = ncdf_run.get_att("samples");
+	NcAtt * attLon = ncdf_run.get_att("lon_points");
+	if ((attSamples == NULL) || (attLon == NULL)) {
+		_EXCEPTION1("File \"%s\" does not contain a running average",
+			strRunningFile.c_str());
+	}
 
-	// Reference number of elements
-	int nRefLev;
-	int nRefLat;
-	int nRefLon;
+	// Dimensions
+	NcVar * varSum0 =
+		ncdf_run.get_var((vecVariableStrings[0] + "_sum").c_str());
+	if (varSum0 == NULL) {
+		_EXCEPTION1("Running average does not contain variable \"%s\"",
+			vecVariableStrings[0].c_str());
+	}
 
-	// Temporary data storage for input data
-	DataMatrix3D<double> dataInput;
+	int nLev = varSum0->get_dim(0)->size();
+	int nLat = varSum0->get_dim(1)->size();
 
-	// Loop through all files
-	for (int f = 0; f < strFileList.size(); f++) {
+	acc.Initialize(
+		vecVariableStrings.size(),
+		nLev,
+		nLat,
+		static_cast<int>(attLon->as_double(0)),
+		fEddyStatistics);
 
-		// Announce file
-		Announce("%s", strFileList[f].c_str());
+	acc.m_dSamples = attSamples->as_double(0);
 
-		// Open the file
-		NcFile ncdf_in(strFileList[f].c_str(), NcFile::ReadOnly);
-		if (!ncdf_in.is_valid()) {
-			_EXCEPTION1("Unable to open file \"%s\" for reading",
-				strFileList[f].c_str());
+	// Shifts and sums
+	for (int v = 0; v < vecVariableStrings.size(); v++) {
+		NcVar * varShift =
+			ncdf_run.get_var((vecVariableStrings[v] + "_shift").c_str());
+		NcVar * varSum =
+			ncdf_run.get_var((vecVariableStrings[v] + "_sum").c_str());
+
+		if ((varShift == NULL) || (varSum == NULL)) {
+			_EXCEPTION1("Running average does not contain variable \"%s\"",
+				vecVariableStrings[v].c_str());
 		}
 
-		// Get the time dimension
-		NcDim * dimTime = ncdf_in.get_dim("time");
-		int nTime = dimTime->size();
-
-		// Loop through all times
-		for (int t = 0; t < nTime; t++) {
-
-			// Loop through all variables
-			for (int v = 0; v < vecVariableStrings.size(); v++) {
+		varShift->set_cur((long)0, (long)0);
+		varShift->get(&(acc.m_dataShift[v][0][0]), nLev, nLat);
 
-				NcVar * varIn =
-					ncdf_in.get_var(vecVariableStrings[v].c_str());
-
-				// Load level array
-				NcDim * dimLev = varIn->get_dim(1);
-				int nLev = dimLev->size();
-
-				// Load latitude array
-				NcDim * dimLat = varIn->get_dim(2);
-				int nLat = dimLat->size();
-
-				// Load longitude array
-				NcDim * dimLon = varIn->get_dim(3);
-				int nLon = dimLon->size();
+		varSum->set_cur((long)0, (long)0);
+		varSum->get(&(acc.m_dataSum[v][0][0]), nLev, nLat);
+	}
 
-				// Allocate space for data
-				if ((f == 0) && (t == 0) && (v == 0)) {
+	for (int e = 0; e < acc.m_dataEddySum.GetRows(); e++) {
+		std::string strName = std::string(EddyStatisticsNames[e]) + "_sum";
 
-					// Store reference sizes
-					nRefLev = nLev;
-					nRefLat = nLat;
-					nRefLon = nLon;
+		NcVar * varSum = ncdf_run.get_var(strName.c_str());
+		if (varSum == NULL) {
+			_EXCEPTIONT("Running average does not contain eddy statistics");
+		}
 
-					dataInput.Initialize(nRefLev, nRefLat, nRefLon);
+		varSum->set_cur((long)0, (long)0);
+		varSum->get(&(acc.m_dataEddySum[e][0][0]), nLev, nLat);
+	}
 
-					for (int w = 0; w < vecDataAverage.size(); w++) {
-						vecDataAverage[w].Initialize(nLev, nLat, nLon);
-					}
-				}
+	// Files already included in the running average
+	vecSourceFiles.clear();
 
-				// Check array sizes
-				if ((nRefLev != nLev) ||
-					(nRefLat != nLat) ||
-					(nRefLon != nLon)
-				) {
-					_EXCEPTIONT("Dimension size mismatch");
-				}
+	NcAtt * attSourceFiles = ncdf_run.get_att("source_files");
+	if (attSourceFiles != NULL) {
+		char * szSourceFiles = attSourceFiles->as_string(0);
 
-				// Load data
-				varIn->set_cur(t, 0, 0, 0);
-				varIn->get(&(dataInput[0][0][0]), 1, nLev, nLat, nLon);
+		std::string strSourceFiles(szSourceFiles);
+		delete[] szSourceFiles;
 
-				// Add to average
-				for (int k = 0; k < nLev; k++) {
-				for (int i = 0; i < nLat; i++) {
-				for (int j = 0; j < nLon; j++) {
-					vecDataAverage[v][k][i][j] += dataInput[k][i][j];
-				}
-				}
+		int iBegin = 0;
+		for (int i = 0; i <= strSourceFiles.length(); i++) {
+			if ((i == strSourceFiles.length()) || (strSourceFiles[i] == '\n')) {
+				if (i > iBegin) {
+					vecSourceFiles.push_back(
+						strSourceFiles.substr(iBegin, i - iBegin));
 				}
+				iBegin = i + 1;
 			}
 		}
-
-		// Advance the total time
-		nTotalTime += nTime;
 	}
 
-	// Average by total time increments
-	for (int v = 0; v < vecDataAverage.size(); v++) {
-		for (int k = 0; k < nRefLev; k++) {
-		for (int i = 0; i < nRefLat; i++) {
-		for (int j = 0; j < nRefLon; j++) {
-			vecDataAverage[v][k][i][j] /= 
-				static_cast<double>(nTotalTime);
-		}
-		}
-		}
-	}
+	Announce("%i samples from %i files",
+		static_cast<int>(acc.m_dSamples),
+		static_cast<int>(vecSourceFiles.size()));
 
 	AnnounceEndBlock("Done");
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void EddyStatistics(
-	const std::vector<std::string> & strFileList,
+void WriteRunningAverage(
+	const ZonalTemporalAccumulator & acc,
 	const std::vector<std::string> & vecVariableStrings,
-	const std::vector< DataMatrix<double> > & dataDifference,
-	std::vector< DataMatrix3D<double> > & vecDataAverage
+	const std::vector<std::string> & vecSourceFiles,
+	NcFile & ncdf_out,
+	NcDim * dimOutLev,
+	NcDim * dimOutLat
 ) {
-	// Find eddy variables
-	int ixVarU = (-1);
-	int ixVarV = (-1);
-	int ixVarT = (-1);
+	const int nLev = acc.m_dataSum.GetColumns();
+	const int nLat = acc.m_dataSum.GetSubColumns();
 
-	for (int v = 0; v < vecVariableStrings.size(); v++) {
-		if (vecVariableStrings[v] == "U") {
-			ixVarU = v;
-		} else if (vecVariableStrings[v] == "V") {
-			ixVarV = v;
-		} else if (vecVariableStrings[v] == "T") {
-			ixVarT = v;
-		}
-	}
+	ncdf_out.add_att("samples", acc.m_dSamples);
+	ncdf_out.add_att("lon_points", static_cast<double>(acc.m_nLon));
 
-	if (ixVarU == (-1)) {
-		_EXCEPTIONT("Variable U must be included in variable list"
-			" for eddy statistics");
-	}
-	if (ixVarV == (-1)) {
-		_EXCEPTIONT("Variable V must be included in variable list"
-			" for eddy statistics");
+	std::string strSourceFiles;
+	for (int f = 0; f < vecSourceFiles.size(); f++) {
+		strSourceFiles += vecSourceFiles[f];
+		strSourceFiles += "\n";
 	}
-	if (ixVarT == (-1)) {
-		_EXCEPTIONT("Variable T must be included in variable list"
-			" for eddy statistics");
-	}
-
-	// Total time 
-	int nTotalTime = 0;
-
-	// Reference number of elements
-	int nRefLev;
-	int nRefLat;
-	int nRefLon;
-
-	// Temporary data storage for input data
-	DataMatrix3D<double> dataInputU;
-	DataMatrix3D<double> dataInputV;
-	DataMatrix3D<double> dataInputT;
-
-	// Loop through all files
-	for (int f = 0; f < strFileList.size(); f++) {
-
-		// Announce file
-		Announce("%s", strFileList[f].c_str());
-
-		// Open the file
-		NcFile ncdf_in(strFileList[f].c_str(), NcFile::ReadOnly);
-		if (!ncdf_in.is_valid()) {
-			_EXCEPTION1("Unable to open file \"%s\" for reading",
-				strFileList[f].c_str());
-		}
-
-		// Get the time dimension
-		NcDim * dimTime = ncdf_in.get_dim("time");
-		int nTime = dimTime->size();
-
-		// Loop through all times
-		for (int t = 0; t < nTime; t++) {
-
-			// Primitive variables
-			NcVar * varInU = ncdf_in.get_var("U");
-			NcVar * varInV = ncdf_in.get_var("V");
-			NcVar * varInT = ncdf_in.get_var("T");
-
-			// Load level array
-			NcDim * dimLev = varInU->get_dim(1);
-			int nLev = dimLev->size();
-
-			// Load latitude array
-			NcDim * dimLat = varInU->get_dim(2);
-			int nLat = dimLat->size();
-
-			// Load longitude array
-			NcDim * dimLon = varInU->get_dim(3);
-			int nLon = dimLon->size();
-
-			// Allocate space for data
-			if ((f == 0) && (t == 0)) {
-
-				// Store reference sizes
-				nRefLev = nLev;
-				nRefLat = nLat;
-				nRefLon = nLon;
+	ncdf_out.add_att("source_files", strSourceFiles.c_str());
 
-				dataInputU.Initialize(nRefLev, nRefLat, nRefLon);
-				dataInputV.Initialize(nRefLev, nRefLat, nRefLon);
-				dataInputT.Initialize(nRefLev, nRefLat, nRefLon);
-
-				// Allocate input data
-				vecDataAverage.resize(5);
-				vecDataAverage[0].Initialize(nLev, nLat, nLon);
-				vecDataAverage[1].Initialize(nLev, nLat, nLon);
-				vecDataAverage[2].Initialize(nLev, nLat, nLon);
-				vecDataAverage[3].Initialize(nLev, nLat, nLon);
-				vecDataAverage[4].Initialize(nLev, nLat, nLon);
-			}
-
-			// Check array sizes
-			if ((nRefLev != nLev) ||
-				(nRefLat != nLat) ||
-				(nRefLon != nLon)
-			) {
-				_EXCEPTIONT("Dimension size mismatch");
-			}
-
-			// Load eddy statistics variables
-			varInU->set_cur(t, 0, 0, 0);
-			varInU->get(&(dataInputU[0][0][0]), 1, nLev, nLat, nLon);
+	for (int v = 0; v < vecVariableStrings.size(); v++) {
+		NcVar * varShift =
+			ncdf_out.add_var(
+				(vecVariableStrings[v] + "_shift").c_str(),
+				ncDouble, dimOutLev, dimOutLat);
 
-			varInV->set_cur(t, 0, 0, 0);
-			varInV->get(&(dataInputV[0][0][0]), 1, nLev, nLat, nLon);
+		NcVar * varSum =
+			ncdf_out.add_var(
+				(vecVariableStrings[v] + "_sum").c_str(),
+				ncDouble, dimOutLev, dimOutLat);
 
-			varInT->set_cur(t, 0, 0, 0);
-			varInT->get(&(dataInputT[0][0][0]), 1, nLev, nLat, nLon);
+		varShift->put(&(acc.m_dataShift[v][0][0]), nLev, nLat);
+		varSum->put(&(acc.m_dataSum[v][0][0]), nLev, nLat);
+	}
 
-			// Add to average
-			for (int k = 0; k < nLev; k++) {
-			for (int i = 0; i < nLat; i++) {
-			for (int j = 0; j < nLon; j++) {
-				double dUprime =
-					dataInputU[k][i][j] - dataDifference[ixVarU][k][i];
-				double dVprime =
-					dataInputV[k][i][j] - dataDifference[ixVarV][k][i];
-				double dTprime =
-					dataInputT[k][i][j] - dataDifference[ixVarT][k][i];
-
-				vecDataAverage[0][k][i][j] += dUprime * dUprime;
-				vecDataAverage[1][k][i][j] += dUprime * dVprime;
-				vecDataAverage[2][k][i][j] += dVprime * dVprime;
-				vecDataAverage[3][k][i][j] += dVprime * dTprime;
-				vecDataAverage[4][k][i][j] += dTprime * dTprime;
-			}
-			}
-			}
-		}
+	for (int e = 0; e < acc.m_dataEddySum.GetRows(); e++) {
+		std::string strName = std::string(EddyStatisticsNames[e]) + "_sum";
 
-		// Advance the total time
-		nTotalTime += nTime;
-	}
+		NcVar * varSum =
+			ncdf_out.add_var(
+				strName.c_str(), ncDouble, dimOutLev, dimOutLat);
 
-	// Average by total time increments
-	for (int v = 0; v < vecDataAverage.size(); v++) {
-		for (int k = 0; k < nRefLev; k++) {
-		for (int i = 0; i < nRefLat; i++) {
-		for (int j = 0; j < nRefLon; j++) {
-			vecDataAverage[v][k][i][j] /= 
-				static_cast<double>(nTotalTime);
-		}
-		}
-		}
+		varSum->put(&(acc.m_dataEddySum[e][0][0]), nLev, nLat);
 	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void ZonalAverage(
-	const DataMatrix3D<double> & dataIn,
-	DataMatrix<double> & dataOut
+void LoadTimeSlice(
+	NcFile & ncdf_in,
+	const std::vector<std::string> & vecVariableStrings,
+	int t,
+	std::vector< DataMatrix3D<double> > & vecSlice
 ) {
-	dataOut.Initialize(
-		dataIn.GetRows(),
-		dataIn.GetColumns());
+	for (int v = 0; v < vecVariableStrings.size(); v++) {
+		NcVar * varIn = ncdf_in.get_var(vecVariableStrings[v].c_str());
+		if (varIn == NULL) {
+			_EXCEPTION1("Unable to load variable \"%s\" from file",
+				vecVariableStrings[v].c_str());
+		}
 
-	dataOut.Zero();
+		int nLev = varIn->get_dim(1)->size();
+		int nLat = varIn->get_dim(2)->size();
+		int nLon = varIn->get_dim(3)->size();
 
-	for (int k = 0; k < dataIn.GetRows(); k++) {
-	for (int i = 0; i < dataIn.GetColumns(); i++) {
-	for (int j = 0; j < dataIn.GetSubColumns(); j++) {
-		dataOut[k][i] += dataIn[k][i][j];
-	}
-	}
-	}
+		if ((nLev != vecSlice[v].GetRows()) ||
+			(nLat != vecSlice[v].GetColumns()) ||
+			(nLon != vecSlice[v].GetSubColumns())
+		) {
+			_EXCEPTIONT("Dimension size mismatch");
+		}
 
-	for (int k = 0; k < dataIn.GetRows(); k++) {
-	for (int i = 0; i < dataIn.GetColumns(); i++) {
-		dataOut[k][i] /= static_cast<double>(dataIn.GetSubColumns());
-	}
+		varIn->set_cur(t, 0, 0, 0);
+		varIn->get(&(vecSlice[v][0][0][0]), 1, nLev, nLat, nLon);
 	}
 }
 
@@ -595,6 +758,9 @@ try {
 	// Output filename
 	std::string strVariables;
 
+	// Existing running average
+	std::string strRunningFile;
+
 	// Eddy statistics
 	bool fCalculateEddyStatistics;
 
@@ -603,6 +769,7 @@ try {
 		CommandLineString(strInputFile, "inlist", "");
 		CommandLineString(strOutputFile, "out", "");
 		CommandLineString(strVariables, "var", "");
+		CommandLineString(strRunningFile, "running", "");
 
 		CommandLineBool(fCalculateEddyStatistics, "eddystats");
 
@@ -611,6 +778,13 @@ try {
 
 	AnnounceBanner();
 
+	// Determine processor rank and number of processors
+	int nRank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &nRank);
+
+	int nSize;
+	MPI_Comm_size(MPI_COMM_WORLD, &nSize);
+
 	// Check command line arguments
 	if (strInputFile == "") {
 		_EXCEPTIONT("No input file specified");
@@ -632,127 +806,333 @@ try {
 		_EXCEPTIONT("No variables specified");
 	}
 
-	// Open input file list
-	AnnounceStartBlock("Loading input file list");
-	FILE * fp = fopen(strInputFile.c_str(), "r");
+	// Find eddy variables
+	int ixVarU = (-1);
+	int ixVarV = (-1);
+	int ixVarT = (-1);
+
+	for (int v = 0; v < vecVariableStrings.size(); v++) {
+		if (vecVariableStrings[v] == "U") {
+			ixVarU = v;
+		} else if (vecVariableStrings[v] == "V") {
+			ixVarV = v;
+		} else if (vecVariableStrings[v] == "T") {
+			ixVarT = v;
+		}
+	}
+
+	if (fCalculateEddyStatistics) {
+		if (ixVarU == (-1)) {
+			_EXCEPTIONT("Variable U must be included in variable list"
+				" for eddy statistics");
+		}
+		if (ixVarV == (-1)) {
+			_EXCEPTIONT("Variable V must be included in variable list"
+				" for eddy statistics");
+		}
+		if (ixVarT == (-1)) {
+			_EXCEPTIONT("Variable T must be included in variable list"
+				" for eddy statistics");
+		}
+	}
+
+	// Running sums including all previous files (root only)
+	ZonalTemporalAccumulator accTotal;
+	accTotal.SetEddyVariables(ixVarU, ixVarV, ixVarT);
 
+	// Files included in the running sums
+	std::vector<std::string> vecSourceFiles;
+
+	// Input files and number of times in each file
 	std::vector<std::string> strFileList;
-	for (;;) {
-		char szFilename[1024];
-		fgets(szFilename, 1024, fp);
 
-		if (feof(fp)) {
-			break;
+	DataVector<int> nDims;
+	nDims.Initialize(4);
+
+	if (nRank == 0) {
+
+		// Load existing running average
+		if (strRunningFile != "") {
+			LoadRunningAverage(
+				strRunningFile,
+				vecVariableStrings,
+				fCalculateEddyStatistics,
+				accTotal,
+				vecSourceFiles);
 		}
 
-		std::string strFilename(szFilename);
-		strFilename[strFilename.length()-1] = '\0';
+		// Open input file list
+		AnnounceStartBlock("Loading input file list");
+		FILE * fp = fopen(strInputFile.c_str(), "r");
+		if (fp == NULL) {
+			_EXCEPTION1("Unable to open file \"%s\" for reading",
+				strInputFile.c_str());
+		}
+
+		for (;;) {
+			char szFilename[1024];
+			fgets(szFilename, 1024, fp);
+
+			if (feof(fp)) {
+				break;
+			}
+
+			std::string strFilename(szFilename);
+			strFilename.resize(strFilename.length()-1);
+
+			// Skip files already included in the running average
+			bool fIncluded = false;
+			for (int f = 0; f < vecSourceFiles.size(); f++) {
+				if (vecSourceFiles[f] == strFilename) {
+					fIncluded = true;
+					break;
+				}
+			}
 
-		strFileList.push_back(strFilename);
+			if (fIncluded) {
+				Announce("Skipping %s (already averaged)",
+					strFilename.c_str());
+			} else {
+				strFileList.push_back(strFilename);
+			}
+		}
+		fclose(fp);
+
+		if (strFileList.size() == 0) {
+			_EXCEPTIONT("No input files specified");
+		}
+		AnnounceEndBlock("Done");
+
+		// Get dimensions from the first file
+		NcFile ncdf_in(strFileList[0].c_str(), NcFile::ReadOnly);
+		if (!ncdf_in.is_valid()) {
+			_EXCEPTION1("Unable to open file \"%s\" for reading",
+				strFileList[0].c_str());
+		}
+
+		NcVar * varIn = ncdf_in.get_var(vecVariableStrings[0].c_str());
+		if (varIn == NULL) {
+			_EXCEPTION1("Unable to load variable \"%s\" from file",
+				vecVariableStrings[0].c_str());
+		}
+
+		nDims[0] = strFileList.size();
+		nDims[1] = varIn->get_dim(1)->size();
+		nDims[2] = varIn->get_dim(2)->size();
+		nDims[3] = varIn->get_dim(3)->size();
+
+		if (strRunningFile != "") {
+			if ((accTotal.m_dataSum.GetColumns() != nDims[1]) ||
+				(accTotal.m_dataSum.GetSubColumns() != nDims[2]) ||
+				(accTotal.m_nLon != nDims[3])
+			) {
+				_EXCEPTIONT("Running average dimension mismatch");
+			}
+		}
 	}
-	fclose(fp);
 
-	if (strFileList.size() == 0) {
-		_EXCEPTIONT("No input files specified");
+	// Broadcast the list of input files
+	MPI_Bcast(&(nDims[0]), 4, MPI_INT, 0, MPI_COMM_WORLD);
+
+	const int nFiles = nDims[0];
+	const int nLev = nDims[1];
+	const int nLat = nDims[2];
+	const int nLon = nDims[3];
+
+	strFileList.resize(nFiles);
+	for (int f = 0; f < nFiles; f++) {
+		int nLength = strFileList[f].length();
+		MPI_Bcast(&nLength, 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+		std::vector<char> vecFilename(nLength + 1, '\0');
+		if (nRank == 0) {
+			memcpy(&(vecFilename[0]), strFileList[f].c_str(), nLength);
+		}
+		MPI_Bcast(&(vecFilename[0]), nLength, MPI_CHAR, 0, MPI_COMM_WORLD);
+
+		strFileList[f] = std::string(&(vecFilename[0]));
 	}
-	AnnounceEndBlock("Done");
 
-	// Output file
-	NcFile ncdf_out(strOutputFile.c_str(), NcFile::Replace);
+	// Temporary data storage for one time slice
+	std::vector< DataMatrix3D<double> > vecSlice;
+	vecSlice.resize(vecVariableStrings.size());
+	for (int v = 0; v < vecSlice.size(); v++) {
+		vecSlice[v].Initialize(nLev, nLat, nLon);
+	}
 
-	// Setup output arrays from file
-	std::vector<NcVar *> vecOutVariables;
+	// Number of times in each file
+	AnnounceStartBlock("Temporal and zonal average");
 
-	NcDim * dimOutLev;
-	NcDim * dimOutLat;
+	DataVector<int> nFileTimes;
+	nFileTimes.Initialize(nFiles);
 
-	SetupArraysFromFile(
-		strFileList[0],
-		vecVariableStrings,
-		ncdf_out,
-		vecOutVariables,
-		&dimOutLev,
-		&dimOutLat);
+	if (nRank == 0) {
+		for (int f = 0; f < nFiles; f++) {
+			NcFile ncdf_in(strFileList[f].c_str(), NcFile::ReadOnly);
+			if (!ncdf_in.is_valid()) {
+				_EXCEPTION1("Unable to open file \"%s\" for reading",
+					strFileList[f].c_str());
+			}
 
-	// Data arrays for storing time average
-	std::vector< DataMatrix3D<double> > vecTimeAverage;
-	vecTimeAverage.resize(vecVariableStrings.size());
+			nFileTimes[f] = ncdf_in.get_dim("time")->size();
+		}
+	}
 
-	// Temporal average
-	TimeAverage(
-		strFileList,
-		vecVariableStrings,
-		vecTimeAverage);
+	MPI_Bcast(&(nFileTimes[0]), nFiles, MPI_INT, 0, MPI_COMM_WORLD);
 
-	// Zonal average
-	std::vector< DataMatrix<double> > vecZonalTimeAverage;
+	// Running sums on this processor
+	ZonalTemporalAccumulator acc;
+	acc.SetEddyVariables(ixVarU, ixVarV, ixVarT);
+	acc.Initialize(
+		vecVariableStrings.size(), nLev, nLat, nLon,
+		fCalculateEddyStatistics);
 
-	vecZonalTimeAverage.resize(vecTimeAverage.size());
+	// The shift is the zonal mean of the first sample in the running sums
+	if (nRank == 0) {
+		if (strRunningFile != "") {
+			memcpy(
+				&(acc.m_dataShift[0][0][0]),
+				&(accTotal.m_dataShift[0][0][0]),
+				acc.m_dataShift.GetTotalElements() * sizeof(double));
 
-	AnnounceStartBlock("Zonal Average");
-	for (int v = 0; v < vecTimeAverage.size(); v++) {
-		ZonalAverage(
-			vecTimeAverage[v],
-			vecZonalTimeAverage[v]);
+		} else {
+			accTotal.Initialize(
+				vecVariableStrings.size(), nLev, nLat, nLon,
+				fCalculateEddyStatistics);
+
+			NcFile ncdf_in(strFileList[0].c_str(), NcFile::ReadOnly);
+			LoadTimeSlice(ncdf_in, vecVariableStrings, 0, vecSlice);
+
+			acc.SetShift(vecSlice);
+			accTotal.SetShift(vecSlice);
+		}
 	}
-	AnnounceEndBlock("Done");
 
-	// Output
-	AnnounceStartBlock("Output zonal averages");
-	for (int v = 0; v < vecTimeAverage.size(); v++) {
-		vecOutVariables[v]->put(
-			&(vecZonalTimeAverage[v][0][0]),
-			vecZonalTimeAverage[v].GetRows(),
-			vecZonalTimeAverage[v].GetColumns());
+	acc.BroadcastShift();
+
+	// Each processor averages a contiguous range of time slices
+	int nTotalTimes = 0;
+	for (int f = 0; f < nFiles; f++) {
+		nTotalTimes += nFileTimes[f];
 	}
+
+	int iSliceBegin = static_cast<int>(
+		static_cast<long>(nTotalTimes) * nRank / nSize);
+	int iSliceEnd = static_cast<int>(
+		static_cast<long>(nTotalTimes) * (nRank + 1) / nSize);
+
+	Announce("%i time slices in %i files on %i processors",
+		nTotalTimes, nFiles, nSize);
+
+	int iSlice = 0;
+	for (int f = 0; f < nFiles; f++) {
+		int iFileBegin = iSlice;
+		iSlice += nFileTimes[f];
+
+		if ((iSlice <= iSliceBegin) || (iFileBegin >= iSliceEnd)) {
+			continue;
+		}
+
+		// Announce file
+		Announce("%s", strFileList[f].c_str());
+
+		// Open the file
+		NcFile ncdf_in(strFileList[f].c_str(), NcFile::ReadOnly);
+		if (!ncdf_in.is_valid()) {
+			_EXCEPTION1("Unable to open file \"%s\" for reading",
+				strFileList[f].c_str());
+		}
+
+		// Loop through all times in this file on this processor
+		for (int t = 0; t < nFileTimes[f]; t++) {
+			if ((iFileBegin + t < iSliceBegin) ||
+				(iFileBegin + t >= iSliceEnd)
+			) {
+				continue;
+			}
+
+			LoadTimeSlice(ncdf_in, vecVariableStrings, t, vecSlice);
+
+			acc.AddSlice(vecSlice);
+		}
+	}
+
+	// Combine the sums from all processors
+	acc.Reduce();
+
 	AnnounceEndBlock("Done");
 
-	// Calculate eddy statistics
-	if (fCalculateEddyStatistics) {
-		AnnounceStartBlock("Eddy statistics");
+	// Output
+	if (nRank == 0) {
+		accTotal.Add(acc);
+
+		for (int f = 0; f < nFiles; f++) {
+			vecSourceFiles.push_back(strFileList[f]);
+		}
+
+		AnnounceStartBlock("Output zonal averages");
 
-		std::vector< DataMatrix3D<double> > vecEddyTimeAverages;
-		vecEddyTimeAverages.resize(5);
+		// Output file
+		NcFile ncdf_out(strOutputFile.c_str(), NcFile::Replace);
 
-		EddyStatistics(
-			strFileList,
+		// Setup output arrays from file
+		std::vector<NcVar *> vecOutVariables;
+
+		NcDim * dimOutLev;
+		NcDim * dimOutLat;
+
+		SetupArraysFromFile(
+			strFileList[0],
 			vecVariableStrings,
-			vecZonalTimeAverage,
-			vecEddyTimeAverages);
-
-		std::vector< DataMatrix<double> > vecZonalTimeEddyAverage;
-		vecZonalTimeEddyAverage.resize(5);
-		for (int v = 0; v < vecEddyTimeAverages.size(); v++) {
-			ZonalAverage(
-				vecEddyTimeAverages[v],
-				vecZonalTimeEddyAverage[v]);
-		}
-
-		int nLev = vecZonalTimeEddyAverage[0].GetRows();
-		int nLat = vecZonalTimeEddyAverage[0].GetColumns();
-
-		NcVar * varUU =
-			ncdf_out.add_var("UU", ncDouble, dimOutLev, dimOutLat); 
-		NcVar * varUV =
-			ncdf_out.add_var("UV", ncDouble, dimOutLev, dimOutLat); 
-		NcVar * varVV =
-			ncdf_out.add_var("VV", ncDouble, dimOutLev, dimOutLat); 
-		NcVar * varVT =
-			ncdf_out.add_var("VT", ncDouble, dimOutLev, dimOutLat); 
-		NcVar * varTT =
-			ncdf_out.add_var("TT", ncDouble, dimOutLev, dimOutLat);
-
-		varUU->put(&(vecZonalTimeEddyAverage[0][0][0]), nLev, nLat);
-		varUV->put(&(vecZonalTimeEddyAverage[1][0][0]), nLev, nLat);
-		varVV->put(&(vecZonalTimeEddyAverage[2][0][0]), nLev, nLat);
-		varVT->put(&(vecZonalTimeEddyAverage[3][0][0]), nLev, nLat);
-		varTT->put(&(vecZonalTimeEddyAverage[4][0][0]), nLev, nLat);
+			ncdf_out,
+			vecOutVariables,
+			&dimOutLev,
+			&dimOutLat);
+
+		DataMatrix<double> dataMean;
+		for (int v = 0; v < vecVariableStrings.size(); v++) {
+			accTotal.GetMean(v, dataMean);
+
+			vecOutVariables[v]->put(
+				&(dataMean[0][0]),
+				dataMean.GetRows(),
+				dataMean.GetColumns());
+		}
+
+		// Eddy statistics
+		if (fCalculateEddyStatistics) {
+			for (int e = 0; e < EddyStatisticsCount; e++) {
+				NcVar * varEddy =
+					ncdf_out.add_var(
+						EddyStatisticsNames[e], ncDouble,
+						dimOutLev, dimOutLat);
+
+				accTotal.GetEddyStatistic(e, dataMean);
+
+				varEddy->put(
+					&(dataMean[0][0]),
+					dataMean.GetRows(),
+					dataMean.GetColumns());
+			}
+		}
+
+		// Running sums, used to add further files to this average
+		WriteRunningAverage(
+			accTotal,
+			vecVariableStrings,
+			vecSourceFiles,
+			ncdf_out,
+			dimOutLev,
+			dimOutLat);
 
 		AnnounceEndBlock("Done");
 	}
-	
+
 } catch(Exception & e) {
 	Announce(e.ToString().c_str());
+
+	// Other processors may be waiting on root
+	MPI_Abort(MPI_COMM_WORLD, 1);
 }
 
 	// Finalize MPI